@@ -0,0 +1,35 @@
+#include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/utils/shape/sphere.h>
+
+#include "../common.h"
+
+using namespace wavemap;
+int main(int, char**) {
+  // Declare a map pointer for illustration purposes
+  // NOTE: See the other tutorials on how to load maps from files or ROS topics,
+  //       such as the map topic published by the wavemap ROS server.
+  HashedWaveletOctree::Ptr map;
+
+  // Define the region of interest, for example a sphere around the robot
+  // NOTE: AABB and OrientedBox regions are also supported.
+  const Sphere<Point3D> region{Point3D{1.f, 2.f, 3.f}, 5.f};
+
+  // Visit all leaf nodes that overlap the region
+  // NOTE: Only the blocks and subtrees that overlap the region are traversed,
+  //       so the cost scales with the size of the region instead of the map.
+  map->forEachLeafInRegion(
+      region, [](const OctreeIndex& node_index, FloatingPoint log_odds) {
+        examples::doSomething(node_index, log_odds);
+      });
+
+  // The iteration can be stopped early by returning false from the visitor,
+  // for example to check whether the region contains any occupied nodes
+  bool region_is_occupied = false;
+  map->forEachLeafInRegion(
+      region, [&region_is_occupied](const OctreeIndex& /*node_index*/,
+                                    FloatingPoint log_odds) {
+        region_is_occupied = 0.f < log_odds;
+        return !region_is_occupied;
+      });
+  examples::doSomething(region_is_occupied);
+}
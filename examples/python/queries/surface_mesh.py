@@ -0,0 +1,20 @@
+import pywavemap as wave
+import _dummy_objects
+
+# Load a map
+your_map = _dummy_objects.example_map()
+
+# Log odds threshold above which to consider a cell occupied
+log_odds_occupancy_threshold = 1e-3
+
+# Extract the surface of occupied space as a triangle mesh in one go
+vertices, triangles = wave.mesh.extract_surface(your_map,
+                                                log_odds_occupancy_threshold)
+print(vertices.shape, triangles.shape)
+
+# If the map keeps changing, keep the extractor around and update it whenever
+# the map changed. Only the blocks that changed will be remeshed.
+surface_extractor = wave.mesh.SurfaceExtractor(log_odds_occupancy_threshold)
+updated_blocks = surface_extractor.update(your_map)
+print(updated_blocks)
+vertices, triangles = surface_extractor.get_mesh()
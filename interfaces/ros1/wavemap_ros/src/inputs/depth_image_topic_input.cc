@@ -13,6 +13,7 @@
 #include <wavemap/core/integrator/projective/projective_integrator.h>
 #include <wavemap/core/utils/iterate/grid_iterator.h>
 #include <wavemap/core/utils/print/eigen.h>
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap {
@@ -64,6 +65,8 @@ DepthImageTopicInput::DepthImageTopicInput(
 
 void DepthImageTopicInput::processQueue() {
   ProfilerZoneScoped;
+  static auto& queue_length = metrics::getGauge("ros_depth_image_queue_length");
+  queue_length.set(static_cast<double>(depth_image_queue_.size()));
   while (!depth_image_queue_.empty()) {
     const sensor_msgs::Image& oldest_msg = depth_image_queue_.front();
     const std::string sensor_frame_id = config_.sensor_frame_id.empty()
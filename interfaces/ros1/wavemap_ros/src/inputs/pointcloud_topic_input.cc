@@ -12,6 +12,7 @@
 #include <sensor_msgs/point_cloud_conversion.h>
 #include <wavemap/core/data_structure/image.h>
 #include <wavemap/core/integrator/projective/projective_integrator.h>
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 #include <wavemap_ros_conversions/time_conversions.h>
 
@@ -182,6 +183,8 @@ void PointcloudTopicInput::callback(
 
 void PointcloudTopicInput::processQueue() {
   ProfilerZoneScoped;
+  static auto& queue_length = metrics::getGauge("ros_pointcloud_queue_length");
+  queue_length.set(static_cast<double>(pointcloud_queue_.size()));
   while (!pointcloud_queue_.empty()) {
     auto& oldest_msg = pointcloud_queue_.front();
 
@@ -6,6 +6,7 @@
 
 #include <wavemap/core/map/hashed_chunked_wavelet_octree.h>
 #include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
 #include <wavemap/core/utils/edit/crop.h>
 
 namespace wavemap {
@@ -95,6 +96,12 @@ void CropMapOperation::run(bool force_run) {
              hashed_chunked_wavelet_octree) {
     edit::crop(*hashed_chunked_wavelet_octree, cropping_sphere,
                termination_height_, thread_pool_);
+  } else if (auto* linear_hashed_wavelet_octree =
+                 dynamic_cast<LinearHashedWaveletOctree*>(
+                     occupancy_map_.get());
+             linear_hashed_wavelet_octree) {
+    edit::crop(*linear_hashed_wavelet_octree, cropping_sphere,
+               termination_height_, thread_pool_);
   } else {
     ROS_WARN(
         "Map cropping is only supported for hash-based map data structures.");
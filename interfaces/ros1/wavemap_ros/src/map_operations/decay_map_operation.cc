@@ -5,6 +5,7 @@
 
 #include <wavemap/core/map/hashed_chunked_wavelet_octree.h>
 #include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
 
 #include "wavemap/core/utils/edit/multiply.h"
 
@@ -58,6 +59,12 @@ void DecayMapOperation::run(bool force_run) {
              hashed_chunked_wavelet_octree) {
     edit::multiply(*hashed_chunked_wavelet_octree, config_.decay_rate,
                    thread_pool_);
+  } else if (auto* linear_hashed_wavelet_octree =
+                 dynamic_cast<LinearHashedWaveletOctree*>(
+                     occupancy_map_.get());
+             linear_hashed_wavelet_octree) {
+    edit::multiply(*linear_hashed_wavelet_octree, config_.decay_rate,
+                   thread_pool_);
   } else {
     ROS_WARN("Map decay is only supported for hash-based map data structures.");
   }
@@ -68,6 +68,12 @@ void PublishMapOperation::publishMap(const ros::Time& current_time,
           dynamic_cast<HashedWaveletOctree*>(occupancy_map_.get());
       hashed_wavelet_octree) {
     publishHashedMap(current_time, hashed_wavelet_octree, republish_whole_map);
+  } else if (auto* linear_hashed_wavelet_octree =
+                 dynamic_cast<LinearHashedWaveletOctree*>(
+                     occupancy_map_.get());
+             linear_hashed_wavelet_octree) {
+    publishHashedMap(current_time, linear_hashed_wavelet_octree,
+                     republish_whole_map);
   } else if (auto* hashed_chunked_wavelet_octree =
                  dynamic_cast<HashedChunkedWaveletOctree*>(
                      occupancy_map_.get());
@@ -9,6 +9,7 @@
 #include <wavemap/core/indexing/index_conversions.h>
 #include <wavemap/core/map/hashed_chunked_wavelet_octree.h>
 #include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
 #include <wavemap/core/utils/iterate/grid_iterator.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 #include <wavemap_ros_conversions/geometry_msg_conversions.h>
@@ -115,6 +116,11 @@ void PublishPointcloudOperation::publishPointcloud(
                      occupancy_map_.get());
              hashed_chunked_wavelet_octree) {
     hashed_chunked_wavelet_octree->forEachBlock(process_block_if_changed);
+  } else if (const auto* linear_hashed_wavelet_octree =
+                 dynamic_cast<const LinearHashedWaveletOctree*>(
+                     occupancy_map_.get());
+             linear_hashed_wavelet_octree) {
+    linear_hashed_wavelet_octree->forEachBlock(process_block_if_changed);
   } else {  // Fallback for non-hashed map types: simply process all leaves
     occupancy_map_->forEachLeaf(add_points_for_leaf_node);
   }
@@ -5,6 +5,7 @@
 
 #include <std_srvs/Trigger.h>
 #include <wavemap/core/map/map_factory.h>
+#include <wavemap/core/utils/cpu/dispatch.h>
 #include <wavemap/io/file_conversions.h>
 #include <wavemap/pipeline/map_operations/map_operation_factory.h>
 #include <wavemap_msgs/FilePath.h>
@@ -46,6 +47,9 @@ RosServer::RosServer(ros::NodeHandle nh, ros::NodeHandle nh_private,
   config_.logging_level.applyToGlog();
   config_.logging_level.applyToRosConsole();
 
+  // Report which instruction sets the hot kernels use on this CPU
+  ROS_INFO_STREAM(cpu::getActiveKernelPathsStr());
+
   // Setup data structure
   const auto data_structure_params =
       param::convert::toParamValue(nh_private, "map");
@@ -140,8 +144,8 @@ MapOperationBase* RosServer::addOperation(const param::Value& operation_params,
   }
 
   if (const auto type = MapOperationType{type_name.value()}; type.isValid()) {
-    auto operation =
-        MapOperationFactory::create(type, operation_params, occupancy_map_);
+    auto operation = MapOperationFactory::create(type, operation_params,
+                                                 occupancy_map_, thread_pool_);
     return pipeline_->addOperation(std::move(operation));
   }
 
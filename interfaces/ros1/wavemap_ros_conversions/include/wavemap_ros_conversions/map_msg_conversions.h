@@ -12,6 +12,7 @@
 #include <wavemap/core/map/hashed_blocks.h>
 #include <wavemap/core/map/hashed_chunked_wavelet_octree.h>
 #include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
 #include <wavemap/core/map/volumetric_octree.h>
 #include <wavemap/core/map/wavelet_octree.h>
 #include <wavemap/core/utils/thread_pool.h>
@@ -20,6 +21,9 @@
 namespace wavemap::convert {
 bool mapToRosMsg(const MapBase& map, const std::string& frame_id,
                  const ros::Time& stamp, wavemap_msgs::Map& msg);
+// NOTE: Hashed wavelet octree msgs are deserialized into a
+//       LinearHashedWaveletOctree if the map argument points to one, and into
+//       a HashedWaveletOctree otherwise.
 bool rosMsgToMap(const wavemap_msgs::Map& msg, MapBase::Ptr& map);
 
 void mapToRosMsg(const HashedBlocks& map, wavemap_msgs::HashedBlocks& msg);
@@ -41,6 +45,19 @@ void blockToRosMsg(const HashedWaveletOctree::BlockIndex& block_index,
 void rosMsgToMap(const wavemap_msgs::HashedWaveletOctree& msg,
                  HashedWaveletOctree::Ptr& map);
 
+// Linear hashed wavelet octrees use the same msg as regular ones
+void mapToRosMsg(const LinearHashedWaveletOctree& map,
+                 wavemap_msgs::HashedWaveletOctree& msg,
+                 std::optional<std::unordered_set<Index3D, Index3DHash>>
+                     include_blocks = std::nullopt,
+                 std::shared_ptr<ThreadPool> thread_pool = nullptr);
+void blockToRosMsg(const LinearHashedWaveletOctree::BlockIndex& block_index,
+                   const LinearHashedWaveletOctree::Block& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   wavemap_msgs::HashedWaveletOctreeBlock& msg);
+void rosMsgToMap(const wavemap_msgs::HashedWaveletOctree& msg,
+                 LinearHashedWaveletOctree::Ptr& map);
+
 void mapToRosMsg(const HashedChunkedWaveletOctree& map,
                  wavemap_msgs::HashedWaveletOctree& msg,
                  std::optional<std::unordered_set<Index3D, Index3DHash>>
@@ -5,11 +5,227 @@
 #include <stack>
 #include <string>
 #include <unordered_set>
+#include <utility>
 
 #include <ros/console.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap::convert {
+namespace {
+// Shared implementation of the conversions for all hashed wavelet octree
+// types, which are represented by the same ROS msg
+template <typename BlockT>
+void hashedWaveletOctreeBlockToRosMsg(
+    const Index3D& block_index, const BlockT& block, FloatingPoint min_log_odds,
+    FloatingPoint max_log_odds, wavemap_msgs::HashedWaveletOctreeBlock& msg) {
+  ProfilerZoneScoped;
+  // Convenience type for elements on the stack used to iterate over the map
+  struct StackElement {
+    const FloatingPoint scale;
+    typename BlockT::OctreeType::NodeConstRefType node;
+  };
+
+  // Serialize the block's metadata
+  msg.root_node_offset.x = block_index.x();
+  msg.root_node_offset.y = block_index.y();
+  msg.root_node_offset.z = block_index.z();
+  // Wavelet scale coefficient of the block's root node
+  msg.root_node_scale_coefficient = block.getRootScale();
+
+  // Serialize the block's data (all nodes of its octree)
+  std::stack<StackElement> stack;
+  stack.emplace(StackElement{block.getRootScale(), block.getRootNode()});
+  while (!stack.empty()) {
+    const FloatingPoint scale = stack.top().scale;
+    typename BlockT::OctreeType::NodeConstRefType node = stack.top().node;
+    stack.pop();
+
+    // Serialize the node's data
+    auto& node_msg = msg.nodes.emplace_back();
+    std::copy(node.data().cbegin(), node.data().cend(),
+              node_msg.detail_coefficients.begin());
+    node_msg.allocated_children_bitset = 0;
+
+    // Evaluate which of its children should be serialized
+    const auto child_scales =
+        BlockT::Transform::backward({scale, node.data()});
+    // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
+    //       the nodes are popped from the stack in increasing order.
+    for (int relative_child_idx = OctreeIndex::kNumChildren - 1;
+         0 <= relative_child_idx; --relative_child_idx) {
+      // If the child is saturated, we don't need to store its descendants
+      const auto child_scale = child_scales[relative_child_idx];
+      if (child_scale < min_log_odds || max_log_odds < child_scale) {
+        continue;
+      }
+      // Otherwise, indicate that the child will be serialized
+      // and add it to the stack
+      const auto child = node.getChild(relative_child_idx);
+      if (child) {
+        stack.emplace(StackElement{child_scale, *child});
+        node_msg.allocated_children_bitset += (1 << relative_child_idx);
+      }
+    }
+  }
+}
+
+template <typename MapT>
+void hashedWaveletOctreeToRosMsg(
+    const MapT& map, wavemap_msgs::HashedWaveletOctree& msg,
+    std::optional<std::unordered_set<Index3D, Index3DHash>> include_blocks,
+    const std::shared_ptr<ThreadPool>& thread_pool) {
+  ProfilerZoneScoped;
+  // Constants
+  constexpr FloatingPoint kNumericalNoise = 1e-3f;
+  const auto min_log_odds = map.getMinLogOdds() + kNumericalNoise;
+  const auto max_log_odds = map.getMaxLogOdds() - kNumericalNoise;
+
+  // Serialize the map and data structure's metadata
+  msg.min_cell_width = map.getMinCellWidth();
+  msg.min_log_odds = map.getMinLogOdds();
+  msg.max_log_odds = map.getMaxLogOdds();
+  msg.tree_height = map.getTreeHeight();
+
+  // Indicate which blocks are allocated in the map
+  // NOTE: This is done such that subscribers know when blocks should be removed
+  //       during incremental map transmission.
+  msg.allocated_block_indices.reserve(map.getHashMap().size());
+  map.forEachBlock([&msg](const Index3D& block_index, const auto& /*block*/) {
+    auto& block_index_msg = msg.allocated_block_indices.emplace_back();
+    block_index_msg.x = block_index.x();
+    block_index_msg.y = block_index.y();
+    block_index_msg.z = block_index.z();
+  });
+
+  // If blocks to include were specified, check that they exist
+  // and remove the ones that do not
+  if (include_blocks) {
+    for (auto include_block_it = include_blocks->begin();
+         include_block_it != include_blocks->end();) {
+      if (map.hasBlock(*include_block_it)) {
+        ++include_block_it;
+      } else {
+        include_block_it = include_blocks->erase(include_block_it);
+      }
+    }
+  } else {  // Otherwise, include all blocks
+    include_blocks.emplace();
+    map.forEachBlock(
+        [&include_blocks](const Index3D& block_index, const auto& /*block*/) {
+          include_blocks->emplace(block_index);
+        });
+  }
+
+  // Serialize the specified blocks
+  int block_idx = 0;
+  msg.blocks.resize(include_blocks->size());
+  for (const auto& block_index : include_blocks.value()) {
+    if (const auto* block = map.getBlock(block_index); block) {
+      auto& block_msg = msg.blocks[block_idx++];
+      // If a thread pool was provided, use it
+      if (thread_pool) {
+        thread_pool->add_task(
+            [block_index, block, min_log_odds, max_log_odds, &block_msg]() {
+              hashedWaveletOctreeBlockToRosMsg(block_index, *block,
+                                               min_log_odds, max_log_odds,
+                                               block_msg);
+            });
+      } else {  // Otherwise, use the current thread
+        hashedWaveletOctreeBlockToRosMsg(block_index, *block, min_log_odds,
+                                         max_log_odds, block_msg);
+      }
+    }
+  }
+
+  // If a thread pool was used, wait for all jobs to finish
+  if (thread_pool) {
+    thread_pool->wait_all();
+  }
+}
+
+template <typename MapT>
+void rosMsgToHashedWaveletOctree(const wavemap_msgs::HashedWaveletOctree& msg,
+                                 typename MapT::Ptr& map) {
+  ProfilerZoneScoped;
+  // Deserialize the map's config and initialize the data structure
+  HashedWaveletOctreeConfig config;
+  config.min_cell_width = msg.min_cell_width;
+  config.min_log_odds = msg.min_log_odds;
+  config.max_log_odds = msg.max_log_odds;
+  config.tree_height = msg.tree_height;
+
+  // Check if the map already exists and has compatible settings
+  if (map && map->getConfig() == config) {
+    // Load allocated block list into a hash table for quick membership lookups
+    std::unordered_set<Index3D, Index3DHash> allocated_blocks;
+    for (const auto& block_index : msg.allocated_block_indices) {
+      allocated_blocks.emplace(block_index.x, block_index.y, block_index.z);
+    }
+    // Remove local blocks that should no longer exist according to the map msg
+    map->eraseBlockIf(
+        [&allocated_blocks](const Index3D& block_index, const auto& /*block*/) {
+          return !allocated_blocks.count(block_index);
+        });
+  } else {
+    // Otherwise create a new map
+    map = std::make_shared<MapT>(config);
+  }
+
+  // Deserialize all the transferred blocks
+  for (const auto& block_msg : msg.blocks) {
+    const Index3D block_index{block_msg.root_node_offset.x,
+                              block_msg.root_node_offset.y,
+                              block_msg.root_node_offset.z};
+
+    // Reset the block if it already existed
+    const bool block_existed = map->hasBlock(block_index);
+    auto& block = map->getOrAllocateBlock(block_index);
+    if (block_existed) {
+      block.clear();
+    }
+
+    // Deserialize the wavelet scale coefficient of the block's root node
+    block.getRootScale() = block_msg.root_node_scale_coefficient;
+
+    // Deserialize the block's remaining data into octree nodes
+    std::stack<typename MapT::Block::OctreeType::NodePtrType> stack;
+    stack.emplace(&block.getRootNode());
+    for (const auto& node_msg : block_msg.nodes) {
+      DCHECK(!stack.empty());
+      auto node = stack.top();
+      stack.pop();
+
+      // Deserialize the node's (wavelet) detail coefficients
+      std::copy(node_msg.detail_coefficients.cbegin(),
+                node_msg.detail_coefficients.cend(), node->data().begin());
+
+      // Allocate the node's children
+      // NOTE: Allocating a child can move its siblings in linear octrees, so
+      //       we only look the children up once they have all been allocated.
+      for (int relative_child_idx = 0;
+           relative_child_idx < wavemap::OctreeIndex::kNumChildren;
+           ++relative_child_idx) {
+        if (node_msg.allocated_children_bitset & (1 << relative_child_idx)) {
+          node->getOrAllocateChild(relative_child_idx);
+        }
+      }
+
+      // Evaluate which of the node's children are coming next
+      // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
+      //       the nodes are popped from the stack in increasing order.
+      for (int relative_child_idx = wavemap::OctreeIndex::kNumChildren - 1;
+           0 <= relative_child_idx; --relative_child_idx) {
+        const bool child_exists =
+            node_msg.allocated_children_bitset & (1 << relative_child_idx);
+        if (child_exists) {
+          stack.emplace(node->getChild(relative_child_idx));
+        }
+      }
+    }
+  }
+}
+}  // namespace
+
 bool mapToRosMsg(const MapBase& map, const std::string& frame_id,
                  const ros::Time& stamp, wavemap_msgs::Map& msg) {
   // Write the msg header
@@ -34,6 +250,13 @@ bool mapToRosMsg(const MapBase& map, const std::string& frame_id,
                          msg.hashed_wavelet_octree.emplace_back());
     return true;
   }
+  if (const auto* linear_hashed_wavelet_octree =
+          dynamic_cast<const LinearHashedWaveletOctree*>(&map);
+      linear_hashed_wavelet_octree) {
+    convert::mapToRosMsg(*linear_hashed_wavelet_octree,
+                         msg.hashed_wavelet_octree.emplace_back());
+    return true;
+  }
   if (const auto* hashed_chunked_wavelet_octree =
           dynamic_cast<const HashedChunkedWaveletOctree*>(&map);
       hashed_chunked_wavelet_octree) {
@@ -92,6 +315,14 @@ bool rosMsgToMap(const wavemap_msgs::Map& msg, MapBase::Ptr& map) {
     return true;
   }
   if (!msg.hashed_wavelet_octree.empty()) {
+    if (auto linear_hashed_wavelet_octree =
+            std::dynamic_pointer_cast<LinearHashedWaveletOctree>(map);
+        linear_hashed_wavelet_octree) {
+      rosMsgToMap(msg.hashed_wavelet_octree.front(),
+                  linear_hashed_wavelet_octree);
+      map = linear_hashed_wavelet_octree;
+      return true;
+    }
     auto hashed_wavelet_octree =
         std::dynamic_pointer_cast<HashedWaveletOctree>(map);
     rosMsgToMap(msg.hashed_wavelet_octree.front(), hashed_wavelet_octree);
@@ -259,197 +490,43 @@ void mapToRosMsg(
     const HashedWaveletOctree& map, wavemap_msgs::HashedWaveletOctree& msg,
     std::optional<std::unordered_set<Index3D, Index3DHash>> include_blocks,
     std::shared_ptr<ThreadPool> thread_pool) {
-  ProfilerZoneScoped;
-  // Constants
-  constexpr FloatingPoint kNumericalNoise = 1e-3f;
-  const auto min_log_odds = map.getMinLogOdds() + kNumericalNoise;
-  const auto max_log_odds = map.getMaxLogOdds() - kNumericalNoise;
-
-  // Serialize the map and data structure's metadata
-  msg.min_cell_width = map.getMinCellWidth();
-  msg.min_log_odds = map.getMinLogOdds();
-  msg.max_log_odds = map.getMaxLogOdds();
-  msg.tree_height = map.getTreeHeight();
-
-  // Indicate which blocks are allocated in the map
-  // NOTE: This is done such that subscribers know when blocks should be removed
-  //       during incremental map transmission.
-  msg.allocated_block_indices.reserve(map.getHashMap().size());
-  map.forEachBlock([&msg](const Index3D& block_index, const auto& /*block*/) {
-    auto& block_index_msg = msg.allocated_block_indices.emplace_back();
-    block_index_msg.x = block_index.x();
-    block_index_msg.y = block_index.y();
-    block_index_msg.z = block_index.z();
-  });
-
-  // If blocks to include were specified, check that they exist
-  // and remove the ones that do not
-  if (include_blocks) {
-    for (auto include_block_it = include_blocks->begin();
-         include_block_it != include_blocks->end();) {
-      if (map.hasBlock(*include_block_it)) {
-        ++include_block_it;
-      } else {
-        include_block_it = include_blocks->erase(include_block_it);
-      }
-    }
-  } else {  // Otherwise, include all blocks
-    include_blocks.emplace();
-    map.forEachBlock(
-        [&include_blocks](const Index3D& block_index, const auto& /*block*/) {
-          include_blocks->emplace(block_index);
-        });
-  }
-
-  // Serialize the specified blocks
-  int block_idx = 0;
-  msg.blocks.resize(include_blocks->size());
-  for (const auto& block_index : include_blocks.value()) {
-    if (const auto* block = map.getBlock(block_index); block) {
-      auto& block_msg = msg.blocks[block_idx++];
-      // If a thread pool was provided, use it
-      if (thread_pool) {
-        thread_pool->add_task(
-            [block_index, block, min_log_odds, max_log_odds, &block_msg]() {
-              blockToRosMsg(block_index, *block, min_log_odds, max_log_odds,
-                            block_msg);
-            });
-      } else {  // Otherwise, use the current thread
-        blockToRosMsg(block_index, *block, min_log_odds, max_log_odds,
-                      block_msg);
-      }
-    }
-  }
-
-  // If a thread pool was used, wait for all jobs to finish
-  if (thread_pool) {
-    thread_pool->wait_all();
-  }
+  hashedWaveletOctreeToRosMsg(map, msg, std::move(include_blocks),
+                              thread_pool);
 }
 
 void blockToRosMsg(const HashedWaveletOctree::BlockIndex& block_index,
                    const HashedWaveletOctree::Block& block,
                    FloatingPoint min_log_odds, FloatingPoint max_log_odds,
                    wavemap_msgs::HashedWaveletOctreeBlock& msg) {
-  ProfilerZoneScoped;
-  // Convenience type for elements on the stack used to iterate over the map
-  struct StackElement {
-    const FloatingPoint scale;
-    HashedWaveletOctreeBlock::OctreeType::NodeConstRefType node;
-  };
-
-  // Serialize the block's metadata
-  msg.root_node_offset.x = block_index.x();
-  msg.root_node_offset.y = block_index.y();
-  msg.root_node_offset.z = block_index.z();
-  // Wavelet scale coefficient of the block's root node
-  msg.root_node_scale_coefficient = block.getRootScale();
-
-  // Serialize the block's data (all nodes of its octree)
-  std::stack<StackElement> stack;
-  stack.emplace(StackElement{block.getRootScale(), block.getRootNode()});
-  while (!stack.empty()) {
-    const FloatingPoint scale = stack.top().scale;
-    const auto& node = stack.top().node;
-    stack.pop();
-
-    // Serialize the node's data
-    auto& node_msg = msg.nodes.emplace_back();
-    std::copy(node.data().cbegin(), node.data().cend(),
-              node_msg.detail_coefficients.begin());
-    node_msg.allocated_children_bitset = 0;
-
-    // Evaluate which of its children should be serialized
-    const auto child_scales =
-        HashedWaveletOctreeBlock::Transform::backward({scale, node.data()});
-    // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
-    //       the nodes are popped from the stack in increasing order.
-    for (int relative_child_idx = OctreeIndex::kNumChildren - 1;
-         0 <= relative_child_idx; --relative_child_idx) {
-      // If the child is saturated, we don't need to store its descendants
-      const auto child_scale = child_scales[relative_child_idx];
-      if (child_scale < min_log_odds || max_log_odds < child_scale) {
-        continue;
-      }
-      // Otherwise, indicate that the child will be serialized
-      // and add it to the stack
-      const auto* child = node.getChild(relative_child_idx);
-      if (child) {
-        stack.emplace(StackElement{child_scale, *child});
-        node_msg.allocated_children_bitset += (1 << relative_child_idx);
-      }
-    }
-  }
+  hashedWaveletOctreeBlockToRosMsg(block_index, block, min_log_odds,
+                                   max_log_odds, msg);
 }
 
 void rosMsgToMap(const wavemap_msgs::HashedWaveletOctree& msg,
                  HashedWaveletOctree::Ptr& map) {
-  ProfilerZoneScoped;
-  // Deserialize the map's config and initialize the data structure
-  HashedWaveletOctreeConfig config;
-  config.min_cell_width = msg.min_cell_width;
-  config.min_log_odds = msg.min_log_odds;
-  config.max_log_odds = msg.max_log_odds;
-  config.tree_height = msg.tree_height;
-
-  // Check if the map already exists and has compatible settings
-  if (map && map->getConfig() == config) {
-    // Load allocated block list into a hash table for quick membership lookups
-    std::unordered_set<Index3D, Index3DHash> allocated_blocks;
-    for (const auto& block_index : msg.allocated_block_indices) {
-      allocated_blocks.emplace(block_index.x, block_index.y, block_index.z);
-    }
-    // Remove local blocks that should no longer exist according to the map msg
-    map->eraseBlockIf(
-        [&allocated_blocks](const Index3D& block_index, const auto& /*block*/) {
-          return !allocated_blocks.count(block_index);
-        });
-  } else {
-    // Otherwise create a new map
-    map = std::make_shared<HashedWaveletOctree>(config);
-  }
-
-  // Deserialize all the transferred blocks
-  for (const auto& block_msg : msg.blocks) {
-    const Index3D block_index{block_msg.root_node_offset.x,
-                              block_msg.root_node_offset.y,
-                              block_msg.root_node_offset.z};
-
-    // Reset the block if it already existed
-    const bool block_existed = map->hasBlock(block_index);
-    auto& block = map->getOrAllocateBlock(block_index);
-    if (block_existed) {
-      block.clear();
-    }
-
-    // Deserialize the wavelet scale coefficient of the block's root node
-    block.getRootScale() = block_msg.root_node_scale_coefficient;
+  rosMsgToHashedWaveletOctree<HashedWaveletOctree>(msg, map);
+}
 
-    // Deserialize the block's remaining data into octree nodes
-    std::stack<WaveletOctree::NodeType*> stack;
-    stack.emplace(&block.getRootNode());
-    for (const auto& node_msg : block_msg.nodes) {
-      DCHECK(!stack.empty());
-      WaveletOctree::NodeType* node = stack.top();
-      stack.pop();
+void mapToRosMsg(
+    const LinearHashedWaveletOctree& map,
+    wavemap_msgs::HashedWaveletOctree& msg,
+    std::optional<std::unordered_set<Index3D, Index3DHash>> include_blocks,
+    std::shared_ptr<ThreadPool> thread_pool) {
+  hashedWaveletOctreeToRosMsg(map, msg, std::move(include_blocks),
+                              thread_pool);
+}
 
-      // Deserialize the node's (wavelet) detail coefficients
-      std::copy(node_msg.detail_coefficients.cbegin(),
-                node_msg.detail_coefficients.cend(), node->data().begin());
+void blockToRosMsg(const LinearHashedWaveletOctree::BlockIndex& block_index,
+                   const LinearHashedWaveletOctree::Block& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   wavemap_msgs::HashedWaveletOctreeBlock& msg) {
+  hashedWaveletOctreeBlockToRosMsg(block_index, block, min_log_odds,
+                                   max_log_odds, msg);
+}
 
-      // Evaluate which of the node's children are coming next
-      // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
-      //       the nodes are popped from the stack in increasing order.
-      for (int relative_child_idx = wavemap::OctreeIndex::kNumChildren - 1;
-           0 <= relative_child_idx; --relative_child_idx) {
-        const bool child_exists =
-            node_msg.allocated_children_bitset & (1 << relative_child_idx);
-        if (child_exists) {
-          stack.emplace(&node->getOrAllocateChild(relative_child_idx));
-        }
-      }
-    }
-  }
+void rosMsgToMap(const wavemap_msgs::HashedWaveletOctree& msg,
+                 LinearHashedWaveletOctree::Ptr& map) {
+  rosMsgToHashedWaveletOctree<LinearHashedWaveletOctree>(msg, map);
 }
 
 void mapToRosMsg(
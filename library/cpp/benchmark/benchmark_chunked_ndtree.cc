@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/chunked_ndtree/chunked_ndtree.h"
+#include "wavemap/core/map/cell_types/haar_coefficients.h"
+#include "wavemap/core/utils/random_number_generator.h"
+
+// NOTE: These benchmarks compare the chunk heights that could be used for the
+//       blocks of the HashedChunkedWaveletOctree, whose default tree height is
+//       6. Trees whose height is not a multiple of the chunk height are rounded
+//       up, so chunk height 4 benchmarks trees of height 8.
+namespace wavemap {
+using NodeDataType = HaarCoefficients<FloatingPoint, 3>::Details;
+template <int chunk_height>
+using TreeType = ChunkedOctree<NodeDataType, chunk_height>;
+
+constexpr IndexElement kTreeHeight = 6;
+constexpr int kNumTrees = 1024;
+constexpr int kNumLeavesPerTree = 256;
+constexpr int kNumQueries = 100000;
+
+// Leaf indices of a thin surface crossing each tree, similar to the cells a
+// depth sensor observes in a block
+std::vector<OctreeIndex> GenerateLeafIndices(
+    RandomNumberGenerator& random_number_generator) {
+  constexpr IndexElement kMaxIndex = int_math::exp2(kTreeHeight) - 1;
+  const IndexElement surface_z =
+      random_number_generator.getRandomInteger(IndexElement{0}, kMaxIndex);
+  std::vector<OctreeIndex> leaf_indices;
+  leaf_indices.reserve(kNumLeavesPerTree);
+  for (int leaf_idx = 0; leaf_idx < kNumLeavesPerTree; ++leaf_idx) {
+    const IndexElement z_offset =
+        random_number_generator.getRandomInteger(IndexElement{-1},
+                                                 IndexElement{1});
+    leaf_indices.push_back(OctreeIndex{
+        0,
+        {random_number_generator.getRandomInteger(IndexElement{0}, kMaxIndex),
+         random_number_generator.getRandomInteger(IndexElement{0}, kMaxIndex),
+         std::clamp(surface_z + z_offset, IndexElement{0}, kMaxIndex)}});
+  }
+  return leaf_indices;
+}
+
+template <int chunk_height>
+std::vector<std::unique_ptr<TreeType<chunk_height>>> GenerateTrees(
+    std::vector<std::vector<OctreeIndex>>& leaf_indices) {
+  RandomNumberGenerator random_number_generator(0);
+  std::vector<std::unique_ptr<TreeType<chunk_height>>> trees;
+  for (int tree_idx = 0; tree_idx < kNumTrees; ++tree_idx) {
+    auto& tree = trees.emplace_back(
+        std::make_unique<TreeType<chunk_height>>(kTreeHeight));
+    auto& tree_leaf_indices =
+        leaf_indices.emplace_back(GenerateLeafIndices(random_number_generator));
+    for (const OctreeIndex& leaf_index : tree_leaf_indices) {
+      tree->getOrAllocateNode(leaf_index).data()[0] = 1.f;
+    }
+  }
+  return trees;
+}
+
+template <int chunk_height>
+static void AllocateNodes(benchmark::State& state) {
+  RandomNumberGenerator random_number_generator(0);
+  std::vector<std::vector<OctreeIndex>> leaf_indices;
+  for (int tree_idx = 0; tree_idx < kNumTrees; ++tree_idx) {
+    leaf_indices.emplace_back(GenerateLeafIndices(random_number_generator));
+  }
+  for (auto _ : state) {
+    size_t memory_usage = 0u;
+    for (const auto& tree_leaf_indices : leaf_indices) {
+      TreeType<chunk_height> tree(kTreeHeight);
+      for (const OctreeIndex& leaf_index : tree_leaf_indices) {
+        tree.getOrAllocateNode(leaf_index).data()[0] = 1.f;
+      }
+      memory_usage += sizeof(tree) + tree.getMemoryUsage();
+    }
+    state.counters["bytes_per_tree"] =
+        static_cast<double>(memory_usage) / kNumTrees;
+  }
+  state.SetItemsProcessed(state.iterations() * kNumTrees * kNumLeavesPerTree);
+}
+
+template <int chunk_height>
+static void LookupNodes(benchmark::State& state) {
+  std::vector<std::vector<OctreeIndex>> leaf_indices;
+  const auto trees = GenerateTrees<chunk_height>(leaf_indices);
+  RandomNumberGenerator random_number_generator(1);
+  std::vector<std::pair<int, OctreeIndex>> queries;
+  for (int query_idx = 0; query_idx < kNumQueries; ++query_idx) {
+    const int tree_idx = random_number_generator.getRandomInteger(
+        0, static_cast<int>(kNumTrees) - 1);
+    const int leaf_idx =
+        random_number_generator.getRandomInteger(0, kNumLeavesPerTree - 1);
+    queries.emplace_back(tree_idx, leaf_indices[tree_idx][leaf_idx]);
+  }
+  for (auto _ : state) {
+    FloatingPoint sum = 0.f;
+    for (const auto& [tree_idx, leaf_index] : queries) {
+      const auto& tree = std::as_const(*trees[tree_idx]);
+      if (auto node = tree.getNode(leaf_index); node) {
+        sum += node->data()[0];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+
+template <typename NodeRefT>
+FloatingPoint SumNodesRecursive(NodeRefT node) {
+  FloatingPoint sum = node.data()[0];
+  for (NdtreeIndexRelativeChild child_idx = 0;
+       child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+    if (auto child = node.getChild(child_idx); child) {
+      sum += SumNodesRecursive(*child);
+    }
+  }
+  return sum;
+}
+
+template <int chunk_height>
+static void TraverseDepthFirst(benchmark::State& state) {
+  std::vector<std::vector<OctreeIndex>> leaf_indices;
+  const auto trees = GenerateTrees<chunk_height>(leaf_indices);
+  for (auto _ : state) {
+    FloatingPoint sum = 0.f;
+    for (const auto& tree : trees) {
+      sum += SumNodesRecursive(std::as_const(*tree).getRootNode());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumTrees);
+}
+
+BENCHMARK_TEMPLATE(AllocateNodes, 1);
+BENCHMARK_TEMPLATE(AllocateNodes, 2);
+BENCHMARK_TEMPLATE(AllocateNodes, 3);
+BENCHMARK_TEMPLATE(AllocateNodes, 4);
+BENCHMARK_TEMPLATE(LookupNodes, 1);
+BENCHMARK_TEMPLATE(LookupNodes, 2);
+BENCHMARK_TEMPLATE(LookupNodes, 3);
+BENCHMARK_TEMPLATE(LookupNodes, 4);
+BENCHMARK_TEMPLATE(TraverseDepthFirst, 1);
+BENCHMARK_TEMPLATE(TraverseDepthFirst, 2);
+BENCHMARK_TEMPLATE(TraverseDepthFirst, 3);
+BENCHMARK_TEMPLATE(TraverseDepthFirst, 4);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
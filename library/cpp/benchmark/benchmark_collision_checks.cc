@@ -0,0 +1,125 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/query/classified_map.h"
+#include "wavemap/core/utils/query/collision_checker.h"
+#include "wavemap/core/utils/random_number_generator.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/core/utils/shape/sphere.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap {
+constexpr IndexElement kMaxIndex = 200;
+constexpr int kNumShapes = 1000;
+const Occupancy::Mask kCollisionMask = Occupancy::toMask(Occupancy::kOccupied);
+
+std::shared_ptr<ClassifiedMap> GenerateRandomClassifiedMap() {
+  constexpr int kNumUpdates = 200000;
+  RandomNumberGenerator random_number_generator(0);
+  HashedWaveletOctree map{HashedWaveletOctree::Config{}};
+  for (int update_idx = 0; update_idx < kNumUpdates; ++update_idx) {
+    const Index3D index{
+        random_number_generator.getRandomInteger(-kMaxIndex, kMaxIndex),
+        random_number_generator.getRandomInteger(-kMaxIndex, kMaxIndex),
+        random_number_generator.getRandomInteger(-kMaxIndex, kMaxIndex)};
+    // Mostly free space, with sparse obstacles
+    const FloatingPoint update =
+        random_number_generator.getRandomRealNumber(0.f, 1.f) < 0.01f
+            ? 2.f
+            : -1.f;
+    map.addToCellValue(index, update);
+  }
+  map.prune();
+  return std::make_shared<ClassifiedMap>(map, OccupancyClassifier{});
+}
+
+// Generate robot spheres of the given radius at random positions
+std::vector<Sphere<Point3D>> GenerateRandomSpheres(
+    const ClassifiedMap& classified_map, IndexElement radius_in_cells) {
+  RandomNumberGenerator random_number_generator(1);
+  const FloatingPoint min_cell_width = classified_map.getMinCellWidth();
+  std::vector<Sphere<Point3D>> spheres(kNumShapes);
+  for (auto& sphere : spheres) {
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      sphere.center[dim_idx] =
+          min_cell_width * random_number_generator.getRandomRealNumber(
+                               static_cast<FloatingPoint>(-kMaxIndex),
+                               static_cast<FloatingPoint>(kMaxIndex));
+    }
+    sphere.radius =
+        min_cell_width * static_cast<FloatingPoint>(radius_in_cells);
+  }
+  return spheres;
+}
+
+static void NaivePerCellChecks(benchmark::State& state) {
+  const auto classified_map = GenerateRandomClassifiedMap();
+  const auto spheres = GenerateRandomSpheres(*classified_map, state.range(0));
+  const FloatingPoint min_cell_width = classified_map->getMinCellWidth();
+  const FloatingPoint min_cell_width_inv = 1.f / min_cell_width;
+  for (auto _ : state) {
+    size_t num_collisions = 0u;
+    for (const auto& sphere : spheres) {
+      const AABB<Point3D> aabb = sphere;
+      const Index3D min_index =
+          convert::pointToNearestIndex(aabb.min, min_cell_width_inv);
+      const Index3D max_index =
+          convert::pointToNearestIndex(aabb.max, min_cell_width_inv);
+      for (const Index3D& index : Grid<3>(min_index, max_index)) {
+        if (shape::overlaps(
+                convert::nodeIndexToAABB(OctreeIndex{0, index}, min_cell_width),
+                sphere) &&
+            classified_map->has(index, kCollisionMask)) {
+          ++num_collisions;
+          break;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(num_collisions);
+  }
+}
+
+static void HierarchicalChecks(benchmark::State& state) {
+  const auto classified_map = GenerateRandomClassifiedMap();
+  const auto spheres = GenerateRandomSpheres(*classified_map, state.range(0));
+  const CollisionChecker collision_checker{classified_map, kCollisionMask};
+  for (auto _ : state) {
+    size_t num_collisions = 0u;
+    for (const auto& sphere : spheres) {
+      num_collisions += collision_checker.isColliding(sphere);
+    }
+    benchmark::DoNotOptimize(num_collisions);
+  }
+}
+
+static void ParallelBatchChecks(benchmark::State& state) {
+  const auto classified_map = GenerateRandomClassifiedMap();
+  const auto spheres = GenerateRandomSpheres(*classified_map, state.range(0));
+  const CollisionChecker collision_checker{classified_map, kCollisionMask};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(collision_checker.checkCollisions(spheres));
+  }
+}
+
+static void ParallelFirstCollision(benchmark::State& state) {
+  const auto classified_map = GenerateRandomClassifiedMap();
+  const auto spheres = GenerateRandomSpheres(*classified_map, state.range(0));
+  const CollisionChecker collision_checker{classified_map, kCollisionMask};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(collision_checker.findFirstCollision(spheres));
+  }
+}
+
+BENCHMARK(NaivePerCellChecks)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(HierarchicalChecks)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(ParallelBatchChecks)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(ParallelFirstCollision)->Arg(2)->Arg(8)->Arg(32);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
@@ -0,0 +1,158 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "synthetic_scene.h"
+#include "wavemap/core/common.h"
+#include "wavemap/core/integrator/measurement_model/continuous_beam.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_chunked_wavelet_integrator.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_wavelet_integrator.h"
+#include "wavemap/core/integrator/projective/fixed_resolution/fixed_resolution_integrator.h"
+#include "wavemap/core/integrator/ray_tracing/ray_tracing_integrator.h"
+#include "wavemap/core/map/hashed_blocks.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+
+namespace wavemap {
+constexpr int kNumScans = 16;
+constexpr FloatingPoint kMinCellWidth = 0.1f;
+
+// Shared inputs of all projective integrators, configured for the sensor
+struct ProjectiveIntegratorInputs {
+  explicit ProjectiveIntegratorInputs(SensorType sensor_type)
+      : projection_model(SyntheticScene::getProjector(sensor_type)),
+        posed_range_image(
+            std::make_shared<PosedImage<>>(projection_model->getDimensions())),
+        beam_offset_image(std::make_shared<Image<Vector2D>>(
+            projection_model->getDimensions())) {
+    ContinuousBeamConfig beam_config;
+    beam_config.angle_sigma =
+        sensor_type == SensorType::kLidar ? 0.01f : 0.0035f;
+    beam_config.range_sigma = 0.05f;
+    measurement_model = std::make_shared<ContinuousBeam>(
+        beam_config, projection_model, posed_range_image, beam_offset_image);
+  }
+
+  ProjectorBase::Ptr projection_model;
+  PosedImage<>::Ptr posed_range_image;
+  Image<Vector2D>::Ptr beam_offset_image;
+  MeasurementModelBase::Ptr measurement_model;
+};
+
+// Integrate scans along the synthetic trajectory and report the throughput in
+// points per second. The map is kept across iterations, such that the measured
+// time includes the cost of updating previously observed regions.
+template <typename IntegratorT>
+void integrateScans(benchmark::State& state, SensorType sensor_type,
+                    IntegratorT& integrator) {
+  const auto scans = SyntheticScene().renderScans(sensor_type, kNumScans);
+  size_t scan_idx = 0u;
+  for (auto _ : state) {
+    integrator.integrate(scans[scan_idx]);
+    scan_idx = (scan_idx + 1u) % scans.size();
+  }
+  state.SetItemsProcessed(state.iterations() * scans.front().size());
+}
+
+template <typename MapT>
+typename MapT::Config getMapConfig() {
+  typename MapT::Config config;
+  config.min_cell_width = kMinCellWidth;
+  return config;
+}
+
+void BM_HashedWaveletIntegrator(benchmark::State& state) {
+  const auto sensor_type = static_cast<SensorType>(state.range(0));
+  ProjectiveIntegratorInputs inputs(sensor_type);
+  auto map = std::make_shared<HashedWaveletOctree>(
+      getMapConfig<HashedWaveletOctree>());
+  HashedWaveletIntegrator integrator(
+      ProjectiveIntegratorConfig{}, inputs.projection_model,
+      inputs.posed_range_image, inputs.beam_offset_image,
+      inputs.measurement_model, map, getThreadPool(state.range(1)));
+  integrateScans(state, sensor_type, integrator);
+}
+
+// Same integrator as above, on a map whose blocks store their octrees linearly
+void BM_LinearHashedWaveletIntegrator(benchmark::State& state) {
+  const auto sensor_type = static_cast<SensorType>(state.range(0));
+  ProjectiveIntegratorInputs inputs(sensor_type);
+  auto map = std::make_shared<LinearHashedWaveletOctree>(
+      getMapConfig<LinearHashedWaveletOctree>());
+  LinearHashedWaveletIntegrator integrator(
+      ProjectiveIntegratorConfig{}, inputs.projection_model,
+      inputs.posed_range_image, inputs.beam_offset_image,
+      inputs.measurement_model, map, getThreadPool(state.range(1)));
+  integrateScans(state, sensor_type, integrator);
+}
+
+void BM_HashedChunkedWaveletIntegrator(benchmark::State& state) {
+  const auto sensor_type = static_cast<SensorType>(state.range(0));
+  ProjectiveIntegratorInputs inputs(sensor_type);
+  auto map = std::make_shared<HashedChunkedWaveletOctree>(
+      getMapConfig<HashedChunkedWaveletOctree>());
+  HashedChunkedWaveletIntegrator integrator(
+      ProjectiveIntegratorConfig{}, inputs.projection_model,
+      inputs.posed_range_image, inputs.beam_offset_image,
+      inputs.measurement_model, map, getThreadPool(state.range(1)));
+  integrateScans(state, sensor_type, integrator);
+}
+
+void BM_FixedResolutionIntegrator(benchmark::State& state) {
+  const auto sensor_type = static_cast<SensorType>(state.range(0));
+  ProjectiveIntegratorInputs inputs(sensor_type);
+  auto map = std::make_shared<HashedBlocks>(getMapConfig<HashedBlocks>());
+  FixedResolutionIntegrator integrator(
+      ProjectiveIntegratorConfig{}, inputs.projection_model,
+      inputs.posed_range_image, inputs.beam_offset_image,
+      inputs.measurement_model, map);
+  integrateScans(state, sensor_type, integrator);
+}
+
+void BM_RayTracingIntegrator(benchmark::State& state) {
+  const auto sensor_type = static_cast<SensorType>(state.range(0));
+  auto map = std::make_shared<HashedBlocks>(getMapConfig<HashedBlocks>());
+  RayTracingIntegrator integrator(RayTracingIntegratorConfig{}, map);
+  integrateScans(state, sensor_type, integrator);
+}
+
+// Arguments: sensor type (0: LiDAR, 1: depth camera), number of threads
+// NOTE: A thread count of zero lets the integrator create its default pool,
+//       which uses all hardware threads.
+void ThreadSweepArguments(benchmark::internal::Benchmark* benchmark) {
+  for (const SensorType sensor_type :
+       {SensorType::kLidar, SensorType::kDepthCamera}) {
+    for (const int num_threads : {1, 2, 4, 8, 0}) {
+      benchmark->Args({static_cast<int>(sensor_type), num_threads});
+    }
+  }
+}
+
+BENCHMARK(BM_HashedWaveletIntegrator)
+    ->ArgNames({"sensor", "threads"})
+    ->Apply(ThreadSweepArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_LinearHashedWaveletIntegrator)
+    ->ArgNames({"sensor", "threads"})
+    ->Apply(ThreadSweepArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_HashedChunkedWaveletIntegrator)
+    ->ArgNames({"sensor", "threads"})
+    ->Apply(ThreadSweepArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_FixedResolutionIntegrator)
+    ->ArgName("sensor")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RayTracingIntegrator)
+    ->ArgName("sensor")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "synthetic_scene.h"
+#include "wavemap/core/common.h"
+#include "wavemap/core/integrator/measurement_model/continuous_beam.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_chunked_wavelet_integrator.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_wavelet_integrator.h"
+#include "wavemap/core/integrator/projective/fixed_resolution/fixed_resolution_integrator.h"
+#include "wavemap/core/map/hashed_blocks.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/io/stream_conversions.h"
+
+namespace wavemap {
+constexpr int kNumScans = 16;
+constexpr FloatingPoint kMinCellWidth = 0.1f;
+
+// Map of the synthetic scene, built with the integrator that matches its type
+template <typename MapT, typename IntegratorT>
+std::shared_ptr<MapT> BuildSceneMap() {
+  typename MapT::Config map_config;
+  map_config.min_cell_width = kMinCellWidth;
+  auto map = std::make_shared<MapT>(map_config);
+  const auto projection_model =
+      SyntheticScene::getProjector(SensorType::kLidar);
+  const auto posed_range_image =
+      std::make_shared<PosedImage<>>(projection_model->getDimensions());
+  const auto beam_offset_image =
+      std::make_shared<Image<Vector2D>>(projection_model->getDimensions());
+  ContinuousBeamConfig beam_config;
+  beam_config.angle_sigma = 0.01f;
+  beam_config.range_sigma = 0.05f;
+  const auto measurement_model = std::make_shared<ContinuousBeam>(
+      beam_config, projection_model, posed_range_image, beam_offset_image);
+  IntegratorT integrator(ProjectiveIntegratorConfig{}, projection_model,
+                         posed_range_image, beam_offset_image,
+                         measurement_model, map);
+  for (const auto& scan :
+       SyntheticScene().renderScans(SensorType::kLidar, kNumScans)) {
+    integrator.integrate(scan);
+  }
+  map->threshold();
+  return map;
+}
+
+template <typename MapT, typename IntegratorT>
+const MapT& GetSceneMap() {
+  static const std::shared_ptr<MapT> scene_map =
+      BuildSceneMap<MapT, IntegratorT>();
+  return *scene_map;
+}
+
+template <typename MapT, typename IntegratorT>
+void BM_Serialization(benchmark::State& state) {
+  const MapT& map = GetSceneMap<MapT, IntegratorT>();
+  size_t num_bytes = 0u;
+  for (auto _ : state) {
+    std::ostringstream ostream;
+    io::mapToStream(map, ostream);
+    num_bytes = ostream.tellp();
+    benchmark::DoNotOptimize(num_bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * num_bytes);
+  state.counters["map_size_in_bytes"] = static_cast<double>(num_bytes);
+}
+
+template <typename MapT, typename IntegratorT>
+void BM_Deserialization(benchmark::State& state) {
+  std::ostringstream ostream;
+  io::mapToStream(GetSceneMap<MapT, IntegratorT>(), ostream);
+  const std::string serialized_map = ostream.str();
+  for (auto _ : state) {
+    std::istringstream istream(serialized_map);
+    typename MapT::Ptr map;
+    io::streamToMap(istream, map);
+    benchmark::DoNotOptimize(map.get());
+  }
+  state.SetBytesProcessed(state.iterations() * serialized_map.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Serialization, HashedWaveletOctree,
+                   HashedWaveletIntegrator)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deserialization, HashedWaveletOctree,
+                   HashedWaveletIntegrator)
+    ->Unit(benchmark::kMillisecond);
+// NOTE: Hashed chunked wavelet octrees are serialized in the hashed wavelet
+//       octree format, and therefore also deserialized as such.
+BENCHMARK_TEMPLATE(BM_Serialization, HashedChunkedWaveletOctree,
+                   HashedChunkedWaveletIntegrator)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Serialization, HashedBlocks, FixedResolutionIntegrator)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deserialization, HashedBlocks, FixedResolutionIntegrator)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
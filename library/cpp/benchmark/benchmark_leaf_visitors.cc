@@ -0,0 +1,95 @@
+#include <atomic>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/map/hashed_blocks.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/random_number_generator.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap {
+template <typename MapT>
+std::unique_ptr<MapT> GenerateRandomMap() {
+  constexpr int kNumUpdates = 200000;
+  constexpr IndexElement kMaxIndex = 200;
+  RandomNumberGenerator random_number_generator(0);
+  auto map = std::make_unique<MapT>(typename MapT::Config{});
+  for (int update_idx = 0; update_idx < kNumUpdates; ++update_idx) {
+    const Index3D index{
+        random_number_generator.getRandomInteger(-kMaxIndex, kMaxIndex),
+        random_number_generator.getRandomInteger(-kMaxIndex, kMaxIndex),
+        random_number_generator.getRandomInteger(-kMaxIndex, kMaxIndex)};
+    map->addToCellValue(index,
+                        random_number_generator.getRandomRealNumber(-1.f, 1.f));
+  }
+  map->prune();
+  return map;
+}
+
+template <typename MapT>
+static void VirtualLeafVisitor(benchmark::State& state) {
+  const auto map = GenerateRandomMap<MapT>();
+  const MapBase& map_base = *map;
+  for (auto _ : state) {
+    FloatingPoint sum = 0.f;
+    map_base.forEachLeaf(
+        [&sum](const OctreeIndex& /*node_index*/, FloatingPoint value) {
+          sum += value;
+        });
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+template <typename MapT>
+static void TemplatedLeafVisitor(benchmark::State& state) {
+  const auto map = GenerateRandomMap<MapT>();
+  for (auto _ : state) {
+    FloatingPoint sum = 0.f;
+    map->forEachLeaf(
+        [&sum](const OctreeIndex& /*node_index*/, FloatingPoint value) {
+          sum += value;
+        });
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+template <typename MapT>
+static void ParallelLeafVisitor(benchmark::State& state) {
+  const auto map = GenerateRandomMap<MapT>();
+  ThreadPool thread_pool;
+  for (auto _ : state) {
+    std::atomic<size_t> num_positive_leaves = 0u;
+    map->forEachLeafParallel(
+        thread_pool, [&num_positive_leaves](const OctreeIndex& /*node_index*/,
+                                            FloatingPoint value) {
+          if (0.f < value) {
+            num_positive_leaves.fetch_add(1u, std::memory_order_relaxed);
+          }
+        });
+    benchmark::DoNotOptimize(num_positive_leaves.load());
+  }
+}
+
+BENCHMARK_TEMPLATE(VirtualLeafVisitor, HashedBlocks);
+BENCHMARK_TEMPLATE(TemplatedLeafVisitor, HashedBlocks);
+BENCHMARK_TEMPLATE(ParallelLeafVisitor, HashedBlocks);
+
+BENCHMARK_TEMPLATE(VirtualLeafVisitor, HashedWaveletOctree);
+BENCHMARK_TEMPLATE(TemplatedLeafVisitor, HashedWaveletOctree);
+BENCHMARK_TEMPLATE(ParallelLeafVisitor, HashedWaveletOctree);
+
+BENCHMARK_TEMPLATE(VirtualLeafVisitor, HashedChunkedWaveletOctree);
+BENCHMARK_TEMPLATE(TemplatedLeafVisitor, HashedChunkedWaveletOctree);
+BENCHMARK_TEMPLATE(ParallelLeafVisitor, HashedChunkedWaveletOctree);
+
+BENCHMARK_TEMPLATE(VirtualLeafVisitor, LinearHashedWaveletOctree);
+BENCHMARK_TEMPLATE(TemplatedLeafVisitor, LinearHashedWaveletOctree);
+BENCHMARK_TEMPLATE(ParallelLeafVisitor, LinearHashedWaveletOctree);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
@@ -0,0 +1,159 @@
+#include <memory>
+#include <type_traits>
+
+#include <benchmark/benchmark.h>
+
+#include "synthetic_scene.h"
+#include "wavemap/core/common.h"
+#include "wavemap/core/integrator/measurement_model/continuous_beam.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_chunked_wavelet_integrator.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_wavelet_integrator.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/crop.h"
+#include "wavemap/core/utils/edit/multiply.h"
+#include "wavemap/core/utils/edit/sum.h"
+#include "wavemap/core/utils/edit/transform.h"
+#include "wavemap/core/utils/sdf/full_euclidean_sdf_generator.h"
+#include "wavemap/core/utils/sdf/quasi_euclidean_sdf_generator.h"
+
+namespace wavemap {
+constexpr int kNumScans = 16;
+constexpr FloatingPoint kMinCellWidth = 0.1f;
+
+// Map of the synthetic scene, shared by all benchmarks
+template <typename MapT = HashedWaveletOctree>
+const MapT& GetSceneMap() {
+  using IntegratorT =
+      std::conditional_t<std::is_same_v<MapT, HashedWaveletOctree>,
+                         HashedWaveletIntegrator,
+                         HashedChunkedWaveletIntegrator>;
+  static const typename MapT::Ptr scene_map = [] {
+    typename MapT::Config map_config;
+    map_config.min_cell_width = kMinCellWidth;
+    auto map = std::make_shared<MapT>(map_config);
+    const auto projection_model =
+        SyntheticScene::getProjector(SensorType::kLidar);
+    const auto posed_range_image =
+        std::make_shared<PosedImage<>>(projection_model->getDimensions());
+    const auto beam_offset_image =
+        std::make_shared<Image<Vector2D>>(projection_model->getDimensions());
+    ContinuousBeamConfig beam_config;
+    beam_config.angle_sigma = 0.01f;
+    beam_config.range_sigma = 0.05f;
+    const auto measurement_model = std::make_shared<ContinuousBeam>(
+        beam_config, projection_model, posed_range_image, beam_offset_image);
+    IntegratorT integrator(
+        ProjectiveIntegratorConfig{}, projection_model, posed_range_image,
+        beam_offset_image, measurement_model, map);
+    for (const auto& scan :
+         SyntheticScene().renderScans(SensorType::kLidar, kNumScans)) {
+      integrator.integrate(scan);
+    }
+    map->threshold();
+    return map;
+  }();
+  return *scene_map;
+}
+
+// NOTE: The operations below modify the map in place. Each iteration therefore
+//       works on a fresh copy of the scene map, created while timing is paused.
+// NOTE: The benchmarks' argument sets the number of threads. Zero runs the
+//       operation on the calling thread, without a thread pool.
+
+template <typename MapT>
+void BM_Sum(benchmark::State& state) {
+  const auto& scene_map = GetSceneMap<MapT>();
+  const auto thread_pool = getThreadPool(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto map = copyMap(scene_map);
+    state.ResumeTiming();
+    edit::sum(*map, scene_map, thread_pool);
+  }
+}
+
+template <typename MapT>
+void BM_Multiply(benchmark::State& state) {
+  const auto& scene_map = GetSceneMap<MapT>();
+  const auto thread_pool = getThreadPool(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto map = copyMap(scene_map);
+    state.ResumeTiming();
+    edit::multiply(*map, 0.5f, thread_pool);
+  }
+}
+
+template <typename MapT>
+void BM_Crop(benchmark::State& state) {
+  const auto& scene_map = GetSceneMap<MapT>();
+  const auto thread_pool = getThreadPool(state.range(0));
+  const Sphere<Point3D> mask{Point3D::Zero(), 5.f};
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto map = copyMap(scene_map);
+    state.ResumeTiming();
+    edit::crop(*map, mask, 0, thread_pool);
+  }
+}
+
+// NOTE: Since transforming requires resampling every cell of the map, it is
+//       benchmarked on a smaller region of the scene.
+void BM_Transform(benchmark::State& state) {
+  static const HashedWaveletOctree::Ptr cropped_map = [] {
+    auto map = copyMap(GetSceneMap());
+    edit::crop(*map, Sphere<Point3D>{Point3D::Zero(), 3.f});
+    return map;
+  }();
+  const auto thread_pool = getThreadPool(state.range(0));
+  const Transformation3D T_AB(
+      Rotation3D{Eigen::Quaternion<FloatingPoint>{
+          Eigen::AngleAxis<FloatingPoint>{0.3f, Vector3D::UnitZ()}}},
+      Vector3D{0.25f, -0.5f, 0.1f});
+  for (auto _ : state) {
+    auto map = edit::transform(*cropped_map, T_AB, thread_pool);
+    benchmark::DoNotOptimize(map.get());
+  }
+}
+
+void BM_QuasiEuclideanSDF(benchmark::State& state) {
+  const auto& scene_map = GetSceneMap();
+  const QuasiEuclideanSDFGenerator sdf_generator{2.f};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sdf_generator.generate(scene_map).empty());
+  }
+}
+
+void BM_FullEuclideanSDF(benchmark::State& state) {
+  const auto& scene_map = GetSceneMap();
+  const FullEuclideanSDFGenerator sdf_generator{2.f};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sdf_generator.generate(scene_map).empty());
+  }
+}
+
+void ThreadSweepArguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("threads");
+  for (const int num_threads : {0, 1, 2, 4, 8}) {
+    benchmark->Arg(num_threads);
+  }
+  benchmark->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_Sum, HashedWaveletOctree)->Apply(ThreadSweepArguments);
+BENCHMARK_TEMPLATE(BM_Sum, HashedChunkedWaveletOctree)
+    ->Apply(ThreadSweepArguments);
+BENCHMARK_TEMPLATE(BM_Multiply, HashedWaveletOctree)
+    ->Apply(ThreadSweepArguments);
+BENCHMARK_TEMPLATE(BM_Multiply, HashedChunkedWaveletOctree)
+    ->Apply(ThreadSweepArguments);
+BENCHMARK_TEMPLATE(BM_Crop, HashedWaveletOctree)->Apply(ThreadSweepArguments);
+BENCHMARK_TEMPLATE(BM_Crop, HashedChunkedWaveletOctree)
+    ->Apply(ThreadSweepArguments);
+BENCHMARK(BM_Transform)->Apply(ThreadSweepArguments);
+BENCHMARK(BM_QuasiEuclideanSDF)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FullEuclideanSDF)->Unit(benchmark::kMillisecond);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
+#include "wavemap/core/utils/bits/morton_encoding.h"
+#include "wavemap/core/utils/random_number_generator.h"
+
+namespace wavemap {
+constexpr size_t kNumIndices = 100000;
+
+std::vector<Index3D> GenerateIndices() {
+  RandomNumberGenerator random_number_generator(0);
+  constexpr IndexElement kMaxCoordinate = morton::kMaxSingleCoordinate<3>;
+  std::vector<Index3D> indices(kNumIndices);
+  for (Index3D& index : indices) {
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      index[dim_idx] = random_number_generator.getRandomInteger(
+          IndexElement{0}, kMaxCoordinate);
+    }
+  }
+  return indices;
+}
+
+// Baseline, encoding one index at a time with the method used throughout
+// wavemap's data structures
+static void EncodeSingle(benchmark::State& state) {
+  const std::vector<Index3D> indices = GenerateIndices();
+  std::vector<MortonIndex> codes(kNumIndices);
+  for (auto _ : state) {
+    for (size_t idx = 0; idx < kNumIndices; ++idx) {
+      codes[idx] = morton::encode<3>(indices[idx]);
+    }
+    benchmark::DoNotOptimize(codes.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumIndices);
+}
+
+static void EncodeBatch(benchmark::State& state) {
+  const morton::BatchCodecType codec{static_cast<int>(state.range(0))};
+  state.SetLabel(codec.toStr());
+  if (!morton::isSupported(codec)) {
+    state.SkipWithError("Codec not supported by this CPU");
+    return;
+  }
+  const std::vector<Index3D> indices = GenerateIndices();
+  std::vector<MortonIndex> codes(kNumIndices);
+  for (auto _ : state) {
+    morton::encode_batch(indices.data(), kNumIndices, codes.data(), codec);
+    benchmark::DoNotOptimize(codes.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumIndices);
+}
+
+static void DecodeBatch(benchmark::State& state) {
+  const morton::BatchCodecType codec{static_cast<int>(state.range(0))};
+  state.SetLabel(codec.toStr());
+  if (!morton::isSupported(codec)) {
+    state.SkipWithError("Codec not supported by this CPU");
+    return;
+  }
+  std::vector<MortonIndex> codes(kNumIndices);
+  morton::encode_batch(GenerateIndices().data(), kNumIndices, codes.data(),
+                       morton::BatchCodecType::kScalar);
+  std::vector<Index3D> indices(kNumIndices);
+  for (auto _ : state) {
+    morton::decode_batch(codes.data(), kNumIndices, indices.data(), codec);
+    benchmark::DoNotOptimize(indices.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumIndices);
+}
+
+BENCHMARK(EncodeSingle);
+BENCHMARK(EncodeBatch)
+    ->Arg(morton::BatchCodecType::kScalar)
+    ->Arg(morton::BatchCodecType::kBmi2)
+    ->Arg(morton::BatchCodecType::kAvx2);
+BENCHMARK(DecodeBatch)
+    ->Arg(morton::BatchCodecType::kScalar)
+    ->Arg(morton::BatchCodecType::kBmi2)
+    ->Arg(morton::BatchCodecType::kAvx2);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
@@ -0,0 +1,201 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "synthetic_scene.h"
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/integrator/measurement_model/continuous_beam.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_wavelet_integrator.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/query/classified_map.h"
+#include "wavemap/core/utils/query/occupancy_classifier.h"
+#include "wavemap/core/utils/query/query_accelerator.h"
+
+namespace wavemap {
+constexpr int kNumScans = 16;
+constexpr int kNumQueries = 1000000;
+constexpr FloatingPoint kMinCellWidth = 0.1f;
+
+// Builds a map of the synthetic scene, integrating all scans along the
+// trajectory upfront and additional passes over them on request
+template <typename MapT = HashedWaveletOctree>
+class SceneMapBuilder {
+ public:
+  SceneMapBuilder()
+      : scans_(scene_.renderScans(SensorType::kLidar, kNumScans)),
+        map_(std::make_shared<MapT>(getMapConfig())) {
+    const auto projection_model =
+        SyntheticScene::getProjector(SensorType::kLidar);
+    const auto posed_range_image =
+        std::make_shared<PosedImage<>>(projection_model->getDimensions());
+    const auto beam_offset_image =
+        std::make_shared<Image<Vector2D>>(projection_model->getDimensions());
+    ContinuousBeamConfig beam_config;
+    beam_config.angle_sigma = 0.01f;
+    beam_config.range_sigma = 0.05f;
+    const auto measurement_model = std::make_shared<ContinuousBeam>(
+        beam_config, projection_model, posed_range_image, beam_offset_image);
+    integrator_ = std::make_unique<BasicHashedWaveletIntegrator<MapT>>(
+        ProjectiveIntegratorConfig{}, projection_model, posed_range_image,
+        beam_offset_image, measurement_model, map_);
+    for (int scan_idx = 0; scan_idx < kNumScans; ++scan_idx) {
+      integrateNextScan();
+    }
+    map_->threshold();
+  }
+
+  void integrateNextScan() {
+    integrator_->integrate(scans_[scan_idx_]);
+    scan_idx_ = (scan_idx_ + 1u) % scans_.size();
+  }
+
+  SyntheticScene& getScene() { return scene_; }
+  MapT& getMap() { return *map_; }
+
+ private:
+  SyntheticScene scene_;
+  const std::vector<PosedPointcloud<>> scans_;
+  const typename MapT::Ptr map_;
+  std::unique_ptr<BasicHashedWaveletIntegrator<MapT>> integrator_;
+  size_t scan_idx_ = 0u;
+
+  static HashedWaveletOctreeConfig getMapConfig() {
+    HashedWaveletOctreeConfig config;
+    config.min_cell_width = kMinCellWidth;
+    return config;
+  }
+};
+
+// Lazily built map of the full synthetic scene, shared by all query benchmarks
+template <typename MapT = HashedWaveletOctree>
+SceneMapBuilder<MapT>& GetSceneMap() {
+  static SceneMapBuilder<MapT> scene_map;
+  return scene_map;
+}
+
+// Query patterns, corresponding to the benchmarks' first argument
+enum class QueryPattern : int { kRandom, kCoherent };
+
+// Random queries are drawn uniformly from the room, while coherent queries
+// walk along rays in steps of one cell, as done by collision checkers and
+// planners that query the map along a path
+std::vector<Index3D> GenerateQueries(QueryPattern pattern,
+                                     SyntheticScene& scene) {
+  const FloatingPoint min_cell_width_inv = 1.f / kMinCellWidth;
+  std::vector<Index3D> queries;
+  queries.reserve(kNumQueries);
+  if (pattern == QueryPattern::kRandom) {
+    while (queries.size() < kNumQueries) {
+      queries.emplace_back(convert::pointToNearestIndex(
+          scene.getRandomPointInRoom(), min_cell_width_inv));
+    }
+  } else {
+    constexpr int kNumStepsPerRay = 200;
+    while (queries.size() < kNumQueries) {
+      const Point3D start = scene.getRandomPointInRoom();
+      const Vector3D step =
+          kMinCellWidth * scene.getRandomPoint<3>(1.f, 1.f).normalized();
+      for (int step_idx = 0; step_idx < kNumStepsPerRay; ++step_idx) {
+        const Point3D point =
+            start + static_cast<FloatingPoint>(step_idx) * step;
+        queries.emplace_back(
+            convert::pointToNearestIndex(point, min_cell_width_inv));
+      }
+    }
+    queries.resize(kNumQueries);
+  }
+  return queries;
+}
+
+template <typename MapT>
+void BM_MapQueries(benchmark::State& state) {
+  auto& scene_map = GetSceneMap<MapT>();
+  const MapT& map = scene_map.getMap();
+  const auto queries = GenerateQueries(
+      static_cast<QueryPattern>(state.range(0)), scene_map.getScene());
+  for (auto _ : state) {
+    for (const Index3D& query : queries) {
+      benchmark::DoNotOptimize(map.getCellValue(query));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+template <typename MapT>
+void BM_AcceleratedQueries(benchmark::State& state) {
+  auto& scene_map = GetSceneMap<MapT>();
+  const auto queries = GenerateQueries(
+      static_cast<QueryPattern>(state.range(0)), scene_map.getScene());
+  QueryAccelerator query_accelerator(scene_map.getMap());
+  for (auto _ : state) {
+    query_accelerator.reset();
+    for (const Index3D& query : queries) {
+      benchmark::DoNotOptimize(query_accelerator.getCellValue(query));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+// Batch queries, which are performed in Morton order to maximize cache reuse
+void BM_BatchQueries(benchmark::State& state) {
+  auto& scene_map = GetSceneMap();
+  const auto queries = GenerateQueries(
+      static_cast<QueryPattern>(state.range(0)), scene_map.getScene());
+  QueryAccelerator query_accelerator(scene_map.getMap());
+  for (auto _ : state) {
+    query_accelerator.reset();
+    benchmark::DoNotOptimize(query_accelerator.getCellValues(queries));
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+void BM_ClassifiedMapConstruction(benchmark::State& state) {
+  const HashedWaveletOctree& map = GetSceneMap().getMap();
+  for (auto _ : state) {
+    ClassifiedMap classified_map(map, OccupancyClassifier{});
+    benchmark::DoNotOptimize(classified_map.empty());
+  }
+}
+
+// Update a classified map after each new scan, such that only the blocks that
+// changed since its previous update need to be reclassified
+void BM_ClassifiedMapUpdate(benchmark::State& state) {
+  SceneMapBuilder<> scene_map;
+  ClassifiedMap classified_map(scene_map.getMap(), OccupancyClassifier{});
+  for (auto _ : state) {
+    state.PauseTiming();
+    scene_map.integrateNextScan();
+    state.ResumeTiming();
+    classified_map.update(scene_map.getMap());
+  }
+}
+
+// Arguments: query pattern (0: random, 1: coherent)
+BENCHMARK_TEMPLATE(BM_MapQueries, HashedWaveletOctree)
+    ->ArgName("coherent")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MapQueries, LinearHashedWaveletOctree)
+    ->ArgName("coherent")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AcceleratedQueries, HashedWaveletOctree)
+    ->ArgName("coherent")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AcceleratedQueries, LinearHashedWaveletOctree)
+    ->ArgName("coherent")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BatchQueries)
+    ->ArgName("coherent")
+    ->DenseRange(0, 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClassifiedMapConstruction)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClassifiedMapUpdate)->Unit(benchmark::kMillisecond);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
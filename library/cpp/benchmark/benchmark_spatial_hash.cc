@@ -0,0 +1,131 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/random_number_generator.h"
+
+namespace wavemap {
+constexpr int kNumQueries = 100000;
+
+// Block indices of a building's floor and walls, as observed by a ground robot
+std::vector<Index3D> GenerateSurfaceBlockIndices() {
+  constexpr IndexElement kHalfWidth = 64;
+  constexpr IndexElement kHeight = 8;
+  std::vector<Index3D> block_indices;
+  for (const Index2D& index_2d : Grid<2>(Index2D::Constant(-kHalfWidth),
+                                         Index2D::Constant(kHalfWidth))) {
+    block_indices.emplace_back(index_2d.x(), index_2d.y(), 0);
+    const bool is_wall = index_2d.x() % 16 == 0 || index_2d.y() % 16 == 0;
+    for (IndexElement z = 1; is_wall && z < kHeight; ++z) {
+      block_indices.emplace_back(index_2d.x(), index_2d.y(), z);
+    }
+  }
+  return block_indices;
+}
+
+// Block indices within the sensor range of a drone's random walk
+std::vector<Index3D> GenerateTrajectoryBlockIndices() {
+  constexpr int kNumPoses = 200;
+  constexpr IndexElement kSensorRange = 6;
+  RandomNumberGenerator random_number_generator(0);
+  std::vector<Index3D> block_indices;
+  Index3D position = Index3D::Zero();
+  for (int pose_idx = 0; pose_idx < kNumPoses; ++pose_idx) {
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      position[dim_idx] += random_number_generator.getRandomInteger(-2, 2);
+    }
+    for (const Index3D& offset : Grid<3>(Index3D::Constant(-kSensorRange),
+                                         Index3D::Constant(kSensorRange))) {
+      if (offset.squaredNorm() <= kSensorRange * kSensorRange) {
+        block_indices.emplace_back(position + offset);
+      }
+    }
+  }
+  return block_indices;
+}
+
+std::vector<Index3D> GenerateBlockIndices(int distribution) {
+  return distribution == 0 ? GenerateSurfaceBlockIndices()
+                           : GenerateTrajectoryBlockIndices();
+}
+
+// Queries that mostly hit allocated blocks, mixed with some misses nearby
+std::vector<Index3D> GenerateQueries(
+    const std::vector<Index3D>& block_indices) {
+  RandomNumberGenerator random_number_generator(1);
+  std::vector<Index3D> queries(kNumQueries);
+  for (auto& query : queries) {
+    query = block_indices[random_number_generator.getRandomInteger(
+        size_t{0}, block_indices.size() - 1u)];
+    if (random_number_generator.getRandomBool(0.2f)) {
+      query += Index3D::Constant(random_number_generator.getRandomInteger(
+          IndexElement{-4}, IndexElement{4}));
+    }
+  }
+  return queries;
+}
+
+template <typename BackendT>
+static void Insert(benchmark::State& state) {
+  const auto block_indices = GenerateBlockIndices(state.range(0));
+  for (auto _ : state) {
+    SpatialHash<int, 3, BackendT> spatial_hash;
+    for (const Index3D& block_index : block_indices) {
+      spatial_hash.getOrAllocateBlock(block_index, 1);
+    }
+    benchmark::DoNotOptimize(spatial_hash.size());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(block_indices.size()));
+}
+
+template <typename BackendT>
+static void Lookup(benchmark::State& state) {
+  const auto block_indices = GenerateBlockIndices(state.range(0));
+  const auto queries = GenerateQueries(block_indices);
+  SpatialHash<int, 3, BackendT> spatial_hash;
+  for (const Index3D& block_index : block_indices) {
+    spatial_hash.getOrAllocateBlock(block_index, 1);
+  }
+  for (auto _ : state) {
+    int sum = 0;
+    for (const Index3D& query : queries) {
+      if (const int* block = spatial_hash.getBlock(query); block) {
+        sum += *block;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+
+template <typename BackendT>
+static void Iterate(benchmark::State& state) {
+  const auto block_indices = GenerateBlockIndices(state.range(0));
+  SpatialHash<int, 3, BackendT> spatial_hash;
+  for (const Index3D& block_index : block_indices) {
+    spatial_hash.getOrAllocateBlock(block_index, 1);
+  }
+  for (auto _ : state) {
+    int sum = 0;
+    spatial_hash.forEachBlock(
+        [&sum](const Index3D& /*block_index*/, int block) { sum += block; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(spatial_hash.size()));
+}
+
+// The argument selects the distribution: 0 for surfaces, 1 for a trajectory
+BENCHMARK_TEMPLATE(Insert, UnorderedMapBackend)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(Insert, FlatHashMapBackend)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(Lookup, UnorderedMapBackend)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(Lookup, FlatHashMapBackend)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(Iterate, UnorderedMapBackend)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(Iterate, FlatHashMapBackend)->Arg(0)->Arg(1);
+}  // namespace wavemap
+
+BENCHMARK_MAIN();
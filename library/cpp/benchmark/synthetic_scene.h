@@ -0,0 +1,170 @@
+#ifndef WAVEMAP_BENCHMARK_SYNTHETIC_SCENE_H_
+#define WAVEMAP_BENCHMARK_SYNTHETIC_SCENE_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/pointcloud.h"
+#include "wavemap/core/integrator/projection_model/pinhole_camera_projector.h"
+#include "wavemap/core/integrator/projection_model/spherical_projector.h"
+#include "wavemap/core/utils/edit/sum.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/shape/sphere.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+enum class SensorType : int { kLidar, kDepthCamera };
+
+// Renders synthetic scans of a room that contains a few spherical obstacles,
+// as observed by a LiDAR or depth camera moving along a smooth trajectory
+class SyntheticScene : public GeometryGenerator {
+ public:
+  explicit SyntheticScene(size_t random_seed = 0u)
+      : GeometryGenerator(random_seed) {
+    for (auto& obstacle : obstacles_) {
+      obstacle.center = getRandomPointInRoom(1.f);
+      obstacle.radius = getRandomSignedDistance(0.3f, 1.5f);
+    }
+  }
+
+  static SphericalProjectorConfig getLidarConfig() {
+    return {{-kQuarterPi / 2.f, kQuarterPi / 2.f, 64}, {-kPi, kPi, 1024}};
+  }
+  static PinholeCameraProjectorConfig getDepthCameraConfig() {
+    return {525.f, 525.f, 319.5f, 239.5f, 480, 640};
+  }
+  static ProjectorBase::Ptr getProjector(SensorType sensor_type) {
+    if (sensor_type == SensorType::kLidar) {
+      return std::make_shared<SphericalProjector>(getLidarConfig());
+    }
+    return std::make_shared<PinholeCameraProjector>(getDepthCameraConfig());
+  }
+
+  // Sensor poses spaced along a trajectory that circles the room
+  std::vector<Transformation3D> getTrajectory(SensorType sensor_type,
+                                              size_t num_poses) {
+    // Body to sensor frame rotation (x-forward, z-up for the LiDAR and
+    // z-forward, y-down for the depth camera)
+    Rotation3D R_B_C;
+    if (sensor_type == SensorType::kDepthCamera) {
+      R_B_C = Rotation3D{0.5f, -0.5f, 0.5f, -0.5f};
+    }
+    std::vector<Transformation3D> trajectory;
+    for (size_t pose_idx = 0; pose_idx < num_poses; ++pose_idx) {
+      const FloatingPoint yaw =
+          kTwoPi * static_cast<FloatingPoint>(pose_idx) / num_poses;
+      const Point3D position{0.6f * kRoomMax.x() * std::cos(yaw),
+                             0.6f * kRoomMax.y() * std::sin(yaw), 1.f};
+      const Rotation3D R_W_B{
+          Eigen::Quaternion<FloatingPoint>{Eigen::AngleAxis<FloatingPoint>{
+              yaw + kHalfPi, Vector3D::UnitZ()}}};
+      trajectory.emplace_back(R_W_B * R_B_C, position);
+    }
+    return trajectory;
+  }
+
+  PosedPointcloud<> renderPointcloud(const ProjectorBase& projector,
+                                     const Transformation3D& T_W_C) {
+    const Index2D dimensions = projector.getDimensions();
+    Pointcloud<> pointcloud;
+    pointcloud.resize(dimensions.prod());
+    for (int point_idx = 0; point_idx < dimensions.prod(); ++point_idx) {
+      const Index2D image_index{point_idx % dimensions.x(),
+                                point_idx / dimensions.x()};
+      const Vector3D C_direction =
+          projector.sensorToCartesian(projector.indexToImage(image_index), 1.f)
+              .normalized();
+      const FloatingPoint range =
+          castRay(T_W_C.getPosition(), T_W_C.getRotation().rotate(C_direction));
+      pointcloud[point_idx] = (range + getNoise()) * C_direction;
+    }
+    return PosedPointcloud<>(T_W_C, pointcloud);
+  }
+
+  std::vector<PosedPointcloud<>> renderScans(SensorType sensor_type,
+                                             size_t num_scans) {
+    const auto projector = getProjector(sensor_type);
+    std::vector<PosedPointcloud<>> scans;
+    for (const auto& T_W_C : getTrajectory(sensor_type, num_scans)) {
+      scans.emplace_back(renderPointcloud(*projector, T_W_C));
+    }
+    return scans;
+  }
+
+  AABB<Point3D> getRoom() const { return {kRoomMin, kRoomMax}; }
+
+  Point3D getRandomPointInRoom(FloatingPoint margin = 0.f) {
+    Point3D point;
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      point[dim_idx] = getRandomSignedDistance(kRoomMin[dim_idx] + margin,
+                                               kRoomMax[dim_idx] - margin);
+    }
+    return point;
+  }
+
+ private:
+  static constexpr FloatingPoint kRangeNoise = 0.02f;
+  inline static const Point3D kRoomMin{-10.f, -10.f, -1.f};
+  inline static const Point3D kRoomMax{10.f, 10.f, 3.f};
+
+  std::array<Sphere<Point3D>, 8> obstacles_;
+
+  FloatingPoint getNoise() {
+    return getRandomSignedDistance(-kRangeNoise, kRangeNoise);
+  }
+
+  // Distance to the closest surface along the ray, assuming the ray's origin
+  // lies inside the room
+  FloatingPoint castRay(const Point3D& origin,
+                        const Vector3D& direction) const {
+    FloatingPoint range = std::numeric_limits<FloatingPoint>::max();
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      if (direction[dim_idx] < 0.f) {
+        range = std::min(range, (kRoomMin[dim_idx] - origin[dim_idx]) /
+                                    direction[dim_idx]);
+      } else if (0.f < direction[dim_idx]) {
+        range = std::min(range, (kRoomMax[dim_idx] - origin[dim_idx]) /
+                                    direction[dim_idx]);
+      }
+    }
+    for (const auto& obstacle : obstacles_) {
+      const Vector3D origin_to_center = obstacle.center - origin;
+      const FloatingPoint projection = origin_to_center.dot(direction);
+      const FloatingPoint discriminant =
+          projection * projection - origin_to_center.squaredNorm() +
+          obstacle.radius * obstacle.radius;
+      if (0.f < discriminant) {
+        const FloatingPoint hit_range = projection - std::sqrt(discriminant);
+        if (0.f < hit_range) {
+          range = std::min(range, hit_range);
+        }
+      }
+    }
+    return range;
+  }
+};
+
+// Deep copy a hashed wavelet octree, by summing it into an empty map
+template <typename MapT>
+std::shared_ptr<MapT> copyMap(const MapT& map) {
+  auto copy = std::make_shared<MapT>(map.getConfig());
+  edit::sum(*copy, map);
+  return copy;
+}
+
+// Thread pool with the given number of threads, or none if it is zero
+inline std::shared_ptr<ThreadPool> getThreadPool(int64_t num_threads) {
+  if (num_threads <= 0) {
+    return nullptr;
+  }
+  return std::make_shared<ThreadPool>(static_cast<size_t>(num_threads));
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_BENCHMARK_SYNTHETIC_SCENE_H_
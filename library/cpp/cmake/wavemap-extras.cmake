@@ -7,6 +7,8 @@ option(USE_TSAN "Compile with thread sanitizer enabled" OFF)
 option(ENABLE_COVERAGE_TESTING
     "Compile with necessary flags for coverage testing" OFF)
 option(USE_CLANG_TIDY "Generate necessary files to run clang-tidy" OFF)
+option(USE_MARCH_NATIVE
+    "Optimize for the build machine's CPU, instead of generic portable code" ON)
 
 # Adds the include paths of the wavemap library to the given target.
 function(add_wavemap_include_directories target)
@@ -30,7 +32,9 @@ function(set_wavemap_target_properties target)
 
   # General compilation options
   set_target_properties(${target} PROPERTIES POSITION_INDEPENDENT_CODE ON)
-  target_compile_options(${target} PUBLIC -march=native)
+  if (USE_MARCH_NATIVE)
+    target_compile_options(${target} PUBLIC -march=native)
+  endif ()
   target_compile_options(${target} PRIVATE
       -Wall -Wextra -Wpedantic
       -Wno-unused-result -Wno-deprecated-copy -Wno-class-memaccess)
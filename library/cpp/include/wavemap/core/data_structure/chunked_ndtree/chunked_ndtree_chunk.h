@@ -8,11 +8,17 @@
 
 #include "wavemap/core/common.h"
 #include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/data/prefetch.h"
 #include "wavemap/core/utils/math/tree_math.h"
 
 namespace wavemap {
+// NOTE: Chunks are aligned to cache lines and store their bookkeeping data
+//       ahead of the node data, such that descending into a chunk only touches
+//       a single cache line before reaching the chunk's root node. Within the
+//       chunk, the nodes are stored level by level, which keeps the siblings
+//       that are visited together during a descent contiguous.
 template <typename DataT, int dim, int height>
-class ChunkedNdtreeChunk {
+class alignas(data::kCacheLineSize) ChunkedNdtreeChunk {
  public:
   static constexpr int kDim = dim;
   static constexpr int kHeight = height;
@@ -22,7 +28,9 @@ class ChunkedNdtreeChunk {
       tree_math::perfect_tree::num_leaf_nodes<dim>(height + 1);
 
   using DataType = DataT;
-  using BitRef = typename std::bitset<kNumInnerNodes>::reference;
+  using NodeDataArray = std::array<DataT, kNumInnerNodes>;
+  using NodeChildBitset = std::bitset<kNumInnerNodes>;
+  using BitRef = typename NodeChildBitset::reference;
 
   ChunkedNdtreeChunk() = default;
   ~ChunkedNdtreeChunk() = default;
@@ -30,6 +38,8 @@ class ChunkedNdtreeChunk {
   bool empty() const;
   void clear();
 
+  // Heap memory owned directly by the chunk, namely its child chunk array and
+  // the storage of its child chunks, but not that of their own descendants
   size_t getMemoryUsage() const;
 
   // Methods to operate at the chunk level
@@ -48,6 +58,20 @@ class ChunkedNdtreeChunk {
   template <typename... DefaultArgs>
   ChunkedNdtreeChunk& getOrAllocateChild(LinearIndex relative_child_index,
                                          DefaultArgs&&... args);
+  // Prefetch the pointers to the 2^dim sibling child chunks that start at the
+  // given index, which share a cache line
+  void prefetchChildren(LinearIndex first_relative_child_index) const;
+
+  // Methods to operate on all nodes inside the chunk at once, which are stored
+  // level by level. Nodes that are not part of the tree hold zero data.
+  NodeDataArray& getNodeData() { return node_data_; }
+  const NodeDataArray& getNodeData() const { return node_data_; }
+  NodeChildBitset& getNodeHasAtLeastOneChild() {
+    return node_has_at_least_one_child_;
+  }
+  const NodeChildBitset& getNodeHasAtLeastOneChild() const {
+    return node_has_at_least_one_child_;
+  }
 
   // Methods to operate on individual nodes inside the chunk
   bool nodeHasNonzeroData(LinearIndex relative_node_index) const;
@@ -66,14 +90,13 @@ class ChunkedNdtreeChunk {
   }
 
  private:
-  using NodeDataArray = std::array<DataT, kNumInnerNodes>;
-  using NodeChildBitset = std::bitset<kNumInnerNodes>;
   using ChunkPtr = std::unique_ptr<ChunkedNdtreeChunk>;
-  using ChildChunkArray = std::array<ChunkPtr, kNumChildren>;
+  struct alignas(data::kCacheLineSize) ChildChunkArray
+      : std::array<ChunkPtr, kNumChildren> {};
 
-  NodeDataArray node_data_{};
   NodeChildBitset node_has_at_least_one_child_{};
   std::unique_ptr<ChildChunkArray> child_chunks_;
+  NodeDataArray node_data_{};
 };
 }  // namespace wavemap
 
@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "wavemap/core/utils/data/comparisons.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
 
 namespace wavemap {
 template <typename DataT, int dim, int height>
@@ -21,9 +22,14 @@ void ChunkedNdtreeChunk<DataT, dim, height>::clear() {
 
 template <typename DataT, int dim, int height>
 size_t ChunkedNdtreeChunk<DataT, dim, height>::getMemoryUsage() const {
-  size_t memory_usage = sizeof(ChunkedNdtreeChunk<DataT, dim, height>);
-  if (hasChildrenArray()) {
-    memory_usage += sizeof(ChildChunkArray);
+  if (!hasChildrenArray()) {
+    return 0u;
+  }
+  size_t memory_usage = memory::getAllocationSize(sizeof(ChildChunkArray));
+  for (const auto& child_chunk : *child_chunks_) {
+    if (child_chunk) {
+      memory_usage += memory::getAllocationSize(sizeof(ChunkedNdtreeChunk));
+    }
   }
   return memory_usage;
 }
@@ -131,6 +137,15 @@ ChunkedNdtreeChunk<DataT, dim, height>::getOrAllocateChild(
   return *child_smart_ptr;
 }
 
+template <typename DataT, int dim, int height>
+void ChunkedNdtreeChunk<DataT, dim, height>::prefetchChildren(
+    LinearIndex first_relative_child_index) const {
+  DCHECK_LT(first_relative_child_index, kNumChildren);
+  if (hasChildrenArray()) {
+    data::prefetch(&(*child_chunks_)[first_relative_child_index]);
+  }
+}
+
 template <typename DataT, int dim, int height>
 bool ChunkedNdtreeChunk<DataT, dim, height>::nodeHasNonzeroData(
     LinearIndex relative_node_index) const {
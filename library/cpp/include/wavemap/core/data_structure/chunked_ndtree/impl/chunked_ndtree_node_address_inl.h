@@ -150,10 +150,20 @@ ChunkedNdtreeNodeRef<ChunkType>::getChild(
       computeChildLevelTraversalDistance(child_index);
   if (child_depth == ChunkType::kHeight) {
     auto* child_chunk = chunk_.getChild(child_level_traversal_distance);
+    // Start fetching the child chunk's bookkeeping data and root node, which
+    // share its first cache line, while the caller processes this node
+    if (child_chunk) {
+      data::prefetch(child_chunk);
+    }
     return {child_chunk, 0, 0u};
-  } else {
-    return {&chunk_, child_depth, child_level_traversal_distance};
   }
+  // The children of nodes on the chunk's last level are stored in child
+  // chunks. Start fetching the pointers to them ahead of time, to hide the
+  // latency of crossing into the next chunk.
+  if (child_depth == ChunkType::kHeight - 1) {
+    chunk_.prefetchChildren(child_level_traversal_distance << kDim);
+  }
+  return {&chunk_, child_depth, child_level_traversal_distance};
 }
 
 template <typename ChunkType>
@@ -169,9 +179,11 @@ ChunkedNdtreeNodeRef<ChunkType>::getOrAllocateChild(
     auto& child_chunk = chunk_.getOrAllocateChild(
         child_level_traversal_distance, std::forward<DefaultArgs>(args)...);
     return {child_chunk, 0, 0};
-  } else {
-    return {chunk_, child_depth, child_level_traversal_distance};
   }
+  if (child_depth == ChunkType::kHeight - 1) {
+    chunk_.prefetchChildren(child_level_traversal_distance << kDim);
+  }
+  return {chunk_, child_depth, child_level_traversal_distance};
 }
 
 template <typename ChunkType>
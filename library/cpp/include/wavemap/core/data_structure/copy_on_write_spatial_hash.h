@@ -0,0 +1,91 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_COPY_ON_WRITE_SPATIAL_HASH_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_COPY_ON_WRITE_SPATIAL_HASH_H_
+
+#include <memory>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
+
+namespace wavemap {
+// Spatial hash whose blocks are reference counted, such that copies of the
+// hash share all their blocks. Blocks are only duplicated once write access to
+// them is requested while they are still shared, which makes copying the hash
+// cheap and lets each copy serve as an immutable snapshot of its source.
+// NOTE: Copying the hash must not run concurrently with modifications to it.
+//       However, once copied, the hash and its copies can be used from
+//       different threads without further synchronization.
+template <typename BlockDataT, int dim>
+class CopyOnWriteSpatialHash {
+ public:
+  static constexpr IndexElement kDim = dim;
+
+  using BlockIndex = Index<dim>;
+  using BlockData = BlockDataT;
+  using BlockPtr = std::shared_ptr<BlockDataT>;
+
+  bool empty() const { return block_map_.empty(); }
+  size_t size() const { return block_map_.size(); }
+  void clear() { block_map_.clear(); }
+
+  // Memory used by the hash map and block directory, including the storage of
+  // the blocks themselves but not the memory they own indirectly
+  // NOTE: Blocks shared with copies of the hash are counted by each copy.
+  size_t getMemoryUsage() const {
+    return block_map_.getMemoryUsage() +
+           size() * memory::getSharedObjectAllocationSize<BlockData>();
+  }
+
+  Index<dim> getMinBlockIndex() const { return block_map_.getMinBlockIndex(); }
+  Index<dim> getMaxBlockIndex() const { return block_map_.getMaxBlockIndex(); }
+
+  bool hasBlock(const BlockIndex& block_index) const {
+    return block_map_.hasBlock(block_index);
+  }
+  // Whether the block is currently shared with a copy of this hash
+  bool isBlockShared(const BlockIndex& block_index) const;
+  bool eraseBlock(const BlockIndex& block_index) {
+    return block_map_.eraseBlock(block_index);
+  }
+  // NOTE: The indicator only gets read access to the blocks, such that
+  //       testing blocks that are shared does not copy them.
+  template <typename IndexedBlockVisitor>
+  void eraseBlockIf(IndexedBlockVisitor indicator_fn);
+
+  // NOTE: The non-const accessors below copy the requested blocks if they are
+  //       shared. Different blocks can be accessed concurrently, as long as
+  //       no blocks are allocated or erased at the same time.
+  BlockData* getBlock(const BlockIndex& block_index);
+  const BlockData* getBlock(const BlockIndex& block_index) const;
+  template <typename... DefaultArgs>
+  BlockData& getOrAllocateBlock(const BlockIndex& block_index,
+                                DefaultArgs&&... args);
+
+  auto& getHashMap() { return block_map_.getHashMap(); }
+  const auto& getHashMap() const { return block_map_.getHashMap(); }
+
+  // Visit the blocks in Morton order, see SpatialHash::enableBlockDirectory()
+  void enableBlockDirectory() { block_map_.enableBlockDirectory(); }
+  void disableBlockDirectory() { block_map_.disableBlockDirectory(); }
+  bool hasBlockDirectory() const { return block_map_.getBlockDirectory(); }
+
+  template <typename IndexedBlockVisitor>
+  void forEachBlock(IndexedBlockVisitor visitor_fn);
+  template <typename IndexedBlockVisitor>
+  void forEachBlock(IndexedBlockVisitor visitor_fn) const;
+  template <typename IndexedBlockVisitor>
+  void forEachBlockInRange(const BlockIndex& min_block_index,
+                           const BlockIndex& max_block_index,
+                           IndexedBlockVisitor visitor_fn) const;
+
+ private:
+  SpatialHash<BlockPtr, dim> block_map_;
+
+  // Make sure the block is not shared, copying it if needed
+  static BlockData& makeUnique(BlockPtr& block_ptr);
+};
+}  // namespace wavemap
+
+#include "wavemap/core/data_structure/impl/copy_on_write_spatial_hash_inl.h"
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_COPY_ON_WRITE_SPATIAL_HASH_H_
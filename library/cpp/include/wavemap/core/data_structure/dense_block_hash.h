@@ -6,7 +6,8 @@
 #include "wavemap/core/utils/math/int_math.h"
 
 namespace wavemap {
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT = UnorderedMapBackend>
 class DenseBlockHash {
  public:
   static constexpr IndexElement kCellsPerSide = cells_per_side;
@@ -15,7 +16,7 @@ class DenseBlockHash {
   static constexpr IndexElement kDim = dim;
 
   using Block = DenseGrid<CellDataT, dim, cells_per_side>;
-  using BlockHashMap = SpatialHash<Block, kDim>;
+  using BlockHashMap = SpatialHash<Block, kDim, BackendT>;
   using Cell = CellDataT;
 
   explicit DenseBlockHash(CellDataT default_value = {})
@@ -24,6 +25,7 @@ class DenseBlockHash {
   bool empty() const { return block_map_.empty(); }
   size_t size() const { return Block::kCellsPerBlock * block_map_.size(); }
   void clear() { block_map_.clear(); }
+  size_t getMemoryUsage() const { return block_map_.getMemoryUsage(); }
 
   Index<dim> getMinBlockIndex() const { return block_map_.getMinBlockIndex(); }
   Index<dim> getMaxBlockIndex() const { return block_map_.getMaxBlockIndex(); }
@@ -55,6 +57,14 @@ class DenseBlockHash {
   auto& getHashMap() { return block_map_.getHashMap(); }
   const auto& getHashMap() const { return block_map_.getHashMap(); }
 
+  // Sort the blocks along the Morton curve and link them to their neighbors,
+  // see SpatialHash::enableBlockDirectory()
+  void enableBlockDirectory() { block_map_.enableBlockDirectory(); }
+  void disableBlockDirectory() { block_map_.disableBlockDirectory(); }
+  const auto* getBlockDirectory() const {
+    return block_map_.getBlockDirectory();
+  }
+
   template <typename IndexedBlockVisitor>
   void forEachBlock(IndexedBlockVisitor visitor_fn);
   template <typename IndexedBlockVisitor>
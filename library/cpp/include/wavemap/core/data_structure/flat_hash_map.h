@@ -0,0 +1,187 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_FLAT_HASH_MAP_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
+
+namespace wavemap {
+// Hash map that resolves collisions with open addressing and linear probing,
+// such that lookups scan a single, contiguous array of slots instead of
+// chasing bucket pointers. Each slot caches its element's hash, which lets
+// most mismatches be rejected without touching the element itself.
+// The elements are allocated individually, which keeps their addresses stable
+// when the table grows, just like for std::unordered_map.
+// NOTE: Since linear probing is sensitive to clustering, the hash function
+//       should mix its input well, e.g. MixingIndexHash instead of IndexHash.
+// NOTE: Erasing elements does not invalidate iterators to other elements, but
+//       inserting elements may.
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>,
+          typename KeyEqualT = std::equal_to<KeyT>>
+class FlatHashMap {
+ private:
+  template <bool is_const>
+  class IteratorBase;
+
+ public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = std::pair<const KeyT, ValueT>;
+  using size_type = size_t;
+  using hasher = HashT;
+  using key_equal = KeyEqualT;
+  using iterator = IteratorBase<false>;
+  using const_iterator = IteratorBase<true>;
+
+  FlatHashMap() = default;
+  FlatHashMap(const FlatHashMap& other);
+  FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+  FlatHashMap& operator=(FlatHashMap other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~FlatHashMap() = default;
+
+  bool empty() const { return num_elements_ == 0u; }
+  size_t size() const { return num_elements_; }
+  size_t capacity() const { return slots_.size(); }
+  // Heap memory used by the slot array and the individually allocated elements
+  size_t getHeapUsage() const {
+    return memory::getHeapUsage(slots_) +
+           num_elements_ * memory::getAllocationSize(sizeof(value_type));
+  }
+  void clear();
+  // Make sure the given number of elements can be inserted without rehashing
+  void reserve(size_t num_elements);
+  void swap(FlatHashMap& other) noexcept;
+
+  iterator begin() { return {slots_.data(), slots_.size(), 0u}; }
+  iterator end() { return {slots_.data(), slots_.size(), slots_.size()}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return {slots_.data(), slots_.size(), 0u}; }
+  const_iterator cend() const {
+    return {slots_.data(), slots_.size(), slots_.size()};
+  }
+
+  size_t count(const KeyT& key) const { return findSlot(key) != kNotFound; }
+  iterator find(const KeyT& key);
+  const_iterator find(const KeyT& key) const;
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const KeyT& key, Args&&... args);
+  ValueT& operator[](const KeyT& key) { return try_emplace(key).first->second; }
+
+  size_t erase(const KeyT& key);
+  iterator erase(const_iterator pos);
+
+ private:
+  struct Slot {
+    std::unique_ptr<value_type> element;
+    // The element's hash if the slot is occupied. Otherwise, marks whether the
+    // slot is free or whether its element was erased, in which case it must
+    // not end the probing. Reusing the hash keeps slots 16 bytes wide.
+    size_t hash = kFreeSlot;
+
+    bool isOccupied() const { return static_cast<bool>(element); }
+    bool isFree() const { return !element && hash == kFreeSlot; }
+    bool isTombstone() const { return !element && hash == kTombstone; }
+  };
+  static constexpr size_t kFreeSlot = 0u;
+  static constexpr size_t kTombstone = 1u;
+
+  static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+  static constexpr size_t kMinCapacity = 16u;
+  // The table is grown once 3/4 of its slots are occupied or tombstones
+  static bool exceedsMaxLoad(size_t num_used_slots, size_t capacity) {
+    return 3u * capacity < 4u * num_used_slots;
+  }
+
+  std::vector<Slot> slots_;
+  size_t num_elements_ = 0u;
+  size_t num_tombstones_ = 0u;
+  HashT hasher_;
+  KeyEqualT key_equal_;
+
+  size_t findSlot(const KeyT& key) const { return findSlot(key, hasher_(key)); }
+  size_t findSlot(const KeyT& key, size_t hash) const;
+  void rehash(size_t new_capacity);
+
+  template <bool is_const>
+  class IteratorBase {
+   public:
+    using SlotPtr = std::conditional_t<is_const, const Slot*, Slot*>;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = FlatHashMap::value_type;
+    using pointer =
+        std::conditional_t<is_const, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<is_const, const value_type&, value_type&>;
+
+    IteratorBase(SlotPtr slots, size_t num_slots, size_t slot_idx)
+        : slots_(slots), num_slots_(num_slots), slot_idx_(slot_idx) {
+      skipUnoccupiedSlots();
+    }
+    // Allow conversions from iterators to const iterators
+    template <bool is_other_const,
+              typename = std::enable_if_t<is_const && !is_other_const>>
+    IteratorBase(const IteratorBase<is_other_const>& other)  // NOLINT
+        : IteratorBase(other.slots_, other.num_slots_, other.slot_idx_) {}
+
+    reference operator*() const { return *slots_[slot_idx_].element; }
+    pointer operator->() const { return slots_[slot_idx_].element.get(); }
+
+    IteratorBase& operator++() {
+      ++slot_idx_;
+      skipUnoccupiedSlots();
+      return *this;
+    }
+    IteratorBase operator++(int) {
+      auto iterator = *this;
+      ++(*this);
+      return iterator;
+    }
+
+    friend bool operator==(const IteratorBase& lhs, const IteratorBase& rhs) {
+      return lhs.slot_idx_ == rhs.slot_idx_ && lhs.slots_ == rhs.slots_;
+    }
+    friend bool operator!=(const IteratorBase& lhs, const IteratorBase& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    SlotPtr slots_;
+    size_t num_slots_;
+    size_t slot_idx_;
+
+    void skipUnoccupiedSlots() {
+      while (slot_idx_ < num_slots_ && !slots_[slot_idx_].isOccupied()) {
+        ++slot_idx_;
+      }
+    }
+
+    friend class FlatHashMap;
+    friend class IteratorBase<!is_const>;
+  };
+};
+
+namespace memory {
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+size_t getHeapUsage(
+    const FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>& hash_map) {
+  return hash_map.getHeapUsage();
+}
+}  // namespace memory
+}  // namespace wavemap
+
+#include "wavemap/core/data_structure/impl/flat_hash_map_inl.h"
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_FLAT_HASH_MAP_H_
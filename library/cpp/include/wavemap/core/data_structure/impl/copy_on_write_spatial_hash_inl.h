@@ -0,0 +1,114 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_IMPL_COPY_ON_WRITE_SPATIAL_HASH_INL_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_IMPL_COPY_ON_WRITE_SPATIAL_HASH_INL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "wavemap/core/utils/iterate/visitor_utils.h"
+
+namespace wavemap {
+template <typename BlockDataT, int dim>
+bool CopyOnWriteSpatialHash<BlockDataT, dim>::isBlockShared(
+    const BlockIndex& block_index) const {
+  const BlockPtr* block_ptr = block_map_.getBlock(block_index);
+  return block_ptr && 1 < block_ptr->use_count();
+}
+
+template <typename BlockDataT, int dim>
+template <typename IndexedBlockVisitor>
+void CopyOnWriteSpatialHash<BlockDataT, dim>::eraseBlockIf(
+    IndexedBlockVisitor indicator_fn) {
+  block_map_.eraseBlockIf(
+      [&indicator_fn](const BlockIndex& block_index, const BlockPtr& block) {
+        return std::invoke(indicator_fn, block_index, std::as_const(*block));
+      });
+}
+
+template <typename BlockDataT, int dim>
+typename CopyOnWriteSpatialHash<BlockDataT, dim>::BlockData*
+CopyOnWriteSpatialHash<BlockDataT, dim>::getBlock(
+    const BlockIndex& block_index) {
+  if (BlockPtr* block_ptr = block_map_.getBlock(block_index); block_ptr) {
+    return &makeUnique(*block_ptr);
+  }
+  return nullptr;
+}
+
+template <typename BlockDataT, int dim>
+const typename CopyOnWriteSpatialHash<BlockDataT, dim>::BlockData*
+CopyOnWriteSpatialHash<BlockDataT, dim>::getBlock(
+    const BlockIndex& block_index) const {
+  if (const BlockPtr* block_ptr = block_map_.getBlock(block_index);
+      block_ptr) {
+    return block_ptr->get();
+  }
+  return nullptr;
+}
+
+template <typename BlockDataT, int dim>
+template <typename... DefaultArgs>
+typename CopyOnWriteSpatialHash<BlockDataT, dim>::BlockData&
+CopyOnWriteSpatialHash<BlockDataT, dim>::getOrAllocateBlock(
+    const BlockIndex& block_index, DefaultArgs&&... args) {
+  BlockPtr& block_ptr = block_map_.getOrAllocateBlock(block_index);
+  if (!block_ptr) {
+    block_ptr =
+        std::make_shared<BlockDataT>(std::forward<DefaultArgs>(args)...);
+    return *block_ptr;
+  }
+  return makeUnique(block_ptr);
+}
+
+template <typename BlockDataT, int dim>
+template <typename IndexedBlockVisitor>
+void CopyOnWriteSpatialHash<BlockDataT, dim>::forEachBlock(
+    IndexedBlockVisitor visitor_fn) {
+  block_map_.forEachBlock(
+      [&visitor_fn](const BlockIndex& block_index, BlockPtr& block) {
+        std::invoke(visitor_fn, block_index, makeUnique(block));
+      });
+}
+
+template <typename BlockDataT, int dim>
+template <typename IndexedBlockVisitor>
+void CopyOnWriteSpatialHash<BlockDataT, dim>::forEachBlock(
+    IndexedBlockVisitor visitor_fn) const {
+  block_map_.forEachBlock(
+      [&visitor_fn](const BlockIndex& block_index, const BlockPtr& block) {
+        std::invoke(visitor_fn, block_index, std::as_const(*block));
+      });
+}
+
+template <typename BlockDataT, int dim>
+template <typename IndexedBlockVisitor>
+void CopyOnWriteSpatialHash<BlockDataT, dim>::forEachBlockInRange(
+    const BlockIndex& min_block_index, const BlockIndex& max_block_index,
+    IndexedBlockVisitor visitor_fn) const {
+  block_map_.forEachBlockInRange(
+      min_block_index, max_block_index,
+      [&visitor_fn](const BlockIndex& block_index, const BlockPtr& block) {
+        return visitor::invoke(visitor_fn, block_index, std::as_const(*block));
+      });
+}
+
+template <typename BlockDataT, int dim>
+typename CopyOnWriteSpatialHash<BlockDataT, dim>::BlockData&
+CopyOnWriteSpatialHash<BlockDataT, dim>::makeUnique(BlockPtr& block_ptr) {
+  DCHECK(block_ptr);
+  if (1 < block_ptr.use_count()) {
+    // NOTE: The copy is made from a const reference, since some blocks'
+    //       variadic constructors would otherwise be selected instead of
+    //       their copy constructors.
+    block_ptr = std::make_shared<BlockDataT>(std::as_const(*block_ptr));
+  } else {
+    // The last copy that shared the block might just have been released by
+    // another thread. Make sure its reads happen-before our writes.
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *block_ptr;
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_IMPL_COPY_ON_WRITE_SPATIAL_HASH_INL_H_
@@ -2,60 +2,70 @@
 #define WAVEMAP_CORE_DATA_STRUCTURE_IMPL_DENSE_BLOCK_HASH_INL_H_
 
 namespace wavemap {
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-bool DenseBlockHash<CellDataT, dim, cells_per_side>::hasBlock(
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+bool DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::hasBlock(
     const Index<dim>& block_index) const {
   return block_map_.hasBlock(block_index);
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-bool DenseBlockHash<CellDataT, dim, cells_per_side>::eraseBlock(
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+bool DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::eraseBlock(
     const Index<dim>& block_index) {
   return block_map_.eraseBlock(block_index);
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
 template <typename IndexedBlockVisitor>
-void DenseBlockHash<CellDataT, dim, cells_per_side>::eraseBlockIf(
+void DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::eraseBlockIf(
     IndexedBlockVisitor indicator_fn) {
   block_map_.eraseBlockIf(indicator_fn);
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline DenseGrid<CellDataT, dim, cells_per_side>*
-DenseBlockHash<CellDataT, dim, cells_per_side>::getBlock(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getBlock(
     const Index<dim>& block_index) {
   return block_map_.getBlock(block_index);
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline const DenseGrid<CellDataT, dim, cells_per_side>*
-DenseBlockHash<CellDataT, dim, cells_per_side>::getBlock(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getBlock(
     const Index<dim>& block_index) const {
   return block_map_.getBlock(block_index);
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline DenseGrid<CellDataT, dim, cells_per_side>&
-DenseBlockHash<CellDataT, dim, cells_per_side>::getOrAllocateBlock(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getOrAllocateBlock(
     const Index<dim>& block_index) {
   return block_map_.getOrAllocateBlock(block_index, default_value_);
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-bool DenseBlockHash<CellDataT, dim, cells_per_side>::hasValue(
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+bool DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::hasValue(
     const Index<dim>& index) const {
   return getValue(index);
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-CellDataT* DenseBlockHash<CellDataT, dim, cells_per_side>::getValue(
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+CellDataT* DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getValue(
     const Index<dim>& index) {
   return const_cast<CellDataT*>(std::as_const(*this).getValue(index));
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-const CellDataT* DenseBlockHash<CellDataT, dim, cells_per_side>::getValue(
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+const CellDataT*
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getValue(
     const Index<dim>& index) const {
   const Index<dim> block_index = indexToBlockIndex(index);
   if (const Block* block = getBlock(block_index); block) {
@@ -65,9 +75,10 @@ const CellDataT* DenseBlockHash<CellDataT, dim, cells_per_side>::getValue(
   return nullptr;
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline CellDataT&
-DenseBlockHash<CellDataT, dim, cells_per_side>::getOrAllocateValue(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getOrAllocateValue(
     const Index<dim>& index) {
   const Index<dim> block_index = indexToBlockIndex(index);
   Block& block = getOrAllocateBlock(block_index);
@@ -75,9 +86,10 @@ DenseBlockHash<CellDataT, dim, cells_per_side>::getOrAllocateValue(
   return block.at(cell_index);
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
 const CellDataT&
-DenseBlockHash<CellDataT, dim, cells_per_side>::getValueOrDefault(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::getValueOrDefault(
     const Index<dim>& index) const {
   if (const CellDataT* value = getValue(index); value) {
     return *value;
@@ -85,29 +97,34 @@ DenseBlockHash<CellDataT, dim, cells_per_side>::getValueOrDefault(
   return default_value_;
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-bool DenseBlockHash<CellDataT, dim, cells_per_side>::equalsDefaultValue(
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+bool DenseBlockHash<CellDataT, dim, cells_per_side,
+                    BackendT>::equalsDefaultValue(
     const CellDataT& value) const {
   return value == default_value_;
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
 template <typename IndexedBlockVisitor>
-void DenseBlockHash<CellDataT, dim, cells_per_side>::forEachBlock(
+void DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::forEachBlock(
     IndexedBlockVisitor visitor_fn) {
   block_map_.forEachBlock(visitor_fn);
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
 template <typename IndexedBlockVisitor>
-void DenseBlockHash<CellDataT, dim, cells_per_side>::forEachBlock(
+void DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::forEachBlock(
     IndexedBlockVisitor visitor_fn) const {
   block_map_.forEachBlock(visitor_fn);
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 template <typename IndexedLeafVisitorFunction>
-void DenseBlockHash<CellDataT, dim, cells_per_side>::forEachLeaf(
+void DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::forEachLeaf(
     IndexedLeafVisitorFunction visitor_fn) {
   block_map_.forEachBlock(
       [&visitor_fn](const Index<dim>& block_index, Block& block) {
@@ -123,9 +140,10 @@ void DenseBlockHash<CellDataT, dim, cells_per_side>::forEachLeaf(
       });
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 template <typename IndexedLeafVisitorFunction>
-void DenseBlockHash<CellDataT, dim, cells_per_side>::forEachLeaf(
+void DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::forEachLeaf(
     IndexedLeafVisitorFunction visitor_fn) const {
   block_map_.forEachBlock(
       [&visitor_fn](const Index<dim>& block_index, const Block& block) {
@@ -141,24 +159,28 @@ void DenseBlockHash<CellDataT, dim, cells_per_side>::forEachLeaf(
       });
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline Index<dim>
-DenseBlockHash<CellDataT, dim, cells_per_side>::indexToBlockIndex(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::indexToBlockIndex(
     const Index<dim>& index) {
   return convert::indexToBlockIndex(index, kCellsPerSideLog2);
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline Index<dim>
-DenseBlockHash<CellDataT, dim, cells_per_side>::indexToCellIndex(
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::indexToCellIndex(
     const Index<dim>& index) {
   return int_math::div_exp2_floor_remainder(index, kCellsPerSideLog2);
 }
 
-template <typename CellDataT, int dim, unsigned cells_per_side>
+template <typename CellDataT, int dim, unsigned cells_per_side,
+          typename BackendT>
 inline Index<dim>
-DenseBlockHash<CellDataT, dim, cells_per_side>::cellAndBlockIndexToIndex(
-    const Index<dim>& block_index, const Index<dim>& cell_index) {
+DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>::
+    cellAndBlockIndexToIndex(const Index<dim>& block_index,
+                             const Index<dim>& cell_index) {
   return kCellsPerSide * block_index + cell_index;
 }
 
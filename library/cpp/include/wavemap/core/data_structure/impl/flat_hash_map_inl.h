@@ -0,0 +1,188 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_IMPL_FLAT_HASH_MAP_INL_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_IMPL_FLAT_HASH_MAP_INL_H_
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/utils/math/int_math.h"
+
+namespace wavemap {
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::FlatHashMap(
+    const FlatHashMap& other)
+    : slots_(other.slots_.size()),
+      num_elements_(other.num_elements_),
+      num_tombstones_(other.num_tombstones_),
+      hasher_(other.hasher_),
+      key_equal_(other.key_equal_) {
+  for (size_t slot_idx = 0u; slot_idx < slots_.size(); ++slot_idx) {
+    const Slot& other_slot = other.slots_[slot_idx];
+    Slot& slot = slots_[slot_idx];
+    if (other_slot.isOccupied()) {
+      slot.element = std::make_unique<value_type>(*other_slot.element);
+    }
+    slot.hash = other_slot.hash;
+  }
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+void FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::clear() {
+  slots_.clear();
+  num_elements_ = 0u;
+  num_tombstones_ = 0u;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+void FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::reserve(
+    size_t num_elements) {
+  size_t new_capacity = std::max(kMinCapacity, slots_.size());
+  while (exceedsMaxLoad(num_elements, new_capacity)) {
+    new_capacity *= 2u;
+  }
+  if (new_capacity != slots_.size()) {
+    rehash(new_capacity);
+  }
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+void FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::swap(
+    FlatHashMap& other) noexcept {
+  using std::swap;
+  swap(slots_, other.slots_);
+  swap(num_elements_, other.num_elements_);
+  swap(num_tombstones_, other.num_tombstones_);
+  swap(hasher_, other.hasher_);
+  swap(key_equal_, other.key_equal_);
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+typename FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::iterator
+FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::find(const KeyT& key) {
+  const size_t slot_idx = findSlot(key);
+  if (slot_idx == kNotFound) {
+    return end();
+  }
+  return {slots_.data(), slots_.size(), slot_idx};
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+typename FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::const_iterator
+FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::find(const KeyT& key) const {
+  const size_t slot_idx = findSlot(key);
+  if (slot_idx == kNotFound) {
+    return end();
+  }
+  return {slots_.data(), slots_.size(), slot_idx};
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+template <typename... Args>
+std::pair<typename FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::iterator, bool>
+FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::try_emplace(const KeyT& key,
+                                                          Args&&... args) {
+  const size_t hash = hasher_(key);
+  if (const size_t slot_idx = findSlot(key, hash); slot_idx != kNotFound) {
+    return {{slots_.data(), slots_.size(), slot_idx}, false};
+  }
+
+  // Grow the table if needed, which also clears out all tombstones
+  if (slots_.empty() ||
+      exceedsMaxLoad(num_elements_ + num_tombstones_ + 1u, slots_.size())) {
+    const size_t new_capacity =
+        exceedsMaxLoad(num_elements_ + 1u, slots_.size())
+            ? std::max(kMinCapacity, 2u * slots_.size())
+            : slots_.size();
+    rehash(new_capacity);
+  }
+
+  // Insert the element into the first free slot or tombstone along its probe
+  // sequence, which comes no later than the end of the sequence
+  const size_t mask = slots_.size() - 1u;
+  size_t slot_idx = hash & mask;
+  while (slots_[slot_idx].isOccupied()) {
+    slot_idx = (slot_idx + 1u) & mask;
+  }
+  Slot& slot = slots_[slot_idx];
+  if (slot.isTombstone()) {
+    --num_tombstones_;
+  }
+  slot.element = std::make_unique<value_type>(
+      std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+  slot.hash = hash;
+  ++num_elements_;
+  return {{slots_.data(), slots_.size(), slot_idx}, true};
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+size_t FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::erase(const KeyT& key) {
+  const size_t slot_idx = findSlot(key);
+  if (slot_idx == kNotFound) {
+    return 0u;
+  }
+  erase(const_iterator{slots_.data(), slots_.size(), slot_idx});
+  return 1u;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+typename FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::iterator
+FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::erase(const_iterator pos) {
+  // NOTE: Erased elements leave a tombstone behind, instead of shifting the
+  //       subsequent elements back, such that erasing elements while iterating
+  //       over the map never skips or revisits elements.
+  const size_t slot_idx = pos.slot_idx_;
+  Slot& slot = slots_[slot_idx];
+  slot.element.reset();
+  slot.hash = kTombstone;
+  --num_elements_;
+  ++num_tombstones_;
+  return {slots_.data(), slots_.size(), slot_idx + 1u};
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+size_t FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::findSlot(
+    const KeyT& key, size_t hash) const {
+  if (slots_.empty()) {
+    return kNotFound;
+  }
+  const size_t mask = slots_.size() - 1u;
+  // NOTE: The load factor is capped, so the probing always hits a free slot.
+  for (size_t slot_idx = hash & mask;; slot_idx = (slot_idx + 1u) & mask) {
+    const Slot& slot = slots_[slot_idx];
+    if (slot.isFree()) {
+      return kNotFound;
+    }
+    if (slot.isOccupied() && slot.hash == hash &&
+        key_equal_(slot.element->first, key)) {
+      return slot_idx;
+    }
+  }
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+void FlatHashMap<KeyT, ValueT, HashT, KeyEqualT>::rehash(size_t new_capacity) {
+  DCHECK(int_math::is_power_of_two(new_capacity));
+  DCHECK(!exceedsMaxLoad(num_elements_, new_capacity));
+  std::vector<Slot> old_slots(new_capacity);
+  slots_.swap(old_slots);
+  num_tombstones_ = 0u;
+  // Move the elements over without reallocating them, such that references
+  // to them remain valid
+  const size_t mask = new_capacity - 1u;
+  for (Slot& old_slot : old_slots) {
+    if (!old_slot.isOccupied()) {
+      continue;
+    }
+    size_t slot_idx = old_slot.hash & mask;
+    while (slots_[slot_idx].isOccupied()) {
+      slot_idx = (slot_idx + 1u) & mask;
+    }
+    slots_[slot_idx] = std::move(old_slot);
+  }
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_IMPL_FLAT_HASH_MAP_INL_H_
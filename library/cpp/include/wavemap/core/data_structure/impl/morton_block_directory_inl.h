@@ -0,0 +1,153 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_IMPL_MORTON_BLOCK_DIRECTORY_INL_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_IMPL_MORTON_BLOCK_DIRECTORY_INL_H_
+
+#include <functional>
+
+namespace wavemap {
+template <typename BlockDataT, int dim>
+void MortonBlockDirectory<BlockDataT, dim>::insert(
+    const Index<dim>& block_index, BlockDataT* block) {
+  CHECK_NOTNULL(block);
+  // NOTE: The Morton codes would not be unique for indices outside the range
+  //       that the encoding supports, so we check the range even in release.
+  CHECK(isInRange(block_index))
+      << "Block index " << block_index.transpose()
+      << " exceeds the range supported by the block directory.";
+  const MortonIndex morton = blockIndexToMorton(block_index);
+  auto [it, inserted] = entries_.try_emplace(morton);
+  Entry& entry = it->second;
+  DCHECK(inserted || entry.block_index == block_index);
+  entry.block_index = block_index;
+  entry.block = block;
+  entry.neighbors[kSelfNeighborIdx] = &entry;
+
+  // Link the block and its existing neighbors in both directions
+  for (int neighbor_idx = 0; neighbor_idx < kNeighborhoodSize;
+       ++neighbor_idx) {
+    if (neighbor_idx == kSelfNeighborIdx) {
+      continue;
+    }
+    const Index<dim> offset = neighborIdxToOffset(neighbor_idx);
+    if (Entry* neighbor = findEntry(block_index + offset); neighbor) {
+      entry.neighbors[neighbor_idx] = neighbor;
+      neighbor->neighbors[neighborOffsetToIdx(-offset)] = &entry;
+    } else {
+      entry.neighbors[neighbor_idx] = nullptr;
+    }
+  }
+}
+
+template <typename BlockDataT, int dim>
+bool MortonBlockDirectory<BlockDataT, dim>::erase(
+    const Index<dim>& block_index) {
+  if (!isInRange(block_index)) {
+    return false;
+  }
+  const auto it = entries_.find(blockIndexToMorton(block_index));
+  if (it == entries_.end()) {
+    return false;
+  }
+  // Unlink the block from its neighbors
+  const Entry& entry = it->second;
+  for (int neighbor_idx = 0; neighbor_idx < kNeighborhoodSize;
+       ++neighbor_idx) {
+    if (neighbor_idx == kSelfNeighborIdx || !entry.neighbors[neighbor_idx]) {
+      continue;
+    }
+    // NOTE: The links are only const to users of the directory
+    auto* neighbor = const_cast<Entry*>(entry.neighbors[neighbor_idx]);
+    const Index<dim> offset = neighborIdxToOffset(neighbor_idx);
+    neighbor->neighbors[neighborOffsetToIdx(-offset)] = nullptr;
+  }
+  entries_.erase(it);
+  return true;
+}
+
+template <typename BlockDataT, int dim>
+const typename MortonBlockDirectory<BlockDataT, dim>::Entry*
+MortonBlockDirectory<BlockDataT, dim>::getEntry(
+    const Index<dim>& block_index) const {
+  if (!isInRange(block_index)) {
+    return nullptr;
+  }
+  const auto it = entries_.find(blockIndexToMorton(block_index));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+template <typename BlockDataT, int dim>
+template <typename EntryVisitor>
+void MortonBlockDirectory<BlockDataT, dim>::forEachEntry(
+    EntryVisitor visitor_fn) const {
+  for (const auto& [morton, entry] : entries_) {
+    std::invoke(visitor_fn, entry);
+  }
+}
+
+template <typename BlockDataT, int dim>
+int MortonBlockDirectory<BlockDataT, dim>::neighborOffsetToIdx(
+    const Index<dim>& offset) {
+  DCHECK((offset.array().abs() <= 1).all());
+  int neighbor_idx = 0;
+  for (int dim_idx = dim - 1; 0 <= dim_idx; --dim_idx) {
+    neighbor_idx = 3 * neighbor_idx + offset[dim_idx] + 1;
+  }
+  return neighbor_idx;
+}
+
+template <typename BlockDataT, int dim>
+Index<dim> MortonBlockDirectory<BlockDataT, dim>::neighborIdxToOffset(
+    int neighbor_idx) {
+  DCHECK_GE(neighbor_idx, 0);
+  DCHECK_LT(neighbor_idx, kNeighborhoodSize);
+  Index<dim> offset;
+  for (int dim_idx = 0; dim_idx < dim; ++dim_idx) {
+    offset[dim_idx] = neighbor_idx % 3 - 1;
+    neighbor_idx /= 3;
+  }
+  return offset;
+}
+
+template <typename BlockDataT, int dim>
+MortonIndex MortonBlockDirectory<BlockDataT, dim>::blockIndexToMorton(
+    const Index<dim>& block_index) {
+  DCHECK(isInRange(block_index));
+  // Flip the sign bits and drop the bits above them, such that negative
+  // coordinates precede positive ones when sorting by Morton code
+  constexpr uint64_t kSignBitMask = uint64_t{1} << kSignBit;
+  constexpr uint64_t kCoordinateMask = (kSignBitMask << 1) - 1u;
+  Index<dim> shifted_index;
+  for (int dim_idx = 0; dim_idx < dim; ++dim_idx) {
+    const auto coordinate = static_cast<uint64_t>(block_index[dim_idx]);
+    shifted_index[dim_idx] = static_cast<IndexElement>(
+        (coordinate ^ kSignBitMask) & kCoordinateMask);
+  }
+  return morton::encode<dim>(shifted_index);
+}
+
+template <typename BlockDataT, int dim>
+bool MortonBlockDirectory<BlockDataT, dim>::isInRange(
+    const Index<dim>& block_index) {
+  const auto coordinates = block_index.array().template cast<int64_t>();
+  return (kMinCoordinate <= coordinates && coordinates <= kMaxCoordinate)
+      .all();
+}
+
+template <typename BlockDataT, int dim>
+typename MortonBlockDirectory<BlockDataT, dim>::Entry*
+MortonBlockDirectory<BlockDataT, dim>::findEntry(
+    const Index<dim>& block_index) {
+  if (!isInRange(block_index)) {
+    return nullptr;
+  }
+  const auto it = entries_.find(blockIndexToMorton(block_index));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_IMPL_MORTON_BLOCK_DIRECTORY_INL_H_
@@ -5,8 +5,8 @@
 #include <utility>
 
 namespace wavemap {
-template <typename CellDataT, int dim>
-inline size_t NdtreeBlockHash<CellDataT, dim>::size() const {
+template <typename CellDataT, int dim, typename BackendT>
+inline size_t NdtreeBlockHash<CellDataT, dim, BackendT>::size() const {
   size_t size = 0u;
   forEachBlock([&size](const Index<dim>& /*block_index*/, const Block& block) {
     size += block.size();
@@ -14,53 +14,56 @@ inline size_t NdtreeBlockHash<CellDataT, dim>::size() const {
   return size;
 }
 
-template <typename CellDataT, int dim>
-bool NdtreeBlockHash<CellDataT, dim>::hasBlock(
+template <typename CellDataT, int dim, typename BackendT>
+bool NdtreeBlockHash<CellDataT, dim, BackendT>::hasBlock(
     const Index<dim>& block_index) const {
   return block_map_.hasBlock(block_index);
 }
 
-template <typename CellDataT, int dim>
-bool NdtreeBlockHash<CellDataT, dim>::eraseBlock(
+template <typename CellDataT, int dim, typename BackendT>
+bool NdtreeBlockHash<CellDataT, dim, BackendT>::eraseBlock(
     const Index<dim>& block_index) {
   return block_map_.eraseBlock(block_index);
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename IndexedBlockVisitor>
-void NdtreeBlockHash<CellDataT, dim>::eraseBlockIf(
+void NdtreeBlockHash<CellDataT, dim, BackendT>::eraseBlockIf(
     IndexedBlockVisitor indicator_fn) {
   block_map_.eraseBlockIf(indicator_fn);
 }
 
-template <typename CellDataT, int dim>
-inline typename NdtreeBlockHash<CellDataT, dim>::Block*
-NdtreeBlockHash<CellDataT, dim>::getBlock(const Index<dim>& block_index) {
+template <typename CellDataT, int dim, typename BackendT>
+inline typename NdtreeBlockHash<CellDataT, dim, BackendT>::Block*
+NdtreeBlockHash<CellDataT, dim, BackendT>::getBlock(
+    const Index<dim>& block_index) {
   return block_map_.getBlock(block_index);
 }
 
-template <typename CellDataT, int dim>
-inline const typename NdtreeBlockHash<CellDataT, dim>::Block*
-NdtreeBlockHash<CellDataT, dim>::getBlock(const Index<dim>& block_index) const {
+template <typename CellDataT, int dim, typename BackendT>
+inline const typename NdtreeBlockHash<CellDataT, dim, BackendT>::Block*
+NdtreeBlockHash<CellDataT, dim, BackendT>::getBlock(
+    const Index<dim>& block_index) const {
   return block_map_.getBlock(block_index);
 }
 
-template <typename CellDataT, int dim>
-inline typename NdtreeBlockHash<CellDataT, dim>::Block&
-NdtreeBlockHash<CellDataT, dim>::getOrAllocateBlock(
+template <typename CellDataT, int dim, typename BackendT>
+inline typename NdtreeBlockHash<CellDataT, dim, BackendT>::Block&
+NdtreeBlockHash<CellDataT, dim, BackendT>::getOrAllocateBlock(
     const Index<dim>& block_index) {
   return block_map_.getOrAllocateBlock(block_index, max_height_,
                                        default_value_);
 }
 
-template <typename CellDataT, int dim>
-bool NdtreeBlockHash<CellDataT, dim>::hasNode(
+template <typename CellDataT, int dim, typename BackendT>
+bool NdtreeBlockHash<CellDataT, dim, BackendT>::hasNode(
     const NdtreeIndex<dim>& index) const {
   return getNode(index);
 }
 
-template <typename CellDataT, int dim>
-bool NdtreeBlockHash<CellDataT, dim>::eraseNode(const NdtreeIndex<dim>& index) {
+template <typename CellDataT, int dim, typename BackendT>
+bool NdtreeBlockHash<CellDataT, dim, BackendT>::eraseNode(
+    const NdtreeIndex<dim>& index) {
   const Index<dim> block_index = indexToBlockIndex(index);
   if (const Block* block = getBlock(block_index); block) {
     const NdtreeIndex<dim> cell_index = indexToCellIndex(index);
@@ -69,15 +72,17 @@ bool NdtreeBlockHash<CellDataT, dim>::eraseNode(const NdtreeIndex<dim>& index) {
   return false;
 }
 
-template <typename CellDataT, int dim>
-typename NdtreeBlockHash<CellDataT, dim>::Node*
-NdtreeBlockHash<CellDataT, dim>::getNode(const NdtreeIndex<dim>& index) {
+template <typename CellDataT, int dim, typename BackendT>
+typename NdtreeBlockHash<CellDataT, dim, BackendT>::Node*
+NdtreeBlockHash<CellDataT, dim, BackendT>::getNode(
+    const NdtreeIndex<dim>& index) {
   return const_cast<Node*>(std::as_const(*this).getNode(index));
 }
 
-template <typename CellDataT, int dim>
-const typename NdtreeBlockHash<CellDataT, dim>::Node*
-NdtreeBlockHash<CellDataT, dim>::getNode(const NdtreeIndex<dim>& index) const {
+template <typename CellDataT, int dim, typename BackendT>
+const typename NdtreeBlockHash<CellDataT, dim, BackendT>::Node*
+NdtreeBlockHash<CellDataT, dim, BackendT>::getNode(
+    const NdtreeIndex<dim>& index) const {
   const Index<dim> block_index = indexToBlockIndex(index);
   if (const Block* block = getBlock(block_index); block) {
     const NdtreeIndex<dim> cell_index = indexToCellIndex(index);
@@ -86,9 +91,9 @@ NdtreeBlockHash<CellDataT, dim>::getNode(const NdtreeIndex<dim>& index) const {
   return nullptr;
 }
 
-template <typename CellDataT, int dim>
-typename NdtreeBlockHash<CellDataT, dim>::Node&
-NdtreeBlockHash<CellDataT, dim>::getOrAllocateNode(
+template <typename CellDataT, int dim, typename BackendT>
+typename NdtreeBlockHash<CellDataT, dim, BackendT>::Node&
+NdtreeBlockHash<CellDataT, dim, BackendT>::getOrAllocateNode(
     const NdtreeIndex<dim>& index) {
   const Index<dim> block_index = indexToBlockIndex(index);
   Block& block = getOrAllocateBlock(block_index);
@@ -96,16 +101,18 @@ NdtreeBlockHash<CellDataT, dim>::getOrAllocateNode(
   return block.getOrAllocateNode(cell_index, default_value_);
 }
 
-template <typename CellDataT, int dim>
-std::pair<typename NdtreeBlockHash<CellDataT, dim>::Node*, IndexElement>
-NdtreeBlockHash<CellDataT, dim>::getNodeOrAncestor(
+template <typename CellDataT, int dim, typename BackendT>
+std::pair<typename NdtreeBlockHash<CellDataT, dim, BackendT>::Node*,
+          IndexElement>
+NdtreeBlockHash<CellDataT, dim, BackendT>::getNodeOrAncestor(
     const NdtreeIndex<dim>& index) {
   return const_cast<Node*>(std::as_const(*this).getNode(index));
 }
 
-template <typename CellDataT, int dim>
-std::pair<const typename NdtreeBlockHash<CellDataT, dim>::Node*, IndexElement>
-NdtreeBlockHash<CellDataT, dim>::getNodeOrAncestor(
+template <typename CellDataT, int dim, typename BackendT>
+std::pair<const typename NdtreeBlockHash<CellDataT, dim, BackendT>::Node*,
+          IndexElement>
+NdtreeBlockHash<CellDataT, dim, BackendT>::getNodeOrAncestor(
     const NdtreeIndex<dim>& index) const {
   const Index<dim> block_index = indexToBlockIndex(index);
   if (const Block* block = getBlock(block_index); block) {
@@ -115,20 +122,20 @@ NdtreeBlockHash<CellDataT, dim>::getNodeOrAncestor(
   return {nullptr, max_height_};
 }
 
-template <typename CellDataT, int dim>
-bool NdtreeBlockHash<CellDataT, dim>::hasValue(
+template <typename CellDataT, int dim, typename BackendT>
+bool NdtreeBlockHash<CellDataT, dim, BackendT>::hasValue(
     const NdtreeIndex<dim>& index) const {
   return hasNode(index);
 }
 
-template <typename CellDataT, int dim>
-CellDataT* NdtreeBlockHash<CellDataT, dim>::getValue(
+template <typename CellDataT, int dim, typename BackendT>
+CellDataT* NdtreeBlockHash<CellDataT, dim, BackendT>::getValue(
     const NdtreeIndex<dim>& index) {
   return const_cast<CellDataT*>(std::as_const(*this).getValue(index));
 }
 
-template <typename CellDataT, int dim>
-const CellDataT* NdtreeBlockHash<CellDataT, dim>::getValue(
+template <typename CellDataT, int dim, typename BackendT>
+const CellDataT* NdtreeBlockHash<CellDataT, dim, BackendT>::getValue(
     const NdtreeIndex<dim>& index) const {
   if (const Node* node = getNode(index); node) {
     return &node->data();
@@ -136,30 +143,30 @@ const CellDataT* NdtreeBlockHash<CellDataT, dim>::getValue(
   return nullptr;
 }
 
-template <typename CellDataT, int dim>
-CellDataT& NdtreeBlockHash<CellDataT, dim>::getOrAllocateValue(
+template <typename CellDataT, int dim, typename BackendT>
+CellDataT& NdtreeBlockHash<CellDataT, dim, BackendT>::getOrAllocateValue(
     const NdtreeIndex<dim>& index) {
   return getOrAllocateNode(index).data();
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 std::pair<CellDataT*, IndexElement>
-NdtreeBlockHash<CellDataT, dim>::getValueOrAncestor(
+NdtreeBlockHash<CellDataT, dim, BackendT>::getValueOrAncestor(
     const NdtreeIndex<dim>& index) {
   auto rv = getNodeOrAncestor(index);
   return {rv.first ? &rv.first->data() : nullptr, rv.second};
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 std::pair<const CellDataT*, IndexElement>
-NdtreeBlockHash<CellDataT, dim>::getValueOrAncestor(
+NdtreeBlockHash<CellDataT, dim, BackendT>::getValueOrAncestor(
     const NdtreeIndex<dim>& index) const {
   auto rv = getNodeOrAncestor(index);
   return {rv.first ? &rv.first->data() : nullptr, rv.second};
 }
 
-template <typename CellDataT, int dim>
-const CellDataT& NdtreeBlockHash<CellDataT, dim>::getValueOrDefault(
+template <typename CellDataT, int dim, typename BackendT>
+const CellDataT& NdtreeBlockHash<CellDataT, dim, BackendT>::getValueOrDefault(
     const NdtreeIndex<dim>& index) const {
   if (const CellDataT* value = getValue(index); value) {
     return *value;
@@ -167,29 +174,29 @@ const CellDataT& NdtreeBlockHash<CellDataT, dim>::getValueOrDefault(
   return default_value_;
 }
 
-template <typename CellDataT, int dim>
-bool NdtreeBlockHash<CellDataT, dim>::equalsDefaultValue(
+template <typename CellDataT, int dim, typename BackendT>
+bool NdtreeBlockHash<CellDataT, dim, BackendT>::equalsDefaultValue(
     const CellDataT& value) const {
   return value == default_value_;
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename IndexedBlockVisitor>
-void NdtreeBlockHash<CellDataT, dim>::forEachBlock(
+void NdtreeBlockHash<CellDataT, dim, BackendT>::forEachBlock(
     IndexedBlockVisitor visitor_fn) {
   block_map_.forEachBlock(visitor_fn);
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename IndexedBlockVisitor>
-void NdtreeBlockHash<CellDataT, dim>::forEachBlock(
+void NdtreeBlockHash<CellDataT, dim, BackendT>::forEachBlock(
     IndexedBlockVisitor visitor_fn) const {
   block_map_.forEachBlock(visitor_fn);
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename IndexedLeafVisitorFunction>
-void NdtreeBlockHash<CellDataT, dim>::forEachLeaf(
+void NdtreeBlockHash<CellDataT, dim, BackendT>::forEachLeaf(
     IndexedLeafVisitorFunction visitor_fn) {
   struct StackElement {
     const OctreeIndex node_index;
@@ -220,9 +227,9 @@ void NdtreeBlockHash<CellDataT, dim>::forEachLeaf(
   });
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename IndexedLeafVisitorFunction>
-void NdtreeBlockHash<CellDataT, dim>::forEachLeaf(
+void NdtreeBlockHash<CellDataT, dim, BackendT>::forEachLeaf(
     IndexedLeafVisitorFunction visitor_fn) const {
   struct StackElement {
     const OctreeIndex node_index;
@@ -258,8 +265,8 @@ void NdtreeBlockHash<CellDataT, dim>::forEachLeaf(
   });
 }
 
-template <typename CellDataT, int dim>
-inline Index<dim> NdtreeBlockHash<CellDataT, dim>::indexToBlockIndex(
+template <typename CellDataT, int dim, typename BackendT>
+inline Index<dim> NdtreeBlockHash<CellDataT, dim, BackendT>::indexToBlockIndex(
     const NdtreeIndex<dim>& index) const {
   DCHECK_GE(index.height, 0);
   DCHECK_LE(index.height, max_height_);
@@ -267,8 +274,9 @@ inline Index<dim> NdtreeBlockHash<CellDataT, dim>::indexToBlockIndex(
   return int_math::div_exp2_floor(index.position, depth);
 }
 
-template <typename CellDataT, int dim>
-inline NdtreeIndex<dim> NdtreeBlockHash<CellDataT, dim>::indexToCellIndex(
+template <typename CellDataT, int dim, typename BackendT>
+inline NdtreeIndex<dim>
+NdtreeBlockHash<CellDataT, dim, BackendT>::indexToCellIndex(
     const NdtreeIndex<dim>& index) const {
   DCHECK_GE(index.height, 0);
   DCHECK_LE(index.height, max_height_);
@@ -277,9 +285,9 @@ inline NdtreeIndex<dim> NdtreeBlockHash<CellDataT, dim>::indexToCellIndex(
           int_math::div_exp2_floor_remainder(index.position, depth)};
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 inline NdtreeIndex<dim>
-NdtreeBlockHash<CellDataT, dim>::cellAndBlockIndexToIndex(
+NdtreeBlockHash<CellDataT, dim, BackendT>::cellAndBlockIndexToIndex(
     const Index<dim>& block_index, const NdtreeIndex<dim>& cell_index) const {
   DCHECK_GE(cell_index.height, 0);
   DCHECK_LE(cell_index.height, max_height_);
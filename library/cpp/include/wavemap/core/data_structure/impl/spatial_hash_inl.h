@@ -2,8 +2,12 @@
 #define WAVEMAP_CORE_DATA_STRUCTURE_IMPL_SPATIAL_HASH_INL_H_
 
 #include <limits>
+#include <memory>
 #include <utility>
 
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/iterate/visitor_utils.h"
+
 namespace wavemap {
 namespace convert {
 template <int dim>
@@ -11,10 +15,65 @@ Index<dim> indexToBlockIndex(const Index<dim>& index,
                              IndexElement cells_per_block_side_log_2) {
   return int_math::div_exp2_floor(index, cells_per_block_side_log_2);
 }
+
+template <int dim>
+std::pair<Index<dim>, Index<dim>> aabbToBlockIndexRange(
+    const AABB<Point<dim>>& aabb, FloatingPoint block_width_inv) {
+  // Clamp the range to avoid overflows for (near) unbounded AABBs
+  constexpr auto kMaxIndex =
+      static_cast<FloatingPoint>(std::numeric_limits<IndexElement>::max() / 4);
+  const Point<dim> min_scaled =
+      (aabb.min * block_width_inv).cwiseMax(-kMaxIndex).cwiseMin(kMaxIndex);
+  const Point<dim> max_scaled =
+      (aabb.max * block_width_inv).cwiseMax(-kMaxIndex).cwiseMin(kMaxIndex);
+  // NOTE: Block i covers the closed interval [i, i + 1] in scaled
+  //       coordinates, consistent with the shape::overlaps(...) tests. To
+  //       robustly include blocks that only touch the AABB despite rounding
+  //       errors, the range is padded by one block on each side. Callers that
+  //       need an exact result should therefore still test each block.
+  return {min_scaled.array().floor().template cast<IndexElement>() - 1,
+          max_scaled.array().floor().template cast<IndexElement>() + 1};
+}
 }  // namespace convert
 
-template <typename BlockDataT, int dim>
-Index<dim> SpatialHash<BlockDataT, dim>::getMinBlockIndex() const {
+template <typename BlockDataT, int dim, typename BackendT>
+SpatialHash<BlockDataT, dim, BackendT>::SpatialHash(const SpatialHash& other)
+    : block_map_(other.block_map_) {
+  // The directory points to the blocks of the other hash, so it is rebuilt
+  if (other.block_directory_) {
+    enableBlockDirectory();
+  }
+}
+
+template <typename BlockDataT, int dim, typename BackendT>
+SpatialHash<BlockDataT, dim, BackendT>&
+SpatialHash<BlockDataT, dim, BackendT>::operator=(const SpatialHash& other) {
+  if (this != &other) {
+    *this = SpatialHash(other);
+  }
+  return *this;
+}
+
+template <typename BlockDataT, int dim, typename BackendT>
+void SpatialHash<BlockDataT, dim, BackendT>::clear() {
+  releaseHashMap();
+  if (block_directory_) {
+    block_directory_->clear();
+  }
+}
+
+template <typename BlockDataT, int dim, typename BackendT>
+size_t SpatialHash<BlockDataT, dim, BackendT>::getMemoryUsage() const {
+  size_t memory_usage = memory::getHeapUsage(block_map_);
+  if (block_directory_) {
+    memory_usage += memory::getAllocationSize(sizeof(BlockDirectory)) +
+                    block_directory_->getMemoryUsage();
+  }
+  return memory_usage;
+}
+
+template <typename BlockDataT, int dim, typename BackendT>
+Index<dim> SpatialHash<BlockDataT, dim, BackendT>::getMinBlockIndex() const {
   if (empty()) {
     return Index<kDim>::Zero();
   }
@@ -28,8 +87,8 @@ Index<dim> SpatialHash<BlockDataT, dim>::getMinBlockIndex() const {
   return min_block_index;
 }
 
-template <typename BlockDataT, int dim>
-Index<dim> SpatialHash<BlockDataT, dim>::getMaxBlockIndex() const {
+template <typename BlockDataT, int dim, typename BackendT>
+Index<dim> SpatialHash<BlockDataT, dim, BackendT>::getMaxBlockIndex() const {
   if (empty()) {
     return Index<kDim>::Zero();
   }
@@ -43,36 +102,49 @@ Index<dim> SpatialHash<BlockDataT, dim>::getMaxBlockIndex() const {
   return max_block_index;
 }
 
-template <typename BlockDataT, int dim>
-bool SpatialHash<BlockDataT, dim>::hasBlock(
+template <typename BlockDataT, int dim, typename BackendT>
+bool SpatialHash<BlockDataT, dim, BackendT>::hasBlock(
     const SpatialHash::BlockIndex& block_index) const {
   return block_map_.count(block_index);
 }
 
-template <typename BlockDataT, int dim>
-bool SpatialHash<BlockDataT, dim>::eraseBlock(
+template <typename BlockDataT, int dim, typename BackendT>
+bool SpatialHash<BlockDataT, dim, BackendT>::eraseBlock(
     const SpatialHash::BlockIndex& block_index) {
-  return block_map_.erase(block_index);
+  if (block_directory_) {
+    block_directory_->erase(block_index);
+  }
+  const bool erased = block_map_.erase(block_index);
+  if (block_map_.empty()) {
+    releaseHashMap();
+  }
+  return erased;
 }
 
-template <typename BlockDataT, int dim>
+template <typename BlockDataT, int dim, typename BackendT>
 template <typename IndexedBlockVisitor>
-void SpatialHash<BlockDataT, dim>::eraseBlockIf(
+void SpatialHash<BlockDataT, dim, BackendT>::eraseBlockIf(
     IndexedBlockVisitor indicator_fn) {
   for (auto it = block_map_.begin(); it != block_map_.end();) {
     const BlockIndex& block_index = it->first;
     BlockData& block = it->second;
     if (std::invoke(indicator_fn, block_index, block)) {
+      if (block_directory_) {
+        block_directory_->erase(block_index);
+      }
       it = block_map_.erase(it);
     } else {
       ++it;
     }
   }
+  if (block_map_.empty()) {
+    releaseHashMap();
+  }
 }
 
-template <typename BlockDataT, int dim>
-typename SpatialHash<BlockDataT, dim>::BlockData*
-SpatialHash<BlockDataT, dim>::getBlock(
+template <typename BlockDataT, int dim, typename BackendT>
+typename SpatialHash<BlockDataT, dim, BackendT>::BlockData*
+SpatialHash<BlockDataT, dim, BackendT>::getBlock(
     const SpatialHash::BlockIndex& block_index) {
   const auto& it = block_map_.find(block_index);
   if (it != block_map_.end()) {
@@ -82,9 +154,9 @@ SpatialHash<BlockDataT, dim>::getBlock(
   }
 }
 
-template <typename BlockDataT, int dim>
-const typename SpatialHash<BlockDataT, dim>::BlockData*
-SpatialHash<BlockDataT, dim>::getBlock(
+template <typename BlockDataT, int dim, typename BackendT>
+const typename SpatialHash<BlockDataT, dim, BackendT>::BlockData*
+SpatialHash<BlockDataT, dim, BackendT>::getBlock(
     const SpatialHash::BlockIndex& block_index) const {
   const auto& it = block_map_.find(block_index);
   if (it != block_map_.end()) {
@@ -94,32 +166,96 @@ SpatialHash<BlockDataT, dim>::getBlock(
   }
 }
 
-template <typename BlockDataT, int dim>
+template <typename BlockDataT, int dim, typename BackendT>
 template <typename... DefaultArgs>
-typename SpatialHash<BlockDataT, dim>::BlockData&
-SpatialHash<BlockDataT, dim>::getOrAllocateBlock(
+typename SpatialHash<BlockDataT, dim, BackendT>::BlockData&
+SpatialHash<BlockDataT, dim, BackendT>::getOrAllocateBlock(
     const SpatialHash::BlockIndex& block_index, DefaultArgs&&... args) {
-  return block_map_.try_emplace(block_index, std::forward<DefaultArgs>(args)...)
-      .first->second;
+  auto [it, inserted] =
+      block_map_.try_emplace(block_index, std::forward<DefaultArgs>(args)...);
+  if (inserted && block_directory_) {
+    block_directory_->insert(block_index, &it->second);
+  }
+  return it->second;
 }
 
-template <typename BlockDataT, int dim>
+template <typename BlockDataT, int dim, typename BackendT>
+void SpatialHash<BlockDataT, dim, BackendT>::enableBlockDirectory() {
+  if (block_directory_) {
+    return;
+  }
+  block_directory_ = std::make_unique<BlockDirectory>();
+  for (auto& [block_index, block_data] : block_map_) {
+    block_directory_->insert(block_index, &block_data);
+  }
+}
+
+template <typename BlockDataT, int dim, typename BackendT>
 template <typename IndexedBlockVisitor>
-void SpatialHash<BlockDataT, dim>::forEachBlock(
+void SpatialHash<BlockDataT, dim, BackendT>::forEachBlock(
     IndexedBlockVisitor visitor_fn) {
+  if (block_directory_) {
+    block_directory_->forEachEntry(
+        [&visitor_fn](const typename BlockDirectory::Entry& entry) {
+          std::invoke(visitor_fn, entry.block_index, *entry.block);
+        });
+    return;
+  }
   for (auto& [block_index, block_data] : block_map_) {
     std::invoke(visitor_fn, block_index, block_data);
   }
 }
 
-template <typename BlockDataT, int dim>
+template <typename BlockDataT, int dim, typename BackendT>
 template <typename IndexedBlockVisitor>
-void SpatialHash<BlockDataT, dim>::forEachBlock(
+void SpatialHash<BlockDataT, dim, BackendT>::forEachBlock(
     IndexedBlockVisitor visitor_fn) const {
+  if (block_directory_) {
+    block_directory_->forEachEntry(
+        [&visitor_fn](const typename BlockDirectory::Entry& entry) {
+          const BlockData& block_data = *entry.block;
+          std::invoke(visitor_fn, entry.block_index, block_data);
+        });
+    return;
+  }
   for (const auto& [block_index, block_data] : block_map_) {
     std::invoke(visitor_fn, block_index, block_data);
   }
 }
+
+template <typename BlockDataT, int dim, typename BackendT>
+template <typename IndexedBlockVisitor>
+void SpatialHash<BlockDataT, dim, BackendT>::forEachBlockInRange(
+    const BlockIndex& min_block_index, const BlockIndex& max_block_index,
+    IndexedBlockVisitor visitor_fn) const {
+  if ((max_block_index.array() < min_block_index.array()).any()) {
+    return;
+  }
+
+  const auto range_widths = max_block_index.template cast<double>().array() -
+                            min_block_index.template cast<double>().array() +
+                            1.0;
+  if (range_widths.prod() < static_cast<double>(block_map_.size())) {
+    for (const BlockIndex& block_index :
+         Grid<dim>(min_block_index, max_block_index)) {
+      if (const BlockData* block_data = getBlock(block_index); block_data) {
+        if (!visitor::invoke(visitor_fn, block_index, *block_data)) {
+          return;
+        }
+      }
+    }
+  } else {
+    for (const auto& [block_index, block_data] : block_map_) {
+      if ((min_block_index.array() <= block_index.array() &&
+           block_index.array() <= max_block_index.array())
+              .all()) {
+        if (!visitor::invoke(visitor_fn, block_index, block_data)) {
+          return;
+        }
+      }
+    }
+  }
+}
 }  // namespace wavemap
 
 #endif  // WAVEMAP_CORE_DATA_STRUCTURE_IMPL_SPATIAL_HASH_INL_H_
@@ -0,0 +1,166 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_IMPL_LINEAR_NDTREE_INL_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_IMPL_LINEAR_NDTREE_INL_H_
+
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/bits/bit_operations.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
+
+namespace wavemap {
+template <typename NodeDataT, int dim>
+LinearNdtree<NodeDataT, dim>::LinearNdtree(HeightType max_height)
+    : max_height_(max_height), nodes_(1) {}
+
+template <typename NodeDataT, int dim>
+void LinearNdtree<NodeDataT, dim>::clear() {
+  nodes_ = std::vector<Node>(1);
+  num_unused_nodes_ = 0u;
+}
+
+template <typename NodeDataT, int dim>
+void LinearNdtree<NodeDataT, dim>::prune() {
+  recursivePrune(getRootNode());
+  compactIfFragmented();
+}
+
+template <typename NodeDataT, int dim>
+void LinearNdtree<NodeDataT, dim>::compact() {
+  if (num_unused_nodes_ == 0u) {
+    return;
+  }
+
+  // Copy all reachable nodes into a new array, in breadth-first order
+  std::vector<Node> compacted_nodes;
+  compacted_nodes.reserve(size());
+  compacted_nodes.emplace_back(nodes_.front());
+  for (size_t node_idx = 0; node_idx < compacted_nodes.size(); ++node_idx) {
+    const NodeOffset first_child = compacted_nodes[node_idx].first_child;
+    const NodeOffset num_children =
+        bit_ops::popcount(uint32_t{compacted_nodes[node_idx].child_mask});
+    compacted_nodes[node_idx].first_child = compacted_nodes.size();
+    for (NodeOffset rank = 0; rank < num_children; ++rank) {
+      compacted_nodes.emplace_back(nodes_[first_child + rank]);
+    }
+  }
+  DCHECK_EQ(compacted_nodes.size(), size());
+
+  nodes_ = std::move(compacted_nodes);
+  num_unused_nodes_ = 0u;
+}
+
+template <typename NodeDataT, int dim>
+void LinearNdtree<NodeDataT, dim>::compactIfFragmented() {
+  if (size() <= num_unused_nodes_) {
+    compact();
+  }
+}
+
+template <typename NodeDataT, int dim>
+size_t LinearNdtree<NodeDataT, dim>::getMemoryUsage() const {
+  return memory::getHeapUsage(nodes_);
+}
+
+template <typename NodeDataT, int dim>
+typename LinearNdtree<NodeDataT, dim>::NodePtrType
+LinearNdtree<NodeDataT, dim>::getNode(const IndexType& index) {
+  NodePtrType node = &getRootNode();
+  const MortonIndex morton_code = convert::nodeIndexToMorton(index);
+  for (int node_height = max_height_; node && index.height < node_height;
+       --node_height) {
+    const NdtreeIndexRelativeChild child_index =
+        NdtreeIndex<dim>::computeRelativeChildIndex(morton_code, node_height);
+    node = node->getChild(child_index);
+  }
+  return node;
+}
+
+template <typename NodeDataT, int dim>
+typename LinearNdtree<NodeDataT, dim>::NodeConstPtrType
+LinearNdtree<NodeDataT, dim>::getNode(const IndexType& index) const {
+  NodeConstPtrType node = &getRootNode();
+  const MortonIndex morton_code = convert::nodeIndexToMorton(index);
+  for (int node_height = max_height_; node && index.height < node_height;
+       --node_height) {
+    const NdtreeIndexRelativeChild child_index =
+        NdtreeIndex<dim>::computeRelativeChildIndex(morton_code, node_height);
+    node = node->getChild(child_index);
+  }
+  return node;
+}
+
+template <typename NodeDataT, int dim>
+template <typename... DefaultArgs>
+typename LinearNdtree<NodeDataT, dim>::NodeRefType
+LinearNdtree<NodeDataT, dim>::getOrAllocateNode(const IndexType& index,
+                                                DefaultArgs&&... args) {
+  NodePtrType node = &getRootNode();
+  const MortonIndex morton_code = convert::nodeIndexToMorton(index);
+  for (int node_height = max_height_; index.height < node_height;
+       --node_height) {
+    const NdtreeIndexRelativeChild child_index =
+        NdtreeIndex<dim>::computeRelativeChildIndex(morton_code, node_height);
+    // Get the child, allocating if needed
+    node = &node->getOrAllocateChild(child_index,
+                                     std::forward<DefaultArgs>(args)...);
+  }
+  return *node;
+}
+
+template <typename NodeDataT, int dim>
+std::pair<typename LinearNdtree<NodeDataT, dim>::NodePtrType,
+          typename LinearNdtree<NodeDataT, dim>::HeightType>
+LinearNdtree<NodeDataT, dim>::getNodeOrAncestor(const IndexType& index) {
+  NodePtrType node = &getRootNode();
+  const MortonIndex morton_code = convert::nodeIndexToMorton(index);
+  for (int node_height = max_height_; index.height < node_height;
+       --node_height) {
+    const NdtreeIndexRelativeChild child_index =
+        NdtreeIndex<dim>::computeRelativeChildIndex(morton_code, node_height);
+    // Check if the child is allocated
+    NodePtrType child = node->getChild(child_index);
+    if (!child) {
+      return {node, node_height};
+    }
+    node = child;
+  }
+  return {node, index.height};
+}
+
+template <typename NodeDataT, int dim>
+std::pair<typename LinearNdtree<NodeDataT, dim>::NodeConstPtrType,
+          typename LinearNdtree<NodeDataT, dim>::HeightType>
+LinearNdtree<NodeDataT, dim>::getNodeOrAncestor(const IndexType& index) const {
+  NodeConstPtrType node = &getRootNode();
+  const MortonIndex morton_code = convert::nodeIndexToMorton(index);
+  for (int node_height = max_height_; index.height < node_height;
+       --node_height) {
+    const NdtreeIndexRelativeChild child_index =
+        NdtreeIndex<dim>::computeRelativeChildIndex(morton_code, node_height);
+    // Check if the child is allocated
+    NodeConstPtrType child = node->getChild(child_index);
+    if (!child) {
+      return {node, node_height};
+    }
+    node = child;
+  }
+  return {node, index.height};
+}
+
+template <typename NodeDataT, int dim>
+bool LinearNdtree<NodeDataT, dim>::recursivePrune(  // NOLINT
+    NodeRefType node) {
+  for (NdtreeIndexRelativeChild child_idx = 0; child_idx < kNumChildren;
+       ++child_idx) {
+    if (NodePtrType child = node.getChild(child_idx); child) {
+      if (recursivePrune(*child)) {
+        node.eraseChild(child_idx);
+      }
+    }
+  }
+  return node.empty();
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_IMPL_LINEAR_NDTREE_INL_H_
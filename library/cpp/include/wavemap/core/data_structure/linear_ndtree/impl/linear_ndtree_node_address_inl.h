@@ -0,0 +1,210 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_IMPL_LINEAR_NDTREE_NODE_ADDRESS_INL_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_IMPL_LINEAR_NDTREE_NODE_ADDRESS_INL_H_
+
+#include <algorithm>
+#include <stack>
+#include <utility>
+
+#include "wavemap/core/utils/bits/bit_operations.h"
+
+namespace wavemap {
+template <typename TreeType>
+LinearNdtreeNodePtr<TreeType>::LinearNdtreeNodePtr(TreeType* tree,
+                                                   uint32_t node_offset)
+    : node_(tree, node_offset) {}
+
+template <typename TreeType>
+LinearNdtreeNodePtr<TreeType>& LinearNdtreeNodePtr<TreeType>::operator=(
+    const LinearNdtreeNodePtr& other) {
+  node_.tree_ = other.node_.tree_;
+  node_.node_offset_ = other.node_.node_offset_;
+  return *this;
+}
+
+template <typename TreeType>
+LinearNdtreeNodePtr<TreeType>& LinearNdtreeNodePtr<TreeType>::operator=(
+    LinearNdtreeNodePtr&& other) noexcept {
+  node_.tree_ = other.node_.tree_;
+  node_.node_offset_ = other.node_.node_offset_;
+  return *this;
+}
+
+template <typename TreeType>
+LinearNdtreeNodeRef<TreeType>::LinearNdtreeNodeRef(TreeType& tree,
+                                                   uint32_t node_offset)
+    : tree_(&tree), node_offset_(node_offset) {}
+
+template <typename TreeType>
+LinearNdtreeNodeRef<TreeType>::LinearNdtreeNodeRef(
+    const LinearNdtreeNodeRef& other)
+    : tree_(other.tree_), node_offset_(other.node_offset_) {}
+
+template <typename TreeType>
+LinearNdtreeNodeRef<TreeType>::LinearNdtreeNodeRef(
+    LinearNdtreeNodeRef&& other) noexcept
+    : tree_(other.tree_), node_offset_(other.node_offset_) {}
+
+template <typename TreeType>
+LinearNdtreeNodeRef<TreeType>::operator LinearNdtreeNodeRef<
+    const TreeType>() const {
+  return {*tree_, node_offset_};
+}
+
+template <typename TreeType>
+typename LinearNdtreeNodeRef<TreeType>::NodePtr
+LinearNdtreeNodeRef<TreeType>::operator&() const {  // NOLINT
+  return {tree_, node_offset_};
+}
+
+template <typename TreeType>
+bool LinearNdtreeNodeRef<TreeType>::empty() const {
+  return !hasAtLeastOneChild() && !hasNonzeroData();
+}
+
+template <typename TreeType>
+bool LinearNdtreeNodeRef<TreeType>::hasNonzeroData() const {
+  return data::is_nonzero(node().data);
+}
+
+template <typename TreeType>
+bool LinearNdtreeNodeRef<TreeType>::hasNonzeroData(
+    FloatingPoint threshold) const {
+  return data::is_nonzero(node().data, threshold);
+}
+
+template <typename TreeType>
+auto& LinearNdtreeNodeRef<TreeType>::data() const {
+  return node().data;
+}
+
+template <typename TreeType>
+bool LinearNdtreeNodeRef<TreeType>::hasAtLeastOneChild() const {
+  return node().child_mask;
+}
+
+template <typename TreeType>
+bool LinearNdtreeNodeRef<TreeType>::hasChild(
+    NdtreeIndexRelativeChild child_index) const {
+  return bit_ops::is_bit_set(node().child_mask, child_index);
+}
+
+template <typename TreeType>
+void LinearNdtreeNodeRef<TreeType>::eraseChild(
+    NdtreeIndexRelativeChild child_index) const {
+  if (!hasChild(child_index)) {
+    return;
+  }
+  auto& nodes = tree_->nodes_;
+  const uint32_t first_child = node().first_child;
+  const uint32_t num_children = bit_ops::popcount(uint32_t{node().child_mask});
+  const uint32_t erased_child = first_child + computeChildRank(child_index);
+
+  // Count the nodes in the child's subtree, which all become unused
+  size_t num_erased_nodes = 0u;
+  std::stack<uint32_t> stack;
+  stack.emplace(erased_child);
+  while (!stack.empty()) {
+    const auto& erased_node = nodes[stack.top()];
+    stack.pop();
+    ++num_erased_nodes;
+    const uint32_t num_grandchildren =
+        bit_ops::popcount(uint32_t{erased_node.child_mask});
+    for (uint32_t rank = 0; rank < num_grandchildren; ++rank) {
+      stack.emplace(erased_node.first_child + rank);
+    }
+  }
+
+  // Close the gap by shifting the child's later siblings forward
+  const uint32_t end_of_children = first_child + num_children;
+  std::move(nodes.begin() + erased_child + 1, nodes.begin() + end_of_children,
+            nodes.begin() + erased_child);
+  if (end_of_children == nodes.size()) {
+    // The slot freed up at the end of the array can directly be reclaimed
+    nodes.pop_back();
+    --num_erased_nodes;
+  }
+  tree_->num_unused_nodes_ += num_erased_nodes;
+  node().child_mask &= ~(1u << child_index);
+}
+
+template <typename TreeType>
+void LinearNdtreeNodeRef<TreeType>::deleteChildrenArray() const {
+  // NOTE: Erasing the children from last to first avoids shifting the
+  //       remaining siblings.
+  for (int child_idx = kNumChildren - 1; 0 <= child_idx; --child_idx) {
+    eraseChild(child_idx);
+  }
+}
+
+template <typename TreeType>
+typename LinearNdtreeNodeRef<TreeType>::NodePtr
+LinearNdtreeNodeRef<TreeType>::getChild(
+    NdtreeIndexRelativeChild child_index) const {
+  if (!hasChild(child_index)) {
+    return {nullptr, 0u};
+  }
+  return {tree_, node().first_child + computeChildRank(child_index)};
+}
+
+template <typename TreeType>
+template <typename... DefaultArgs>
+LinearNdtreeNodeRef<TreeType> LinearNdtreeNodeRef<TreeType>::getOrAllocateChild(
+    NdtreeIndexRelativeChild child_index, DefaultArgs&&... args) const {
+  DCHECK_GE(child_index, 0);
+  DCHECK_LT(child_index, kNumChildren);
+  const uint32_t child_rank = computeChildRank(child_index);
+  if (hasChild(child_index)) {
+    return {tree_, node().first_child + child_rank};
+  }
+
+  // Allocate the child
+  auto& nodes = tree_->nodes_;
+  const uint32_t first_child = node().first_child;
+  const uint32_t num_children = bit_ops::popcount(uint32_t{node().child_mask});
+  const typename TreeType::Node new_child{
+      NodeDataType(std::forward<DefaultArgs>(args)...), 0u, 0u};
+  if (num_children == 0) {
+    // Start a new group of children at the end of the array
+    node().first_child = nodes.size();
+    nodes.emplace_back(new_child);
+  } else if (first_child + num_children == nodes.size()) {
+    // The children are at the end of the array, so the group can grow in-place
+    nodes.insert(nodes.begin() + first_child + child_rank, new_child);
+  } else {
+    // Move the group of children to the end of the array, to make space
+    // NOTE: We reserve the required capacity upfront, such that the existing
+    //       children remain valid while they are being copied.
+    nodes.reserve(nodes.size() + num_children + 1);
+    node().first_child = nodes.size();
+    for (uint32_t rank = 0; rank < num_children; ++rank) {
+      if (rank == child_rank) {
+        nodes.emplace_back(new_child);
+      }
+      nodes.emplace_back(nodes[first_child + rank]);
+    }
+    if (child_rank == num_children) {
+      nodes.emplace_back(new_child);
+    }
+    tree_->num_unused_nodes_ += num_children;
+  }
+  node().child_mask |= (1u << child_index);
+
+  return {tree_, node().first_child + child_rank};
+}
+
+template <typename TreeType>
+size_t LinearNdtreeNodeRef<TreeType>::getMemoryUsage() const {
+  return bit_ops::popcount(uint32_t{node().child_mask}) *
+         sizeof(typename TreeType::Node);
+}
+
+template <typename TreeType>
+uint32_t LinearNdtreeNodeRef<TreeType>::computeChildRank(
+    NdtreeIndexRelativeChild child_index) const {
+  const uint32_t preceding_children_mask =
+      node().child_mask & ((1u << child_index) - 1u);
+  return bit_ops::popcount(preceding_children_mask);
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_IMPL_LINEAR_NDTREE_NODE_ADDRESS_INL_H_
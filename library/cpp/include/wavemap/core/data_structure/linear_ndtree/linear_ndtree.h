@@ -0,0 +1,100 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_LINEAR_NDTREE_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_LINEAR_NDTREE_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/linear_ndtree/linear_ndtree_node_address.h"
+#include "wavemap/core/indexing/ndtree_index.h"
+
+namespace wavemap {
+/**
+ * Ndtree that stores all its nodes contiguously in a single array, instead of
+ * linking them through pointers. The children of each node are stored next to
+ * each other, and are located through the index of the first child and a
+ * bitmask indicating which children exist. This saves the memory of pointers
+ * to absent children and improves the cache locality of descents.
+ * Allocating or erasing children is done in-place where possible, but may
+ * move the other children of the same parent. Unused space is reclaimed by
+ * compacting the tree, which also reorders its nodes breadth-first.
+ * @note Allocating or erasing a child invalidates refs and ptrs to its
+ *       siblings, and compacting invalidates all refs and ptrs except those to
+ *       the root node.
+ */
+template <typename NodeDataT, int dim>
+class LinearNdtree {
+ public:
+  using IndexType = NdtreeIndex<dim>;
+  using HeightType = IndexElement;
+  using NodeRefType = LinearNdtreeNodeRef<LinearNdtree>;
+  using NodeConstRefType = LinearNdtreeNodeRef<const LinearNdtree>;
+  using NodePtrType = LinearNdtreeNodePtr<LinearNdtree>;
+  using NodeConstPtrType = LinearNdtreeNodePtr<const LinearNdtree>;
+  using NodeDataType = NodeDataT;
+  using NodeOffset = uint32_t;
+  using ChildMask = uint8_t;
+  static constexpr int kDim = dim;
+  static constexpr int kNumChildren = NdtreeIndex<dim>::kNumChildren;
+  static_assert(kNumChildren <= 8 * sizeof(ChildMask));
+
+  explicit LinearNdtree(HeightType max_height);
+  ~LinearNdtree() = default;
+
+  bool empty() const { return getRootNode().empty(); }
+  size_t size() const { return nodes_.size() - num_unused_nodes_; }
+  void clear();
+  void prune();
+
+  // Reclaim the space left behind by moved and erased nodes
+  void compact();
+  // Only compact if at least half of the allocated nodes are unused
+  void compactIfFragmented();
+  size_t getNumUnusedNodes() const { return num_unused_nodes_; }
+
+  HeightType getMaxHeight() const { return max_height_; }
+  // Heap memory used by the tree's nodes, excluding the tree object itself
+  size_t getMemoryUsage() const;
+
+  bool hasNode(const IndexType& index) const { return getNode(index); }
+  NodePtrType getNode(const IndexType& index);
+  NodeConstPtrType getNode(const IndexType& index) const;
+  template <typename... DefaultArgs>
+  NodeRefType getOrAllocateNode(const IndexType& index, DefaultArgs&&... args);
+
+  std::pair<NodePtrType, HeightType> getNodeOrAncestor(const IndexType& index);
+  std::pair<NodeConstPtrType, HeightType> getNodeOrAncestor(
+      const IndexType& index) const;
+
+  NodeRefType getRootNode() { return {*this, 0u}; }
+  NodeConstRefType getRootNode() const { return {*this, 0u}; }
+
+ private:
+  struct Node {
+    NodeDataT data{};
+    NodeOffset first_child = 0u;
+    ChildMask child_mask = 0u;
+  };
+
+  const HeightType max_height_;
+  std::vector<Node> nodes_;
+  size_t num_unused_nodes_ = 0u;
+
+  bool recursivePrune(NodeRefType node);  // NOLINT
+
+  template <typename T>
+  friend class LinearNdtreeNodeRef;
+};
+
+template <typename NodeDataT>
+using LinearBinaryTree = LinearNdtree<NodeDataT, 1>;
+template <typename NodeDataT>
+using LinearQuadtree = LinearNdtree<NodeDataT, 2>;
+template <typename NodeDataT>
+using LinearOctree = LinearNdtree<NodeDataT, 3>;
+}  // namespace wavemap
+
+#include "wavemap/core/data_structure/linear_ndtree/impl/linear_ndtree_inl.h"
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_LINEAR_NDTREE_H_
@@ -0,0 +1,116 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_LINEAR_NDTREE_NODE_ADDRESS_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_LINEAR_NDTREE_NODE_ADDRESS_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/data/comparisons.h"
+
+namespace wavemap {
+template <typename TreeType>
+class LinearNdtreeNodeRef;
+
+template <typename TreeType>
+class LinearNdtreeNodePtr {
+ public:
+  using NodeRef = LinearNdtreeNodeRef<TreeType>;
+
+  // Constructors
+  LinearNdtreeNodePtr() = default;
+  LinearNdtreeNodePtr(TreeType* tree, uint32_t node_offset);
+
+  // Copy/move constructors
+  LinearNdtreeNodePtr(const LinearNdtreeNodePtr& other) = default;
+  LinearNdtreeNodePtr(LinearNdtreeNodePtr&& other) noexcept = default;
+
+  // Copy/move assignment operators
+  LinearNdtreeNodePtr& operator=(const LinearNdtreeNodePtr& other);
+  LinearNdtreeNodePtr& operator=(LinearNdtreeNodePtr&& other) noexcept;
+
+  // Emulate pointer semantics
+  void reset() { node_.tree_ = nullptr; }
+  NodeRef operator*() const { return node_; }
+  NodeRef* operator->() { return std::addressof(node_); }
+  const NodeRef* operator->() const { return std::addressof(node_); }
+
+  // Emulate null check semantics
+  operator bool() const { return node_.tree_; }  // NOLINT
+  bool operator==(std::nullptr_t) noexcept { return !node_.tree_; }
+
+ private:
+  // NOTE: The pointer is null if the ref does not point to a tree
+  NodeRef node_{static_cast<TreeType*>(nullptr), 0u};
+};
+
+template <typename TreeType>
+class LinearNdtreeNodeRef {
+ public:
+  using NodeRef = LinearNdtreeNodeRef<TreeType>;
+  using NodePtr = LinearNdtreeNodePtr<TreeType>;
+
+  static constexpr int kDim = TreeType::kDim;
+  static constexpr int kNumChildren = NdtreeIndex<kDim>::kNumChildren;
+  using NodeDataType = typename TreeType::NodeDataType;
+
+  LinearNdtreeNodeRef() = delete;
+  LinearNdtreeNodeRef(TreeType& tree, uint32_t node_offset);
+
+  // Copy/move constructor
+  LinearNdtreeNodeRef(const LinearNdtreeNodeRef& other);
+  LinearNdtreeNodeRef(LinearNdtreeNodeRef&& other) noexcept;
+
+  // Copy/move assignment operators are deleted (to behave like a ref)
+  LinearNdtreeNodeRef& operator=(const LinearNdtreeNodeRef&) = delete;
+  LinearNdtreeNodeRef& operator=(LinearNdtreeNodeRef&&) = delete;
+
+  // Conversion of non-const ref to const ref
+  operator LinearNdtreeNodeRef<const TreeType>() const;  // NOLINT
+
+  // Conversion to pointer
+  NodePtr operator&() const;  // NOLINT
+
+  // Regular node methods
+  bool empty() const;
+
+  bool hasNonzeroData() const;
+  bool hasNonzeroData(FloatingPoint threshold) const;
+  auto& data() const;
+
+  bool hasAtLeastOneChild() const;
+  // Linear nodes have no separate children array, so these methods consider
+  // the node's existing children instead
+  bool hasChildrenArray() const { return hasAtLeastOneChild(); }
+  void deleteChildrenArray() const;
+
+  bool hasChild(NdtreeIndexRelativeChild child_index) const;
+  void eraseChild(NdtreeIndexRelativeChild child_index) const;
+
+  NodePtr getChild(NdtreeIndexRelativeChild child_index) const;
+  template <typename... DefaultArgs>
+  NodeRef getOrAllocateChild(NdtreeIndexRelativeChild child_index,
+                             DefaultArgs&&... args) const;
+
+  // Memory used by the node's children, excluding their descendants
+  size_t getMemoryUsage() const;
+
+ private:
+  TreeType* tree_;
+  uint32_t node_offset_ = 0u;
+
+  // Constructor for null refs, which only exist inside null ptrs
+  LinearNdtreeNodeRef(TreeType* tree, uint32_t node_offset)
+      : tree_(tree), node_offset_(node_offset) {}
+
+  auto& node() const { return tree_->nodes_[node_offset_]; }
+  uint32_t computeChildRank(NdtreeIndexRelativeChild child_index) const;
+
+  template <typename T>
+  friend class LinearNdtreeNodePtr;
+};
+}  // namespace wavemap
+
+#include "wavemap/core/data_structure/linear_ndtree/impl/linear_ndtree_node_address_inl.h"
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_LINEAR_NDTREE_LINEAR_NDTREE_NODE_ADDRESS_H_
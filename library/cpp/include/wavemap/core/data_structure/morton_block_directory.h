@@ -0,0 +1,81 @@
+#ifndef WAVEMAP_CORE_DATA_STRUCTURE_MORTON_BLOCK_DIRECTORY_H_
+#define WAVEMAP_CORE_DATA_STRUCTURE_MORTON_BLOCK_DIRECTORY_H_
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/bits/morton_encoding.h"
+#include "wavemap/core/utils/math/int_math.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
+
+namespace wavemap {
+// Directory of the blocks of a spatial hash, sorted along the Morton
+// space-filling curve. Iterating over the blocks in this order visits blocks
+// that are close in space in close succession, which improves cache locality
+// for operations that also access each block's neighbors.
+// Each entry additionally links to the entries in its 3^dim neighborhood,
+// such that neighboring blocks can be resolved, and neighborhoods walked,
+// without hashing.
+// NOTE: The directory only stores pointers to the blocks, which must remain
+//       valid until the blocks are erased from the directory.
+template <typename BlockDataT, int dim>
+class MortonBlockDirectory {
+ public:
+  // Number of blocks in a block's neighborhood, including the block itself
+  static constexpr int kNeighborhoodSize = int_math::pow(3, dim);
+  static constexpr int kSelfNeighborIdx = (kNeighborhoodSize - 1) / 2;
+
+  struct Entry {
+    Index<dim> block_index;
+    BlockDataT* block = nullptr;
+    // Entries of the blocks in the neighborhood, or nullptr if a neighboring
+    // block does not exist. Indexed with neighborOffsetToIdx(offset).
+    std::array<const Entry*, kNeighborhoodSize> neighbors{};
+
+    const Entry* getNeighbor(const Index<dim>& offset) const {
+      return neighbors[neighborOffsetToIdx(offset)];
+    }
+  };
+
+  bool empty() const { return entries_.empty(); }
+  size_t size() const { return entries_.size(); }
+  void clear() { entries_.clear(); }
+  // Heap memory used by the entries, excluding the directory object itself
+  size_t getMemoryUsage() const { return memory::getHeapUsage(entries_); }
+
+  void insert(const Index<dim>& block_index, BlockDataT* block);
+  bool erase(const Index<dim>& block_index);
+
+  const Entry* getEntry(const Index<dim>& block_index) const;
+
+  // Visit all entries in Morton order
+  template <typename EntryVisitor>
+  void forEachEntry(EntryVisitor visitor_fn) const;
+
+  // Map offsets in {-1, 0, 1}^dim to indices in [0, kNeighborhoodSize)
+  static int neighborOffsetToIdx(const Index<dim>& offset);
+  static Index<dim> neighborIdxToOffset(int neighbor_idx);
+
+  // Morton code whose order matches the order of the block indices along the
+  // Z-curve, including for negative indices
+  static MortonIndex blockIndexToMorton(const Index<dim>& block_index);
+  static bool isInRange(const Index<dim>& block_index);
+
+ private:
+  // Sign bit of the coordinates within the range supported by the encoding
+  static constexpr int kSignBit =
+      std::min(morton::kMaxTreeHeight<dim>, 8 * int{sizeof(IndexElement)}) - 1;
+  static constexpr int64_t kMinCoordinate = -(int64_t{1} << kSignBit);
+  static constexpr int64_t kMaxCoordinate = (int64_t{1} << kSignBit) - 1;
+
+  std::map<MortonIndex, Entry> entries_;
+
+  Entry* findEntry(const Index<dim>& block_index);
+};
+}  // namespace wavemap
+
+#include "wavemap/core/data_structure/impl/morton_block_directory_inl.h"
+
+#endif  // WAVEMAP_CORE_DATA_STRUCTURE_MORTON_BLOCK_DIRECTORY_H_
@@ -5,8 +5,24 @@
 #include <utility>
 
 #include "wavemap/core/utils/data/comparisons.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
 
 namespace wavemap {
+template <typename DataT, int dim>
+NdtreeNode<DataT, dim>::NdtreeNode(const NdtreeNode& other)
+    : data_(other.data_) {
+  if (!other.hasChildrenArray()) {
+    return;
+  }
+  children_ = std::make_unique<ChildrenArray>();
+  for (NdtreeIndexRelativeChild child_idx = 0; child_idx < kNumChildren;
+       ++child_idx) {
+    if (const NdtreeNode* child = other.getChild(child_idx); child) {
+      children_->operator[](child_idx) = std::make_unique<NdtreeNode>(*child);
+    }
+  }
+}
+
 template <typename DataT, int dim>
 bool NdtreeNode<DataT, dim>::empty() const {
   return !hasChildrenArray() && !hasNonzeroData();
@@ -20,9 +36,14 @@ void NdtreeNode<DataT, dim>::clear() {
 
 template <typename DataT, int dim>
 size_t NdtreeNode<DataT, dim>::getMemoryUsage() const {
-  size_t memory_usage = sizeof(NdtreeNode<DataT, dim>);
-  if (hasChildrenArray()) {
-    memory_usage += sizeof(ChildrenArray);
+  if (!hasChildrenArray()) {
+    return 0u;
+  }
+  size_t memory_usage = memory::getAllocationSize(sizeof(ChildrenArray));
+  for (const auto& child : *children_) {
+    if (child) {
+      memory_usage += memory::getAllocationSize(sizeof(NdtreeNode));
+    }
   }
   return memory_usage;
 }
@@ -34,6 +34,7 @@ class Ndtree {
   void prune();
 
   HeightType getMaxHeight() const { return max_height_; }
+  // Heap memory used by the tree's nodes, excluding the tree object itself
   size_t getMemoryUsage() const;
 
   bool hasNode(const IndexType& index) const { return getNode(index); }
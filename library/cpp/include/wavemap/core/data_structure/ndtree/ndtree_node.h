@@ -18,11 +18,18 @@ class NdtreeNode {
   NdtreeNode() = default;
   template <typename... Args>
   explicit NdtreeNode(Args&&... args) : data_(std::forward<Args>(args)...) {}
+  // Deep copy, including all of the node's descendants
+  // NOTE: Make sure to copy from a const reference, as the variadic
+  //       constructor above is otherwise a better match.
+  NdtreeNode(const NdtreeNode& other);
+  NdtreeNode(NdtreeNode&& other) noexcept = default;
   ~NdtreeNode() = default;
 
   bool empty() const;
   void clear();
 
+  // Heap memory owned directly by the node, namely its children array and the
+  // storage of its children, but not that of their own descendants
   size_t getMemoryUsage() const;
 
   bool hasNonzeroData() const;
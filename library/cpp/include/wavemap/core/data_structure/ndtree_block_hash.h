@@ -8,14 +8,14 @@
 #include "wavemap/core/utils/math/int_math.h"
 
 namespace wavemap {
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT = UnorderedMapBackend>
 class NdtreeBlockHash {
  public:
   static constexpr IndexElement kDim = dim;
 
   using Block = Ndtree<CellDataT, dim>;
   using Node = typename Block::NodeType;
-  using BlockHashMap = SpatialHash<Block, dim>;
+  using BlockHashMap = SpatialHash<Block, dim, BackendT>;
 
   using IndexType = NdtreeIndex<dim>;
   using HeightType = IndexElement;
@@ -75,6 +75,14 @@ class NdtreeBlockHash {
   auto& getHashMap() { return block_map_.getHashMap(); }
   const auto& getHashMap() const { return block_map_.getHashMap(); }
 
+  // Sort the blocks along the Morton curve and link them to their neighbors,
+  // see SpatialHash::enableBlockDirectory()
+  void enableBlockDirectory() { block_map_.enableBlockDirectory(); }
+  void disableBlockDirectory() { block_map_.disableBlockDirectory(); }
+  const auto* getBlockDirectory() const {
+    return block_map_.getBlockDirectory();
+  }
+
   template <typename IndexedBlockVisitor>
   void forEachBlock(IndexedBlockVisitor visitor_fn);
   template <typename IndexedBlockVisitor>
@@ -96,12 +104,12 @@ class NdtreeBlockHash {
   BlockHashMap block_map_;
 };
 
-template <typename CellDataT>
-using BinaryTreeBlockHash = NdtreeBlockHash<CellDataT, 1>;
-template <typename CellDataT>
-using QuadtreeBlockHash = NdtreeBlockHash<CellDataT, 2>;
-template <typename CellDataT>
-using OctreeBlockHash = NdtreeBlockHash<CellDataT, 3>;
+template <typename CellDataT, typename BackendT = UnorderedMapBackend>
+using BinaryTreeBlockHash = NdtreeBlockHash<CellDataT, 1, BackendT>;
+template <typename CellDataT, typename BackendT = UnorderedMapBackend>
+using QuadtreeBlockHash = NdtreeBlockHash<CellDataT, 2, BackendT>;
+template <typename CellDataT, typename BackendT = UnorderedMapBackend>
+using OctreeBlockHash = NdtreeBlockHash<CellDataT, 3, BackendT>;
 }  // namespace wavemap
 
 #include "wavemap/core/data_structure/impl/ndtree_block_hash_inl.h"
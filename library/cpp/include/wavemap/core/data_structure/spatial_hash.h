@@ -1,31 +1,67 @@
 #ifndef WAVEMAP_CORE_DATA_STRUCTURE_SPATIAL_HASH_H_
 #define WAVEMAP_CORE_DATA_STRUCTURE_SPATIAL_HASH_H_
 
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 #include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/flat_hash_map.h"
+#include "wavemap/core/data_structure/morton_block_directory.h"
 #include "wavemap/core/indexing/index_conversions.h"
 #include "wavemap/core/indexing/index_hashes.h"
 #include "wavemap/core/utils/math/int_math.h"
+#include "wavemap/core/utils/profile/memory_usage.h"
+#include "wavemap/core/utils/shape/aabb.h"
 
 namespace wavemap {
 namespace convert {
 template <int dim>
 Index<dim> indexToBlockIndex(const Index<dim>& index,
                              IndexElement cells_per_block_side_log_2);
+
+// Inclusive range of block indices that covers all blocks overlapping the AABB
+template <int dim>
+std::pair<Index<dim>, Index<dim>> aabbToBlockIndexRange(
+    const AABB<Point<dim>>& aabb, FloatingPoint block_width_inv);
 }  // namespace convert
 
-template <typename BlockDataT, int dim>
+// Hash map implementations that spatial hashes can store their blocks in
+struct UnorderedMapBackend {
+  template <typename BlockDataT, int dim>
+  using HashMap = std::unordered_map<Index<dim>, BlockDataT, IndexHash<dim>>;
+};
+// Open addressing hash map, whose lookups are more cache friendly. Preferable
+// for maps that are queried often and whose blocks are rarely erased.
+struct FlatHashMapBackend {
+  template <typename BlockDataT, int dim>
+  using HashMap = FlatHashMap<Index<dim>, BlockDataT, MixingIndexHash<dim>>;
+};
+
+template <typename BlockDataT, int dim, typename BackendT = UnorderedMapBackend>
 class SpatialHash {
  public:
   static constexpr IndexElement kDim = dim;
 
   using BlockIndex = Index<dim>;
   using BlockData = BlockDataT;
+  using HashMap = typename BackendT::template HashMap<BlockDataT, dim>;
+  using BlockDirectory = MortonBlockDirectory<BlockDataT, dim>;
+
+  SpatialHash() = default;
+  SpatialHash(const SpatialHash& other);
+  SpatialHash(SpatialHash&& other) = default;
+  SpatialHash& operator=(const SpatialHash& other);
+  SpatialHash& operator=(SpatialHash&& other) = default;
+  ~SpatialHash() = default;
 
   bool empty() const { return block_map_.empty(); }
   size_t size() const { return block_map_.size(); }
-  void clear() { block_map_.clear(); }
+  void clear();
+
+  // Memory used by the hash map and block directory, including the storage of
+  // the blocks themselves but not the memory they own indirectly
+  size_t getMemoryUsage() const;
 
   Index<dim> getMinBlockIndex() const;
   Index<dim> getMaxBlockIndex() const;
@@ -41,16 +77,44 @@ class SpatialHash {
   BlockData& getOrAllocateBlock(const BlockIndex& block_index,
                                 DefaultArgs&&... args);
 
+  // NOTE: Blocks inserted or erased directly through the hash map are not
+  //       reflected in the block directory.
   auto& getHashMap() { return block_map_; }
   const auto& getHashMap() const { return block_map_; }
 
+  // Maintain a directory that sorts the blocks along the Morton curve and
+  // links each block to its neighbors, see MortonBlockDirectory. While it is
+  // enabled, forEachBlock(...) visits the blocks in Morton order.
+  // NOTE: Enabling the directory makes allocating and erasing blocks, as well
+  //       as copying the hash, more expensive. It therefore pays off for maps
+  //       that are mostly traversed or queried, rather than grown.
+  void enableBlockDirectory();
+  void disableBlockDirectory() { block_directory_.reset(); }
+  const BlockDirectory* getBlockDirectory() const {
+    return block_directory_.get();
+  }
+
   template <typename IndexedBlockVisitor>
   void forEachBlock(IndexedBlockVisitor visitor_fn);
   template <typename IndexedBlockVisitor>
   void forEachBlock(IndexedBlockVisitor visitor_fn) const;
+  // Visit all blocks whose index lies in the given inclusive range. The
+  // iteration stops early if the visitor returns false.
+  // NOTE: If the range contains fewer indices than the map contains blocks,
+  //       the blocks are looked up individually. The cost therefore scales
+  //       with the size of the range, not of the map, for local queries.
+  template <typename IndexedBlockVisitor>
+  void forEachBlockInRange(const BlockIndex& min_block_index,
+                           const BlockIndex& max_block_index,
+                           IndexedBlockVisitor visitor_fn) const;
 
  private:
-  std::unordered_map<Index<dim>, BlockDataT, IndexHash<dim>> block_map_;
+  HashMap block_map_;
+  std::unique_ptr<BlockDirectory> block_directory_;
+
+  // Replace the hash map with a new one, since clearing it or erasing all of
+  // its elements would keep its bucket array allocated
+  void releaseHashMap() { block_map_ = HashMap{}; }
 };
 }  // namespace wavemap
 
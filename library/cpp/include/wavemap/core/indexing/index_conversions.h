@@ -4,9 +4,11 @@
 #include <algorithm>
 #include <limits>
 #include <numeric>
+#include <vector>
 
 #include "wavemap/core/common.h"
 #include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
 #include "wavemap/core/utils/bits/morton_encoding.h"
 #include "wavemap/core/utils/data/eigen_checks.h"
 #include "wavemap/core/utils/math/int_math.h"
@@ -194,6 +196,32 @@ inline MortonIndex nodeIndexToMorton(const NdtreeIndex<dim>& node_index) {
   return convert::indexToMorton(node_index.position)
          << (node_index.height * dim);
 }
+
+// Batch versions of the conversions above, which use the fastest Morton codec
+// supported by the CPU the program is running on
+inline std::vector<MortonIndex> indicesToMorton(
+    const std::vector<Index3D>& indices) {
+  return morton::encode_batch(indices);
+}
+
+inline std::vector<Index3D> mortonToIndices(
+    const std::vector<MortonIndex>& morton_codes) {
+  return morton::decode_batch(morton_codes);
+}
+
+inline std::vector<MortonIndex> nodeIndicesToMorton(
+    const std::vector<OctreeIndex>& node_indices) {
+  std::vector<Index3D> positions;
+  positions.reserve(node_indices.size());
+  for (const OctreeIndex& node_index : node_indices) {
+    positions.emplace_back(node_index.position);
+  }
+  std::vector<MortonIndex> morton_codes = indicesToMorton(positions);
+  for (size_t idx = 0; idx < node_indices.size(); ++idx) {
+    morton_codes[idx] <<= node_indices[idx].height * OctreeIndex::kDim;
+  }
+  return morton_codes;
+}
 }  // namespace wavemap::convert
 
 #endif  // WAVEMAP_CORE_INDEXING_INDEX_CONVERSIONS_H_
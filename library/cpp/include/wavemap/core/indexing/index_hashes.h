@@ -1,6 +1,7 @@
 #ifndef WAVEMAP_CORE_INDEXING_INDEX_HASHES_H_
 #define WAVEMAP_CORE_INDEXING_INDEX_HASHES_H_
 
+#include <cstdint>
 #include <numeric>
 
 #include "wavemap/core/common.h"
@@ -20,6 +21,34 @@ struct IndexHash {
 using Index2DHash = IndexHash<2>;
 using Index3DHash = IndexHash<3>;
 
+// Hash that mixes all bits of the index into all bits of the hash. Unlike
+// IndexHash, whose low bits are heavily correlated for nearby indices, it is
+// suitable for open addressing hash maps that select slots using the low bits.
+template <int dim>
+struct MixingIndexHash {
+  static constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+
+  size_t operator()(const Index<dim>& index) const {
+    uint64_t hash = 0u;
+    for (int dim_idx = 0; dim_idx < dim; ++dim_idx) {
+      hash = (hash ^ static_cast<uint32_t>(index[dim_idx])) * kMultiplier;
+    }
+    return static_cast<size_t>(finalize(hash));
+  }
+
+  // Avalanche the bits using the 64-bit finalizer of MurmurHash3
+  static constexpr uint64_t finalize(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+  }
+};
+using MixingIndex2DHash = MixingIndexHash<2>;
+using MixingIndex3DHash = MixingIndexHash<3>;
+
 template <int dim>
 struct NdtreeIndexHash {
   static constexpr auto coefficients =
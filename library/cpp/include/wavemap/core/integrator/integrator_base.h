@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "wavemap/core/common.h"
 #include "wavemap/core/config/config_base.h"
@@ -39,6 +40,26 @@ class IntegratorBase {
   virtual void integrate(const PosedPointcloud<>& pointcloud) = 0;
   virtual void integrate(const PosedImage<>& range_image) = 0;
 
+  // Methods to fuse the measurements of several integrators into a single map
+  // update, such that each affected block is only traversed once
+  // NOTE: Integrators that support fused integration return a fusion group,
+  //       and integrators can only be fused with others of the same group.
+  //       Their measurements are first loaded with importMeasurement(...),
+  //       after which updateMapFused(...) applies all of them at once. All
+  //       other integrators return nullptr and can only be updated through
+  //       integrate(...), even if they implement importMeasurement(...) as
+  //       all ProjectiveIntegrators do.
+  virtual const void* getFusionGroup() const { return nullptr; }
+  virtual size_t getMaxNumFusedMeasurements() const { return 1; }
+  virtual bool importMeasurement(const PosedPointcloud<>& /*pointcloud*/) {
+    return false;
+  }
+  virtual bool importMeasurement(const PosedImage<>& /*range_image*/) {
+    return false;
+  }
+  virtual void updateMapFused(
+      const std::vector<IntegratorBase*>& /*integrators*/) {}
+
  protected:
   static bool isPoseValid(const Transformation3D& T_W_C);
   static bool isMeasurementValid(const Point3D& C_end_point);
@@ -1,6 +1,7 @@
 #ifndef WAVEMAP_CORE_INTEGRATOR_PROJECTIVE_COARSE_TO_FINE_HASHED_WAVELET_INTEGRATOR_H_
 #define WAVEMAP_CORE_INTEGRATOR_PROJECTIVE_COARSE_TO_FINE_HASHED_WAVELET_INTEGRATOR_H_
 
+#include <bitset>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -8,19 +9,29 @@
 #include "wavemap/core/integrator/projective/coarse_to_fine/range_image_intersector.h"
 #include "wavemap/core/integrator/projective/projective_integrator.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
 #include "wavemap/core/utils/thread_pool.h"
 
 namespace wavemap {
-class HashedWaveletIntegrator : public ProjectiveIntegrator {
+/**
+ * Coarse-to-fine integrator for BasicHashedWaveletOctree maps, which works
+ * with any of their block types. Blocks whose coefficients are stored in
+ * compressed form, such as those of the QuantizedHashedWaveletOctree, are
+ * restored to full precision before they are updated.
+ */
+template <typename MapT>
+class BasicHashedWaveletIntegrator : public ProjectiveIntegrator {
  public:
-  HashedWaveletIntegrator(const ProjectiveIntegratorConfig& config,
-                          ProjectorBase::ConstPtr projection_model,
-                          PosedImage<>::Ptr posed_range_image,
-                          Image<Vector2D>::Ptr beam_offset_image,
-                          MeasurementModelBase::ConstPtr measurement_model,
-                          HashedWaveletOctree::Ptr occupancy_map,
-                          std::shared_ptr<ThreadPool> thread_pool = nullptr)
+  BasicHashedWaveletIntegrator(
+      const ProjectiveIntegratorConfig& config,
+      ProjectorBase::ConstPtr projection_model,
+      PosedImage<>::Ptr posed_range_image,
+      Image<Vector2D>::Ptr beam_offset_image,
+      MeasurementModelBase::ConstPtr measurement_model,
+      typename MapT::Ptr occupancy_map,
+      std::shared_ptr<ThreadPool> thread_pool = nullptr)
       : ProjectiveIntegrator(
             config, std::move(projection_model), std::move(posed_range_image),
             std::move(beam_offset_image), std::move(measurement_model)),
@@ -28,11 +39,33 @@ class HashedWaveletIntegrator : public ProjectiveIntegrator {
         thread_pool_(thread_pool ? std::move(thread_pool)
                                  : std::make_shared<ThreadPool>()) {}
 
+  //! Maximum number of measurements that can be fused in a single map update
+  static constexpr size_t kMaxNumFusedMeasurements = 32;
+
+  //! Hashed wavelet integrators that update the same map can be fused
+  const void* getFusionGroup() const override { return occupancy_map_.get(); }
+  size_t getMaxNumFusedMeasurements() const override {
+    return kMaxNumFusedMeasurements;
+  }
+  //! Update the map with the measurements that were loaded into each of the
+  //! given integrators through importMeasurement(...), such that every
+  //! affected block is only decompressed, traversed and recompressed once.
+  //! NOTE: The updates of all measurements that reach a given node are summed
+  //!       before the result is clamped. Close to the log-odds bounds, the
+  //!       result can therefore differ slightly from sequential integration.
+  //!       Which blocks each measurement updates is decided based on the map
+  //!       as it was before the batch. Integrators with an integration time
+  //!       budget adapt to the time taken by the batch as a whole.
+  void updateMapFused(const std::vector<IntegratorBase*>& integrators) override;
+
  private:
-  using BlockList = std::vector<HashedWaveletOctree::BlockIndex>;
-  using OctreeType = HashedWaveletOctreeBlock::OctreeType;
+  using Block = typename MapT::Block;
+  using BlockIndex = typename MapT::BlockIndex;
+  using BlockList = std::vector<BlockIndex>;
+  using OctreeType = typename Block::OctreeType;
+  using MeasurementMask = std::bitset<kMaxNumFusedMeasurements>;
 
-  const HashedWaveletOctree::Ptr occupancy_map_;
+  const typename MapT::Ptr occupancy_map_;
   const std::shared_ptr<ThreadPool> thread_pool_;
   std::shared_ptr<RangeImageIntersector> range_image_intersector_;
 
@@ -57,10 +90,42 @@ class HashedWaveletIntegrator : public ProjectiveIntegrator {
   void recursiveTester(const OctreeIndex& node_index,
                        BlockList& update_job_list);
 
+  void updateRangeImageIntersector();
+  void selectBlocksToUpdate(BlockList& blocks_to_update);
+
   void updateMap() override;
-  void updateBlock(HashedWaveletOctree::Block& block,
-                   const HashedWaveletOctree::BlockIndex& block_index);
+  void updateBlock(Block& block, const BlockIndex& block_index);
+
+  static void updateMapFused(
+      const std::vector<BasicHashedWaveletIntegrator*>& integrators);
+  static void updateBlockFused(
+      const std::vector<BasicHashedWaveletIntegrator*>& integrators,
+      const MeasurementMask& block_measurements, Block& block,
+      const BlockIndex& block_index);
+
+  // Traverse the block coarse-to-fine, calling the node updater on each node
+  // that is reached with the measurements that are still active at that node.
+  // The updater applies the measurements that can be terminated to the node's
+  // value, and returns the ones that need to be refined further. The node's
+  // children are only visited if at least one measurement remains.
+  // NOTE: The traversal is multiversioned, and the node updaters are inlined
+  //       into each of its variants.
+  template <typename NodeUpdaterT>
+  static void traverseBlock(Block& block, const OctreeIndex& block_node_index,
+                            const MeasurementMask& block_measurements,
+                            NodeUpdaterT&& node_updater);
+  // Apply a measurement update to a node that is not refined further, while
+  // keeping the value within the log-odds bounds if the node is a leaf
+  void applyUpdate(FloatingPoint update, bool node_has_children,
+                   FloatingPoint& node_value, Block& block) const;
 };
+
+using HashedWaveletIntegrator =
+    BasicHashedWaveletIntegrator<HashedWaveletOctree>;
+using LinearHashedWaveletIntegrator =
+    BasicHashedWaveletIntegrator<LinearHashedWaveletOctree>;
+using QuantizedHashedWaveletIntegrator =
+    BasicHashedWaveletIntegrator<QuantizedHashedWaveletOctree>;
 }  // namespace wavemap
 
 #include "wavemap/core/integrator/projective/coarse_to_fine/impl/hashed_wavelet_integrator_inl.h"
@@ -1,12 +1,16 @@
 #ifndef WAVEMAP_CORE_INTEGRATOR_PROJECTIVE_COARSE_TO_FINE_IMPL_HASHED_WAVELET_INTEGRATOR_INL_H_
 #define WAVEMAP_CORE_INTEGRATOR_PROJECTIVE_COARSE_TO_FINE_IMPL_HASHED_WAVELET_INTEGRATOR_INL_H_
 
+#include <algorithm>
+#include <stack>
 #include <utility>
 
+#include "wavemap/core/utils/cpu/dispatch.h"
+
 namespace wavemap {
-inline void HashedWaveletIntegrator::recursiveTester(  // NOLINT
-    const OctreeIndex& node_index,
-    HashedWaveletIntegrator::BlockList& update_job_list) {
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::recursiveTester(  // NOLINT
+    const OctreeIndex& node_index, BlockList& update_job_list) {
   const AABB<Point3D> block_aabb =
       convert::nodeIndexToAABB(node_index, min_cell_width_);
   const UpdateType update_type = range_image_intersector_->determineUpdateType(
@@ -36,6 +40,100 @@ inline void HashedWaveletIntegrator::recursiveTester(  // NOLINT
     recursiveTester(child_index, update_job_list);
   }
 }
+
+template <typename MapT>
+template <typename NodeUpdaterT>
+WAVEMAP_MULTIVERSIONED void BasicHashedWaveletIntegrator<MapT>::traverseBlock(
+    Block& block, const OctreeIndex& block_node_index,
+    const MeasurementMask& block_measurements, NodeUpdaterT&& node_updater) {
+  block.setNeedsPruning();
+  block.setLastUpdatedStamp();
+
+  struct StackElement {
+    typename OctreeType::NodeRefType parent_node;
+    const OctreeIndex parent_node_index;
+    NdtreeIndexRelativeChild next_child_idx;
+    typename Block::Coefficients::CoefficientsArray child_scale_coefficients;
+    // Measurements that still need to be refined below the parent node
+    const MeasurementMask active_measurements;
+  };
+  std::stack<StackElement> stack;
+
+  typename OctreeType::NodeRefType root_node = block.getRootNode();
+  typename Block::Coefficients::Scale& root_node_scale = block.getRootScale();
+  stack.emplace(StackElement{
+      root_node, block_node_index, 0,
+      Block::Transform::backward({root_node_scale, root_node.data()}),
+      block_measurements});
+
+  while (!stack.empty()) {
+    // If the current stack element has fully been processed, propagate upward
+    if (OctreeIndex::kNumChildren <= stack.top().next_child_idx) {
+      const auto [scale, details] =
+          Block::Transform::forward(stack.top().child_scale_coefficients);
+      stack.top().parent_node.data() = details;
+      stack.pop();
+      if (stack.empty()) {
+        root_node_scale = scale;
+        return;
+      } else {
+        const NdtreeIndexRelativeChild current_child_idx =
+            stack.top().next_child_idx - 1;
+        stack.top().child_scale_coefficients[current_child_idx] = scale;
+        continue;
+      }
+    }
+
+    // Evaluate stack element's active child
+    const NdtreeIndexRelativeChild current_child_idx =
+        stack.top().next_child_idx;
+    ++stack.top().next_child_idx;
+    DCHECK_GE(current_child_idx, 0);
+    DCHECK_LT(current_child_idx, OctreeIndex::kNumChildren);
+
+    typename OctreeType::NodeRefType parent_node = stack.top().parent_node;
+    FloatingPoint& node_value =
+        stack.top().child_scale_coefficients[current_child_idx];
+    const OctreeIndex node_index =
+        stack.top().parent_node_index.computeChildIndex(current_child_idx);
+    DCHECK_GE(node_index.height, 0);
+
+    // Update the node, and find the measurements that need to be refined
+    typename OctreeType::NodePtrType node =
+        parent_node.getChild(current_child_idx);
+    const bool node_has_children = node && node->hasAtLeastOneChild();
+    const MeasurementMask measurements_to_refine =
+        node_updater(node_index, node_has_children, node_value,
+                     stack.top().active_measurements);
+    if (measurements_to_refine.none()) {
+      continue;
+    }
+
+    // Since the approximation error would still be too big, refine
+    if (!node) {
+      // Allocate the current node if it has not yet been allocated
+      node = &parent_node.getOrAllocateChild(current_child_idx);
+    }
+    stack.emplace(StackElement{
+        *node, node_index, 0,
+        Block::Transform::backward({node_value, node->data()}),
+        measurements_to_refine});
+  }
+}
+
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::applyUpdate(
+    FloatingPoint update, bool node_has_children, FloatingPoint& node_value,
+    Block& block) const {
+  if (!node_has_children) {
+    node_value =
+        std::clamp(update + node_value, min_log_odds_ - kNoiseThreshold,
+                   max_log_odds_ + kNoiseThreshold);
+  } else if (update != 0.f) {
+    node_value += update;
+    block.setNeedsThresholding();
+  }
+}
 }  // namespace wavemap
 
 #endif  // WAVEMAP_CORE_INTEGRATOR_PROJECTIVE_COARSE_TO_FINE_IMPL_HASHED_WAVELET_INTEGRATOR_INL_H_
@@ -11,7 +11,7 @@ inline FloatingPoint WaveletIntegrator::recursiveSamplerCompressor(  // NOLINT
   constexpr FloatingPoint kNoiseThreshold = 1e-4f;
 
   // If we're at the leaf level, directly update the node
-  if (node_index.height <= termination_height_) {
+  if (node_index.height <= termination_height_ + coarsening_level_) {
     const Point3D W_node_center =
         convert::nodeIndexToCenterPoint(node_index, min_cell_width_);
     const Point3D C_node_center =
@@ -58,7 +58,7 @@ inline FloatingPoint WaveletIntegrator::recursiveSamplerCompressor(  // NOLINT
   WaveletOctree::NodeType* node = parent_node.getChild(relative_child_index);
   if (measurement_model_->computeWorstCaseApproximationError(
           update_type, d_C_cell, bounding_sphere_radius) <
-      config_.termination_update_error) {
+      getTerminationUpdateError()) {
     const FloatingPoint sample = computeUpdate(C_node_center);
     if (!node || !node->hasAtLeastOneChild()) {
       return std::clamp(sample + node_value,
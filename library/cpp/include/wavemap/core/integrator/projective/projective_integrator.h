@@ -10,12 +10,13 @@
 #include "wavemap/core/integrator/measurement_model/measurement_model_base.h"
 #include "wavemap/core/integrator/projection_model/projector_base.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/math/int_math.h"
 
 namespace wavemap {
 /**
  * Config struct for projective integrators.
  */
-struct ProjectiveIntegratorConfig : ConfigBase<ProjectiveIntegratorConfig, 4> {
+struct ProjectiveIntegratorConfig : ConfigBase<ProjectiveIntegratorConfig, 6> {
   //! Minimum range measurements should have to be considered.
   //! Measurements below this threshold are ignored.
   Meters<FloatingPoint> min_range = 0.5f;
@@ -34,6 +35,16 @@ struct ProjectiveIntegratorConfig : ConfigBase<ProjectiveIntegratorConfig, 4> {
   //! please refer to: https://www.roboticsproceedings.org/rss19/p065.pdf.
   FloatingPoint termination_update_error = 0.1f;
 
+  //! Time budget for integrating a single measurement. When integration takes
+  //! longer, the termination update error and maximum update resolution are
+  //! progressively coarsened, and refined again once integration catches up.
+  //! Set to zero to disable.
+  Seconds<FloatingPoint> integration_time_budget = 0.f;
+  //! Maximum number of coarsening steps that can be taken to stay within the
+  //! integration time budget. Each step doubles the termination update error
+  //! and halves the maximum update resolution.
+  IndexElement max_num_coarsening_steps = 3;
+
   static MemberMap memberMap;
 
   // Constructors
@@ -64,6 +75,11 @@ class ProjectiveIntegrator : public IntegratorBase {
   void integrate(const PosedPointcloud<>& pointcloud) override;
   void integrate(const PosedImage<>& range_image) override;
 
+  // Methods to load a measurement into the integrator's range image without
+  // updating the map, returning false if the measurement was rejected
+  bool importMeasurement(const PosedPointcloud<>& pointcloud) override;
+  bool importMeasurement(const PosedImage<>& range_image) override;
+
   // Accessors for debugging and visualization
   // NOTE: These accessors are for introspection only, not for modifying the
   //       internal state. They therefore only expose const references or
@@ -80,6 +96,9 @@ class ProjectiveIntegrator : public IntegratorBase {
   Image<Vector2D>::ConstPtr getBeamOffsetImage() const {
     return beam_offset_image_;
   }
+  //! Number of coarsening steps currently taken to stay within the
+  //! integration time budget
+  IndexElement getCoarseningLevel() const { return coarsening_level_; }
 
  protected:
   const ProjectiveIntegratorConfig config_;
@@ -90,9 +109,22 @@ class ProjectiveIntegrator : public IntegratorBase {
 
   const MeasurementModelBase::ConstPtr measurement_model_;
 
+  IndexElement coarsening_level_ = 0;
+  FloatingPoint getTerminationUpdateError() const {
+    return config_.termination_update_error *
+           static_cast<FloatingPoint>(int_math::exp2(coarsening_level_));
+  }
+  void adaptToIntegrationTime(FloatingPoint integration_time);
+
   virtual void importPointcloud(const PosedPointcloud<>& pointcloud);
   virtual void importRangeImage(const PosedImage<>& range_image_input);
+  // Project the points into the range and beam offset images, keeping the
+  // closest point per pixel
+  // NOTE: This loop is split out of importPointcloud() since virtual methods
+  //       cannot be multiversioned.
+  void projectPointcloud(const PosedPointcloud<>& pointcloud);
 
+  void updateMapWithinBudget();
   virtual void updateMap() = 0;
 
   FloatingPoint computeUpdate(const Point3D& C_cell_center) const;
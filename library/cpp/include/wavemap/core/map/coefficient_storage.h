@@ -0,0 +1,126 @@
+#ifndef WAVEMAP_CORE_MAP_COEFFICIENT_STORAGE_H_
+#define WAVEMAP_CORE_MAP_COEFFICIENT_STORAGE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/ndtree/ndtree.h"
+#include "wavemap/core/map/cell_types/haar_coefficients.h"
+
+namespace wavemap {
+/**
+ * Policies that determine how the blocks of a BasicHashedWaveletOctree store
+ * their detail coefficients while they are not being updated. The blocks
+ * always update and threshold their coefficients in full precision. Once a
+ * block is pruned, its coefficients are handed to the policy, which can store
+ * them in a more compact form until the block is modified again.
+ */
+class FullPrecisionCoefficientStorage {
+ public:
+  FullPrecisionCoefficientStorage(IndexElement /*tree_height*/,
+                                  FloatingPoint /*min_log_odds*/,
+                                  FloatingPoint /*max_log_odds*/) {}
+
+  // Whether the policy may move the coefficients out of the block's octree
+  static constexpr bool kMayCompress = false;
+  static constexpr bool isCompressed() { return false; }
+  template <typename OctreeT>
+  void compress(OctreeT& /*octree*/) {}
+  template <typename OctreeT>
+  void decompress(OctreeT& /*octree*/) {}
+
+  static constexpr bool empty() { return true; }
+  static constexpr size_t size() { return 0u; }
+  void clear() {}
+  static constexpr size_t getMemoryUsage() { return 0u; }
+
+  // Detail coefficients below this magnitude are pruned
+  static constexpr FloatingPoint getPruningThreshold() { return 1e-3f; }
+
+  // Call the visitor with the octree that currently holds the coefficients and
+  // a function that loads the detail coefficients of its nodes
+  template <typename OctreeT, typename OctreeVisitor>
+  auto visit(const OctreeT& octree, OctreeVisitor visitor_fn) const {
+    return visitor_fn(octree, [](const auto& details) -> const auto& {
+      return details;
+    });
+  }
+};
+
+/**
+ * Stores the detail coefficients of blocks that are not being updated as 16
+ * bit fixed-point numbers, roughly halving the size of each octree node. The
+ * quantization step is derived from the map's log-odds bounds, such that all
+ * coefficients of a thresholded block can be represented without saturating.
+ */
+class QuantizedCoefficientStorage {
+ public:
+  using Coefficients = HaarCoefficients<FloatingPoint, 3>;
+  using OctreeType = Octree<Coefficients::Details>;
+  using QuantizedValue = int16_t;
+  using QuantizedDetails =
+      std::array<QuantizedValue, Coefficients::kNumDetailCoefficients>;
+  using QuantizedOctreeType = Octree<QuantizedDetails>;
+
+  QuantizedCoefficientStorage(IndexElement tree_height,
+                              FloatingPoint min_log_odds,
+                              FloatingPoint max_log_odds)
+      : quantization_step_(getQuantizationStep(min_log_odds, max_log_odds)),
+        quantized_octree_(tree_height - 1) {}
+
+  static constexpr bool kMayCompress = true;
+  bool isCompressed() const { return is_compressed_; }
+  // Move the (thresholded) coefficients from the octree into the quantized
+  // octree, leaving the octree empty
+  void compress(OctreeType& octree);
+  // Restore the coefficients into the (empty) octree at full precision
+  void decompress(OctreeType& octree);
+
+  bool empty() const { return quantized_octree_.empty(); }
+  size_t size() const {
+    return is_compressed_ ? quantized_octree_.size() : 0u;
+  }
+  void clear();
+  size_t getMemoryUsage() const { return quantized_octree_.getMemoryUsage(); }
+
+  // Detail coefficients that would be quantized to zero are pruned as well
+  FloatingPoint getPruningThreshold() const {
+    return std::max(1e-3f, quantization_step_ / 2.f);
+  }
+
+  template <typename OctreeVisitor>
+  auto visit(const OctreeType& octree, OctreeVisitor visitor_fn) const;
+
+  // Conversions between the stored and full precision detail coefficients
+  QuantizedDetails quantize(const Coefficients::Details& details) const;
+  Coefficients::Details dequantize(const QuantizedDetails& details) const;
+
+  // The quantization step size, in log-odds, for maps with the given bounds
+  // NOTE: Only thresholded blocks are quantized, whose cell values all lie
+  //       within the log-odds bounds. Each level of the lifted Haar transform
+  //       then at most doubles the differences between them, such that the
+  //       detail coefficients never exceed four times the span of the bounds.
+  static FloatingPoint getQuantizationStep(FloatingPoint min_log_odds,
+                                           FloatingPoint max_log_odds);
+  // Upper bound on the error, in log-odds, that quantizing a block introduces
+  // in the value of any of its cells
+  // NOTE: Each detail coefficient is off by at most half a quantization step.
+  //       Reconstructing a child's value from its parent's coefficients sums
+  //       the 7 detail coefficients, scaled by 1/2 (3x), 1/4 (3x) and 1/8
+  //       (1x), which amplifies the error by at most 19/8 per tree level.
+  static FloatingPoint getMaxQuantizationError(IndexElement tree_height,
+                                               FloatingPoint min_log_odds,
+                                               FloatingPoint max_log_odds);
+
+ private:
+  FloatingPoint quantization_step_;
+  QuantizedOctreeType quantized_octree_;
+  bool is_compressed_ = false;
+};
+}  // namespace wavemap
+
+#include "wavemap/core/map/impl/coefficient_storage_inl.h"
+
+#endif  // WAVEMAP_CORE_MAP_COEFFICIENT_STORAGE_H_
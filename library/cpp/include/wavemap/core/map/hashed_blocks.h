@@ -2,6 +2,7 @@
 #define WAVEMAP_CORE_MAP_HASHED_BLOCKS_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -9,6 +10,8 @@
 #include "wavemap/core/config/config_base.h"
 #include "wavemap/core/data_structure/dense_block_hash.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/thread_pool.h"
 
 namespace wavemap {
 class HashedBlocks : public MapBase,
@@ -34,7 +37,7 @@ class HashedBlocks : public MapBase,
   void clear() override { DenseBlockHash::clear(); }
 
   size_t getMemoryUsage() const override {
-    return size() * sizeof(FloatingPoint);
+    return DenseBlockHash::getMemoryUsage();
   }
 
   Index3D getMinIndex() const override;
@@ -50,6 +53,35 @@ class HashedBlocks : public MapBase,
 
   void forEachLeaf(
       typename MapBase::IndexedLeafVisitorFunction visitor_fn) const override;
+  // NOTE: The visitors of the serial methods below can stop the iteration
+  //       early by returning false.
+  template <typename IndexedLeafVisitor>
+  void forEachLeaf(IndexedLeafVisitor visitor_fn) const;
+  // Only visit the blocks and cells that overlap the region, which can be any
+  // shape supported by shape::overlaps(AABB, ShapeT), such as an AABB, Sphere
+  // or OrientedBox. For regions that are small compared to the map, the cost
+  // scales with the size of the region instead of the size of the map.
+  template <typename ShapeT, typename IndexedBlockVisitor>
+  void forEachBlockInRegion(const ShapeT& region,
+                            IndexedBlockVisitor visitor_fn) const;
+  template <typename ShapeT, typename IndexedLeafVisitor>
+  void forEachLeafInRegion(const ShapeT& region,
+                           IndexedLeafVisitor visitor_fn) const;
+  // NOTE: The blocks are processed in parallel, so the visitor must be
+  //       thread-safe. Early termination is not supported.
+  template <typename IndexedLeafVisitor>
+  void forEachLeafParallel(
+      ThreadPool& thread_pool, IndexedLeafVisitor visitor_fn,
+      const std::optional<AABB<Point3D>>& region = std::nullopt) const;
+
+ private:
+  template <typename IndexedLeafVisitor>
+  bool forEachLeafInBlock(const Index3D& block_index, const Block& block,
+                          IndexedLeafVisitor& visitor_fn) const;
+  template <typename ShapeT, typename IndexedLeafVisitor>
+  bool forEachLeafInBlock(const Index3D& block_index, const Block& block,
+                          const ShapeT& region,
+                          IndexedLeafVisitor& visitor_fn) const;
 };
 }  // namespace wavemap
 
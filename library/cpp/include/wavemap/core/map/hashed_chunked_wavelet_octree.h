@@ -2,7 +2,9 @@
 #define WAVEMAP_CORE_MAP_HASHED_CHUNKED_WAVELET_OCTREE_H_
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "wavemap/core/common.h"
 #include "wavemap/core/config/config_base.h"
@@ -11,6 +13,8 @@
 #include "wavemap/core/map/hashed_chunked_wavelet_octree_block.h"
 #include "wavemap/core/map/map_base.h"
 #include "wavemap/core/utils/math/int_math.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/thread_pool.h"
 
 namespace wavemap {
 /**
@@ -86,7 +90,21 @@ class HashedChunkedWaveletOctree : public MapBase {
   void pruneSmart() override;
   void clear() override { block_map_.clear(); }
 
+  // Memory used by the map's blocks and hash map, including an estimate of
+  // the heap allocator's overhead
   size_t getMemoryUsage() const override;
+  // Memory used by the given block, including an even share of the hash map's
+  // memory usage, or zero if the block does not exist
+  size_t getBlockMemoryUsage(const BlockIndex& block_index) const;
+  // Memory used by the blocks that overlap the region, which can be any shape
+  // supported by forEachBlockInRegion(...)
+  template <typename ShapeT>
+  size_t getMemoryUsageInRegion(const ShapeT& region) const;
+  // Memory used per height, indexed by height. Entry h holds the memory used
+  // by the coefficients that resolve cells at height h, which coarsening the
+  // blocks to height h + 1 frees. The last entry, at index tree_height, holds
+  // the memory of the blocks themselves and of the hash map.
+  std::vector<size_t> getMemoryUsageByHeight() const;
 
   Index3D getMinIndex() const override;
   Index3D getMaxIndex() const override;
@@ -123,6 +141,28 @@ class HashedChunkedWaveletOctree : public MapBase {
 
   void forEachLeaf(
       typename MapBase::IndexedLeafVisitorFunction visitor_fn) const override;
+  // NOTE: The visitors of the serial methods below can stop the iteration
+  //       early by returning false.
+  template <typename IndexedLeafVisitor>
+  void forEachLeaf(IndexedLeafVisitor visitor_fn,
+                   IndexElement termination_height = 0) const;
+  // Only visit the blocks and leaves that overlap the region, which can be any
+  // shape supported by shape::overlaps(AABB, ShapeT), such as an AABB, Sphere
+  // or OrientedBox. For regions that are small compared to the map, the cost
+  // scales with the size of the region instead of the size of the map.
+  template <typename ShapeT, typename IndexedBlockVisitor>
+  void forEachBlockInRegion(const ShapeT& region,
+                            IndexedBlockVisitor visitor_fn) const;
+  template <typename ShapeT, typename IndexedLeafVisitor>
+  void forEachLeafInRegion(const ShapeT& region, IndexedLeafVisitor visitor_fn,
+                           IndexElement termination_height = 0) const;
+  // NOTE: The blocks are processed in parallel, so the visitor must be
+  //       thread-safe. Early termination is not supported.
+  template <typename IndexedLeafVisitor>
+  void forEachLeafParallel(
+      ThreadPool& thread_pool, IndexedLeafVisitor visitor_fn,
+      const std::optional<AABB<Point3D>>& region = std::nullopt,
+      IndexElement termination_height = 0) const;
 
   BlockIndex indexToBlockIndex(const OctreeIndex& node_index) const;
   CellIndex indexToCellIndex(OctreeIndex index) const;
@@ -30,15 +30,30 @@ class HashedChunkedWaveletOctreeBlock {
   size_t size() const { return ndtree_.size(); }
   void threshold();
   void prune();
+  // Discard the detail coefficients that resolve cells below the termination
+  // height, such that the block is only represented down to cells at that
+  // height. The values of the remaining cells are preserved. Coarsening marks
+  // the block as modified, but not as updated, such that its age still
+  // reflects when it was last observed. Returns whether any coefficients were
+  // discarded.
+  bool coarsen(IndexElement termination_height);
   void clear();
 
   FloatingPoint getCellValue(const OctreeIndex& index) const;
   void setCellValue(const OctreeIndex& index, FloatingPoint new_value);
   void addToCellValue(const OctreeIndex& index, FloatingPoint update);
 
-  void forEachLeaf(const BlockIndex& block_index,
-                   typename MapBase::IndexedLeafVisitorFunction visitor_fn,
+  // NOTE: The visitor can stop the iteration early by returning false, in
+  //       which case these methods also return false.
+  template <typename IndexedLeafVisitor>
+  bool forEachLeaf(const BlockIndex& block_index, IndexedLeafVisitor visitor_fn,
                    IndexElement termination_height = 0) const;
+  // Only visit the nodes that pass the indicator, skipping the subtrees of
+  // those that do not
+  template <typename NodeIndicator, typename IndexedLeafVisitor>
+  bool forEachLeafIf(const BlockIndex& block_index, NodeIndicator indicator_fn,
+                     IndexedLeafVisitor visitor_fn,
+                     IndexElement termination_height = 0) const;
 
   Coefficients::Scale& getRootScale() { return root_scale_coefficient_; }
   const Coefficients::Scale& getRootScale() const {
@@ -60,11 +75,19 @@ class HashedChunkedWaveletOctreeBlock {
   void setNeedsThresholding(bool value = true) { needs_thresholding_ = value; }
   bool getNeedsThresholding() const { return needs_thresholding_; }
 
+  // Updates mark the block as observed, and also as modified
   void setLastUpdatedStamp(Timestamp stamp = Time::now()) {
     last_updated_stamp_ = stamp;
+    last_modified_stamp_ = stamp;
   }
   Timestamp getLastUpdatedStamp() const { return last_updated_stamp_; }
   FloatingPoint getTimeSinceLastUpdated() const;
+  // Edits that change the block's values without observing it, such as
+  // coarsening, only mark it as modified
+  void setLastModifiedStamp(Timestamp stamp = Time::now()) {
+    last_modified_stamp_ = stamp;
+  }
+  Timestamp getLastModifiedStamp() const { return last_modified_stamp_; }
 
   template <TraversalOrder traversal_order>
   auto getChunkIterator() {
@@ -88,11 +111,16 @@ class HashedChunkedWaveletOctreeBlock {
   bool needs_thresholding_ = false;
   bool needs_pruning_ = false;
   Timestamp last_updated_stamp_ = Time::now();
+  Timestamp last_modified_stamp_ = last_updated_stamp_;
 
   void recursiveThreshold(OctreeType::NodeRefType node,
                           Coefficients::Scale& node_scale_coefficient);
   void recursivePrune(
       HashedChunkedWaveletOctreeBlock::OctreeType::NodeRefType node);
+  // Returns whether any coefficients were discarded
+  static bool recursiveCoarsen(OctreeType::ChunkType& chunk,
+                               IndexElement chunk_top_height,
+                               IndexElement termination_height);
 };
 }  // namespace wavemap
 
@@ -2,15 +2,19 @@
 #define WAVEMAP_CORE_MAP_HASHED_WAVELET_OCTREE_H_
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "wavemap/core/common.h"
 #include "wavemap/core/config/config_base.h"
-#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/data_structure/copy_on_write_spatial_hash.h"
 #include "wavemap/core/indexing/index_hashes.h"
 #include "wavemap/core/map/hashed_wavelet_octree_block.h"
 #include "wavemap/core/map/map_base.h"
 #include "wavemap/core/utils/math/int_math.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/thread_pool.h"
 
 namespace wavemap {
 /**
@@ -56,23 +60,38 @@ struct HashedWaveletOctreeConfig : ConfigBase<HashedWaveletOctreeConfig, 5> {
   bool isValid(bool verbose) const override;
 };
 
-class HashedWaveletOctree : public MapBase {
+/**
+ * Map that divides space into hashed blocks, each storing its cells' values
+ * as the wavelet coefficients of an octree. The block type determines how the
+ * coefficients are stored, see BasicHashedWaveletOctreeBlock.
+ */
+template <typename BlockT>
+class BasicHashedWaveletOctree : public MapBase {
  public:
-  using Ptr = std::shared_ptr<HashedWaveletOctree>;
-  using ConstPtr = std::shared_ptr<const HashedWaveletOctree>;
+  using Ptr = std::shared_ptr<BasicHashedWaveletOctree>;
+  using ConstPtr = std::shared_ptr<const BasicHashedWaveletOctree>;
   using Config = HashedWaveletOctreeConfig;
   static constexpr bool kRequiresExplicitThresholding = true;
 
   using BlockIndex = Index3D;
   using CellIndex = OctreeIndex;
-  using Block = HashedWaveletOctreeBlock;
-  using BlockHashMap = SpatialHash<Block, kDim>;
+  using Block = BlockT;
+  using BlockHashMap = CopyOnWriteSpatialHash<Block, kDim>;
 
-  explicit HashedWaveletOctree(const HashedWaveletOctreeConfig& config)
+  explicit BasicHashedWaveletOctree(const HashedWaveletOctreeConfig& config)
       : MapBase(config), config_(config.checkValid()) {}
 
-  // Copy construction is not supported
-  HashedWaveletOctree(const HashedWaveletOctree&) = delete;
+  // Copy construction is not supported, use snapshot() instead
+  BasicHashedWaveletOctree(const BasicHashedWaveletOctree&) = delete;
+
+  // Get an immutable snapshot of the map's current state. Snapshots share all
+  // blocks with the map, which only copies blocks once it modifies them while
+  // they are still shared. Taking a snapshot therefore only costs one pointer
+  // copy per block, and queries on the snapshot never see partial updates.
+  // NOTE: Snapshots must be taken from the thread that updates the map, or
+  //       otherwise be synchronized with its updates. The snapshots can then
+  //       be queried from other threads without any further locking.
+  ConstPtr snapshot() const;
 
   bool empty() const override { return block_map_.empty(); }
   size_t size() const override;
@@ -81,7 +100,21 @@ class HashedWaveletOctree : public MapBase {
   void pruneSmart() override;
   void clear() override { block_map_.clear(); }
 
+  // Memory used by the map's blocks and hash map, including an estimate of
+  // the heap allocator's overhead
   size_t getMemoryUsage() const override;
+  // Memory used by the given block, including an even share of the hash map's
+  // memory usage, or zero if the block does not exist
+  size_t getBlockMemoryUsage(const BlockIndex& block_index) const;
+  // Memory used by the blocks that overlap the region, which can be any shape
+  // supported by forEachBlockInRegion(...)
+  template <typename ShapeT>
+  size_t getMemoryUsageInRegion(const ShapeT& region) const;
+  // Memory used per height, indexed by height. Entry h holds the memory used
+  // by the coefficients that resolve cells at height h, which coarsening the
+  // blocks to height h + 1 frees. The last entry, at index tree_height, holds
+  // the memory of the blocks themselves and of the hash map.
+  std::vector<size_t> getMemoryUsageByHeight() const;
 
   Index3D getMinIndex() const override;
   Index3D getMaxIndex() const override;
@@ -110,6 +143,12 @@ class HashedWaveletOctree : public MapBase {
   auto& getHashMap() { return block_map_.getHashMap(); }
   const auto& getHashMap() const { return block_map_.getHashMap(); }
 
+  // Visit the blocks in Morton order, see SpatialHash::enableBlockDirectory()
+  // NOTE: Snapshots inherit the directory, which makes taking them O(n log n).
+  void enableBlockDirectory() { block_map_.enableBlockDirectory(); }
+  void disableBlockDirectory() { block_map_.disableBlockDirectory(); }
+  bool hasBlockDirectory() const { return block_map_.hasBlockDirectory(); }
+
   template <typename IndexedBlockVisitor>
   void forEachBlock(IndexedBlockVisitor visitor_fn);
   template <typename IndexedBlockVisitor>
@@ -117,6 +156,28 @@ class HashedWaveletOctree : public MapBase {
 
   void forEachLeaf(
       typename MapBase::IndexedLeafVisitorFunction visitor_fn) const override;
+  // NOTE: The visitors of the serial methods below can stop the iteration
+  //       early by returning false.
+  template <typename IndexedLeafVisitor>
+  void forEachLeaf(IndexedLeafVisitor visitor_fn,
+                   IndexElement termination_height = 0) const;
+  // Only visit the blocks and leaves that overlap the region, which can be any
+  // shape supported by shape::overlaps(AABB, ShapeT), such as an AABB, Sphere
+  // or OrientedBox. For regions that are small compared to the map, the cost
+  // scales with the size of the region instead of the size of the map.
+  template <typename ShapeT, typename IndexedBlockVisitor>
+  void forEachBlockInRegion(const ShapeT& region,
+                            IndexedBlockVisitor visitor_fn) const;
+  template <typename ShapeT, typename IndexedLeafVisitor>
+  void forEachLeafInRegion(const ShapeT& region, IndexedLeafVisitor visitor_fn,
+                           IndexElement termination_height = 0) const;
+  // NOTE: The blocks are processed in parallel, so the visitor must be
+  //       thread-safe. Early termination is not supported.
+  template <typename IndexedLeafVisitor>
+  void forEachLeafParallel(
+      ThreadPool& thread_pool, IndexedLeafVisitor visitor_fn,
+      const std::optional<AABB<Point3D>>& region = std::nullopt,
+      IndexElement termination_height = 0) const;
 
   BlockIndex indexToBlockIndex(const OctreeIndex& node_index) const;
   CellIndex indexToCellIndex(OctreeIndex index) const;
@@ -127,7 +188,13 @@ class HashedWaveletOctree : public MapBase {
       int_math::exp2(config_.tree_height);
 
   BlockHashMap block_map_;
+
+  BasicHashedWaveletOctree(const HashedWaveletOctreeConfig& config,
+                           BlockHashMap block_map)
+      : MapBase(config), config_(config), block_map_(std::move(block_map)) {}
 };
+
+using HashedWaveletOctree = BasicHashedWaveletOctree<HashedWaveletOctreeBlock>;
 }  // namespace wavemap
 
 #include "wavemap/core/map/impl/hashed_wavelet_octree_inl.h"
@@ -1,72 +1,137 @@
 #ifndef WAVEMAP_CORE_MAP_HASHED_WAVELET_OCTREE_BLOCK_H_
 #define WAVEMAP_CORE_MAP_HASHED_WAVELET_OCTREE_BLOCK_H_
 
+#include <type_traits>
+
 #include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/linear_ndtree/linear_ndtree.h"
 #include "wavemap/core/data_structure/ndtree/ndtree.h"
 #include "wavemap/core/map/cell_types/haar_coefficients.h"
 #include "wavemap/core/map/cell_types/haar_transform.h"
+#include "wavemap/core/map/coefficient_storage.h"
 #include "wavemap/core/map/map_base.h"
 #include "wavemap/core/utils/time/time.h"
 
 namespace wavemap {
-class HashedWaveletOctreeBlock {
+/**
+ * Block of a BasicHashedWaveletOctree, storing the wavelet coefficients of the
+ * cells it covers in an octree. The CoefficientStorageT policy determines how
+ * the detail coefficients are stored while the block is not being updated,
+ * see coefficient_storage.h. The NdtreeT template determines how the octree
+ * stores its nodes, either linked through pointers (Ndtree) or contiguously
+ * in a single array (LinearNdtree).
+ */
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT = Ndtree>
+class BasicHashedWaveletOctreeBlock {
  public:
   static constexpr int kDim = 3;
   using BlockIndex = Index3D;
   using Coefficients = HaarCoefficients<FloatingPoint, kDim>;
   using Transform = HaarTransform<FloatingPoint, kDim>;
-  using OctreeType = Octree<Coefficients::Details>;
+  using OctreeType = NdtreeT<Coefficients::Details, kDim>;
+  using CoefficientStorage = CoefficientStorageT;
 
-  explicit HashedWaveletOctreeBlock(IndexElement tree_height,
-                                    FloatingPoint min_log_odds,
-                                    FloatingPoint max_log_odds)
+  explicit BasicHashedWaveletOctreeBlock(IndexElement tree_height,
+                                         FloatingPoint min_log_odds,
+                                         FloatingPoint max_log_odds)
       : tree_height_(tree_height),
         min_log_odds_(min_log_odds),
-        max_log_odds_(max_log_odds) {}
+        max_log_odds_(max_log_odds),
+        coefficient_storage_(tree_height, min_log_odds, max_log_odds) {}
 
   bool empty() const;
-  size_t size() const { return ndtree_.size(); }
+  size_t size() const;
   void threshold();
+  // Threshold the block, prune its negligible coefficients and then hand them
+  // to the coefficient storage policy, which may compress them until the
+  // block is modified again
   void prune();
+  // Discard the detail coefficients that resolve cells below the termination
+  // height, such that the block is only represented down to cells at that
+  // height. The values of the remaining cells are preserved. Coarsening marks
+  // the block as modified, but not as updated, such that its age still
+  // reflects when it was last observed. Returns whether any coefficients were
+  // discarded.
+  bool coarsen(IndexElement termination_height);
   void clear();
 
   FloatingPoint getCellValue(const OctreeIndex& index) const;
   void setCellValue(const OctreeIndex& index, FloatingPoint new_value);
   void addToCellValue(const OctreeIndex& index, FloatingPoint update);
 
-  void forEachLeaf(const BlockIndex& block_index,
-                   typename MapBase::IndexedLeafVisitorFunction visitor_fn,
+  // NOTE: The visitor can stop the iteration early by returning false, in
+  //       which case these methods also return false.
+  template <typename IndexedLeafVisitor>
+  bool forEachLeaf(const BlockIndex& block_index, IndexedLeafVisitor visitor_fn,
                    IndexElement termination_height = 0) const;
+  // Only visit the nodes that pass the indicator, skipping the subtrees of
+  // those that do not
+  template <typename NodeIndicator, typename IndexedLeafVisitor>
+  bool forEachLeafIf(const BlockIndex& block_index, NodeIndicator indicator_fn,
+                     IndexedLeafVisitor visitor_fn,
+                     IndexElement termination_height = 0) const;
 
   Coefficients::Scale& getRootScale() { return root_scale_coefficient_; }
   const Coefficients::Scale& getRootScale() const {
     return root_scale_coefficient_;
   }
-  OctreeType::NodeRefType getRootNode() { return ndtree_.getRootNode(); }
-  OctreeType::NodeConstRefType getRootNode() const {
+  // NOTE: Accessing the nodes for writing decompresses the block. The const
+  //       accessors below are only available if the coefficient storage never
+  //       compresses the block, use visitOctree(...) to read blocks
+  //       regardless of how they are stored.
+  typename OctreeType::NodeRefType getRootNode() {
+    decompress();
+    return ndtree_.getRootNode();
+  }
+  template <bool kEnabled = !CoefficientStorageT::kMayCompress,
+            std::enable_if_t<kEnabled, bool> = true>
+  typename OctreeType::NodeConstRefType getRootNode() const {
     return ndtree_.getRootNode();
   }
+  // Call the visitor with the octree that currently holds the block's detail
+  // coefficients and a function that loads them at full precision
+  template <typename OctreeVisitor>
+  auto visitOctree(OctreeVisitor visitor_fn) const {
+    return coefficient_storage_.visit(ndtree_, visitor_fn);
+  }
+  const CoefficientStorageT& getCoefficientStorage() const {
+    return coefficient_storage_;
+  }
 
   void setNeedsPruning(bool value = true) { needs_pruning_ = value; }
   bool getNeedsPruning() const { return needs_pruning_; }
   void setNeedsThresholding(bool value = true) { needs_thresholding_ = value; }
   bool getNeedsThresholding() const { return needs_thresholding_; }
+  // Updates mark the block as observed, and also as modified
   void setLastUpdatedStamp(Timestamp stamp = Time::now()) {
     last_updated_stamp_ = stamp;
+    last_modified_stamp_ = stamp;
   }
   Timestamp getLastUpdatedStamp() const { return last_updated_stamp_; }
   FloatingPoint getTimeSinceLastUpdated() const;
+  // Edits that change the block's values without observing it, such as
+  // coarsening, only mark it as modified
+  void setLastModifiedStamp(Timestamp stamp = Time::now()) {
+    last_modified_stamp_ = stamp;
+  }
+  Timestamp getLastModifiedStamp() const { return last_modified_stamp_; }
 
   template <TraversalOrder traversal_order>
   auto getNodeIterator() {
-    return ndtree_.getIterator<traversal_order>();
+    decompress();
+    return ndtree_.template getIterator<traversal_order>();
   }
-  template <TraversalOrder traversal_order>
+  template <TraversalOrder traversal_order,
+            bool kEnabled = !CoefficientStorageT::kMayCompress,
+            std::enable_if_t<kEnabled, bool> = true>
   auto getNodeIterator() const {
-    return ndtree_.getIterator<traversal_order>();
+    return ndtree_.template getIterator<traversal_order>();
   }
 
-  size_t getMemoryUsage() const { return ndtree_.getMemoryUsage(); }
+  size_t getMemoryUsage() const {
+    return ndtree_.getMemoryUsage() + coefficient_storage_.getMemoryUsage();
+  }
 
  private:
   const IndexElement tree_height_;
@@ -75,15 +140,34 @@ class HashedWaveletOctreeBlock {
 
   OctreeType ndtree_{tree_height_ - 1};
   Coefficients::Scale root_scale_coefficient_{};
+  CoefficientStorageT coefficient_storage_;
 
   bool needs_thresholding_ = false;
   bool needs_pruning_ = false;
   Timestamp last_updated_stamp_ = Time::now();
+  Timestamp last_modified_stamp_ = last_updated_stamp_;
 
-  void recursiveThreshold(OctreeType::NodeRefType node,
+  // Restore the coefficients into the octree before they are modified
+  void decompress();
+  // Reclaim the space of erased nodes, for octrees that store them linearly
+  void compact();
+  void compactIfFragmented();
+
+  void recursiveThreshold(typename OctreeType::NodeRefType node,
                           Coefficients::Scale& node_scale_coefficient);
-  void recursivePrune(OctreeType::NodeRefType node);
+  void recursivePrune(typename OctreeType::NodeRefType node,
+                      FloatingPoint threshold);
+  // Returns whether any coefficients were discarded
+  static bool recursiveCoarsen(typename OctreeType::NodeRefType node,
+                               IndexElement node_height,
+                               IndexElement termination_height);
 };
+
+using HashedWaveletOctreeBlock =
+    BasicHashedWaveletOctreeBlock<FullPrecisionCoefficientStorage>;
+using LinearHashedWaveletOctreeBlock =
+    BasicHashedWaveletOctreeBlock<FullPrecisionCoefficientStorage,
+                                  LinearNdtree>;
 }  // namespace wavemap
 
 #include "wavemap/core/map/impl/hashed_wavelet_octree_block_inl.h"
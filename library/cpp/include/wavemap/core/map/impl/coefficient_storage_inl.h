@@ -0,0 +1,64 @@
+#ifndef WAVEMAP_CORE_MAP_IMPL_COEFFICIENT_STORAGE_INL_H_
+#define WAVEMAP_CORE_MAP_IMPL_COEFFICIENT_STORAGE_INL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace wavemap {
+template <typename OctreeVisitor>
+auto QuantizedCoefficientStorage::visit(const OctreeType& octree,
+                                        OctreeVisitor visitor_fn) const {
+  if (is_compressed_) {
+    return visitor_fn(quantized_octree_,
+                      [this](const QuantizedDetails& details) {
+                        return dequantize(details);
+                      });
+  }
+  return visitor_fn(octree, [](const Coefficients::Details& details)
+                                -> const Coefficients::Details& {
+    return details;
+  });
+}
+
+inline QuantizedCoefficientStorage::QuantizedDetails
+QuantizedCoefficientStorage::quantize(
+    const Coefficients::Details& details) const {
+  QuantizedDetails quantized_details;
+  std::transform(details.cbegin(), details.cend(), quantized_details.begin(),
+                 [step = quantization_step_](FloatingPoint value) {
+                   constexpr auto kMaxValue = static_cast<FloatingPoint>(
+                       std::numeric_limits<QuantizedValue>::max());
+                   const FloatingPoint steps = std::round(value / step);
+                   return static_cast<QuantizedValue>(
+                       std::clamp(steps, -kMaxValue, kMaxValue));
+                 });
+  return quantized_details;
+}
+
+inline QuantizedCoefficientStorage::Coefficients::Details
+QuantizedCoefficientStorage::dequantize(const QuantizedDetails& details) const {
+  Coefficients::Details dequantized_details;
+  std::transform(details.cbegin(), details.cend(), dequantized_details.begin(),
+                 [step = quantization_step_](QuantizedValue value) {
+                   return static_cast<FloatingPoint>(value) * step;
+                 });
+  return dequantized_details;
+}
+
+inline FloatingPoint QuantizedCoefficientStorage::getQuantizationStep(
+    FloatingPoint min_log_odds, FloatingPoint max_log_odds) {
+  return 4.f * (max_log_odds - min_log_odds) /
+         static_cast<FloatingPoint>(std::numeric_limits<QuantizedValue>::max());
+}
+
+inline FloatingPoint QuantizedCoefficientStorage::getMaxQuantizationError(
+    IndexElement tree_height, FloatingPoint min_log_odds,
+    FloatingPoint max_log_odds) {
+  const FloatingPoint max_error_per_level =
+      0.5f * (19.f / 8.f) * getQuantizationStep(min_log_odds, max_log_odds);
+  return static_cast<FloatingPoint>(tree_height) * max_error_per_level;
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_MAP_IMPL_COEFFICIENT_STORAGE_INL_H_
@@ -1,12 +1,15 @@
 #ifndef WAVEMAP_CORE_MAP_IMPL_HASHED_BLOCKS_INL_H_
 #define WAVEMAP_CORE_MAP_IMPL_HASHED_BLOCKS_INL_H_
 
+#include <functional>
 #include <limits>
 #include <string>
 #include <unordered_set>
 
 #include "wavemap/core/indexing/index_conversions.h"
 #include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/iterate/visitor_utils.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
 
 namespace wavemap {
 inline FloatingPoint HashedBlocks::getCellValue(const Index3D& index) const {
@@ -23,6 +26,115 @@ inline void HashedBlocks::addToCellValue(const Index3D& index,
   FloatingPoint& cell_data = getOrAllocateValue(index);
   cell_data = clampedAdd(cell_data, update);
 }
+
+template <typename IndexedLeafVisitor>
+void HashedBlocks::forEachLeaf(IndexedLeafVisitor visitor_fn) const {
+  for (const auto& [block_index, block] : getHashMap()) {
+    if (!forEachLeafInBlock(block_index, block, visitor_fn)) {
+      return;
+    }
+  }
+}
+
+template <typename ShapeT, typename IndexedBlockVisitor>
+void HashedBlocks::forEachBlockInRegion(const ShapeT& region,
+                                        IndexedBlockVisitor visitor_fn) const {
+  const FloatingPoint min_cell_width = getMinCellWidth();
+  const FloatingPoint block_width =
+      convert::heightToCellWidth(min_cell_width, kCellsPerSideLog2);
+  const auto block_index_range = convert::aabbToBlockIndexRange(
+      static_cast<AABB<Point3D>>(region), 1.f / block_width);
+  block_map_.forEachBlockInRange(
+      block_index_range.first, block_index_range.second,
+      [&region, &visitor_fn, min_cell_width](const Index3D& block_index,
+                                             const Block& block) {
+        const OctreeIndex block_node_index{kCellsPerSideLog2, block_index};
+        if (!shape::overlaps(
+                convert::nodeIndexToAABB(block_node_index, min_cell_width),
+                region)) {
+          return true;
+        }
+        return visitor::invoke(visitor_fn, block_index, block);
+      });
+}
+
+template <typename ShapeT, typename IndexedLeafVisitor>
+void HashedBlocks::forEachLeafInRegion(const ShapeT& region,
+                                       IndexedLeafVisitor visitor_fn) const {
+  forEachBlockInRegion(region, [this, &region, &visitor_fn](
+                                   const Index3D& block_index,
+                                   const Block& block) {
+    return forEachLeafInBlock(block_index, block, region, visitor_fn);
+  });
+}
+
+template <typename IndexedLeafVisitor>
+void HashedBlocks::forEachLeafParallel(
+    ThreadPool& thread_pool, IndexedLeafVisitor visitor_fn,
+    const std::optional<AABB<Point3D>>& region) const {
+  auto add_block_task = [this, &thread_pool, &region, &visitor_fn](
+                            const Index3D& block_index, const Block& block) {
+    thread_pool.add_task([this, &region, &visitor_fn, block_index, &block]() {
+      if (region) {
+        forEachLeafInBlock(block_index, block, region.value(), visitor_fn);
+      } else {
+        forEachLeafInBlock(block_index, block, visitor_fn);
+      }
+    });
+  };
+  if (region) {
+    forEachBlockInRegion(region.value(), add_block_task);
+  } else {
+    forEachBlock(add_block_task);
+  }
+  thread_pool.wait_all();
+}
+
+template <typename IndexedLeafVisitor>
+bool HashedBlocks::forEachLeafInBlock(const Index3D& block_index,
+                                      const Block& block,
+                                      IndexedLeafVisitor& visitor_fn) const {
+  for (LinearIndex cell_idx = 0u; cell_idx < Block::kCellsPerBlock;
+       ++cell_idx) {
+    const Index3D cell_index =
+        convert::linearIndexToIndex<kCellsPerSide, kDim>(cell_idx);
+    const OctreeIndex index{0,
+                            cellAndBlockIndexToIndex(block_index, cell_index)};
+    if (!visitor::invoke(visitor_fn, index, block[cell_idx])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename ShapeT, typename IndexedLeafVisitor>
+bool HashedBlocks::forEachLeafInBlock(const Index3D& block_index,
+                                      const Block& block, const ShapeT& region,
+                                      IndexedLeafVisitor& visitor_fn) const {
+  // Only check the cells individually if the block is partially in the region
+  const FloatingPoint min_cell_width = getMinCellWidth();
+  const auto block_aabb = convert::nodeIndexToAABB(
+      OctreeIndex{kCellsPerSideLog2, block_index}, min_cell_width);
+  if (shape::is_inside(block_aabb, region)) {
+    return forEachLeafInBlock(block_index, block, visitor_fn);
+  }
+
+  for (LinearIndex cell_idx = 0u; cell_idx < Block::kCellsPerBlock;
+       ++cell_idx) {
+    const Index3D cell_index =
+        convert::linearIndexToIndex<kCellsPerSide, kDim>(cell_idx);
+    const OctreeIndex index{0,
+                            cellAndBlockIndexToIndex(block_index, cell_index)};
+    if (!shape::overlaps(convert::nodeIndexToAABB(index, min_cell_width),
+                         region)) {
+      continue;
+    }
+    if (!visitor::invoke(visitor_fn, index, block[cell_idx])) {
+      return false;
+    }
+  }
+  return true;
+}
 }  // namespace wavemap
 
 #endif  // WAVEMAP_CORE_MAP_IMPL_HASHED_BLOCKS_INL_H_
@@ -1,6 +1,10 @@
 #ifndef WAVEMAP_CORE_MAP_IMPL_HASHED_CHUNKED_WAVELET_OCTREE_BLOCK_INL_H_
 #define WAVEMAP_CORE_MAP_IMPL_HASHED_CHUNKED_WAVELET_OCTREE_BLOCK_INL_H_
 
+#include <functional>
+#include <stack>
+
+#include "wavemap/core/utils/iterate/visitor_utils.h"
 #include "wavemap/core/utils/query/occupancy_classifier.h"
 
 namespace wavemap {
@@ -32,6 +36,64 @@ inline FloatingPoint HashedChunkedWaveletOctreeBlock::getCellValue(
   }
   return value;
 }
+
+template <typename IndexedLeafVisitor>
+bool HashedChunkedWaveletOctreeBlock::forEachLeaf(
+    const BlockIndex& block_index, IndexedLeafVisitor visitor_fn,
+    IndexElement termination_height) const {
+  return forEachLeafIf(
+      block_index, [](const OctreeIndex& /*node_index*/) { return true; },
+      visitor_fn, termination_height);
+}
+
+template <typename NodeIndicator, typename IndexedLeafVisitor>
+bool HashedChunkedWaveletOctreeBlock::forEachLeafIf(
+    const BlockIndex& block_index, NodeIndicator indicator_fn,
+    IndexedLeafVisitor visitor_fn, IndexElement termination_height) const {
+  const OctreeIndex block_node_index{tree_height_, block_index};
+  if (empty() || !std::invoke(indicator_fn, block_node_index)) {
+    return true;
+  }
+
+  struct StackElement {
+    const OctreeIndex node_index;
+    OctreeType::NodeConstRefType node;
+    const Coefficients::Scale scale_coefficient{};
+  };
+  std::stack<StackElement> stack;
+  stack.emplace(StackElement{block_node_index, ndtree_.getRootNode(),
+                             root_scale_coefficient_});
+  while (!stack.empty()) {
+    const OctreeIndex node_index = stack.top().node_index;
+    OctreeType::NodeConstRefType node = stack.top().node;
+    const FloatingPoint node_scale_coefficient = stack.top().scale_coefficient;
+    stack.pop();
+
+    const Coefficients::CoefficientsArray child_scale_coefficients =
+        Transform::backward({node_scale_coefficient, {node.data()}});
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      const OctreeIndex child_node_index =
+          node_index.computeChildIndex(child_idx);
+      if (!std::invoke(indicator_fn, child_node_index)) {
+        continue;
+      }
+      const FloatingPoint child_scale_coefficient =
+          child_scale_coefficients[child_idx];
+      if (auto child_node = node.getChild(child_idx);
+          child_node && termination_height < child_node_index.height) {
+        stack.emplace(StackElement{child_node_index, *child_node,
+                                   child_scale_coefficient});
+      } else {
+        if (!visitor::invoke(visitor_fn, child_node_index,
+                             child_scale_coefficient)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
 }  // namespace wavemap
 
 #endif  // WAVEMAP_CORE_MAP_IMPL_HASHED_CHUNKED_WAVELET_OCTREE_BLOCK_INL_H_
@@ -1,7 +1,11 @@
 #ifndef WAVEMAP_CORE_MAP_IMPL_HASHED_CHUNKED_WAVELET_OCTREE_INL_H_
 #define WAVEMAP_CORE_MAP_IMPL_HASHED_CHUNKED_WAVELET_OCTREE_INL_H_
 
+#include <functional>
+
 #include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/iterate/visitor_utils.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
 
 namespace wavemap {
 inline size_t HashedChunkedWaveletOctree::size() const {
@@ -12,6 +16,22 @@ inline size_t HashedChunkedWaveletOctree::size() const {
   return size;
 }
 
+template <typename ShapeT>
+size_t HashedChunkedWaveletOctree::getMemoryUsageInRegion(
+    const ShapeT& region) const {
+  if (empty()) {
+    return 0u;
+  }
+  const size_t hash_map_share = block_map_.getMemoryUsage() / block_map_.size();
+  size_t memory_usage = 0u;
+  forEachBlockInRegion(region, [&memory_usage, hash_map_share](
+                                   const BlockIndex& /*block_index*/,
+                                   const Block& block) {
+    memory_usage += hash_map_share + block.getMemoryUsage();
+  });
+  return memory_usage;
+}
+
 inline FloatingPoint HashedChunkedWaveletOctree::getCellValue(
     const Index3D& index) const {
   const BlockIndex block_index =
@@ -97,6 +117,83 @@ void HashedChunkedWaveletOctree::forEachBlock(
   block_map_.forEachBlock(visitor_fn);
 }
 
+template <typename IndexedLeafVisitor>
+void HashedChunkedWaveletOctree::forEachLeaf(
+    IndexedLeafVisitor visitor_fn, IndexElement termination_height) const {
+  for (const auto& [block_index, block] : getHashMap()) {
+    if (!block.forEachLeaf(block_index, visitor_fn, termination_height)) {
+      return;
+    }
+  }
+}
+
+template <typename ShapeT, typename IndexedBlockVisitor>
+void HashedChunkedWaveletOctree::forEachBlockInRegion(
+    const ShapeT& region, IndexedBlockVisitor visitor_fn) const {
+  const FloatingPoint min_cell_width = getMinCellWidth();
+  const FloatingPoint block_width =
+      convert::heightToCellWidth(min_cell_width, getTreeHeight());
+  const auto block_index_range = convert::aabbToBlockIndexRange(
+      static_cast<AABB<Point3D>>(region), 1.f / block_width);
+  block_map_.forEachBlockInRange(
+      block_index_range.first, block_index_range.second,
+      [&region, &visitor_fn, min_cell_width, tree_height = getTreeHeight()](
+          const BlockIndex& block_index, const Block& block) {
+        const OctreeIndex block_node_index{tree_height, block_index};
+        if (!shape::overlaps(
+                convert::nodeIndexToAABB(block_node_index, min_cell_width),
+                region)) {
+          return true;
+        }
+        return visitor::invoke(visitor_fn, block_index, block);
+      });
+}
+
+template <typename ShapeT, typename IndexedLeafVisitor>
+void HashedChunkedWaveletOctree::forEachLeafInRegion(
+    const ShapeT& region, IndexedLeafVisitor visitor_fn,
+    IndexElement termination_height) const {
+  auto overlaps_region = [&region, min_cell_width = getMinCellWidth()](
+                             const OctreeIndex& node_index) {
+    return shape::overlaps(
+        convert::nodeIndexToAABB(node_index, min_cell_width), region);
+  };
+  forEachBlockInRegion(
+      region, [&overlaps_region, &visitor_fn, termination_height](
+                  const BlockIndex& block_index, const Block& block) {
+        return block.forEachLeafIf(block_index, overlaps_region, visitor_fn,
+                                   termination_height);
+      });
+}
+
+template <typename IndexedLeafVisitor>
+void HashedChunkedWaveletOctree::forEachLeafParallel(
+    ThreadPool& thread_pool, IndexedLeafVisitor visitor_fn,
+    const std::optional<AABB<Point3D>>& region,
+    IndexElement termination_height) const {
+  auto overlaps_region = [&region, min_cell_width = getMinCellWidth()](
+                             const OctreeIndex& node_index) {
+    return shape::overlaps(
+        convert::nodeIndexToAABB(node_index, min_cell_width), region.value());
+  };
+  auto add_block_task = [&](const BlockIndex& block_index, const Block& block) {
+    thread_pool.add_task([&, block_index]() {
+      if (region) {
+        block.forEachLeafIf(block_index, overlaps_region, visitor_fn,
+                            termination_height);
+      } else {
+        block.forEachLeaf(block_index, visitor_fn, termination_height);
+      }
+    });
+  };
+  if (region) {
+    forEachBlockInRegion(region.value(), add_block_task);
+  } else {
+    forEachBlock(add_block_task);
+  }
+  thread_pool.wait_all();
+}
+
 inline HashedChunkedWaveletOctree::BlockIndex
 HashedChunkedWaveletOctree::indexToBlockIndex(
     const OctreeIndex& node_index) const {
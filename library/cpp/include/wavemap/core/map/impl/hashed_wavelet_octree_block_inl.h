@@ -1,35 +1,159 @@
 #ifndef WAVEMAP_CORE_MAP_IMPL_HASHED_WAVELET_OCTREE_BLOCK_INL_H_
 #define WAVEMAP_CORE_MAP_IMPL_HASHED_WAVELET_OCTREE_BLOCK_INL_H_
 
+#include <functional>
+#include <stack>
+#include <type_traits>
+
+#include "wavemap/core/utils/iterate/visitor_utils.h"
 #include "wavemap/core/utils/query/occupancy_classifier.h"
 
 namespace wavemap {
-inline bool HashedWaveletOctreeBlock::empty() const {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+bool BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::empty()
+    const {
   // Check if all cells in the block are equal to zero
   // NOTE: Aside from checking whether the block contains no detail
   //       coefficients, we also need to check whether its scale coefficient
   //       (average value over the whole block) is zero.
-  return ndtree_.empty() &&
+  return ndtree_.empty() && coefficient_storage_.empty() &&
          OccupancyClassifier::isUnobserved(root_scale_coefficient_);
 }
 
-inline FloatingPoint HashedWaveletOctreeBlock::getTimeSinceLastUpdated() const {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+size_t BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::size()
+    const {
+  if (coefficient_storage_.isCompressed()) {
+    return coefficient_storage_.size();
+  }
+  return ndtree_.size();
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+FloatingPoint
+BasicHashedWaveletOctreeBlock<CoefficientStorageT,
+                              NdtreeT>::getTimeSinceLastUpdated() const {
   return time::to_seconds<FloatingPoint>(Time::now() - last_updated_stamp_);
 }
 
-inline FloatingPoint HashedWaveletOctreeBlock::getCellValue(
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+FloatingPoint
+BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::getCellValue(
     const OctreeIndex& index) const {
-  const MortonIndex morton_code = convert::nodeIndexToMorton(index);
-  OctreeType::NodeConstPtrType node = &ndtree_.getRootNode();
-  FloatingPoint value = root_scale_coefficient_;
-  for (int parent_height = tree_height_; node && index.height < parent_height;
-       --parent_height) {
-    const NdtreeIndexRelativeChild child_index =
-        OctreeIndex::computeRelativeChildIndex(morton_code, parent_height);
-    value = Transform::backwardSingleChild({value, node->data()}, child_index);
-    node = node->getChild(child_index);
+  return visitOctree([this, &index](const auto& octree, auto load_details) {
+    const MortonIndex morton_code = convert::nodeIndexToMorton(index);
+    auto node = &octree.getRootNode();
+    FloatingPoint value = root_scale_coefficient_;
+    for (int parent_height = tree_height_;
+         node && index.height < parent_height; --parent_height) {
+      const NdtreeIndexRelativeChild child_index =
+          OctreeIndex::computeRelativeChildIndex(morton_code, parent_height);
+      value = Transform::backwardSingleChild(
+          {value, load_details(node->data())}, child_index);
+      node = node->getChild(child_index);
+    }
+    return value;
+  });
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+template <typename IndexedLeafVisitor>
+bool BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::forEachLeaf(
+    const BlockIndex& block_index, IndexedLeafVisitor visitor_fn,
+    IndexElement termination_height) const {
+  return forEachLeafIf(
+      block_index, [](const OctreeIndex& /*node_index*/) { return true; },
+      visitor_fn, termination_height);
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+template <typename NodeIndicator, typename IndexedLeafVisitor>
+bool BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::forEachLeafIf(
+    const BlockIndex& block_index, NodeIndicator indicator_fn,
+    IndexedLeafVisitor visitor_fn, IndexElement termination_height) const {
+  const OctreeIndex block_node_index{tree_height_, block_index};
+  if (empty() || !std::invoke(indicator_fn, block_node_index)) {
+    return true;
+  }
+
+  return visitOctree([&](const auto& octree, auto load_details) {
+    using NodeConstRefType =
+        typename std::decay_t<decltype(octree)>::NodeConstRefType;
+    struct StackElement {
+      const OctreeIndex node_index;
+      NodeConstRefType node;
+      const typename Coefficients::Scale scale_coefficient{};
+    };
+    std::stack<StackElement> stack;
+    stack.emplace(StackElement{block_node_index, octree.getRootNode(),
+                               root_scale_coefficient_});
+    while (!stack.empty()) {
+      const OctreeIndex node_index = stack.top().node_index;
+      NodeConstRefType node = stack.top().node;
+      const FloatingPoint node_scale_coefficient =
+          stack.top().scale_coefficient;
+      stack.pop();
+
+      const typename Coefficients::CoefficientsArray child_scale_coefficients =
+          Transform::backward(
+              {node_scale_coefficient, load_details(node.data())});
+      for (NdtreeIndexRelativeChild child_idx = 0;
+           child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+        const OctreeIndex child_node_index =
+            node_index.computeChildIndex(child_idx);
+        if (!std::invoke(indicator_fn, child_node_index)) {
+          continue;
+        }
+        const FloatingPoint child_scale_coefficient =
+            child_scale_coefficients[child_idx];
+        auto child_node = node.getChild(child_idx);
+        if (child_node && termination_height < child_node_index.height) {
+          stack.emplace(StackElement{child_node_index, *child_node,
+                                     child_scale_coefficient});
+        } else {
+          if (!visitor::invoke(visitor_fn, child_node_index,
+                               child_scale_coefficient)) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  });
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::decompress() {
+  if (coefficient_storage_.isCompressed()) {
+    coefficient_storage_.decompress(ndtree_);
+    setNeedsPruning();
+  }
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::compact() {
+  if constexpr (std::is_same_v<OctreeType,
+                               LinearOctree<Coefficients::Details>>) {
+    ndtree_.compact();
+  }
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT,
+                                   NdtreeT>::compactIfFragmented() {
+  if constexpr (std::is_same_v<OctreeType,
+                               LinearOctree<Coefficients::Details>>) {
+    ndtree_.compactIfFragmented();
   }
-  return value;
 }
 }  // namespace wavemap
 
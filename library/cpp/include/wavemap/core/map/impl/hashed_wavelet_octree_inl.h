@@ -1,10 +1,15 @@
 #ifndef WAVEMAP_CORE_MAP_IMPL_HASHED_WAVELET_OCTREE_INL_H_
 #define WAVEMAP_CORE_MAP_IMPL_HASHED_WAVELET_OCTREE_INL_H_
 
+#include <functional>
+
 #include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/iterate/visitor_utils.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
 
 namespace wavemap {
-inline size_t HashedWaveletOctree::size() const {
+template <typename BlockT>
+size_t BasicHashedWaveletOctree<BlockT>::size() const {
   size_t size = 0u;
   forEachBlock([&size](const BlockIndex& /*block_index*/, const Block& block) {
     size += block.size();
@@ -12,7 +17,25 @@ inline size_t HashedWaveletOctree::size() const {
   return size;
 }
 
-inline FloatingPoint HashedWaveletOctree::getCellValue(
+template <typename BlockT>
+template <typename ShapeT>
+size_t BasicHashedWaveletOctree<BlockT>::getMemoryUsageInRegion(
+    const ShapeT& region) const {
+  if (empty()) {
+    return 0u;
+  }
+  const size_t hash_map_share = block_map_.getMemoryUsage() / block_map_.size();
+  size_t memory_usage = 0u;
+  forEachBlockInRegion(region, [&memory_usage, hash_map_share](
+                                   const BlockIndex& /*block_index*/,
+                                   const Block& block) {
+    memory_usage += hash_map_share + block.getMemoryUsage();
+  });
+  return memory_usage;
+}
+
+template <typename BlockT>
+FloatingPoint BasicHashedWaveletOctree<BlockT>::getCellValue(
     const Index3D& index) const {
   const BlockIndex block_index =
       convert::indexToBlockIndex(index, config_.tree_height);
@@ -24,7 +47,8 @@ inline FloatingPoint HashedWaveletOctree::getCellValue(
   return block->getCellValue(cell_index);
 }
 
-inline FloatingPoint HashedWaveletOctree::getCellValue(
+template <typename BlockT>
+FloatingPoint BasicHashedWaveletOctree<BlockT>::getCellValue(
     const OctreeIndex& index) const {
   const BlockIndex block_index = indexToBlockIndex(index);
   const Block* block = getBlock(block_index);
@@ -35,8 +59,9 @@ inline FloatingPoint HashedWaveletOctree::getCellValue(
   return block->getCellValue(cell_index);
 }
 
-inline void HashedWaveletOctree::setCellValue(const Index3D& index,
-                                              FloatingPoint new_value) {
+template <typename BlockT>
+void BasicHashedWaveletOctree<BlockT>::setCellValue(const Index3D& index,
+                                                    FloatingPoint new_value) {
   const BlockIndex block_index =
       convert::indexToBlockIndex(index, config_.tree_height);
   auto& block = getOrAllocateBlock(block_index);
@@ -44,8 +69,9 @@ inline void HashedWaveletOctree::setCellValue(const Index3D& index,
   block.setCellValue(cell_index, new_value);
 }
 
-inline void HashedWaveletOctree::addToCellValue(const Index3D& index,
-                                                FloatingPoint update) {
+template <typename BlockT>
+void BasicHashedWaveletOctree<BlockT>::addToCellValue(const Index3D& index,
+                                                      FloatingPoint update) {
   const BlockIndex block_index =
       convert::indexToBlockIndex(index, config_.tree_height);
   auto& block = getOrAllocateBlock(block_index);
@@ -53,55 +79,152 @@ inline void HashedWaveletOctree::addToCellValue(const Index3D& index,
   block.addToCellValue(cell_index, update);
 }
 
-inline bool HashedWaveletOctree::hasBlock(const Index3D& block_index) const {
+template <typename BlockT>
+bool BasicHashedWaveletOctree<BlockT>::hasBlock(
+    const Index3D& block_index) const {
   return block_map_.hasBlock(block_index);
 }
 
-inline bool HashedWaveletOctree::eraseBlock(
-    const HashedWaveletOctree::BlockIndex& block_index) {
+template <typename BlockT>
+bool BasicHashedWaveletOctree<BlockT>::eraseBlock(
+    const BlockIndex& block_index) {
   return block_map_.eraseBlock(block_index);
 }
 
+template <typename BlockT>
 template <typename IndexedBlockVisitor>
-void HashedWaveletOctree::eraseBlockIf(IndexedBlockVisitor indicator_fn) {
+void BasicHashedWaveletOctree<BlockT>::eraseBlockIf(
+    IndexedBlockVisitor indicator_fn) {
   block_map_.eraseBlockIf(indicator_fn);
 }
 
-inline HashedWaveletOctree::Block* HashedWaveletOctree::getBlock(
-    const Index3D& block_index) {
+template <typename BlockT>
+typename BasicHashedWaveletOctree<BlockT>::Block*
+BasicHashedWaveletOctree<BlockT>::getBlock(const Index3D& block_index) {
   return block_map_.getBlock(block_index);
 }
 
-inline const HashedWaveletOctree::Block* HashedWaveletOctree::getBlock(
-    const Index3D& block_index) const {
+template <typename BlockT>
+const typename BasicHashedWaveletOctree<BlockT>::Block*
+BasicHashedWaveletOctree<BlockT>::getBlock(const Index3D& block_index) const {
   return block_map_.getBlock(block_index);
 }
 
-inline HashedWaveletOctree::Block& HashedWaveletOctree::getOrAllocateBlock(
+template <typename BlockT>
+typename BasicHashedWaveletOctree<BlockT>::Block&
+BasicHashedWaveletOctree<BlockT>::getOrAllocateBlock(
     const Index3D& block_index) {
   return block_map_.getOrAllocateBlock(block_index, config_.tree_height,
                                        config_.min_log_odds,
                                        config_.max_log_odds);
 }
 
+template <typename BlockT>
 template <typename IndexedBlockVisitor>
-void HashedWaveletOctree::forEachBlock(IndexedBlockVisitor visitor_fn) {
+void BasicHashedWaveletOctree<BlockT>::forEachBlock(
+    IndexedBlockVisitor visitor_fn) {
   block_map_.forEachBlock(visitor_fn);
 }
 
+template <typename BlockT>
 template <typename IndexedBlockVisitor>
-void HashedWaveletOctree::forEachBlock(IndexedBlockVisitor visitor_fn) const {
+void BasicHashedWaveletOctree<BlockT>::forEachBlock(
+    IndexedBlockVisitor visitor_fn) const {
   block_map_.forEachBlock(visitor_fn);
 }
 
-inline HashedWaveletOctree::BlockIndex HashedWaveletOctree::indexToBlockIndex(
+template <typename BlockT>
+template <typename IndexedLeafVisitor>
+void BasicHashedWaveletOctree<BlockT>::forEachLeaf(
+    IndexedLeafVisitor visitor_fn, IndexElement termination_height) const {
+  for (const auto& [block_index, block] : getHashMap()) {
+    if (!block->forEachLeaf(block_index, visitor_fn, termination_height)) {
+      return;
+    }
+  }
+}
+
+template <typename BlockT>
+template <typename ShapeT, typename IndexedBlockVisitor>
+void BasicHashedWaveletOctree<BlockT>::forEachBlockInRegion(
+    const ShapeT& region, IndexedBlockVisitor visitor_fn) const {
+  const FloatingPoint min_cell_width = getMinCellWidth();
+  const FloatingPoint block_width =
+      convert::heightToCellWidth(min_cell_width, getTreeHeight());
+  const auto block_index_range = convert::aabbToBlockIndexRange(
+      static_cast<AABB<Point3D>>(region), 1.f / block_width);
+  block_map_.forEachBlockInRange(
+      block_index_range.first, block_index_range.second,
+      [&region, &visitor_fn, min_cell_width, tree_height = getTreeHeight()](
+          const BlockIndex& block_index, const Block& block) {
+        const OctreeIndex block_node_index{tree_height, block_index};
+        if (!shape::overlaps(
+                convert::nodeIndexToAABB(block_node_index, min_cell_width),
+                region)) {
+          return true;
+        }
+        return visitor::invoke(visitor_fn, block_index, block);
+      });
+}
+
+template <typename BlockT>
+template <typename ShapeT, typename IndexedLeafVisitor>
+void BasicHashedWaveletOctree<BlockT>::forEachLeafInRegion(
+    const ShapeT& region, IndexedLeafVisitor visitor_fn,
+    IndexElement termination_height) const {
+  auto overlaps_region = [&region, min_cell_width = getMinCellWidth()](
+                             const OctreeIndex& node_index) {
+    return shape::overlaps(
+        convert::nodeIndexToAABB(node_index, min_cell_width), region);
+  };
+  forEachBlockInRegion(
+      region, [&overlaps_region, &visitor_fn, termination_height](
+                  const BlockIndex& block_index, const Block& block) {
+        return block.forEachLeafIf(block_index, overlaps_region, visitor_fn,
+                                   termination_height);
+      });
+}
+
+template <typename BlockT>
+template <typename IndexedLeafVisitor>
+void BasicHashedWaveletOctree<BlockT>::forEachLeafParallel(
+    ThreadPool& thread_pool, IndexedLeafVisitor visitor_fn,
+    const std::optional<AABB<Point3D>>& region,
+    IndexElement termination_height) const {
+  auto overlaps_region = [&region, min_cell_width = getMinCellWidth()](
+                             const OctreeIndex& node_index) {
+    return shape::overlaps(
+        convert::nodeIndexToAABB(node_index, min_cell_width), region.value());
+  };
+  auto add_block_task = [&](const BlockIndex& block_index, const Block& block) {
+    thread_pool.add_task([&, block_index]() {
+      if (region) {
+        block.forEachLeafIf(block_index, overlaps_region, visitor_fn,
+                            termination_height);
+      } else {
+        block.forEachLeaf(block_index, visitor_fn, termination_height);
+      }
+    });
+  };
+  if (region) {
+    forEachBlockInRegion(region.value(), add_block_task);
+  } else {
+    forEachBlock(add_block_task);
+  }
+  thread_pool.wait_all();
+}
+
+template <typename BlockT>
+typename BasicHashedWaveletOctree<BlockT>::BlockIndex
+BasicHashedWaveletOctree<BlockT>::indexToBlockIndex(
     const OctreeIndex& node_index) const {
   const Index3D index = convert::nodeIndexToMinCornerIndex(node_index);
   return convert::indexToBlockIndex(index, config_.tree_height);
 }
 
-inline HashedWaveletOctree::CellIndex HashedWaveletOctree::indexToCellIndex(
-    OctreeIndex index) const {
+template <typename BlockT>
+typename BasicHashedWaveletOctree<BlockT>::CellIndex
+BasicHashedWaveletOctree<BlockT>::indexToCellIndex(OctreeIndex index) const {
   DCHECK_LE(index.height, config_.tree_height);
   const IndexElement height_difference = config_.tree_height - index.height;
   index.position =
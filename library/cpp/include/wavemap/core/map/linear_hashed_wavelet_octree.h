@@ -0,0 +1,20 @@
+#ifndef WAVEMAP_CORE_MAP_LINEAR_HASHED_WAVELET_OCTREE_H_
+#define WAVEMAP_CORE_MAP_LINEAR_HASHED_WAVELET_OCTREE_H_
+
+#include "wavemap/core/data_structure/linear_ndtree/linear_ndtree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree_block.h"
+
+namespace wavemap {
+/**
+ * Variant of the HashedWaveletOctree whose blocks store their octrees in a
+ * single contiguous array, using the LinearOctree, instead of linking the nodes
+ * through pointers. It is configured exactly like the HashedWaveletOctree and
+ * stores the same values, but uses less memory and offers better cache locality
+ * for lookups and leaf iteration.
+ */
+using LinearHashedWaveletOctree =
+    BasicHashedWaveletOctree<LinearHashedWaveletOctreeBlock>;
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_MAP_LINEAR_HASHED_WAVELET_OCTREE_H_
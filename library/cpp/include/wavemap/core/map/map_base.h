@@ -19,12 +19,15 @@ struct MapType : TypeSelector<MapType> {
     kOctree,
     kWaveletOctree,
     kHashedWaveletOctree,
-    kHashedChunkedWaveletOctree
+    kHashedChunkedWaveletOctree,
+    kQuantizedHashedWaveletOctree,
+    kLinearHashedWaveletOctree
   };
 
   static constexpr std::array names = {
       "hashed_blocks", "octree", "wavelet_octree", "hashed_wavelet_octree",
-      "hashed_chunked_wavelet_octree"};
+      "hashed_chunked_wavelet_octree", "quantized_hashed_wavelet_octree",
+      "linear_hashed_wavelet_octree"};
 };
 
 /**
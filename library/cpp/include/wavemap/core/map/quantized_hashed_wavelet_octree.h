@@ -0,0 +1,25 @@
+#ifndef WAVEMAP_CORE_MAP_QUANTIZED_HASHED_WAVELET_OCTREE_H_
+#define WAVEMAP_CORE_MAP_QUANTIZED_HASHED_WAVELET_OCTREE_H_
+
+#include "wavemap/core/map/coefficient_storage.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree_block.h"
+
+namespace wavemap {
+/**
+ * Variant of the HashedWaveletOctree that stores the detail coefficients of
+ * its pruned blocks with 16 bit fixed-point precision, roughly halving the
+ * size of each octree node. It is configured exactly like the
+ * HashedWaveletOctree. Blocks are updated at full precision and are only
+ * quantized once they are pruned, such that pruneSmart() keeps the blocks
+ * that are still being updated at full precision. The values of quantized
+ * blocks differ from those at full precision by at most
+ * QuantizedCoefficientStorage::getMaxQuantizationError(...).
+ */
+using QuantizedHashedWaveletOctreeBlock =
+    BasicHashedWaveletOctreeBlock<QuantizedCoefficientStorage>;
+using QuantizedHashedWaveletOctree =
+    BasicHashedWaveletOctree<QuantizedHashedWaveletOctreeBlock>;
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_MAP_QUANTIZED_HASHED_WAVELET_OCTREE_H_
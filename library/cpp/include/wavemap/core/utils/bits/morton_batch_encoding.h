@@ -0,0 +1,64 @@
+#ifndef WAVEMAP_CORE_UTILS_BITS_MORTON_BATCH_ENCODING_H_
+#define WAVEMAP_CORE_UTILS_BITS_MORTON_BATCH_ENCODING_H_
+
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/config/type_selector.h"
+#include "wavemap/core/utils/bits/morton_encoding.h"
+
+namespace wavemap::morton {
+/**
+ * Implementations that can be used to Morton encode and decode batches of 3D
+ * indices. All codecs produce results identical to morton::encode<3> and
+ * morton::decode<3>, but differ in the CPU features they require.
+ * - scalar: Encodes one index at a time, using the same method as
+ *   morton::encode<3>. Available on all CPUs.
+ * - bmi2: Uses the BMI2 bit deposit and extract instructions (pdep/pext).
+ * - avx2: Spreads the bits of four indices at once using AVX2 shifts and
+ *   masks.
+ */
+struct BatchCodecType : public TypeSelector<BatchCodecType> {
+  using TypeSelector<BatchCodecType>::TypeSelector;
+
+  enum Id : TypeId { kScalar, kBmi2, kAvx2 };
+
+  static constexpr std::array names = {"scalar", "bmi2", "avx2"};
+};
+
+//! Whether the given codec is supported by the CPU the program is running on
+bool isSupported(BatchCodecType codec);
+
+//! The fastest codec supported by the CPU the program is running on
+BatchCodecType getDefaultBatchCodec();
+
+//! Morton encode the given indices, writing the codes to codes[0, num_indices)
+void encode_batch(const Index3D* indices, size_t num_indices,
+                  MortonIndex* codes, BatchCodecType codec);
+inline void encode_batch(const Index3D* indices, size_t num_indices,
+                         MortonIndex* codes) {
+  encode_batch(indices, num_indices, codes, getDefaultBatchCodec());
+}
+inline std::vector<MortonIndex> encode_batch(
+    const std::vector<Index3D>& indices) {
+  std::vector<MortonIndex> codes(indices.size());
+  encode_batch(indices.data(), indices.size(), codes.data());
+  return codes;
+}
+
+//! Decode the given Morton codes, writing the indices to indices[0, num_codes)
+void decode_batch(const MortonIndex* codes, size_t num_codes, Index3D* indices,
+                  BatchCodecType codec);
+inline void decode_batch(const MortonIndex* codes, size_t num_codes,
+                         Index3D* indices) {
+  decode_batch(codes, num_codes, indices, getDefaultBatchCodec());
+}
+inline std::vector<Index3D> decode_batch(
+    const std::vector<MortonIndex>& codes) {
+  std::vector<Index3D> indices(codes.size());
+  decode_batch(codes.data(), codes.size(), indices.data());
+  return indices;
+}
+}  // namespace wavemap::morton
+
+#endif  // WAVEMAP_CORE_UTILS_BITS_MORTON_BATCH_ENCODING_H_
@@ -0,0 +1,26 @@
+#ifndef WAVEMAP_CORE_UTILS_CPU_CPU_FEATURES_H_
+#define WAVEMAP_CORE_UTILS_CPU_CPU_FEATURES_H_
+
+namespace wavemap::cpu {
+/**
+ * Instruction set extensions that wavemap's hot kernels can use, as supported
+ * by the CPU the program is running on. Unlike the compiler's predefined macros
+ * (e.g. __AVX2__), which describe the CPU the code was compiled for, these
+ * flags are detected at runtime. This allows a single binary to select the
+ * fastest kernels the current CPU supports.
+ */
+struct Features {
+  bool bmi2 = false;
+  bool avx2 = false;
+  bool avx512f = false;
+  //! Microarchitecture levels, as defined by the x86-64 psABI. Level 3 adds
+  //! AVX2, BMI2 and FMA to the x86-64 baseline, level 4 adds AVX-512.
+  bool x86_64_v3 = false;
+  bool x86_64_v4 = false;
+};
+
+//! Features of the current CPU, detected once on first use
+const Features& getFeatures();
+}  // namespace wavemap::cpu
+
+#endif  // WAVEMAP_CORE_UTILS_CPU_CPU_FEATURES_H_
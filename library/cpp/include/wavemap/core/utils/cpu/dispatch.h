@@ -0,0 +1,39 @@
+#ifndef WAVEMAP_CORE_UTILS_CPU_DISPATCH_H_
+#define WAVEMAP_CORE_UTILS_CPU_DISPATCH_H_
+
+#include <string>
+#include <vector>
+
+// Hot kernels annotated with WAVEMAP_MULTIVERSIONED are compiled once for each
+// of the x86-64 microarchitecture levels below. When the program is loaded,
+// each call is bound to the variant that best matches the CPU. This allows
+// portable builds, e.g. distro packages that target generic x86-64, to use
+// AVX2 and AVX-512 where available. Builds whose baseline already includes
+// AVX2, such as builds with -march=native, skip the variants since they would
+// be (nearly) identical.
+// NOTE: Eigen selects its explicit vectorization at compile time. The variants
+//       therefore mainly benefit from auto-vectorization and FMA contraction.
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__) && \
+    !defined(__clang__) && 12 <= __GNUC__ && !defined(__AVX2__)
+#define WAVEMAP_MULTIVERSIONING_ENABLED
+#define WAVEMAP_MULTIVERSIONED \
+  __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define WAVEMAP_MULTIVERSIONED
+#endif
+
+namespace wavemap::cpu {
+//! The code path used by one of wavemap's hot kernels
+struct KernelPath {
+  std::string kernel;
+  std::string path;
+};
+
+//! Report which code paths wavemap's hot kernels use on the current CPU
+std::vector<KernelPath> getActiveKernelPaths();
+
+//! Convenience method to print the report above, e.g. in startup logs
+std::string getActiveKernelPathsStr();
+}  // namespace wavemap::cpu
+
+#endif  // WAVEMAP_CORE_UTILS_CPU_DISPATCH_H_
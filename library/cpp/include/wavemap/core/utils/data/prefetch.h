@@ -0,0 +1,24 @@
+#ifndef WAVEMAP_CORE_UTILS_DATA_PREFETCH_H_
+#define WAVEMAP_CORE_UTILS_DATA_PREFETCH_H_
+
+#include "wavemap/core/common.h"
+
+namespace wavemap::data {
+// Size of a cache line on the x86-64 and most ARM CPUs wavemap runs on
+// NOTE: We do not use std::hardware_destructive_interference_size since its
+//       value can differ between compilers, which would change the layout of
+//       the data structures that are aligned to it.
+static constexpr size_t kCacheLineSize = 64;
+
+// Hint that the cache line containing the given address will soon be read, such
+// that the CPU can fetch it while other work is being done
+inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, /*rw=*/0, /*locality=*/3);
+#else
+  static_cast<void>(address);
+#endif
+}
+}  // namespace wavemap::data
+
+#endif  // WAVEMAP_CORE_UTILS_DATA_PREFETCH_H_
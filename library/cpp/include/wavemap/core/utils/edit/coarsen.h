@@ -0,0 +1,38 @@
+#ifndef WAVEMAP_CORE_UTILS_EDIT_COARSEN_H_
+#define WAVEMAP_CORE_UTILS_EDIT_COARSEN_H_
+
+#include <memory>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap::edit {
+// Center of the most recently updated block, which approximates the sensor's
+// current position when no pose is available. Returns the origin if the map is
+// empty.
+template <typename MapT>
+Point3D getMostRecentlyUpdatedBlockCenter(const MapT& map);
+
+// Discard the detail coefficients below the termination height in all blocks
+// that pass the indicator, such that they are only represented down to cells
+// at that height. The indicator is called with each block's index and block.
+// The blocks are coarsened in parallel if a thread pool is provided.
+// Returns the number of blocks that had coefficients discarded.
+template <typename MapT, typename BlockIndicatorT>
+size_t coarsenIf(MapT& map, IndexElement termination_height,
+                 BlockIndicatorT indicator_fn,
+                 const std::shared_ptr<ThreadPool>& thread_pool = nullptr);
+
+// Coarsen the blocks that lie fully outside the given sphere, or that have not
+// been updated for longer than the max block age. Setting the radius or the
+// max block age to zero or less disables the corresponding criterion.
+template <typename MapT>
+size_t coarsen(MapT& map, IndexElement termination_height,
+               const Point3D& center, FloatingPoint radius,
+               FloatingPoint max_block_age,
+               const std::shared_ptr<ThreadPool>& thread_pool = nullptr);
+}  // namespace wavemap::edit
+
+#include "wavemap/core/utils/edit/impl/coarsen_inl.h"
+
+#endif  // WAVEMAP_CORE_UTILS_EDIT_COARSEN_H_
@@ -0,0 +1,33 @@
+#ifndef WAVEMAP_CORE_UTILS_EDIT_ENFORCE_MEMORY_BUDGET_H_
+#define WAVEMAP_CORE_UTILS_EDIT_ENFORCE_MEMORY_BUDGET_H_
+
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/common.h"
+
+namespace wavemap::edit {
+namespace detail {
+// Indices of all the map's blocks, sorted from furthest to nearest
+template <typename MapT>
+std::vector<std::pair<FloatingPoint, Index3D>> getBlocksByDistance(
+    const MapT& map, const Point3D& focus_point);
+}  // namespace detail
+
+// Reduce the map's memory usage, in bytes, to at most the given budget. The
+// map is reduced in increasingly lossy steps, stopping once the budget is met:
+// 1. Prune all blocks, including those that were updated recently
+// 2. Coarsen the blocks from furthest to nearest to the focus point, first to
+//    height 1 and then one height at a time up to the max coarsening height
+// 3. Erase the blocks from furthest to nearest, if eviction is allowed
+// Returns the map's memory usage once done.
+template <typename MapT>
+size_t enforceMemoryBudget(MapT& map, size_t memory_budget,
+                           const Point3D& focus_point,
+                           IndexElement max_coarsening_height,
+                           bool allow_eviction);
+}  // namespace wavemap::edit
+
+#include "wavemap/core/utils/edit/impl/enforce_memory_budget_inl.h"
+
+#endif  // WAVEMAP_CORE_UTILS_EDIT_ENFORCE_MEMORY_BUDGET_H_
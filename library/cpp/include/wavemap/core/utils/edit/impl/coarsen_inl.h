@@ -0,0 +1,111 @@
+#ifndef WAVEMAP_CORE_UTILS_EDIT_IMPL_COARSEN_INL_H_
+#define WAVEMAP_CORE_UTILS_EDIT_IMPL_COARSEN_INL_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/profile/metrics.h"
+
+namespace wavemap::edit {
+template <typename MapT>
+Point3D getMostRecentlyUpdatedBlockCenter(const MapT& map) {
+  if (map.empty()) {
+    return Point3D::Zero();
+  }
+  Index3D newest_block_index = Index3D::Zero();
+  Timestamp newest_block_stamp = Timestamp::min();
+  map.forEachBlock([&newest_block_index, &newest_block_stamp](
+                       const Index3D& block_index, const auto& block) {
+    if (newest_block_stamp < block.getLastUpdatedStamp()) {
+      newest_block_index = block_index;
+      newest_block_stamp = block.getLastUpdatedStamp();
+    }
+  });
+  const OctreeIndex newest_block_node_index{map.getTreeHeight(),
+                                            newest_block_index};
+  return convert::nodeIndexToCenterPoint(newest_block_node_index,
+                                         map.getMinCellWidth());
+}
+
+template <typename MapT, typename BlockIndicatorT>
+size_t coarsenIf(MapT& map, IndexElement termination_height,
+                 BlockIndicatorT indicator_fn,
+                 const std::shared_ptr<ThreadPool>& thread_pool) {
+  static auto& coarsened_blocks =
+      metrics::getCounter("map_coarsened_blocks_total");
+  if (termination_height <= 0) {
+    return 0u;
+  }
+
+  // Select the blocks to coarsen
+  // NOTE: The blocks are only accessed for writing once they were selected,
+  //       such that blocks shared with map snapshots are not copied
+  //       needlessly.
+  std::vector<Index3D> selected_blocks;
+  std::as_const(map).forEachBlock(
+      [&indicator_fn, &selected_blocks](const Index3D& block_index,
+                                        const auto& block) {
+        if (indicator_fn(block_index, block)) {
+          selected_blocks.emplace_back(block_index);
+        }
+      });
+
+  // Coarsen the selected blocks
+  // NOTE: Coarsening only marks the blocks as modified, not as updated, such
+  //       that their age still reflects when they were last observed.
+  std::atomic<size_t> num_coarsened_blocks = 0u;
+  for (const Index3D& block_index : selected_blocks) {
+    auto* block_ptr = map.getBlock(block_index);
+    if (thread_pool) {
+      thread_pool->add_task(
+          [block_ptr, termination_height, &num_coarsened_blocks]() {
+            if (block_ptr->coarsen(termination_height)) {
+              ++num_coarsened_blocks;
+            }
+          });
+    } else if (block_ptr->coarsen(termination_height)) {
+      ++num_coarsened_blocks;
+    }
+  }
+
+  // Wait for all parallel jobs to finish
+  if (thread_pool) {
+    thread_pool->wait_all();
+  }
+
+  coarsened_blocks.increment(num_coarsened_blocks);
+  return num_coarsened_blocks;
+}
+
+template <typename MapT>
+size_t coarsen(MapT& map, IndexElement termination_height,
+               const Point3D& center, FloatingPoint radius,
+               FloatingPoint max_block_age,
+               const std::shared_ptr<ThreadPool>& thread_pool) {
+  const IndexElement tree_height = map.getTreeHeight();
+  const FloatingPoint min_cell_width = map.getMinCellWidth();
+  return coarsenIf(
+      map, termination_height,
+      [&center, radius, max_block_age, tree_height, min_cell_width](
+          const Index3D& block_index, const auto& block) {
+        if (0.f < max_block_age &&
+            max_block_age < block.getTimeSinceLastUpdated()) {
+          return true;
+        }
+        if (0.f < radius) {
+          const OctreeIndex block_node_index{tree_height, block_index};
+          const auto block_aabb =
+              convert::nodeIndexToAABB(block_node_index, min_cell_width);
+          return radius < block_aabb.minDistanceTo(center);
+        }
+        return false;
+      },
+      thread_pool);
+}
+}  // namespace wavemap::edit
+
+#endif  // WAVEMAP_CORE_UTILS_EDIT_IMPL_COARSEN_INL_H_
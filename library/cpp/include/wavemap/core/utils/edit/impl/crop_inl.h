@@ -2,6 +2,7 @@
 #define WAVEMAP_CORE_UTILS_EDIT_IMPL_CROP_INL_H_
 
 #include <memory>
+#include <vector>
 
 #include "wavemap/core/indexing/index_conversions.h"
 #include "wavemap/core/utils/shape/intersection_tests.h"
@@ -14,7 +15,9 @@ void cropLeavesBatch(typename MapT::Block::OctreeType::NodeRefType node,
                      ShapeT&& mask, FloatingPoint min_cell_width) {
   // Decompress child values
   using Transform = typename MapT::Block::Transform;
-  auto& node_details = node.data();
+  // NOTE: The details are copied, as allocating or erasing children can
+  //       invalidate references into linear octrees' node storage.
+  const auto node_details = node.data();
   auto child_values = Transform::backward({node_value, {node_details}});
 
   // Set all children whose center is outside the cropping shape to zero
@@ -34,7 +37,7 @@ void cropLeavesBatch(typename MapT::Block::OctreeType::NodeRefType node,
   // Compress
   const auto [new_value, new_details] =
       MapT::Block::Transform::forward(child_values);
-  node_details = new_details;
+  node.data() = new_details;
   node_value = new_value;
 }
 
@@ -47,7 +50,9 @@ void cropNodeRecursive(typename MapT::Block::OctreeType::NodeRefType node,
 
   // Decompress child values
   using Transform = typename MapT::Block::Transform;
-  auto& node_details = node.data();
+  // NOTE: The details are copied, as allocating or erasing children can
+  //       invalidate references into linear octrees' node storage.
+  const auto node_details = node.data();
   auto child_values = Transform::backward({node_value, {node_details}});
 
   // Handle each child
@@ -82,7 +87,7 @@ void cropNodeRecursive(typename MapT::Block::OctreeType::NodeRefType node,
 
   // Compress
   const auto [new_value, new_details] = Transform::forward(child_values);
-  node_details = new_details;
+  node.data() = new_details;
   node_value = new_value;
 }
 }  // namespace detail
@@ -95,6 +100,9 @@ void crop(MapT& map, ShapeT mask, IndexElement termination_height,
   const FloatingPoint min_cell_width = map.getMinCellWidth();
 
   // Check all blocks
+  // NOTE: Blocks are erased through the map once the iteration is done, such
+  //       that auxiliary structures such as the block directory stay in sync.
+  std::vector<Index3D> blocks_to_erase;
   for (auto it = map.getHashMap().begin(); it != map.getHashMap().end();) {
     // Start by testing at the block level
     const Index3D& block_index = it->first;
@@ -108,13 +116,14 @@ void crop(MapT& map, ShapeT mask, IndexElement termination_height,
     }
     // If the block is fully outside the cropping shape, erase it entirely
     if (!shape::overlaps(block_aabb, mask)) {
-      it = map.getHashMap().erase(it);
+      blocks_to_erase.emplace_back(block_index);
+      ++it;
       continue;
     }
 
     // Since the block overlaps with the shape's boundary, we need to process
     // it at a higher resolution by recursing over its cells
-    auto& block = it->second;
+    auto& block = *map.getBlock(block_index);
     // Indicate that the block has changed
     block.setLastUpdatedStamp();
     // Get pointers to the root value and node, which contain the wavelet
@@ -142,6 +151,11 @@ void crop(MapT& map, ShapeT mask, IndexElement termination_height,
   if (thread_pool) {
     thread_pool->wait_all();
   }
+
+  // Erase the blocks that were fully outside the cropping shape
+  for (const Index3D& block_index : blocks_to_erase) {
+    map.eraseBlock(block_index);
+  }
 }
 }  // namespace wavemap::edit
 
@@ -0,0 +1,107 @@
+#ifndef WAVEMAP_CORE_UTILS_EDIT_IMPL_ENFORCE_MEMORY_BUDGET_INL_H_
+#define WAVEMAP_CORE_UTILS_EDIT_IMPL_ENFORCE_MEMORY_BUDGET_INL_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/profile/metrics.h"
+
+namespace wavemap::edit {
+namespace detail {
+template <typename MapT>
+std::vector<std::pair<FloatingPoint, Index3D>> getBlocksByDistance(
+    const MapT& map, const Point3D& focus_point) {
+  std::vector<std::pair<FloatingPoint, Index3D>> blocks_by_distance;
+  blocks_by_distance.reserve(map.getHashMap().size());
+  map.forEachBlock(
+      [&blocks_by_distance, &focus_point, tree_height = map.getTreeHeight(),
+       min_cell_width = map.getMinCellWidth()](const Index3D& block_index,
+                                               const auto& /*block*/) {
+        const OctreeIndex block_node_index{tree_height, block_index};
+        const FloatingPoint distance =
+            convert::nodeIndexToAABB(block_node_index, min_cell_width)
+                .minDistanceTo(focus_point);
+        blocks_by_distance.emplace_back(distance, block_index);
+      });
+  std::sort(blocks_by_distance.begin(), blocks_by_distance.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return rhs.first < lhs.first;
+            });
+  return blocks_by_distance;
+}
+}  // namespace detail
+
+template <typename MapT>
+size_t enforceMemoryBudget(MapT& map, size_t memory_budget,
+                           const Point3D& focus_point,
+                           IndexElement max_coarsening_height,
+                           bool allow_eviction) {
+  size_t memory_usage = map.getMemoryUsage();
+  if (memory_usage <= memory_budget) {
+    return memory_usage;
+  }
+
+  // Prune all blocks, instead of only those that have not been updated lately
+  map.prune();
+  memory_usage = map.getMemoryUsage();
+  if (memory_usage <= memory_budget) {
+    return memory_usage;
+  }
+
+  // Progressively coarsen the blocks, starting with the furthest ones
+  static auto& coarsened_blocks =
+      metrics::getCounter("map_coarsened_blocks_total");
+  const auto blocks_by_distance =
+      detail::getBlocksByDistance(std::as_const(map), focus_point);
+  const IndexElement max_termination_height =
+      std::min(max_coarsening_height, map.getTreeHeight());
+  for (IndexElement termination_height = 1;
+       termination_height <= max_termination_height; ++termination_height) {
+    for (const auto& [distance, block_index] : blocks_by_distance) {
+      auto* block = map.getBlock(block_index);
+      const size_t block_memory_usage = block->getMemoryUsage();
+      block->coarsen(termination_height);
+      const size_t freed_memory = block_memory_usage - block->getMemoryUsage();
+      if (0u < freed_memory) {
+        memory_usage -= freed_memory;
+        coarsened_blocks.increment();
+      }
+      if (memory_usage <= memory_budget) {
+        return memory_usage;
+      }
+    }
+  }
+  if (!allow_eviction) {
+    return memory_usage;
+  }
+
+  // Erase the furthest blocks
+  // NOTE: Since the hash map's memory usage is split among the blocks, the
+  //       memory freed by erasing each block is only estimated. The exact
+  //       memory usage is therefore recomputed after each pass, and more blocks
+  //       are erased if the estimate turned out to be too optimistic.
+  static auto& evicted_blocks = metrics::getCounter("map_evicted_blocks_total");
+  auto block_it = blocks_by_distance.cbegin();
+  while (memory_budget < memory_usage &&
+         block_it != blocks_by_distance.cend()) {
+    size_t estimated_memory_usage = memory_usage;
+    while (memory_budget < estimated_memory_usage &&
+           block_it != blocks_by_distance.cend()) {
+      const Index3D& block_index = block_it->second;
+      const size_t block_memory_usage = map.getBlockMemoryUsage(block_index);
+      map.eraseBlock(block_index);
+      evicted_blocks.increment();
+      estimated_memory_usage -=
+          std::min(estimated_memory_usage, block_memory_usage);
+      ++block_it;
+    }
+    memory_usage = map.getMemoryUsage();
+  }
+  return memory_usage;
+}
+}  // namespace wavemap::edit
+
+#endif  // WAVEMAP_CORE_UTILS_EDIT_IMPL_ENFORCE_MEMORY_BUDGET_INL_H_
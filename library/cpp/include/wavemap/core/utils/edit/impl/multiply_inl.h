@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/meta/type_utils.h"
 
 namespace wavemap::edit {
 namespace detail {
@@ -20,6 +21,30 @@ void multiplyNodeRecursive(typename MapT::Block::OctreeType::NodeRefType node,
     }
   }
 }
+
+template <typename ChunkT>
+void multiplyChunkRecursive(ChunkT& chunk, FloatingPoint multiplier) {
+  // Multiply the values of all nodes in the chunk at once
+  // NOTE: Nodes that are not part of the tree hold zero data, which remains
+  //       zero. Skipping the per node existence checks lets the compiler
+  //       vectorize the loop over the chunk's contiguous coefficients.
+  for (auto& node_data : chunk.getNodeData()) {
+    for (auto& coefficient : node_data) {
+      coefficient *= multiplier;
+    }
+  }
+
+  // Recursively handle all child chunks
+  if (!chunk.hasChildrenArray()) {
+    return;
+  }
+  for (LinearIndex child_idx = 0; child_idx < ChunkT::kNumChildren;
+       ++child_idx) {
+    if (ChunkT* child_chunk = chunk.getChild(child_idx); child_chunk) {
+      multiplyChunkRecursive(*child_chunk, multiplier);
+    }
+  }
+}
 }  // namespace detail
 
 template <typename MapT>
@@ -37,7 +62,22 @@ void multiply(MapT& map, FloatingPoint multiplier,
         FloatingPoint& root_value = block.getRootScale();
         root_value *= multiplier;
 
-        // Recursively multiply all node values (wavelet detail coefficients)
+        // For chunked octrees, multiply all node values (wavelet detail
+        // coefficients) chunk by chunk
+        if constexpr (meta::has_get_root_chunk_member_fn_v<
+                          typename MapT::Block>) {
+          auto* root_chunk_ptr = &block.getRootChunk();
+          if (thread_pool) {
+            thread_pool->add_task([root_chunk_ptr, multiplier]() {
+              detail::multiplyChunkRecursive(*root_chunk_ptr, multiplier);
+            });
+          } else {
+            detail::multiplyChunkRecursive(*root_chunk_ptr, multiplier);
+          }
+          return;
+        }
+
+        // Otherwise, recursively multiply them node by node
         NodePtrType root_node_ptr = &block.getRootNode();
         if (thread_pool) {
           thread_pool->add_task([root_node_ptr, multiplier]() {
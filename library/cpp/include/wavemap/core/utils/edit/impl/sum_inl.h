@@ -7,30 +7,70 @@
 
 #include "wavemap/core/indexing/index_conversions.h"
 #include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/math/tree_math.h"
+#include "wavemap/core/utils/meta/type_utils.h"
 #include "wavemap/core/utils/shape/aabb.h"
 #include "wavemap/core/utils/shape/intersection_tests.h"
 
 namespace wavemap::edit {
 namespace detail {
-template <typename MapT>
-void sumNodeRecursive(
-    typename MapT::Block::OctreeType::NodeRefType node_A,
-    typename MapT::Block::OctreeType::NodeConstRefType node_B) {
+template <typename MapT, typename NodeTypeB, typename DetailsLoaderB>
+void sumNodeRecursive(typename MapT::Block::OctreeType::NodeRefType node_A,
+                      const NodeTypeB& node_B, DetailsLoaderB load_details_B) {
   using NodeRefType = decltype(node_A);
-  using NodeConstPtrType = typename MapT::Block::OctreeType::NodeConstPtrType;
 
   // Sum
-  node_A.data() += node_B.data();
+  node_A.data() += load_details_B(node_B.data());
 
   // Recursively handle all child nodes
   for (NdtreeIndexRelativeChild child_idx = 0;
        child_idx < OctreeIndex::kNumChildren; ++child_idx) {
-    NodeConstPtrType child_node_B = node_B.getChild(child_idx);
+    const auto child_node_B = node_B.getChild(child_idx);
     if (!child_node_B) {
       continue;
     }
     NodeRefType child_node_A = node_A.getOrAllocateChild(child_idx);
-    sumNodeRecursive<MapT>(child_node_A, *child_node_B);
+    sumNodeRecursive<MapT>(child_node_A, *child_node_B, load_details_B);
+  }
+}
+
+template <typename ChunkT>
+void sumChunkRecursive(ChunkT& chunk_A, const ChunkT& chunk_B) {
+  // Sum the values of all nodes in the chunks at once
+  // NOTE: Nodes that are not part of the tree hold zero data, so the nodes
+  //       that only exist in chunk A are left unchanged.
+  auto& node_data_A = chunk_A.getNodeData();
+  const auto& node_data_B = chunk_B.getNodeData();
+  for (LinearIndex node_idx = 0; node_idx < ChunkT::kNumInnerNodes;
+       ++node_idx) {
+    auto& node_A = node_data_A[node_idx];
+    const auto& node_B = node_data_B[node_idx];
+    for (size_t coeff_idx = 0; coeff_idx < node_A.size(); ++coeff_idx) {
+      node_A[coeff_idx] += node_B[coeff_idx];
+    }
+  }
+
+  // All nodes that exist in chunk B now also exist in chunk A
+  chunk_A.getNodeHasAtLeastOneChild() |= chunk_B.getNodeHasAtLeastOneChild();
+
+  // Recursively handle all child chunks that are part of tree B
+  if (!chunk_B.hasChildrenArray()) {
+    return;
+  }
+  constexpr LinearIndex kLastLevelOffset =
+      tree_math::perfect_tree::num_total_nodes<ChunkT::kDim>(ChunkT::kHeight -
+                                                             1);
+  for (LinearIndex child_idx = 0; child_idx < ChunkT::kNumChildren;
+       ++child_idx) {
+    const LinearIndex parent_idx =
+        kLastLevelOffset + (child_idx >> ChunkT::kDim);
+    if (!chunk_B.nodeHasAtLeastOneChild(parent_idx)) {
+      continue;
+    }
+    if (const ChunkT* child_chunk_B = chunk_B.getChild(child_idx);
+        child_chunk_B) {
+      sumChunkRecursive(chunk_A.getOrAllocateChild(child_idx), *child_chunk_B);
+    }
   }
 }
 
@@ -180,7 +220,6 @@ void sum(MapT& map_A, const MapT& map_B,
   CHECK_EQ(map_A.getTreeHeight(), map_B.getTreeHeight());
   CHECK_EQ(map_A.getMinCellWidth(), map_B.getMinCellWidth());
   using NodePtrType = typename MapT::Block::OctreeType::NodePtrType;
-  using NodeConstPtrType = typename MapT::Block::OctreeType::NodeConstPtrType;
 
   // Process all blocks
   map_B.forEachBlock(
@@ -194,18 +233,40 @@ void sum(MapT& map_A, const MapT& map_B,
         // Sum the blocks' average values (wavelet scale coefficient)
         block_A.getRootScale() += block_B.getRootScale();
 
-        // Recursively sum all node values (wavelet detail coefficients)
-        NodePtrType root_node_ptr_A = &block_A.getRootNode();
-        NodeConstPtrType root_node_ptr_B = &block_B.getRootNode();
-        if (thread_pool) {
-          thread_pool->add_task([root_node_ptr_A, root_node_ptr_B,
-                                 block_ptr_A = &block_A]() {
-            detail::sumNodeRecursive<MapT>(*root_node_ptr_A, *root_node_ptr_B);
-            block_ptr_A->prune();
-          });
+        // For chunked octrees, sum all node values (wavelet detail
+        // coefficients) chunk by chunk
+        if constexpr (meta::has_get_root_chunk_member_fn_v<
+                          typename MapT::Block>) {
+          auto* root_chunk_ptr_A = &block_A.getRootChunk();
+          const auto* root_chunk_ptr_B = &block_B.getRootChunk();
+          if (thread_pool) {
+            thread_pool->add_task([root_chunk_ptr_A, root_chunk_ptr_B,
+                                   block_ptr_A = &block_A]() {
+              detail::sumChunkRecursive(*root_chunk_ptr_A, *root_chunk_ptr_B);
+              block_ptr_A->prune();
+            });
+          } else {
+            detail::sumChunkRecursive(*root_chunk_ptr_A, *root_chunk_ptr_B);
+            block_A.prune();
+          }
         } else {
-          detail::sumNodeRecursive<MapT>(*root_node_ptr_A, *root_node_ptr_B);
-          block_A.prune();
+          // Otherwise, recursively sum them node by node
+          NodePtrType root_node_ptr_A = &block_A.getRootNode();
+          block_B.visitOctree([&](const auto& octree_B, auto load_details_B) {
+            const auto root_node_ptr_B = &octree_B.getRootNode();
+            if (thread_pool) {
+              thread_pool->add_task([root_node_ptr_A, root_node_ptr_B,
+                                     load_details_B, block_ptr_A = &block_A]() {
+                detail::sumNodeRecursive<MapT>(
+                    *root_node_ptr_A, *root_node_ptr_B, load_details_B);
+                block_ptr_A->prune();
+              });
+            } else {
+              detail::sumNodeRecursive<MapT>(*root_node_ptr_A,
+                                             *root_node_ptr_B, load_details_B);
+              block_A.prune();
+            }
+          });
         }
       });
 
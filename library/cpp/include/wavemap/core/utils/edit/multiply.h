@@ -11,6 +11,11 @@ namespace detail {
 template <typename MapT>
 void multiplyNodeRecursive(typename MapT::Block::OctreeType::NodeRefType node,
                            FloatingPoint multiplier);
+
+// Recursively multiply all chunks of a chunked octree, operating on each
+// chunk's node data array as a whole
+template <typename ChunkT>
+void multiplyChunkRecursive(ChunkT& chunk, FloatingPoint multiplier);
 }  // namespace detail
 
 template <typename MapT>
@@ -12,10 +12,18 @@
 namespace wavemap::edit {
 namespace detail {
 // Recursively sum two maps together
-template <typename MapT>
-void sumNodeRecursive(
-    typename MapT::Block::OctreeType::NodeRefType node_A,
-    typename MapT::Block::OctreeType::NodeConstRefType node_B);
+// NOTE: Node B can belong to any octree that holds block B's coefficients, as
+//       returned by the block's visitOctree(...) method. Its detail
+//       coefficients are loaded at full precision with load_details_B, such
+//       that blocks that store them in compressed form can also be summed.
+template <typename MapT, typename NodeTypeB, typename DetailsLoaderB>
+void sumNodeRecursive(typename MapT::Block::OctreeType::NodeRefType node_A,
+                      const NodeTypeB& node_B, DetailsLoaderB load_details_B);
+
+// Recursively sum two chunked octrees together, operating on each chunk's
+// node data array as a whole
+template <typename ChunkT>
+void sumChunkRecursive(ChunkT& chunk_A, const ChunkT& chunk_B);
 
 // Recursively add a sampled value
 template <typename MapT, typename SamplingFn>
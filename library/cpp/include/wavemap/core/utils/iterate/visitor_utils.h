@@ -0,0 +1,28 @@
+#ifndef WAVEMAP_CORE_UTILS_ITERATE_VISITOR_UTILS_H_
+#define WAVEMAP_CORE_UTILS_ITERATE_VISITOR_UTILS_H_
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace wavemap::visitor {
+// Visitors can request early termination of an iteration by returning false.
+// Visitors that return void always continue until the iteration is done.
+template <typename VisitorT, typename... Args>
+inline constexpr bool can_terminate_early_v =
+    std::is_convertible_v<std::invoke_result_t<VisitorT&, Args...>, bool>;
+
+// Invoke the visitor and return whether the iteration should continue
+template <typename VisitorT, typename... Args>
+bool invoke(VisitorT& visitor_fn, Args&&... args) {
+  if constexpr (can_terminate_early_v<VisitorT, Args...>) {
+    return static_cast<bool>(
+        std::invoke(visitor_fn, std::forward<Args>(args)...));
+  } else {
+    std::invoke(visitor_fn, std::forward<Args>(args)...);
+    return true;
+  }
+}
+}  // namespace wavemap::visitor
+
+#endif  // WAVEMAP_CORE_UTILS_ITERATE_VISITOR_UTILS_H_
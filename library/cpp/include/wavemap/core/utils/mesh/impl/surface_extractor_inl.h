@@ -0,0 +1,210 @@
+#ifndef WAVEMAP_CORE_UTILS_MESH_IMPL_SURFACE_EXTRACTOR_INL_H_
+#define WAVEMAP_CORE_UTILS_MESH_IMPL_SURFACE_EXTRACTOR_INL_H_
+
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/query/query_accelerator.h"
+
+namespace wavemap {
+template <typename MapT>
+std::vector<Index3D> SurfaceExtractor::update(const MapT& map) {
+  // Find the blocks that changed since the previous update, including the
+  // blocks that were removed
+  // NOTE: We compare the blocks' modification stamps, which, unlike their
+  //       update stamps, also account for edits such as coarsening.
+  std::unordered_set<Index3D, Index3DHash> changed_blocks;
+  std::unordered_map<Index3D, Timestamp, Index3DHash> new_block_stamps;
+  map.forEachBlock([this, &changed_blocks, &new_block_stamps](
+                       const Index3D& block_index, const auto& block) {
+    const Timestamp stamp = block.getLastModifiedStamp();
+    new_block_stamps.emplace(block_index, stamp);
+    if (const auto it = block_stamps_.find(block_index);
+        it == block_stamps_.end() || it->second != stamp) {
+      changed_blocks.emplace(block_index);
+    }
+  });
+  for (const auto& [block_index, stamp] : block_stamps_) {
+    if (!new_block_stamps.count(block_index)) {
+      changed_blocks.emplace(block_index);
+    }
+  }
+  block_stamps_ = std::move(new_block_stamps);
+
+  // Since the cubes of each block also read the cells of the blocks that
+  // neighbor it in the positive direction, changes to a block also affect
+  // the meshes of the blocks that neighbor it in the negative direction
+  const Grid<3> neighbor_offsets{Index3D::Zero(), Index3D::Ones()};
+  std::unordered_set<Index3D, Index3DHash> blocks_to_mesh;
+  for (const Index3D& block_index : changed_blocks) {
+    for (const Index3D& offset : neighbor_offsets) {
+      blocks_to_mesh.emplace(block_index - offset);
+    }
+  }
+
+  // Remesh the affected blocks in parallel
+  std::vector<Index3D> updated_blocks{blocks_to_mesh.cbegin(),
+                                      blocks_to_mesh.cend()};
+  std::vector<SurfaceMesh> updated_meshes(updated_blocks.size());
+  for (size_t block_idx = 0; block_idx < updated_blocks.size(); ++block_idx) {
+    // Blocks whose cubes only read unobserved cells contain no surface
+    const Index3D& block_index = updated_blocks[block_idx];
+    const bool has_observed_cells =
+        std::any_of(neighbor_offsets.begin(), neighbor_offsets.end(),
+                    [&map, &block_index](const Index3D& offset) {
+                      return map.hasBlock(block_index + offset);
+                    });
+    if (!has_observed_cells) {
+      continue;
+    }
+    thread_pool_->add_task(
+        [this, &map, &updated_blocks, &updated_meshes, block_idx]() {
+          updated_meshes[block_idx] =
+              extractBlock(map, updated_blocks[block_idx]);
+        });
+  }
+  thread_pool_->wait_all();
+
+  // Store the results
+  for (size_t block_idx = 0; block_idx < updated_blocks.size(); ++block_idx) {
+    const Index3D& block_index = updated_blocks[block_idx];
+    if (updated_meshes[block_idx].empty()) {
+      block_meshes_.erase(block_index);
+    } else {
+      block_meshes_[block_index] = std::move(updated_meshes[block_idx]);
+    }
+  }
+
+  return updated_blocks;
+}
+
+template <typename MapT>
+SurfaceMesh SurfaceExtractor::extractBlock(const MapT& map,
+                                           const Index3D& block_index) const {
+  const OctreeIndex block_node_index{map.getTreeHeight(), block_index};
+  const Index3D block_min_corner =
+      convert::nodeIndexToMinCornerIndex(block_node_index);
+  const Index3D block_max_corner =
+      convert::nodeIndexToMaxCornerIndex(block_node_index);
+
+  QueryAccelerator query_accelerator{map};
+  CubeMesher cube_mesher{config_.occupancy_threshold, map.getMinCellWidth()};
+  auto mesh_cube = [this, &query_accelerator, &cube_mesher](
+                       const Index3D& min_corner, const Index3D& leaf_min,
+                       const Index3D& leaf_max) {
+    std::array<FloatingPoint, 8> corner_values{};
+    for (int corner_idx = 0; corner_idx < 8; ++corner_idx) {
+      const Index3D corner_index = min_corner + cornerOffset(corner_idx);
+      corner_values[corner_idx] = query_accelerator.getCellValue(corner_index);
+    }
+    // Cubes can touch several occupied leaves. To mesh each cube exactly
+    // once, only mesh it from the leaf that contains its first occupied corner.
+    const auto first_occupied_corner =
+        std::find_if(corner_values.cbegin(), corner_values.cend(),
+                     [this](FloatingPoint value) {
+                       return config_.occupancy_threshold < value;
+                     });
+    if (first_occupied_corner == corner_values.cend()) {
+      return;
+    }
+    const Index3D first_occupied_index =
+        min_corner + cornerOffset(static_cast<int>(
+                         first_occupied_corner - corner_values.cbegin()));
+    if ((first_occupied_index.array() < leaf_min.array()).any() ||
+        (leaf_max.array() < first_occupied_index.array()).any()) {
+      return;
+    }
+    cube_mesher.addCube(min_corner, corner_values);
+  };
+
+  // Every cube that intersects the surface has at least one occupied corner.
+  // Since leaves are homogeneous, such cubes can therefore only lie on the
+  // boundaries of occupied leaves. The occupied leaves that affect this block
+  // lie in the block itself and its neighbors in the positive direction.
+  auto touches_block = [&block_min_corner,
+                        &block_max_corner](const OctreeIndex& node_index) {
+    const Index3D node_min = convert::nodeIndexToMinCornerIndex(node_index);
+    const Index3D node_max = convert::nodeIndexToMaxCornerIndex(node_index);
+    return (block_min_corner.array() <= node_max.array()).all() &&
+           (node_min.array() - 1 <= block_max_corner.array()).all();
+  };
+  for (const Index3D& offset : Grid<3>(Index3D::Zero(), Index3D::Ones())) {
+    const Index3D neighbor_index = block_index + offset;
+    const auto* neighbor_block = map.getBlock(neighbor_index);
+    if (!neighbor_block) {
+      continue;
+    }
+    neighbor_block->forEachLeafIf(
+        neighbor_index, touches_block,
+        [this, &block_min_corner, &block_max_corner, &mesh_cube](
+            const OctreeIndex& node_index, FloatingPoint node_value) {
+          // NOTE: We add a small tolerance, since the leaf values and the
+          //       cell values are reconstructed through different paths.
+          if (node_value <= config_.occupancy_threshold - kLeafValueTolerance) {
+            return;
+          }
+          // Visit the cubes whose minimum corner lies in this block and that
+          // touch the leaf without being fully contained in it
+          const Index3D leaf_min =
+              convert::nodeIndexToMinCornerIndex(node_index);
+          const Index3D leaf_max =
+              convert::nodeIndexToMaxCornerIndex(node_index);
+          const Index3D shell_min =
+              block_min_corner.cwiseMax(leaf_min - Index3D::Ones());
+          const Index3D shell_max = block_max_corner.cwiseMin(leaf_max);
+          forEachIndexInShell(
+              shell_min, shell_max, leaf_min, leaf_max - Index3D::Ones(),
+              [&mesh_cube, &leaf_min, &leaf_max](const Index3D& min_corner) {
+                mesh_cube(min_corner, leaf_min, leaf_max);
+              });
+        });
+  }
+
+  return cube_mesher.extractMesh();
+}
+
+template <typename IndexVisitor>
+void SurfaceExtractor::forEachIndexInShell(const Index3D& outer_min,
+                                           const Index3D& outer_max,
+                                           const Index3D& inner_min,
+                                           const Index3D& inner_max,
+                                           IndexVisitor visitor_fn) {
+  // Peel off the slabs of the outer box that lie below and above the inner
+  // box, one axis at a time
+  Index3D remaining_min = outer_min;
+  Index3D remaining_max = outer_max;
+  auto visit_slab = [&visitor_fn](const Index3D& slab_min,
+                                  const Index3D& slab_max) {
+    if ((slab_max.array() < slab_min.array()).any()) {
+      return;
+    }
+    for (const Index3D& index : Grid<3>(slab_min, slab_max)) {
+      std::invoke(visitor_fn, index);
+    }
+  };
+  for (int axis = 0; axis < 3; ++axis) {
+    if (remaining_min[axis] < inner_min[axis]) {
+      Index3D slab_max = remaining_max;
+      slab_max[axis] = std::min(remaining_max[axis], inner_min[axis] - 1);
+      visit_slab(remaining_min, slab_max);
+      remaining_min[axis] = inner_min[axis];
+    }
+    if (inner_max[axis] < remaining_max[axis]) {
+      Index3D slab_min = remaining_min;
+      slab_min[axis] = std::max(remaining_min[axis], inner_max[axis] + 1);
+      visit_slab(slab_min, remaining_max);
+      remaining_max[axis] = inner_max[axis];
+    }
+    if (remaining_max[axis] < remaining_min[axis]) {
+      return;
+    }
+  }
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_UTILS_MESH_IMPL_SURFACE_EXTRACTOR_INL_H_
@@ -0,0 +1,138 @@
+#ifndef WAVEMAP_CORE_UTILS_MESH_SURFACE_EXTRACTOR_H_
+#define WAVEMAP_CORE_UTILS_MESH_SURFACE_EXTRACTOR_H_
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/config/config_base.h"
+#include "wavemap/core/indexing/index_hashes.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/core/utils/time/time.h"
+
+namespace wavemap {
+struct SurfaceMesh {
+  using VertexIndex = uint32_t;
+  using Triangle = std::array<VertexIndex, 3>;
+
+  std::vector<Point3D> vertices;
+  //! Triangles are oriented counter-clockwise when seen from free space, such
+  //! that their normals point away from the occupied side of the surface.
+  std::vector<Triangle> triangles;
+
+  bool empty() const { return triangles.empty(); }
+  void clear();
+  void append(const SurfaceMesh& other);
+};
+
+/**
+ * Config struct for the occupancy surface extractor.
+ */
+struct SurfaceExtractorConfig : ConfigBase<SurfaceExtractorConfig, 1> {
+  //! Log-odds value at which the surface is extracted. Cells whose occupancy
+  //! exceeds this threshold are considered occupied. Must be at least
+  //! OccupancyClassifier::getUnobservedThreshold(), such that unobserved space
+  //! is never meshed.
+  FloatingPoint occupancy_threshold = 1e-3f;
+
+  static MemberMap memberMap;
+
+  bool isValid(bool verbose) const override;
+};
+
+// Extracts the occupancy surface of hashed wavelet octrees as a triangle mesh.
+// The surface is polygonized with marching tetrahedra on the grid of cell
+// centers. Each cube of 2x2x2 cell centers is assigned to the block containing
+// its minimum corner, which makes the meshes of neighboring blocks line up
+// exactly at their seams. Since leaves are homogeneous, only the cubes on the
+// boundaries of occupied leaves need to be polygonized, which lets coarse
+// leaves and free or unobserved space be skipped entirely.
+class SurfaceExtractor {
+ public:
+  using BlockMeshMap = std::unordered_map<Index3D, SurfaceMesh, Index3DHash>;
+
+  explicit SurfaceExtractor(const SurfaceExtractorConfig& config = {},
+                            std::shared_ptr<ThreadPool> thread_pool = nullptr)
+      : config_(config.checkValid()),
+        thread_pool_(thread_pool ? std::move(thread_pool)
+                                 : std::make_shared<ThreadPool>()) {}
+
+  // Remesh all blocks whose cell values might have changed since the previous
+  // update, in parallel, and return the indices of the updated block meshes
+  // NOTE: Changes are detected using the blocks' last modified stamps.
+  //       Supported map types are HashedWaveletOctree and
+  //       HashedChunkedWaveletOctree.
+  template <typename MapT>
+  std::vector<Index3D> update(const MapT& map);
+
+  // Mesh a single block, reading the cells it shares with its neighbors
+  template <typename MapT>
+  SurfaceMesh extractBlock(const MapT& map, const Index3D& block_index) const;
+
+  const BlockMeshMap& getBlockMeshes() const { return block_meshes_; }
+  // Merge all block meshes into a single mesh
+  SurfaceMesh getMesh() const;
+  void clear();
+
+  const SurfaceExtractorConfig& getConfig() const { return config_; }
+
+ private:
+  const SurfaceExtractorConfig config_;
+  const std::shared_ptr<ThreadPool> thread_pool_;
+
+  BlockMeshMap block_meshes_;
+  std::unordered_map<Index3D, Timestamp, Index3DHash> block_stamps_;
+
+  // Polygonizes cubes of 2x2x2 cell centers and merges their shared vertices
+  class CubeMesher {
+   public:
+    CubeMesher(FloatingPoint isovalue, FloatingPoint min_cell_width)
+        : isovalue_(isovalue), min_cell_width_(min_cell_width) {}
+
+    void addCube(const Index3D& min_corner,
+                 const std::array<FloatingPoint, 8>& corner_values);
+
+    SurfaceMesh&& extractMesh() { return std::move(mesh_); }
+
+   private:
+    const FloatingPoint isovalue_;
+    const FloatingPoint min_cell_width_;
+
+    SurfaceMesh mesh_;
+    // Vertices are uniquely identified by the lattice point at the lower end
+    // of the edge they lie on, and the edge's direction encoded as a bitmask
+    std::unordered_map<Index<4>, SurfaceMesh::VertexIndex, IndexHash<4>>
+        vertex_ids_;
+
+    SurfaceMesh::VertexIndex getOrAddVertex(
+        const Index3D& min_corner,
+        const std::array<FloatingPoint, 8>& corner_values, int corner_a,
+        int corner_b);
+    void addTriangle(const std::array<SurfaceMesh::VertexIndex, 3>& vertices,
+                     const Point3D& towards_free_space);
+  };
+
+  static constexpr FloatingPoint kLeafValueTolerance = 1e-4f;
+
+  // Cube corner i is located at the cube's min corner + cornerOffset(i)
+  static Index3D cornerOffset(int corner_idx) {
+    return {corner_idx & 1, corner_idx >> 1 & 1, corner_idx >> 2 & 1};
+  }
+
+  // Call the visitor for each index in the outer box that does not lie in
+  // the inner box, where both boxes are inclusive and the inner one may be
+  // empty
+  template <typename IndexVisitor>
+  static void forEachIndexInShell(const Index3D& outer_min,
+                                  const Index3D& outer_max,
+                                  const Index3D& inner_min,
+                                  const Index3D& inner_max,
+                                  IndexVisitor visitor_fn);
+};
+}  // namespace wavemap
+
+#include "wavemap/core/utils/mesh/impl/surface_extractor_inl.h"
+
+#endif  // WAVEMAP_CORE_UTILS_MESH_SURFACE_EXTRACTOR_H_
@@ -74,6 +74,18 @@ struct has_to_str_member_fn<T, std::void_t<decltype(std::declval<T>().toStr())>>
 
 template <typename T>
 constexpr bool has_to_str_member_fn_v = has_to_str_member_fn<T>::value;
+
+template <typename T, typename = void>
+struct has_get_root_chunk_member_fn : std::false_type {};
+
+template <typename T>
+struct has_get_root_chunk_member_fn<
+    T, std::void_t<decltype(std::declval<T>().getRootChunk())>>
+    : std::true_type {};
+
+template <typename T>
+constexpr bool has_get_root_chunk_member_fn_v =
+    has_get_root_chunk_member_fn<T>::value;
 }  // namespace wavemap::meta
 
 #endif  // WAVEMAP_CORE_UTILS_META_TYPE_UTILS_H_
@@ -0,0 +1,75 @@
+#ifndef WAVEMAP_CORE_UTILS_PROFILE_MEMORY_USAGE_H_
+#define WAVEMAP_CORE_UTILS_PROFILE_MEMORY_USAGE_H_
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "wavemap/core/common.h"
+
+namespace wavemap::memory {
+// Size of the bookkeeping header the heap allocator prefixes each chunk with
+static constexpr size_t kAllocationHeaderSize = sizeof(size_t);
+// Chunks are padded to multiples of this alignment, and are at least as large
+// as the minimum chunk size
+static constexpr size_t kAllocationAlignment = 2 * sizeof(size_t);
+static constexpr size_t kMinAllocationSize = 4 * sizeof(size_t);
+
+// Estimate of the number of bytes the heap allocator reserves to serve a
+// request for the given number of bytes, modeled after glibc's malloc
+constexpr size_t getAllocationSize(size_t num_bytes) {
+  if (num_bytes == 0u) {
+    return 0u;
+  }
+  const size_t padded_size =
+      (num_bytes + kAllocationHeaderSize + kAllocationAlignment - 1u) /
+      kAllocationAlignment * kAllocationAlignment;
+  return std::max(padded_size, kMinAllocationSize);
+}
+
+// Bytes reserved for an object created with std::make_shared, which allocates
+// the object together with its reference counts
+template <typename T>
+constexpr size_t getSharedObjectAllocationSize() {
+  return getAllocationSize(2 * sizeof(int) + sizeof(void*) + sizeof(T));
+}
+
+// Heap memory allocated by the containers below, excluding the memory their
+// elements own indirectly, e.g. through pointers
+template <typename T, typename AllocatorT>
+size_t getHeapUsage(const std::vector<T, AllocatorT>& vector) {
+  return getAllocationSize(vector.capacity() * sizeof(T));
+}
+
+// NOTE: The estimates for the node-based containers assume the layout used by
+//       libstdc++, which allocates each element in its own node. For hash
+//       maps, the nodes link to the next element and cache the element's hash.
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT,
+          typename AllocatorT>
+size_t getHeapUsage(
+    const std::unordered_map<KeyT, ValueT, HashT, KeyEqualT, AllocatorT>&
+        hash_map) {
+  using ValueType = std::pair<const KeyT, ValueT>;
+  constexpr size_t kNodeSize =
+      getAllocationSize(sizeof(void*) + sizeof(ValueType) + sizeof(size_t));
+  // NOTE: Hash maps with a single bucket store it inline.
+  const size_t bucket_array_size =
+      1u < hash_map.bucket_count()
+          ? getAllocationSize(hash_map.bucket_count() * sizeof(void*))
+          : 0u;
+  return bucket_array_size + hash_map.size() * kNodeSize;
+}
+
+template <typename KeyT, typename ValueT, typename CompareT,
+          typename AllocatorT>
+size_t getHeapUsage(const std::map<KeyT, ValueT, CompareT, AllocatorT>& map) {
+  using ValueType = std::pair<const KeyT, ValueT>;
+  // Each node stores its color and links to its parent and children
+  constexpr size_t kNodeSize =
+      getAllocationSize(4 * sizeof(void*) + sizeof(ValueType));
+  return map.size() * kNodeSize;
+}
+}  // namespace wavemap::memory
+
+#endif  // WAVEMAP_CORE_UTILS_PROFILE_MEMORY_USAGE_H_
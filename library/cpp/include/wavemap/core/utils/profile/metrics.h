@@ -0,0 +1,153 @@
+#ifndef WAVEMAP_CORE_UTILS_PROFILE_METRICS_H_
+#define WAVEMAP_CORE_UTILS_PROFILE_METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/time/time.h"
+
+namespace wavemap::metrics {
+/**
+ * @brief Monotonically increasing count, e.g. of integrated measurements.
+ *
+ * Counters can safely be incremented from multiple threads concurrently.
+ */
+class Counter {
+ public:
+  void increment(uint64_t amount = 1u) {
+    count_.fetch_add(amount, std::memory_order_relaxed);
+  }
+  uint64_t get() const { return count_.load(std::memory_order_relaxed); }
+  void reset() { count_.store(0u, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> count_{0u};
+};
+
+/**
+ * @brief Value that can go up and down, e.g. the memory usage of a map.
+ *
+ * Gauges can safely be updated from multiple threads concurrently.
+ */
+class Gauge {
+ public:
+  void set(double value) { value_.store(value, std::memory_order_relaxed); }
+  void add(double amount);
+  double get() const { return value_.load(std::memory_order_relaxed); }
+  void reset() { set(0.0); }
+
+ private:
+  std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief Distribution of observed values, e.g. latencies in seconds.
+ *
+ * The observations are counted in buckets whose upper bounds grow
+ * exponentially, from kMinUpperBound up to kMinUpperBound * 2^(kNumBuckets-1).
+ * Larger values are counted in an additional overflow bucket. With the default
+ * bounds, latencies from 10 microseconds to over a minute are resolved to
+ * within a factor of two.
+ * Histograms can safely be updated from multiple threads concurrently.
+ */
+class Histogram {
+ public:
+  static constexpr int kNumBuckets = 24;
+  static constexpr double kMinUpperBound = 1e-5;
+
+  void observe(double value);
+
+  uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+  double getSum() const { return sum_.load(std::memory_order_relaxed); }
+  //! Number of observations in the bucket with the given index, where index
+  //! kNumBuckets refers to the overflow bucket
+  uint64_t getBucketCount(int bucket_idx) const {
+    return bucket_counts_[bucket_idx].load(std::memory_order_relaxed);
+  }
+  static double getBucketUpperBound(int bucket_idx);
+  void reset();
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets + 1> bucket_counts_{};
+  std::atomic<uint64_t> count_{0u};
+  std::atomic<double> sum_{0.0};
+};
+
+/**
+ * @brief Records the time between its construction and destruction, in
+ *        seconds, into a histogram.
+ */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Histogram& histogram)
+      : histogram_(histogram), start_time_(Time::now()) {}
+  ~ScopedTimer() {
+    histogram_.observe(time::to_seconds<double>(Time::now() - start_time_));
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Histogram& histogram_;
+  const Timestamp start_time_;
+};
+
+/**
+ * @brief Named collection of counters, gauges and histograms.
+ *
+ * Metrics are created on first access, and remain valid for the lifetime of
+ * the registry. Looking a metric up takes a lock, but updating it does not.
+ * Call sites that update a metric frequently should therefore look it up once,
+ * e.g. by storing the returned reference in a function-local static variable.
+ * Metrics that are never updated cost nothing beyond their registration.
+ *
+ * Metric names should consist of lowercase letters, digits and underscores,
+ * such that they can be exported as is. By convention, counter names end in
+ * "_total" and histograms of durations in "_seconds".
+ */
+class Registry {
+ public:
+  Counter& getCounter(const std::string& name);
+  Gauge& getGauge(const std::string& name);
+  Histogram& getHistogram(const std::string& name);
+
+  //! Reset the values of all metrics, without deregistering them
+  void reset();
+
+  //! Serialize all metrics to a JSON object
+  std::string toJson() const;
+  //! Serialize all metrics to Prometheus' text exposition format, prefixing
+  //! each metric's name with the given namespace
+  std::string toPrometheus(const std::string& name_prefix = "wavemap_") const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Counter>> counters_;
+  std::map<std::string, std::unique_ptr<Gauge>> gauges_;
+  std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+};
+
+//! Process-wide registry, which wavemap's integrators, map operations and I/O
+//! record their metrics into
+Registry& getRegistry();
+
+// Shorthands to look metrics up in the process-wide registry
+inline Counter& getCounter(const std::string& name) {
+  return getRegistry().getCounter(name);
+}
+inline Gauge& getGauge(const std::string& name) {
+  return getRegistry().getGauge(name);
+}
+inline Histogram& getHistogram(const std::string& name) {
+  return getRegistry().getHistogram(name);
+}
+}  // namespace wavemap::metrics
+
+#endif  // WAVEMAP_CORE_UTILS_PROFILE_METRICS_H_
@@ -11,6 +11,7 @@
 #include "wavemap/core/map/hashed_wavelet_octree.h"
 #include "wavemap/core/utils/query/occupancy_classifier.h"
 #include "wavemap/core/utils/query/query_accelerator.h"
+#include "wavemap/core/utils/shape/aabb.h"
 
 namespace wavemap {
 struct ChildBitset {
@@ -76,6 +77,18 @@ class ClassifiedMap {
   bool isFully(const Index3D& index, Occupancy::Mask occupancy_mask) const;
   bool isFully(const OctreeIndex& index, Occupancy::Mask occupancy_mask) const;
 
+  // Check whether any cell that overlaps the region matches the occupancy mask.
+  // The region can be any shape supported by shape::overlaps(AABB, ShapeT) and
+  // shape::is_inside(AABB, ShapeT), such as an AABB, Sphere, Capsule or
+  // OrientedBox. The classified octree is descended once, skipping subtrees
+  // that do not overlap the region or hold no matching cells, and the search
+  // stops at the first match.
+  // NOTE: Unlike the per-index queries above, cells that are not covered by
+  //       any block are treated as unobserved. Since this method does not use
+  //       the query cache, it can safely be called from multiple threads.
+  template <typename ShapeT>
+  bool hasInRegion(const ShapeT& region, Occupancy::Mask occupancy_mask) const;
+
   bool hasBlock(const Index3D& block_index) const;
   const Block* getBlock(const Index3D& block_index) const;
   const BlockHashMap& getBlockMap() const { return block_map_; }
@@ -98,13 +111,16 @@ class ClassifiedMap {
 
   using IndexedLeafVisitorFunction =
       std::function<void(const OctreeIndex& index, Occupancy::Mask occupancy)>;
-  void forEachLeaf(IndexedLeafVisitorFunction visitor_fn,
+  template <typename IndexedLeafVisitor>
+  void forEachLeaf(IndexedLeafVisitor visitor_fn,
                    IndexElement termination_height = 0) const;
+  template <typename IndexedLeafVisitor>
   void forEachLeafMatching(Occupancy::Id occupancy_type,
-                           IndexedLeafVisitorFunction visitor_fn,
+                           IndexedLeafVisitor visitor_fn,
                            IndexElement termination_height = 0) const;
+  template <typename IndexedLeafVisitor>
   void forEachLeafMatching(Occupancy::Mask occupancy_mask,
-                           IndexedLeafVisitorFunction visitor_fn,
+                           IndexedLeafVisitor visitor_fn,
                            IndexElement termination_height = 0) const;
 
  private:
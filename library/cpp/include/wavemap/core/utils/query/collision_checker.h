@@ -0,0 +1,65 @@
+#ifndef WAVEMAP_CORE_UTILS_QUERY_COLLISION_CHECKER_H_
+#define WAVEMAP_CORE_UTILS_QUERY_COLLISION_CHECKER_H_
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/query/classified_map.h"
+#include "wavemap/core/utils/query/occupancy.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap {
+// Checks robot shapes against a ClassifiedMap. Shapes can be AABBs, Spheres,
+// Capsules, OrientedBoxes or vectors thereof, where a vector collides if any of
+// its shapes collides. This makes it possible to check, for example, each
+// pose along a trajectory with a robot model made of several spheres. Every
+// shape is checked with a single hierarchical descent of the classified map,
+// and batches of shapes are checked in parallel.
+class CollisionChecker {
+ public:
+  explicit CollisionChecker(
+      ClassifiedMap::ConstPtr classified_map,
+      Occupancy::Mask collision_mask = Occupancy::toMask(false, true, true),
+      std::shared_ptr<ThreadPool> thread_pool = nullptr)
+      : classified_map_(std::move(classified_map)),
+        collision_mask_(collision_mask),
+        thread_pool_(thread_pool ? std::move(thread_pool)
+                                 : std::make_shared<ThreadPool>()) {}
+
+  // Check whether the shape overlaps any cell that matches the collision mask
+  template <typename ShapeT>
+  bool isColliding(const ShapeT& shape) const {
+    return classified_map_->hasInRegion(shape, collision_mask_);
+  }
+  template <typename ShapeT>
+  bool isColliding(const std::vector<ShapeT>& shapes) const;
+
+  // Return the index of the first colliding shape, or nullopt if no shape
+  // collides. Shapes that come after an already found collision are skipped.
+  template <typename ShapeT>
+  std::optional<size_t> findFirstCollision(
+      const std::vector<ShapeT>& shapes) const;
+
+  // Check all shapes in parallel
+  template <typename ShapeT>
+  std::vector<bool> checkCollisions(const std::vector<ShapeT>& shapes) const;
+
+  const ClassifiedMap& getClassifiedMap() const { return *classified_map_; }
+  Occupancy::Mask getCollisionMask() const { return collision_mask_; }
+
+ private:
+  const ClassifiedMap::ConstPtr classified_map_;
+  const Occupancy::Mask collision_mask_;
+  const std::shared_ptr<ThreadPool> thread_pool_;
+
+  // Number of shapes checked per thread pool task
+  static constexpr size_t kShapesPerTask = 32;
+};
+}  // namespace wavemap
+
+#include "wavemap/core/utils/query/impl/collision_checker_inl.h"
+
+#endif  // WAVEMAP_CORE_UTILS_QUERY_COLLISION_CHECKER_H_
@@ -1,8 +1,16 @@
 #ifndef WAVEMAP_CORE_UTILS_QUERY_IMPL_CLASSIFIED_MAP_INL_H_
 #define WAVEMAP_CORE_UTILS_QUERY_IMPL_CLASSIFIED_MAP_INL_H_
 
+#include <functional>
 #include <limits>
+#include <stack>
 #include <utility>
+#include <vector>
+
+#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
 
 namespace wavemap {
 inline void ChildBitset::set(NdtreeIndexRelativeChild child_idx, bool value) {
@@ -57,9 +65,79 @@ inline bool ClassifiedMap::isFully(const OctreeIndex& index,
   return query_cache_.isFully(index, occupancy_mask, block_map_);
 }
 
-inline void ClassifiedMap::forEachLeafMatching(
-    Occupancy::Id occupancy_type, IndexedLeafVisitorFunction visitor_fn,
-    IndexElement termination_height) const {
+template <typename ShapeT>
+bool ClassifiedMap::hasInRegion(const ShapeT& region,
+                                Occupancy::Mask occupancy_mask) const {
+  const AABB<Point3D> region_aabb = static_cast<AABB<Point3D>>(region);
+  if ((region_aabb.max.array() < region_aabb.min.array()).any()) {
+    return false;
+  }
+  const bool matches_unobserved = OccupancyClassifier::has(
+      Occupancy::toMask(Occupancy::kUnobserved), occupancy_mask);
+
+  const FloatingPoint block_width =
+      convert::heightToCellWidth(min_cell_width_, tree_height_);
+  const auto [min_block_index, max_block_index] =
+      convert::aabbToBlockIndexRange(region_aabb, 1.f / block_width);
+  for (const Index3D& block_index :
+       Grid<3>(min_block_index, max_block_index)) {
+    const OctreeIndex block_node_index{tree_height_, block_index};
+    if (!shape::overlaps(
+            convert::nodeIndexToAABB(block_node_index, min_cell_width_),
+            region)) {
+      continue;
+    }
+    const Block* block = block_map_.getBlock(block_index);
+    if (!block) {
+      if (matches_unobserved) {
+        return true;
+      }
+      continue;
+    }
+
+    struct StackElement {
+      const OctreeIndex node_index;
+      const Node& node;
+    };
+    std::stack<StackElement, std::vector<StackElement>> stack;
+    stack.emplace(StackElement{block_node_index, block->getRootNode()});
+    while (!stack.empty()) {
+      const OctreeIndex node_index = stack.top().node_index;
+      const Node& node = stack.top().node;
+      stack.pop();
+
+      for (NdtreeIndexRelativeChild child_idx = 0;
+           child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+        const auto child_occupancy = node.data().childOccupancyMask(child_idx);
+        if (!OccupancyClassifier::has(child_occupancy, occupancy_mask)) {
+          continue;
+        }
+        const OctreeIndex child_node_index =
+            node_index.computeChildIndex(child_idx);
+        const AABB<Point3D> child_aabb =
+            convert::nodeIndexToAABB(child_node_index, min_cell_width_);
+        if (!shape::overlaps(child_aabb, region)) {
+          continue;
+        }
+        // The child holds a matching cell that overlaps the region if all its
+        // cells match, or if it lies entirely inside the region
+        if (OccupancyClassifier::isFully(child_occupancy, occupancy_mask) ||
+            shape::is_inside(child_aabb, region)) {
+          return true;
+        }
+        if (const Node* child_node = node.getChild(child_idx); child_node) {
+          stack.emplace(StackElement{child_node_index, *child_node});
+        }
+      }
+    }
+  }
+  return false;
+}
+
+template <typename IndexedLeafVisitor>
+void ClassifiedMap::forEachLeafMatching(Occupancy::Id occupancy_type,
+                                        IndexedLeafVisitor visitor_fn,
+                                        IndexElement termination_height) const {
   forEachLeafMatching(Occupancy::toMask(occupancy_type), std::move(visitor_fn),
                       termination_height);
 }
@@ -121,6 +199,78 @@ inline const ClassifiedMap::Block* ClassifiedMap::QueryCache::getBlock(
   }
   return block;
 }
+
+template <typename IndexedLeafVisitor>
+void ClassifiedMap::forEachLeaf(IndexedLeafVisitor visitor_fn,
+                                IndexElement termination_height) const {
+  forEachBlock([&visitor_fn, termination_height](const Index3D& block_index,
+                                                 const Block& block) {
+    struct StackElement {
+      const OctreeIndex node_index;
+      const Node& node;
+    };
+    std::stack<StackElement> stack;
+    stack.emplace(StackElement{OctreeIndex{block.getMaxHeight(), block_index},
+                               block.getRootNode()});
+    while (!stack.empty()) {
+      const OctreeIndex node_index = stack.top().node_index;
+      const Node& node = stack.top().node;
+      stack.pop();
+
+      for (NdtreeIndexRelativeChild child_idx = 0;
+           child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+        const OctreeIndex child_node_index =
+            node_index.computeChildIndex(child_idx);
+        const Node* child_node = node.getChild(child_idx);
+        if (child_node && termination_height < child_node_index.height) {
+          stack.emplace(StackElement{child_node_index, *child_node});
+        } else {
+          const Occupancy::Mask child_occupancy =
+              node.data().childOccupancyMask(child_idx);
+          std::invoke(visitor_fn, child_node_index, child_occupancy);
+        }
+      }
+    }
+  });
+}
+
+template <typename IndexedLeafVisitor>
+void ClassifiedMap::forEachLeafMatching(Occupancy::Mask occupancy_mask,
+                                        IndexedLeafVisitor visitor_fn,
+                                        IndexElement termination_height) const {
+  block_map_.forEachBlock([occupancy_mask, termination_height, &visitor_fn](
+                              const Index3D& block_index, const Block& block) {
+    struct StackElement {
+      const OctreeIndex node_index;
+      const Node& node;
+    };
+    std::stack<StackElement, std::vector<StackElement>> stack;
+    stack.emplace(StackElement{OctreeIndex{block.getMaxHeight(), block_index},
+                               block.getRootNode()});
+    while (!stack.empty()) {
+      const OctreeIndex node_index = stack.top().node_index;
+      const Node& node = stack.top().node;
+      stack.pop();
+
+      for (NdtreeIndexRelativeChild child_idx = 0;
+           child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+        const auto child_occupancy = node.data().childOccupancyMask(child_idx);
+        if (!OccupancyClassifier::has(child_occupancy, occupancy_mask)) {
+          continue;
+        }
+        const OctreeIndex child_node_index =
+            node_index.computeChildIndex(child_idx);
+        if (OccupancyClassifier::isFully(child_occupancy, occupancy_mask) ||
+            child_node_index.height <= termination_height) {
+          std::invoke(visitor_fn, child_node_index, child_occupancy);
+        } else if (const Node* child_node = node.getChild(child_idx);
+                   child_node) {
+          stack.emplace(StackElement{child_node_index, *child_node});
+        }
+      }
+    }
+  });
+}
 }  // namespace wavemap
 
 #endif  // WAVEMAP_CORE_UTILS_QUERY_IMPL_CLASSIFIED_MAP_INL_H_
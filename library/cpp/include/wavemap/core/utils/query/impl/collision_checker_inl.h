@@ -0,0 +1,78 @@
+#ifndef WAVEMAP_CORE_UTILS_QUERY_IMPL_COLLISION_CHECKER_INL_H_
+#define WAVEMAP_CORE_UTILS_QUERY_IMPL_COLLISION_CHECKER_INL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace wavemap {
+template <typename ShapeT>
+bool CollisionChecker::isColliding(const std::vector<ShapeT>& shapes) const {
+  return std::any_of(shapes.begin(), shapes.end(), [this](const ShapeT& shape) {
+    return isColliding(shape);
+  });
+}
+
+template <typename ShapeT>
+std::optional<size_t> CollisionChecker::findFirstCollision(
+    const std::vector<ShapeT>& shapes) const {
+  constexpr size_t kNoCollision = std::numeric_limits<size_t>::max();
+  std::atomic<size_t> first_collision = kNoCollision;
+  for (size_t task_begin = 0; task_begin < shapes.size();
+       task_begin += kShapesPerTask) {
+    const size_t task_end =
+        std::min(task_begin + kShapesPerTask, shapes.size());
+    thread_pool_->add_task([this, &shapes, &first_collision, task_begin,
+                            task_end]() {
+      for (size_t shape_idx = task_begin; shape_idx < task_end; ++shape_idx) {
+        // Stop early once a collision has been found earlier in the sequence
+        size_t current_first = first_collision.load(std::memory_order_relaxed);
+        if (current_first < shape_idx) {
+          return;
+        }
+        if (isColliding(shapes[shape_idx])) {
+          while (shape_idx < current_first &&
+                 !first_collision.compare_exchange_weak(
+                     current_first, shape_idx, std::memory_order_relaxed)) {
+          }
+          return;
+        }
+      }
+    });
+  }
+  thread_pool_->wait_all();
+
+  if (first_collision == kNoCollision) {
+    return std::nullopt;
+  }
+  return first_collision.load();
+}
+
+template <typename ShapeT>
+std::vector<bool> CollisionChecker::checkCollisions(
+    const std::vector<ShapeT>& shapes) const {
+  // NOTE: The results are first written to a byte array since std::vector<bool>
+  //       packs its elements and can therefore not be written concurrently.
+  const auto is_colliding = std::make_unique<bool[]>(shapes.size());
+  for (size_t task_begin = 0; task_begin < shapes.size();
+       task_begin += kShapesPerTask) {
+    const size_t task_end =
+        std::min(task_begin + kShapesPerTask, shapes.size());
+    thread_pool_->add_task(
+        [this, &shapes, &is_colliding, task_begin, task_end]() {
+          for (size_t shape_idx = task_begin; shape_idx < task_end;
+               ++shape_idx) {
+            is_colliding[shape_idx] = isColliding(shapes[shape_idx]);
+          }
+        });
+  }
+  thread_pool_->wait_all();
+
+  return std::vector<bool>(is_colliding.get(),
+                           is_colliding.get() + shapes.size());
+}
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_UTILS_QUERY_IMPL_COLLISION_CHECKER_INL_H_
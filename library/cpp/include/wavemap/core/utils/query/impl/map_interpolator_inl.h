@@ -34,14 +34,18 @@ FloatingPoint trilinear(MapT& map, const Point3D& position) {
   // Compute the offset between the query point, the min corner and max corner
   const Point3D position_min_corner =
       wavemap::convert::indexToCenterPoint(min_corner_index, cell_width);
+  // NOTE: The offsets are only accurate up to the rounding error of the
+  //       positions, which grows with their distance from the origin.
+  const FloatingPoint tolerance =
+      kEpsilon * (1.f + position.cwiseAbs().maxCoeff() * cell_width_inv);
   // Offset to min corner
   const Vector3D a = (position - position_min_corner) * cell_width_inv;
-  DCHECK_EIGEN_GE(a, Vector3D::Constant(0.f - kEpsilon));
-  DCHECK_EIGEN_LE(a, Vector3D::Constant(1.f + kEpsilon));
+  DCHECK_EIGEN_GE(a, Vector3D::Constant(0.f - tolerance));
+  DCHECK_EIGEN_LE(a, Vector3D::Constant(1.f + tolerance));
   // Offset to max corner
   const Vector3D a_comp = 1.f - a.array();
-  DCHECK_EIGEN_GE(a_comp, Vector3D::Constant(0.f - kEpsilon));
-  DCHECK_EIGEN_LE(a_comp, Vector3D::Constant(1.f + kEpsilon));
+  DCHECK_EIGEN_GE(a_comp, Vector3D::Constant(0.f - tolerance));
+  DCHECK_EIGEN_LE(a_comp, Vector3D::Constant(1.f + tolerance));
 
   // Interpolate out the first dimension,
   // reducing the cube into a square that contains the query point
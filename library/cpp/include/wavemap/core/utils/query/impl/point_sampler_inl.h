@@ -11,10 +11,22 @@ inline std::optional<Point3D> PointSampler::getRandomPoint(
 inline std::optional<Point3D> PointSampler::getRandomPoint(
     Occupancy::Mask occupancy_mask, const std::optional<AABB<Point3D>>& aabb,
     size_t max_attempts) {
+  if (!aabb) {
+    return getRandomMatchingPoint(occupancy_mask, max_attempts);
+  }
   size_t attempt_idx = 0;
   return getRandomPointImpl(occupancy_mask, aabb, attempt_idx, max_attempts);
 }
 
+inline uint64_t PointSampler::getMatchingVolume(Occupancy::Id occupancy_type) {
+  return getMatchingVolume(Occupancy::toMask(occupancy_type));
+}
+
+inline uint64_t PointSampler::getMatchingVolume(
+    Occupancy::Mask occupancy_mask) {
+  return getMatchingRegions(occupancy_mask).getTotalVolume();
+}
+
 inline Point3D PointSampler::getRandomPointInAABB(const AABB<Point3D>& aabb) {
   return {rng_.getRandomRealNumber(aabb.min[0], aabb.max[0]),
           rng_.getRandomRealNumber(aabb.min[1], aabb.max[1]),
@@ -22,9 +34,13 @@ inline Point3D PointSampler::getRandomPointInAABB(const AABB<Point3D>& aabb) {
 }
 
 inline Point3D PointSampler::getRandomPointInBlock(const Index3D& block_index) {
-  const auto block_aabb = convert::nodeIndexToAABB(
-      OctreeIndex{block_height_, block_index}, min_cell_width_);
-  return getRandomPointInAABB(block_aabb);
+  return getRandomPointInNode(OctreeIndex{block_height_, block_index});
+}
+
+inline Point3D PointSampler::getRandomPointInNode(
+    const OctreeIndex& node_index) {
+  const auto node_aabb = convert::nodeIndexToAABB(node_index, min_cell_width_);
+  return getRandomPointInAABB(node_aabb);
 }
 }  // namespace wavemap
 
@@ -5,15 +5,15 @@
 #include <utility>
 
 namespace wavemap {
-template <typename BlockDataT, int dim>
-void QueryAccelerator<SpatialHash<BlockDataT, dim>>::reset() {
+template <typename BlockDataT, int dim, typename BackendT>
+void QueryAccelerator<SpatialHash<BlockDataT, dim, BackendT>>::reset() {
   last_block_index_ =
       Index3D::Constant(std::numeric_limits<IndexElement>::max());
   last_block_ = nullptr;
 }
 
-template <typename BlockDataT, int dim>
-BlockDataT* QueryAccelerator<SpatialHash<BlockDataT, dim>>::getBlock(
+template <typename BlockDataT, int dim, typename BackendT>
+BlockDataT* QueryAccelerator<SpatialHash<BlockDataT, dim, BackendT>>::getBlock(
     const Index<dim>& block_index) {
   if (block_index != last_block_index_) {
     last_block_index_ = block_index;
@@ -22,9 +22,10 @@ BlockDataT* QueryAccelerator<SpatialHash<BlockDataT, dim>>::getBlock(
   return last_block_;
 }
 
-template <typename BlockDataT, int dim>
+template <typename BlockDataT, int dim, typename BackendT>
 template <typename... DefaultArgs>
-BlockDataT& QueryAccelerator<SpatialHash<BlockDataT, dim>>::getOrAllocateBlock(
+BlockDataT&
+QueryAccelerator<SpatialHash<BlockDataT, dim, BackendT>>::getOrAllocateBlock(
     const Index<dim>& block_index, DefaultArgs&&... args) {
   if (block_index != last_block_index_ || !last_block_) {
     last_block_index_ = block_index;
@@ -34,28 +35,47 @@ BlockDataT& QueryAccelerator<SpatialHash<BlockDataT, dim>>::getOrAllocateBlock(
   return *last_block_;
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-void QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side>>::reset() {
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+void QueryAccelerator<
+    DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>>::reset() {
   block_index_ = Index<dim>::Constant(std::numeric_limits<IndexElement>::max());
   block_ = nullptr;
+  directory_entry_ = nullptr;
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
 const typename QueryAccelerator<
-    DenseBlockHash<CellDataT, dim, cells_per_side>>::BlockType*
-QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side>>::getBlock(
-    const Index<dim>& block_index) {
-  if (block_index != block_index_) {
-    block_index_ = block_index;
+    DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>>::BlockType*
+QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>>::
+    getBlock(const Index<dim>& block_index) {
+  if (block_index == block_index_) {
+    return block_;
+  }
+
+  if (const auto* block_directory = dense_block_hash_.getBlockDirectory();
+      block_directory) {
+    // Follow the neighbor links if possible, and look the block up otherwise
+    const Index<dim> offset = block_index - block_index_;
+    if (directory_entry_ && (offset.array().abs() <= 1).all()) {
+      directory_entry_ = directory_entry_->getNeighbor(offset);
+    } else {
+      directory_entry_ = block_directory->getEntry(block_index);
+    }
+    block_ = directory_entry_ ? directory_entry_->block : nullptr;
+  } else {
     block_ = dense_block_hash_.getBlock(block_index);
   }
+  block_index_ = block_index;
   return block_;
 }
 
-template <typename CellDataT, int dim, unsigned int cells_per_side>
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
 const CellDataT*
-QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side>>::getValue(
-    const Index<dim>& index) {
+QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>>::
+    getValue(const Index<dim>& index) {
   const Index<dim> block_index = dense_block_hash_.indexToBlockIndex(index);
   if (const BlockType* block = getBlock(block_index); block) {
     const Index<dim> cell_index = dense_block_hash_.indexToCellIndex(index);
@@ -64,8 +84,8 @@ QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side>>::getValue(
   return nullptr;
 }
 
-template <typename CellDataT, int dim>
-void QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::reset() {
+template <typename CellDataT, int dim, typename BackendT>
+void QueryAccelerator<NdtreeBlockHash<CellDataT, dim, BackendT>>::reset() {
   block_index_ = Index<dim>::Constant(std::numeric_limits<IndexElement>::max());
   height = tree_height_;
   morton_code = std::numeric_limits<MortonIndex>::max();
@@ -74,9 +94,10 @@ void QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::reset() {
   node_stack_.fill({});
 }
 
-template <typename CellDataT, int dim>
-typename QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::BlockType*
-QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getBlock(
+template <typename CellDataT, int dim, typename BackendT>
+typename QueryAccelerator<
+    NdtreeBlockHash<CellDataT, dim, BackendT>>::BlockType*
+QueryAccelerator<NdtreeBlockHash<CellDataT, dim, BackendT>>::getBlock(
     const Index<dim>& block_index) {
   if (block_index != block_index_) {
     block_index_ = block_index;
@@ -89,10 +110,12 @@ QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getBlock(
   return block_;
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename... DefaultArgs>
-typename QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::BlockType&
-QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getOrAllocateBlock(
+typename QueryAccelerator<
+    NdtreeBlockHash<CellDataT, dim, BackendT>>::BlockType&
+QueryAccelerator<
+    NdtreeBlockHash<CellDataT, dim, BackendT>>::getOrAllocateBlock(
     const Index<dim>& block_index, DefaultArgs&&... args) {
   if (block_index != block_index_ || !block_) {
     block_index_ = block_index;
@@ -104,9 +127,10 @@ QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getOrAllocateBlock(
   return *block_;
 }
 
-template <typename CellDataT, int dim>
-typename QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::NodeType*
-QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getNode(
+template <typename CellDataT, int dim, typename BackendT>
+typename QueryAccelerator<
+    NdtreeBlockHash<CellDataT, dim, BackendT>>::NodeType*
+QueryAccelerator<NdtreeBlockHash<CellDataT, dim, BackendT>>::getNode(
     const OctreeIndex& index) {
   // Remember previous query indices and compute new ones
   const IndexElement previous_height = height;
@@ -147,10 +171,10 @@ QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getNode(
   return node_stack_[height];
 }
 
-template <typename CellDataT, int dim>
+template <typename CellDataT, int dim, typename BackendT>
 template <typename... DefaultArgs>
-typename QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::NodeType&
-QueryAccelerator<NdtreeBlockHash<CellDataT, dim>>::getOrAllocateNode(
+typename QueryAccelerator<NdtreeBlockHash<CellDataT, dim, BackendT>>::NodeType&
+QueryAccelerator<NdtreeBlockHash<CellDataT, dim, BackendT>>::getOrAllocateNode(
     const OctreeIndex& index, DefaultArgs&&... args) {
   // Remember previous query indices and compute new ones
   const IndexElement previous_height = height;
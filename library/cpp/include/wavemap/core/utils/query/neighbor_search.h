@@ -0,0 +1,87 @@
+#ifndef WAVEMAP_CORE_UTILS_QUERY_NEIGHBOR_SEARCH_H_
+#define WAVEMAP_CORE_UTILS_QUERY_NEIGHBOR_SEARCH_H_
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/ndtree_index.h"
+#include "wavemap/core/utils/query/classified_map.h"
+#include "wavemap/core/utils/query/occupancy.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap {
+// Finds the cells of a ClassifiedMap that match a target occupancy, such as the
+// nearest occupied cells, without building a full distance field. The nearest
+// neighbor queries run a best-first search over the blocks and octree nodes,
+// ordered by their AABB distance to the query point, such that only nodes that
+// could contain a closer match are ever expanded.
+// NOTE: Cells that are not covered by any block are treated as unobserved.
+//       Distances are measured to the closest point of each cell, and are
+//       therefore zero for query points inside a matching cell.
+class NeighborSearch {
+ public:
+  struct Neighbor {
+    Index3D cell_index;
+    FloatingPoint distance;
+  };
+
+  static constexpr FloatingPoint kUnlimitedDistance =
+      std::numeric_limits<FloatingPoint>::max();
+
+  explicit NeighborSearch(
+      ClassifiedMap::ConstPtr classified_map,
+      Occupancy::Mask target_mask = Occupancy::toMask(Occupancy::kOccupied),
+      std::shared_ptr<ThreadPool> thread_pool = nullptr)
+      : classified_map_(std::move(classified_map)),
+        target_mask_(target_mask),
+        thread_pool_(thread_pool ? std::move(thread_pool)
+                                 : std::make_shared<ThreadPool>()) {}
+
+  // Find the nearest matching cell within the max distance
+  std::optional<Neighbor> findNearest(
+      const Point3D& point,
+      FloatingPoint max_distance = kUnlimitedDistance) const;
+
+  // Find up to k matching cells within the max distance, sorted by distance
+  std::vector<Neighbor> findKNearest(
+      const Point3D& point, size_t k,
+      FloatingPoint max_distance = kUnlimitedDistance) const;
+
+  // Find all matching nodes that overlap the sphere. Each node is either a
+  // cell on the sphere's boundary or the largest node that lies entirely
+  // inside the sphere and only contains matching cells.
+  std::vector<OctreeIndex> findWithinRadius(const Point3D& center,
+                                            FloatingPoint radius) const;
+
+  // Compute the distance from each point to its nearest matching cell, in
+  // parallel. Points without a match within the max distance are assigned
+  // the max distance.
+  std::vector<FloatingPoint> getNearestDistances(
+      const std::vector<Point3D>& points,
+      FloatingPoint max_distance = kUnlimitedDistance) const;
+
+  const ClassifiedMap& getClassifiedMap() const { return *classified_map_; }
+  Occupancy::Mask getTargetMask() const { return target_mask_; }
+
+ private:
+  const ClassifiedMap::ConstPtr classified_map_;
+  const Occupancy::Mask target_mask_;
+  const std::shared_ptr<ThreadPool> thread_pool_;
+
+  // Number of points processed per thread pool task
+  static constexpr size_t kPointsPerTask = 64;
+
+  // Call the visitor with each matching cell, in order of increasing distance,
+  // until it returns false or no matching cells within the max distance remain
+  template <typename NeighborVisitor>
+  void forEachNeighborByDistance(const Point3D& point,
+                                 FloatingPoint max_distance,
+                                 NeighborVisitor visitor_fn) const;
+};
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_UTILS_QUERY_NEIGHBOR_SEARCH_H_
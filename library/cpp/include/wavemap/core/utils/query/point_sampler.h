@@ -1,8 +1,11 @@
 #ifndef WAVEMAP_CORE_UTILS_QUERY_POINT_SAMPLER_H_
 #define WAVEMAP_CORE_UTILS_QUERY_POINT_SAMPLER_H_
 
+#include <array>
+#include <optional>
 #include <random>
 #include <utility>
+#include <vector>
 
 #include "wavemap/core/common.h"
 #include "wavemap/core/utils/query/classified_map.h"
@@ -11,11 +14,23 @@
 #include "wavemap/core/utils/shape/aabb.h"
 
 namespace wavemap {
+/**
+ * Class to draw random blocks and points from a ClassifiedMap.
+ * Random blocks are drawn in constant time from a dense list of the map's
+ * blocks. Random points without bounding box constraint are drawn directly
+ * from the regions that fully match the requested occupancy, with a
+ * probability proportional to each region's volume, instead of through
+ * rejection sampling. These regions are indexed lazily, the first time each
+ * occupancy mask is requested.
+ * @note If the classified map changes after the sampler was created, update()
+ *       must be called to refresh the sampler's indices.
+ */
 class PointSampler {
  public:
   explicit PointSampler(ClassifiedMap::ConstPtr classified_map,
-                        size_t random_seed = std::random_device()())
-      : classified_map_(std::move(classified_map)), rng_(random_seed) {}
+                        size_t random_seed = std::random_device()());
+
+  void update();
 
   std::optional<Index3D> getRandomBlock();
 
@@ -28,6 +43,10 @@ class PointSampler {
       const std::optional<AABB<Point3D>>& aabb = std::nullopt,
       size_t max_attempts = 1000);
 
+  // Number of cells that fully match the given occupancy
+  uint64_t getMatchingVolume(Occupancy::Id occupancy_type);
+  uint64_t getMatchingVolume(Occupancy::Mask occupancy_mask);
+
  private:
   const ClassifiedMap::ConstPtr classified_map_;
 
@@ -37,12 +56,32 @@ class PointSampler {
   const FloatingPoint min_cell_width_ = classified_map_->getMinCellWidth();
   const FloatingPoint min_cell_width_inv_ = 1.f / min_cell_width_;
 
+  // Dense list of the classified map's blocks
+  std::vector<Index3D> block_indices_;
+
+  // Regions that fully match an occupancy mask and their cumulative volumes
+  struct MatchingRegions {
+    std::vector<OctreeIndex> node_indices;
+    std::vector<uint64_t> cumulative_volumes;
+
+    uint64_t getTotalVolume() const {
+      return cumulative_volumes.empty() ? 0u : cumulative_volumes.back();
+    }
+  };
+  static constexpr size_t kNumOccupancyMasks = 8;
+  std::array<std::optional<MatchingRegions>, kNumOccupancyMasks>
+      matching_regions_{};
+  const MatchingRegions& getMatchingRegions(Occupancy::Mask occupancy_mask);
+
   std::optional<Point3D> getRandomPointImpl(
       Occupancy::Mask occupancy_mask, const std::optional<AABB<Point3D>>& aabb,
       size_t& attempt_idx, size_t max_attempts);
+  std::optional<Point3D> getRandomMatchingPoint(Occupancy::Mask occupancy_mask,
+                                                size_t max_attempts);
 
   Point3D getRandomPointInAABB(const AABB<Point3D>& aabb);
   Point3D getRandomPointInBlock(const Index3D& block_index);
+  Point3D getRandomPointInNode(const OctreeIndex& node_index);
 };
 }  // namespace wavemap
 
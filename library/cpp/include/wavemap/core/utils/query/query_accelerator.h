@@ -2,6 +2,7 @@
 #define WAVEMAP_CORE_UTILS_QUERY_QUERY_ACCELERATOR_H_
 
 #include <limits>
+#include <vector>
 
 #include "wavemap/core/data_structure/dense_block_hash.h"
 #include "wavemap/core/data_structure/ndtree_block_hash.h"
@@ -9,6 +10,7 @@
 #include "wavemap/core/indexing/index_hashes.h"
 #include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
 
 namespace wavemap {
 // Base template
@@ -22,12 +24,13 @@ template <typename T>
 QueryAccelerator(const T& type) -> QueryAccelerator<T>;
 
 // Query accelerator for vanilla spatial hashes
-template <typename BlockDataT, int dim>
-class QueryAccelerator<SpatialHash<BlockDataT, dim>> {
+template <typename BlockDataT, int dim, typename BackendT>
+class QueryAccelerator<SpatialHash<BlockDataT, dim, BackendT>> {
  public:
   static constexpr int kDim = dim;
 
-  explicit QueryAccelerator(SpatialHash<BlockDataT, dim>& spatial_hash)
+  explicit QueryAccelerator(
+      SpatialHash<BlockDataT, dim, BackendT>& spatial_hash)
       : spatial_hash_(spatial_hash) {}
 
   //! Copy and move constructors
@@ -42,7 +45,7 @@ class QueryAccelerator<SpatialHash<BlockDataT, dim>> {
                                  DefaultArgs&&... args);
 
  private:
-  SpatialHash<BlockDataT, dim>& spatial_hash_;
+  SpatialHash<BlockDataT, dim, BackendT>& spatial_hash_;
 
   Index<dim> last_block_index_ =
       Index3D::Constant(std::numeric_limits<IndexElement>::max());
@@ -50,17 +53,18 @@ class QueryAccelerator<SpatialHash<BlockDataT, dim>> {
 };
 
 // Query accelerator for dense block hashes
-template <typename CellDataT, int dim, unsigned int cells_per_side>
-class QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side>> {
+template <typename CellDataT, int dim, unsigned int cells_per_side,
+          typename BackendT>
+class QueryAccelerator<
+    DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>> {
  public:
   static constexpr int kDim = dim;
-  using BlockType =
-      typename DenseBlockHash<CellDataT, dim, cells_per_side>::Block;
-  using CellType =
-      typename DenseBlockHash<CellDataT, dim, cells_per_side>::Cell;
+  using DenseBlockHashType =
+      DenseBlockHash<CellDataT, dim, cells_per_side, BackendT>;
+  using BlockType = typename DenseBlockHashType::Block;
+  using CellType = typename DenseBlockHashType::Cell;
 
-  explicit QueryAccelerator(
-      const DenseBlockHash<CellDataT, dim, cells_per_side>& dense_block_hash)
+  explicit QueryAccelerator(const DenseBlockHashType& dense_block_hash)
       : dense_block_hash_(dense_block_hash) {}
 
   //! Copy and move constructors
@@ -69,26 +73,33 @@ class QueryAccelerator<DenseBlockHash<CellDataT, dim, cells_per_side>> {
 
   void reset();
 
+  // NOTE: If the hash's block directory is enabled, moving to a neighboring
+  //       block follows the directory's neighbor links instead of hashing.
   const BlockType* getBlock(const Index<dim>& block_index);
   const CellDataT* getValue(const Index<dim>& index);
 
  private:
-  const DenseBlockHash<CellDataT, dim, cells_per_side>& dense_block_hash_;
+  using DirectoryEntry = typename DenseBlockHashType::BlockHashMap::
+      BlockDirectory::Entry;
+
+  const DenseBlockHashType& dense_block_hash_;
 
   Index<dim> block_index_ =
       Index<dim>::Constant(std::numeric_limits<IndexElement>::max());
   const BlockType* block_ = nullptr;
+  const DirectoryEntry* directory_entry_ = nullptr;
 };
 
 // Query accelerator for ndtree block hashes
-template <typename CellDataT, int dim>
-class QueryAccelerator<NdtreeBlockHash<CellDataT, dim>> {
+template <typename CellDataT, int dim, typename BackendT>
+class QueryAccelerator<NdtreeBlockHash<CellDataT, dim, BackendT>> {
  public:
   static constexpr int kDim = dim;
-  using BlockType = typename NdtreeBlockHash<CellDataT, dim>::Block;
+  using NdtreeBlockHashType = NdtreeBlockHash<CellDataT, dim, BackendT>;
+  using BlockType = typename NdtreeBlockHashType::Block;
   using NodeType = typename BlockType::NodeType;
 
-  explicit QueryAccelerator(NdtreeBlockHash<CellDataT, dim>& ndtree_block_hash)
+  explicit QueryAccelerator(NdtreeBlockHashType& ndtree_block_hash)
       : ndtree_block_hash_(ndtree_block_hash) {}
 
   //! Copy and move constructors
@@ -107,7 +118,7 @@ class QueryAccelerator<NdtreeBlockHash<CellDataT, dim>> {
   NodeType& getOrAllocateNode(const OctreeIndex& index, DefaultArgs&&... args);
 
  private:
-  NdtreeBlockHash<CellDataT, dim>& ndtree_block_hash_;
+  NdtreeBlockHashType& ndtree_block_hash_;
   const IndexElement tree_height_ = ndtree_block_hash_.getMaxHeight();
 
   Index<dim> block_index_ =
@@ -128,13 +139,18 @@ class QueryAccelerator<NdtreeBlockHash<CellDataT, dim>> {
  *       Since the accelerator is lightweight and cheap to construct, we
  *       recommend using a separate instance per thread for the best performance
  *       and simplicity.
+ * @note The accelerator is implemented for the HashedWaveletOctree and the
+ *       LinearHashedWaveletOctree. Maps whose blocks compress their
+ *       coefficients, such as the QuantizedHashedWaveletOctree, are not
+ *       supported since their nodes can not be cached directly.
  */
-template <>
-class QueryAccelerator<HashedWaveletOctree> {
+template <typename BlockT>
+class QueryAccelerator<BasicHashedWaveletOctree<BlockT>> {
  public:
-  static constexpr int kDim = HashedWaveletOctree::kDim;
+  using MapType = BasicHashedWaveletOctree<BlockT>;
+  static constexpr int kDim = MapType::kDim;
 
-  explicit QueryAccelerator(const HashedWaveletOctree& map) : map_(map) {}
+  explicit QueryAccelerator(const MapType& map) : map_(map) {}
 
   //! Copy and move constructors
   QueryAccelerator(const QueryAccelerator& other) = default;
@@ -155,14 +171,22 @@ class QueryAccelerator<HashedWaveletOctree> {
   //! Query the value of the map at a given octree node index
   FloatingPoint getCellValue(const OctreeIndex& index);
 
+  //! Query the values of the map at a batch of indices
+  //! @note The queries are performed in Morton order, such that consecutive
+  //!       queries share as many cached ancestors as possible, but the values
+  //!       are returned in the order of the given indices. This mainly pays
+  //!       off for incoherent batches, e.g. random samples. Coherent queries,
+  //!       e.g. along rays, are best performed one by one with getCellValue.
+  std::vector<FloatingPoint> getCellValues(const std::vector<Index3D>& indices);
+
   //! Convenience function to get the map's minimum cell width
   FloatingPoint getMinCellWidth() const { return map_.getMinCellWidth(); }
 
  private:
-  using BlockIndex = HashedWaveletOctree::BlockIndex;
-  using NodePtrType = HashedWaveletOctree::Block::OctreeType::NodeConstPtrType;
+  using BlockIndex = typename MapType::BlockIndex;
+  using NodePtrType = typename BlockT::OctreeType::NodeConstPtrType;
 
-  const HashedWaveletOctree& map_;
+  const MapType& map_;
   const IndexElement tree_height_ = map_.getTreeHeight();
 
   std::array<NodePtrType, morton::kMaxTreeHeight<3>> node_stack_{};
@@ -211,6 +235,14 @@ class QueryAccelerator<HashedChunkedWaveletOctree> {
   //! Query the value of the map at a given octree node index
   FloatingPoint getCellValue(const OctreeIndex& index);
 
+  //! Query the values of the map at a batch of indices
+  //! @note The queries are performed in Morton order, such that consecutive
+  //!       queries share as many cached ancestors as possible, but the values
+  //!       are returned in the order of the given indices. This mainly pays
+  //!       off for incoherent batches, e.g. random samples. Coherent queries,
+  //!       e.g. along rays, are best performed one by one with getCellValue.
+  std::vector<FloatingPoint> getCellValues(const std::vector<Index3D>& indices);
+
   //! Convenience function to get the map's minimum cell width
   FloatingPoint getMinCellWidth() const { return map_.getMinCellWidth(); }
 
@@ -0,0 +1,65 @@
+#ifndef WAVEMAP_CORE_UTILS_QUERY_RAYCASTER_H_
+#define WAVEMAP_CORE_UTILS_QUERY_RAYCASTER_H_
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/image.h"
+#include "wavemap/core/integrator/projection_model/projector_base.h"
+#include "wavemap/core/utils/query/classified_map.h"
+#include "wavemap/core/utils/query/occupancy.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap {
+// Casts rays against a ClassifiedMap and returns the distance to the first cell
+// whose occupancy matches the hit mask. Instead of stepping through the map at
+// its maximum resolution, each block along the ray is descended front-to-back,
+// skipping all subtrees that the ray misses or that contain no matching cells.
+// NOTE: Cells that are not covered by any block are treated as unobserved.
+class Raycaster {
+ public:
+  explicit Raycaster(
+      ClassifiedMap::ConstPtr classified_map,
+      Occupancy::Mask hit_mask = Occupancy::toMask(Occupancy::kOccupied),
+      std::shared_ptr<ThreadPool> thread_pool = nullptr)
+      : classified_map_(std::move(classified_map)),
+        hit_mask_(hit_mask),
+        thread_pool_(thread_pool ? std::move(thread_pool)
+                                 : std::make_shared<ThreadPool>()) {}
+
+  // Return the distance from the ray's start to the first matching cell, or
+  // nullopt if no matching cell lies within the max range
+  std::optional<FloatingPoint> castRay(const Point3D& W_start,
+                                       const Vector3D& W_direction,
+                                       FloatingPoint max_range) const;
+
+  // Cast a ray through every pixel of the sensor, in parallel, and store the
+  // hits' sensor Z coordinates (e.g. the range for spherical projectors or the
+  // depth for pinhole cameras). Pixels without a hit are set to zero.
+  Image<> renderRangeImage(const ProjectorBase& projection_model,
+                           const Transformation3D& T_W_C,
+                           FloatingPoint max_range) const;
+
+  const ClassifiedMap& getClassifiedMap() const { return *classified_map_; }
+  Occupancy::Mask getHitMask() const { return hit_mask_; }
+
+ private:
+  const ClassifiedMap::ConstPtr classified_map_;
+  const Occupancy::Mask hit_mask_;
+  const std::shared_ptr<ThreadPool> thread_pool_;
+
+  // Distances along the ray at which it enters and exits the box, where the
+  // exit precedes the entry if the ray misses the box
+  static std::pair<FloatingPoint, FloatingPoint> intersectBox(
+      const Point3D& start, const Vector3D& direction,
+      const AABB<Point3D>& box);
+
+  std::optional<FloatingPoint> castRayThroughBlock(
+      const Point3D& start, const Vector3D& direction, FloatingPoint max_range,
+      const Index3D& block_index, const ClassifiedMap::Block& block) const;
+};
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_UTILS_QUERY_RAYCASTER_H_
@@ -0,0 +1,68 @@
+#ifndef WAVEMAP_CORE_UTILS_SHAPE_CAPSULE_H_
+#define WAVEMAP_CORE_UTILS_SHAPE_CAPSULE_H_
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/print/eigen.h"
+#include "wavemap/core/utils/shape/aabb.h"
+
+namespace wavemap {
+/**
+ * Capsule, defined as the set of points within a given radius of the line
+ * segment that connects its start and end points.
+ */
+template <typename PointT>
+struct Capsule {
+  static constexpr int kDim = dim_v<PointT>;
+  using PointType = PointT;
+  using ScalarType = typename PointT::Scalar;
+
+  PointT start = PointT::Constant(kNaN);
+  PointT end = PointT::Constant(kNaN);
+  ScalarType radius = static_cast<ScalarType>(0);
+
+  Capsule() = default;
+  Capsule(const PointT& start, const PointT& end, ScalarType radius)
+      : start(start), end(end), radius(radius) {}
+  Capsule(PointT&& start, PointT&& end, ScalarType radius)
+      : start(std::move(start)), end(std::move(end)), radius(radius) {}
+
+  operator AABB<PointT>() const {
+    if (std::isnan(start[0])) {
+      return {};
+    }
+    return {start.cwiseMin(end).array() - radius,
+            start.cwiseMax(end).array() + radius};
+  }
+
+  PointT closestPointOnAxisTo(const PointT& point) const {
+    const PointT direction = end - start;
+    const ScalarType squared_length = direction.squaredNorm();
+    if (squared_length <= static_cast<ScalarType>(0)) {
+      return start;
+    }
+    const ScalarType t =
+        std::clamp((point - start).dot(direction) / squared_length,
+                   static_cast<ScalarType>(0), static_cast<ScalarType>(1));
+    return start + t * direction;
+  }
+
+  bool contains(const PointT& point) const {
+    return (point - closestPointOnAxisTo(point)).squaredNorm() <=
+           radius * radius;
+  }
+
+  std::string toString() const {
+    std::stringstream ss;
+    ss << "[start =" << print::eigen::oneLine(start)
+       << ", end =" << print::eigen::oneLine(end) << ", radius = " << radius
+       << "]";
+    return ss.str();
+  }
+};
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_UTILS_SHAPE_CAPSULE_H_
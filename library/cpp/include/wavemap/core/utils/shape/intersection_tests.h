@@ -1,7 +1,12 @@
 #ifndef WAVEMAP_CORE_UTILS_SHAPE_INTERSECTION_TESTS_H_
 #define WAVEMAP_CORE_UTILS_SHAPE_INTERSECTION_TESTS_H_
 
+#include <algorithm>
+#include <array>
+
 #include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/shape/capsule.h"
+#include "wavemap/core/utils/shape/oriented_box.h"
 #include "wavemap/core/utils/shape/sphere.h"
 
 namespace wavemap::shape {
@@ -34,6 +39,45 @@ bool is_inside(const Sphere<PointT>& inner, const AABB<PointT>& outer) {
       .all();
 }
 
+// AABB inside OrientedBox
+template <typename PointT>
+bool is_inside(const AABB<PointT>& inner, const OrientedBox<PointT>& outer) {
+  // Since the box is convex, it contains the AABB iff it contains its corners
+  for (int corner_idx = 0; corner_idx < AABB<PointT>::kNumCorners;
+       ++corner_idx) {
+    if (!outer.contains(inner.corner_point(corner_idx))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// OrientedBox inside AABB
+template <typename PointT>
+bool is_inside(const OrientedBox<PointT>& inner, const AABB<PointT>& outer) {
+  return is_inside(static_cast<AABB<PointT>>(inner), outer);
+}
+
+// AABB inside Capsule
+template <typename PointT>
+bool is_inside(const AABB<PointT>& inner, const Capsule<PointT>& outer) {
+  // Since the capsule is convex, it contains the AABB iff it contains its
+  // corners
+  for (int corner_idx = 0; corner_idx < AABB<PointT>::kNumCorners;
+       ++corner_idx) {
+    if (!outer.contains(inner.corner_point(corner_idx))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Capsule inside AABB
+template <typename PointT>
+bool is_inside(const Capsule<PointT>& inner, const AABB<PointT>& outer) {
+  return is_inside(static_cast<AABB<PointT>>(inner), outer);
+}
+
 // AABB <-> AABB overlap
 template <typename PointT>
 bool overlaps(const AABB<PointT>& aabb_A, const AABB<PointT>& aabb_B) {
@@ -52,6 +96,120 @@ template <typename PointT>
 bool overlaps(const Sphere<PointT>& sphere, const AABB<PointT>& aabb) {
   return overlaps(aabb, sphere);
 }
+
+// AABB <-> OrientedBox overlap
+template <typename PointT>
+bool overlaps(const AABB<PointT>& aabb, const OrientedBox<PointT>& box) {
+  // Check whether any of the candidate axes given by the separating axis
+  // theorem separates the two boxes
+  using ScalarType = typename PointT::Scalar;
+  const PointT aabb_half_extents = aabb.widths() / static_cast<ScalarType>(2);
+  const PointT center_offset =
+      box.center - (aabb.min + aabb.max) / static_cast<ScalarType>(2);
+  auto separates = [&](const PointT& axis) {
+    const ScalarType aabb_radius = aabb_half_extents.dot(axis.cwiseAbs());
+    const ScalarType box_radius =
+        box.half_extents.dot((box.rotation.transpose() * axis).cwiseAbs());
+    return aabb_radius + box_radius < std::abs(center_offset.dot(axis));
+  };
+  for (int dim_idx = 0; dim_idx < PointT::RowsAtCompileTime; ++dim_idx) {
+    if (separates(PointT::Unit(dim_idx)) ||
+        separates(box.rotation.col(dim_idx))) {
+      return false;
+    }
+  }
+  if constexpr (PointT::RowsAtCompileTime == 3) {
+    for (int aabb_axis_idx = 0; aabb_axis_idx < 3; ++aabb_axis_idx) {
+      for (int box_axis_idx = 0; box_axis_idx < 3; ++box_axis_idx) {
+        const PointT axis = PointT::Unit(aabb_axis_idx)
+                                .cross(box.rotation.col(box_axis_idx));
+        if (separates(axis)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+template <typename PointT>
+bool overlaps(const OrientedBox<PointT>& box, const AABB<PointT>& aabb) {
+  return overlaps(aabb, box);
+}
+
+// AABB <-> Capsule overlap
+template <typename PointT>
+bool overlaps(const AABB<PointT>& aabb, const Capsule<PointT>& capsule) {
+  // The squared distance from the capsule's axis to the AABB is a convex,
+  // piecewise quadratic function of the position along the axis. Its pieces
+  // change wherever the axis enters or leaves one of the AABB's slabs, so we
+  // minimize it exactly by minimizing each piece.
+  using ScalarType = typename PointT::Scalar;
+  constexpr int kDim = dim_v<PointT>;
+  constexpr auto kZero = static_cast<ScalarType>(0);
+  constexpr auto kOne = static_cast<ScalarType>(1);
+  const PointT direction = capsule.end - capsule.start;
+  std::array<ScalarType, 2 * kDim + 2> breakpoints{kZero, kOne};
+  int num_breakpoints = 2;
+  for (int dim_idx = 0; dim_idx < kDim; ++dim_idx) {
+    if (direction[dim_idx] == kZero) {
+      continue;
+    }
+    for (const ScalarType bound : {aabb.min[dim_idx], aabb.max[dim_idx]}) {
+      const ScalarType t =
+          (bound - capsule.start[dim_idx]) / direction[dim_idx];
+      if (!(kZero < t && t < kOne)) {
+        continue;
+      }
+      // Insert the breakpoint in order, as there are at most 2 * kDim of them
+      int insert_idx = num_breakpoints++;
+      for (; t < breakpoints[insert_idx - 1]; --insert_idx) {
+        breakpoints[insert_idx] = breakpoints[insert_idx - 1];
+      }
+      breakpoints[insert_idx] = t;
+    }
+  }
+
+  const ScalarType squared_radius = capsule.radius * capsule.radius;
+  for (int piece_idx = 0; piece_idx + 1 < num_breakpoints; ++piece_idx) {
+    const ScalarType t_begin = breakpoints[piece_idx];
+    const ScalarType t_end = breakpoints[piece_idx + 1];
+    // Within each piece, every axis either lies inside the AABB's slab and
+    // contributes nothing, or contributes the squared offset to one of its
+    // bounds. Sum the quadratic terms to find the piece's minimum.
+    const ScalarType t_mid = (t_begin + t_end) / static_cast<ScalarType>(2);
+    const PointT point_mid = capsule.start + t_mid * direction;
+    ScalarType quadratic_coefficient = kZero;
+    ScalarType linear_coefficient = kZero;
+    for (int dim_idx = 0; dim_idx < kDim; ++dim_idx) {
+      ScalarType bound;
+      if (point_mid[dim_idx] < aabb.min[dim_idx]) {
+        bound = aabb.min[dim_idx];
+      } else if (aabb.max[dim_idx] < point_mid[dim_idx]) {
+        bound = aabb.max[dim_idx];
+      } else {
+        continue;
+      }
+      quadratic_coefficient += direction[dim_idx] * direction[dim_idx];
+      linear_coefficient +=
+          direction[dim_idx] * (capsule.start[dim_idx] - bound);
+    }
+    const ScalarType t_min =
+        kZero < quadratic_coefficient
+            ? std::clamp(-linear_coefficient / quadratic_coefficient, t_begin,
+                         t_end)
+            : t_begin;
+    const PointT closest_point_on_axis = capsule.start + t_min * direction;
+    if ((closest_point_on_axis - aabb.closestPointTo(closest_point_on_axis))
+            .squaredNorm() <= squared_radius) {
+      return true;
+    }
+  }
+  return false;
+}
+template <typename PointT>
+bool overlaps(const Capsule<PointT>& capsule, const AABB<PointT>& aabb) {
+  return overlaps(aabb, capsule);
+}
 }  // namespace wavemap::shape
 
 #endif  // WAVEMAP_CORE_UTILS_SHAPE_INTERSECTION_TESTS_H_
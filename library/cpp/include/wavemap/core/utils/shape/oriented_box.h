@@ -0,0 +1,66 @@
+#ifndef WAVEMAP_CORE_UTILS_SHAPE_ORIENTED_BOX_H_
+#define WAVEMAP_CORE_UTILS_SHAPE_ORIENTED_BOX_H_
+
+#include <string>
+#include <utility>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/print/eigen.h"
+#include "wavemap/core/utils/shape/aabb.h"
+
+namespace wavemap {
+/**
+ * Box whose axes can be arbitrarily rotated w.r.t. the world frame.
+ * The box is parameterized by its center, its half extents along each of its
+ * axes and a rotation matrix whose columns are the box's axes expressed in
+ * world frame.
+ */
+template <typename PointT>
+struct OrientedBox {
+  static constexpr int kDim = dim_v<PointT>;
+  using PointType = PointT;
+  using ScalarType = typename PointT::Scalar;
+  using RotationMatrix = Eigen::Matrix<ScalarType, kDim, kDim>;
+
+  PointT center = PointT::Constant(kNaN);
+  PointT half_extents = PointT::Zero();
+  RotationMatrix rotation = RotationMatrix::Identity();
+
+  OrientedBox() = default;
+  OrientedBox(const PointT& center, const PointT& half_extents,
+              const RotationMatrix& rotation)
+      : center(center), half_extents(half_extents), rotation(rotation) {}
+  OrientedBox(PointT&& center, PointT&& half_extents,
+              RotationMatrix&& rotation)
+      : center(std::move(center)),
+        half_extents(std::move(half_extents)),
+        rotation(std::move(rotation)) {}
+
+  operator AABB<PointT>() const {
+    if (std::isnan(center[0])) {
+      return {};
+    }
+    const PointT world_half_extents = rotation.cwiseAbs() * half_extents;
+    return {center - world_half_extents, center + world_half_extents};
+  }
+
+  PointT toBoxFrame(const PointT& point) const {
+    return rotation.transpose() * (point - center);
+  }
+
+  bool contains(const PointT& point) const {
+    return (toBoxFrame(point).cwiseAbs().array() <= half_extents.array())
+        .all();
+  }
+
+  std::string toString() const {
+    std::stringstream ss;
+    ss << "[center =" << print::eigen::oneLine(center)
+       << ", half_extents =" << print::eigen::oneLine(half_extents)
+       << ", rotation =" << print::eigen::oneLine(rotation) << "]";
+    return ss.str();
+  }
+};
+}  // namespace wavemap
+
+#endif  // WAVEMAP_CORE_UTILS_SHAPE_ORIENTED_BOX_H_
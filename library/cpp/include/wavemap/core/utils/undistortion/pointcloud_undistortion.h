@@ -1,13 +1,33 @@
 #ifndef WAVEMAP_CORE_UTILS_UNDISTORTION_POINTCLOUD_UNDISTORTION_H_
 #define WAVEMAP_CORE_UTILS_UNDISTORTION_POINTCLOUD_UNDISTORTION_H_
 
+#include <memory>
+
 #include "wavemap/core/data_structure/pointcloud.h"
+#include "wavemap/core/utils/thread_pool.h"
 #include "wavemap/core/utils/undistortion/stamped_pointcloud.h"
 #include "wavemap/core/utils/undistortion/stamped_pose_buffer.h"
 
 namespace wavemap::undistortion {
-PosedPointcloud<> compensate_motion(const StampedPoseBuffer& pose_buffer,
-                                    StampedPointcloud& stamped_pointcloud);
+//! Compensate the sensor's motion during the pointcloud's acquisition, using
+//! the poses in the pose buffer. The result is expressed in the sensor frame
+//! at the median of the points' timestamps, see
+//! StampedPointcloud::getMedianTime(). If a thread pool is provided, the points
+//! are transformed in parallel.
+//! NOTE: Computing the median time sorts the points by time. For pointclouds
+//!       whose points are not ordered by time, this frame differs from the
+//!       frame at the time of the middle point in storage order, which earlier
+//!       versions used.
+PosedPointcloud<> compensate_motion(
+    const StampedPoseBuffer& pose_buffer, StampedPointcloud& stamped_pointcloud,
+    const std::shared_ptr<ThreadPool>& thread_pool = nullptr);
+
+//! Same as above, but writing the result into an existing pointcloud such
+//! that its memory can be reused across scans
+void compensate_motion(
+    const StampedPoseBuffer& pose_buffer, StampedPointcloud& stamped_pointcloud,
+    PosedPointcloud<>& undistorted_pointcloud,
+    const std::shared_ptr<ThreadPool>& thread_pool = nullptr);
 }  // namespace wavemap::undistortion
 
 #endif  // WAVEMAP_CORE_UTILS_UNDISTORTION_POINTCLOUD_UNDISTORTION_H_
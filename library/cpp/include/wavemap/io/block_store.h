@@ -0,0 +1,54 @@
+#ifndef WAVEMAP_IO_BLOCK_STORE_H_
+#define WAVEMAP_IO_BLOCK_STORE_H_
+
+#include <filesystem>
+#include <unordered_set>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_hashes.h"
+#include "wavemap/core/map/hashed_wavelet_octree_block.h"
+
+namespace wavemap::io {
+// Stores hashed wavelet octree blocks on disk, in one file per block. The
+// blocks are encoded in the same way as the blocks of serialized maps.
+// NOTE: The store only keeps track of the blocks that were stored through it.
+//       Files left in the directory by previous instances are ignored and
+//       overwritten when blocks with the same index are stored.
+class BlockStore {
+ public:
+  using BlockIndexSet = std::unordered_set<Index3D, Index3DHash>;
+
+  // Create a store in the given directory, which is created if needed
+  explicit BlockStore(std::filesystem::path directory);
+
+  bool empty() const { return block_indices_.empty(); }
+  size_t size() const { return block_indices_.size(); }
+  // Erase all the stored blocks, including their files
+  void clear();
+
+  bool hasBlock(const Index3D& block_index) const {
+    return block_indices_.count(block_index);
+  }
+  const BlockIndexSet& getBlockIndices() const { return block_indices_; }
+
+  // Write the block to disk, replacing any previously stored version
+  bool storeBlock(const Index3D& block_index,
+                  const HashedWaveletOctreeBlock& block,
+                  FloatingPoint min_log_odds, FloatingPoint max_log_odds);
+  // Read a stored block into the given, empty block
+  // NOTE: The block remains in the store until it is erased.
+  bool loadBlock(const Index3D& block_index,
+                 HashedWaveletOctreeBlock& block) const;
+  bool eraseBlock(const Index3D& block_index);
+
+  const std::filesystem::path& getDirectory() const { return directory_; }
+  std::filesystem::path getBlockFilePath(const Index3D& block_index) const;
+
+ private:
+  const std::filesystem::path directory_;
+
+  BlockIndexSet block_indices_;
+};
+}  // namespace wavemap::io
+
+#endif  // WAVEMAP_IO_BLOCK_STORE_H_
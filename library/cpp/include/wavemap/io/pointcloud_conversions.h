@@ -0,0 +1,66 @@
+#ifndef WAVEMAP_IO_POINTCLOUD_CONVERSIONS_H_
+#define WAVEMAP_IO_POINTCLOUD_CONVERSIONS_H_
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <ostream>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/config/config_base.h"
+#include "wavemap/core/config/type_selector.h"
+#include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/thread_pool.h"
+
+namespace wavemap::io {
+struct PointcloudFormat : TypeSelector<PointcloudFormat> {
+  using TypeSelector<PointcloudFormat>::TypeSelector;
+
+  enum Id : TypeId { kPly, kPcd };
+
+  static constexpr std::array names = {"ply", "pcd"};
+};
+
+/**
+ * Config struct for exporting the occupied cells of a map as a pointcloud.
+ */
+struct OccupiedPointcloudConfig
+    : ConfigBase<OccupiedPointcloudConfig, 4, PointcloudFormat> {
+  //! Format of the exported pointcloud. The points are always stored in binary.
+  PointcloudFormat format = PointcloudFormat::kPly;
+  //! Nodes whose occupancy exceeds this threshold, in log-odds, are exported.
+  FloatingPoint occupancy_threshold = 0.01f;
+  //! Height of the nodes whose centers are exported as points. Height 0
+  //! corresponds to the map's maximum resolution, and every subsequent height
+  //! halves the resolution. Nodes at this height are classified based on their
+  //! average occupancy.
+  IndexElement output_height = 0;
+  //! Maximum number of blocks that are converted in parallel while the
+  //! previous batch is written. Bounds the exporter's memory usage.
+  int max_blocks_per_batch = 256;
+
+  static MemberMap memberMap;
+
+  bool isValid(bool verbose) const override;
+};
+
+// Write the centers of all occupied nodes as a binary PLY or PCD pointcloud.
+// Only points inside the optional region are exported. Hashed wavelet octrees
+// are converted block by block, in parallel, without ever holding the full
+// pointcloud in memory. Other map types are converted serially.
+// NOTE: For maps that are not hashed wavelet octrees, leaves below the output
+//       height are exported at their own resolution.
+bool occupiedCellsToStream(
+    const MapBase& map, std::ostream& ostream,
+    const OccupiedPointcloudConfig& config = {},
+    const std::optional<AABB<Point3D>>& region = std::nullopt,
+    std::shared_ptr<ThreadPool> thread_pool = nullptr);
+bool occupiedCellsToFile(
+    const MapBase& map, const std::filesystem::path& file_path,
+    const OccupiedPointcloudConfig& config = {},
+    const std::optional<AABB<Point3D>>& region = std::nullopt,
+    std::shared_ptr<ThreadPool> thread_pool = nullptr);
+}  // namespace wavemap::io
+
+#endif  // WAVEMAP_IO_POINTCLOUD_CONVERSIONS_H_
@@ -0,0 +1,98 @@
+#ifndef WAVEMAP_IO_SLIDING_WINDOW_MAP_H_
+#define WAVEMAP_IO_SLIDING_WINDOW_MAP_H_
+
+#include <optional>
+#include <string>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/config/config_base.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/io/block_store.h"
+
+namespace wavemap::io {
+/**
+ * Config struct for sliding window maps, which keep the blocks around a moving
+ * center point in memory and spill all other blocks to disk.
+ */
+struct SlidingWindowMapConfig : ConfigBase<SlidingWindowMapConfig, 3> {
+  //! Blocks that lie entirely further than this distance from the window's
+  //! center are evicted from memory. Should exceed the sensors' maximum range,
+  //! such that integration only touches blocks that are kept in memory.
+  Meters<FloatingPoint> radius = 50.f;
+  //! Maximum memory usage of the blocks kept in memory, in megabytes. When
+  //! exceeded, the blocks furthest from the window's center are evicted first,
+  //! even if they lie within the radius. Set to 0 to disable the budget.
+  int memory_budget_in_mb = 0;
+  //! Directory in which the evicted blocks are stored.
+  std::string storage_directory;
+
+  static MemberMap memberMap;
+
+  bool isValid(bool verbose) const override;
+};
+
+// Bounds the memory usage of a hashed wavelet octree by only keeping the
+// blocks within a radius, or memory budget, around a moving center point in
+// memory. Evicted blocks are written to an on-disk BlockStore. They are only
+// paged back in when the window returns to them, when one of their cells is
+// queried through this class' getCellValue(...), or when they are requested
+// through loadRegion(...) or loadAll().
+// If the map allocates a block that was previously evicted, for example because
+// a measurement reached beyond the window, the stored and allocated blocks are
+// merged when the stored block is paged back in. Since log-odds updates are
+// additive, no information is lost in this case.
+// NOTE: All other accessors, such as the map's own leaf visitors, the
+//       QueryAccelerator and the ClassifiedMap, operate on the underlying map
+//       directly and do not see the evicted blocks. Call loadRegion(...) or
+//       loadAll() before using them on regions outside the window.
+// NOTE: The window is not thread-safe. It should be updated from the thread
+//       that updates the map, for example between integrator runs.
+// NOTE: Sliding windows are not yet configurable through the pipeline or ROS
+//       configs, and must be set up and updated through this class.
+class SlidingWindowMap {
+ public:
+  SlidingWindowMap(const SlidingWindowMapConfig& config,
+                   HashedWaveletOctree::Ptr map);
+
+  // Move the window, evicting the blocks that it no longer covers and paging
+  // in the stored blocks that it now covers
+  void update(const Point3D& center);
+
+  // Page in all stored blocks that overlap the region, e.g. before querying
+  // or integrating measurements outside the window
+  void loadRegion(const AABB<Point3D>& region);
+  // Page in all stored blocks, e.g. before saving the full map
+  void loadAll();
+
+  // Get a cell's value, paging in its block if it is stored
+  // NOTE: This is the only query that pages blocks in on demand.
+  FloatingPoint getCellValue(const Index3D& index);
+  FloatingPoint getCellValue(const OctreeIndex& index);
+
+  bool isBlockStored(const Index3D& block_index) const {
+    return block_store_.hasBlock(block_index);
+  }
+
+  const SlidingWindowMapConfig& getConfig() const { return config_; }
+  // Access the underlying map, which only contains the blocks in memory
+  const HashedWaveletOctree::Ptr& getMap() const { return map_; }
+  const BlockStore& getBlockStore() const { return block_store_; }
+
+ private:
+  const SlidingWindowMapConfig config_;
+  const HashedWaveletOctree::Ptr map_;
+  BlockStore block_store_;
+
+  // Distance of the nearest block that was evicted to meet the memory budget.
+  // Only closer blocks are paged in, until memory usage drops well below the
+  // budget, to avoid paging blocks in only to evict them again right away.
+  std::optional<FloatingPoint> budget_radius_;
+
+  bool loadBlock(const Index3D& block_index);
+  bool evictBlock(const Index3D& block_index);
+  AABB<Point3D> getBlockAABB(const Index3D& block_index) const;
+};
+}  // namespace wavemap::io
+
+#endif  // WAVEMAP_IO_SLIDING_WINDOW_MAP_H_
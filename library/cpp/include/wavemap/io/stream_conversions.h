@@ -9,11 +9,16 @@
 #include "wavemap/core/map/hashed_blocks.h"
 #include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
 #include "wavemap/core/map/wavelet_octree.h"
 #include "wavemap/io/streamable_types.h"
 
 namespace wavemap::io {
 bool mapToStream(const MapBase& map, std::ostream& ostream);
+// NOTE: Hashed wavelet octrees are deserialized into a
+//       LinearHashedWaveletOctree or QuantizedHashedWaveletOctree if the map
+//       argument points to one, and into a HashedWaveletOctree otherwise.
 bool streamToMap(std::istream& istream, MapBase::Ptr& map);
 
 bool mapToStream(const HashedBlocks& map, std::ostream& ostream);
@@ -25,6 +30,44 @@ bool streamToMap(std::istream& istream, WaveletOctree::Ptr& map);
 bool mapToStream(const HashedWaveletOctree& map, std::ostream& ostream);
 bool streamToMap(std::istream& istream, HashedWaveletOctree::Ptr& map);
 
+// Linear hashed wavelet octrees are stored in the same format as regular
+// hashed wavelet octrees, such that either type can be loaded from the other
+bool mapToStream(const LinearHashedWaveletOctree& map, std::ostream& ostream);
+bool streamToMap(std::istream& istream, LinearHashedWaveletOctree::Ptr& map);
+
+// Quantized hashed wavelet octrees are stored at full precision in the same
+// format as well. Their blocks are quantized again when they are loaded.
+bool mapToStream(const QuantizedHashedWaveletOctree& map,
+                 std::ostream& ostream);
+bool streamToMap(std::istream& istream,
+                 QuantizedHashedWaveletOctree::Ptr& map);
+
+// Serialize individual hashed wavelet octree blocks, using the same encoding
+// as the blocks of complete maps. Descendants of nodes that are saturated
+// w.r.t. the given log-odds bounds are not stored.
+bool blockToStream(const Index3D& block_index,
+                   const HashedWaveletOctreeBlock& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   std::ostream& ostream);
+// NOTE: The block should be empty, and is allocated by the caller such that
+//       it can be configured to match the map it will be added to.
+bool streamToBlock(std::istream& istream, Index3D& block_index,
+                   HashedWaveletOctreeBlock& block);
+
+bool blockToStream(const Index3D& block_index,
+                   const LinearHashedWaveletOctreeBlock& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   std::ostream& ostream);
+bool streamToBlock(std::istream& istream, Index3D& block_index,
+                   LinearHashedWaveletOctreeBlock& block);
+
+bool blockToStream(const Index3D& block_index,
+                   const QuantizedHashedWaveletOctreeBlock& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   std::ostream& ostream);
+bool streamToBlock(std::istream& istream, Index3D& block_index,
+                   QuantizedHashedWaveletOctreeBlock& block);
+
 bool mapToStream(const HashedChunkedWaveletOctree& map, std::ostream& ostream);
 }  // namespace wavemap::io
 
@@ -1,13 +1,27 @@
 #ifndef WAVEMAP_PIPELINE_IMPL_PIPELINE_INL_H_
 #define WAVEMAP_PIPELINE_IMPL_PIPELINE_INL_H_
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace wavemap {
+namespace detail {
+inline size_t getNumPoints(const PosedPointcloud<>& pointcloud) {
+  return pointcloud.size();
+}
+inline size_t getNumPoints(const PosedImage<>& range_image) {
+  return range_image.getDimensions().prod();
+}
+}  // namespace detail
+
 template <typename MeasurementT>
 bool Pipeline::runIntegrators(const std::vector<std::string>& integrator_names,
                               const MeasurementT& measurement) {
+  static auto& integration_time =
+      metrics::getHistogram("pipeline_integration_seconds");
+  metrics::ScopedTimer integration_timer(integration_time);
   for (const auto& integrator_name : integrator_names) {
     if (auto* integrator = getIntegrator(integrator_name); integrator) {
       integrator->integrate(measurement);
@@ -18,6 +32,104 @@ bool Pipeline::runIntegrators(const std::vector<std::string>& integrator_names,
   return true;
 }
 
+template <typename MeasurementT>
+bool Pipeline::runIntegratorsFused(
+    const std::vector<std::string>& integrator_names,
+    const std::vector<MeasurementT>& measurements) {
+  if (integrator_names.size() != measurements.size()) {
+    LOG(WARNING) << "Number of integrators (" << integrator_names.size()
+                 << ") does not match number of measurements ("
+                 << measurements.size()
+                 << "). Ignoring fused integration request.";
+    return false;
+  }
+
+  // Look up all integrators before importing any measurements, such that an
+  // unknown integrator name does not leave the others with stale imports
+  std::vector<IntegratorBase*> integrators;
+  integrators.reserve(integrator_names.size());
+  for (const auto& integrator_name : integrator_names) {
+    auto* integrator = getIntegrator(integrator_name);
+    if (!integrator) {
+      LOG(WARNING) << "Integrator \"" << integrator_name
+                   << "\" does not exist. Ignoring fused integration request.";
+      return false;
+    }
+    integrators.emplace_back(integrator);
+  }
+
+  static auto& integration_time =
+      metrics::getHistogram("pipeline_integration_seconds");
+  static auto& batch_size = metrics::getGauge("pipeline_fused_batch_size");
+  static auto& integrator_integration_time =
+      metrics::getHistogram("integrator_integration_seconds");
+  static auto& integrator_num_points =
+      metrics::getCounter("integrator_points_total");
+  metrics::ScopedTimer integration_timer(integration_time);
+  batch_size.set(static_cast<double>(measurements.size()));
+
+  // Load the measurements into the integrators that support fusion, batched
+  // by fusion group, and integrate the others sequentially once the fused
+  // updates completed
+  // NOTE: Each fused measurement is recorded in the integrator metrics, with
+  //       the time it took to import plus an even share of its batch's update.
+  struct FusedBatch {
+    std::vector<IntegratorBase*> integrators;
+    std::vector<double> import_seconds;
+  };
+  std::vector<FusedBatch> fused_batches;
+  std::vector<std::pair<IntegratorBase*, const MeasurementT*>>
+      sequential_integrations;
+  for (size_t idx = 0; idx < integrators.size(); ++idx) {
+    auto* integrator = integrators[idx];
+    const void* fusion_group = integrator->getFusionGroup();
+    auto batch_it = std::find_if(
+        fused_batches.begin(), fused_batches.end(),
+        [fusion_group](const FusedBatch& batch) {
+          return batch.integrators.front()->getFusionGroup() == fusion_group;
+        });
+    const bool can_fuse =
+        fusion_group &&
+        (batch_it == fused_batches.end() ||
+         (batch_it->integrators.size() <
+              integrator->getMaxNumFusedMeasurements() &&
+          std::find(batch_it->integrators.begin(),
+                    batch_it->integrators.end(),
+                    integrator) == batch_it->integrators.end()));
+    if (can_fuse) {
+      const Timestamp import_start_time = Time::now();
+      if (integrator->importMeasurement(measurements[idx])) {
+        integrator_num_points.increment(
+            detail::getNumPoints(measurements[idx]));
+        if (batch_it == fused_batches.end()) {
+          batch_it = fused_batches.emplace(fused_batches.end());
+        }
+        batch_it->integrators.emplace_back(integrator);
+        batch_it->import_seconds.emplace_back(
+            time::to_seconds<double>(Time::now() - import_start_time));
+      }
+    } else {
+      sequential_integrations.emplace_back(integrator, &measurements[idx]);
+    }
+  }
+
+  for (const auto& batch : fused_batches) {
+    const Timestamp update_start_time = Time::now();
+    batch.integrators.front()->updateMapFused(batch.integrators);
+    const double update_seconds_share =
+        time::to_seconds<double>(Time::now() - update_start_time) /
+        static_cast<double>(batch.integrators.size());
+    for (const double import_seconds : batch.import_seconds) {
+      integrator_integration_time.observe(import_seconds +
+                                          update_seconds_share);
+    }
+  }
+  for (const auto& [integrator, measurement] : sequential_integrations) {
+    integrator->integrate(*measurement);
+  }
+  return true;
+}
+
 template <typename MeasurementT>
 bool Pipeline::runPipeline(const std::vector<std::string>& integrator_names,
                            const MeasurementT& measurement) {
@@ -0,0 +1,65 @@
+#ifndef WAVEMAP_PIPELINE_MAP_OPERATIONS_COARSEN_MAP_OPERATION_H_
+#define WAVEMAP_PIPELINE_MAP_OPERATIONS_COARSEN_MAP_OPERATION_H_
+
+#include <memory>
+#include <utility>
+
+#include "wavemap/core/config/config_base.h"
+#include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/core/utils/time/time.h"
+#include "wavemap/pipeline/map_operations/map_operation_base.h"
+
+namespace wavemap {
+/**
+ * Config struct for map coarsening operations.
+ */
+struct CoarsenMapOperationConfig
+    : public ConfigBase<CoarsenMapOperationConfig, 4> {
+  //! Time period controlling how often the map is coarsened.
+  Seconds<FloatingPoint> once_every = 10.f;
+  //! Height of the smallest cells that are preserved in coarsened blocks. For
+  //! example, a height of 2 reduces their resolution to 4x the map's maximum
+  //! resolution.
+  IndexElement termination_height = 2;
+  //! Distance from the most recently updated block beyond which blocks are
+  //! coarsened. Set to 0 to disable coarsening based on distance.
+  Meters<FloatingPoint> radius = 0.f;
+  //! Time since their last update after which blocks are coarsened. Set to 0
+  //! to disable coarsening based on age.
+  Seconds<FloatingPoint> max_block_age = 0.f;
+
+  static MemberMap memberMap;
+
+  bool isValid(bool verbose) const override;
+};
+
+/**
+ * Reduces the resolution of the blocks that are far away or have not been
+ * updated for a while, by discarding their wavelet detail coefficients below
+ * the termination height. Unlike cropping, the coarse occupancy of these
+ * regions is preserved. Coarsening is only supported for hashed wavelet
+ * octrees, including their linear and quantized variants, and for hashed
+ * chunked wavelet octrees.
+ */
+class CoarsenMapOperation : public MapOperationBase {
+ public:
+  CoarsenMapOperation(const CoarsenMapOperationConfig& config,
+                      MapBase::Ptr occupancy_map,
+                      std::shared_ptr<ThreadPool> thread_pool = nullptr)
+      : MapOperationBase(std::move(occupancy_map)),
+        config_(config.checkValid()),
+        thread_pool_(std::move(thread_pool)) {}
+
+  bool shouldRun(const Timestamp& current_time);
+
+  void run(bool force_run) override;
+
+ private:
+  const CoarsenMapOperationConfig config_;
+  const std::shared_ptr<ThreadPool> thread_pool_;
+  Timestamp last_run_timestamp_;
+};
+}  // namespace wavemap
+
+#endif  // WAVEMAP_PIPELINE_MAP_OPERATIONS_COARSEN_MAP_OPERATION_H_
@@ -9,9 +9,15 @@ namespace wavemap {
 struct MapOperationType : public TypeSelector<MapOperationType> {
   using TypeSelector<MapOperationType>::TypeSelector;
 
-  enum Id : TypeId { kThresholdMap, kPruneMap };
-
-  static constexpr std::array names = {"threshold_map", "prune_map"};
+  enum Id : TypeId {
+    kThresholdMap,
+    kPruneMap,
+    kEnforceMemoryBudget,
+    kCoarsenMap
+  };
+
+  static constexpr std::array names = {"threshold_map", "prune_map",
+                                       "enforce_memory_budget", "coarsen_map"};
 };
 
 class MapOperationBase {
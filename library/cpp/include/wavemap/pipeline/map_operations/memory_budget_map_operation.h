@@ -0,0 +1,59 @@
+#ifndef WAVEMAP_PIPELINE_MAP_OPERATIONS_MEMORY_BUDGET_MAP_OPERATION_H_
+#define WAVEMAP_PIPELINE_MAP_OPERATIONS_MEMORY_BUDGET_MAP_OPERATION_H_
+
+#include <utility>
+
+#include "wavemap/core/config/config_base.h"
+#include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/time/time.h"
+#include "wavemap/pipeline/map_operations/map_operation_base.h"
+
+namespace wavemap {
+/**
+ * Config struct for map memory budget enforcement operations.
+ */
+struct MemoryBudgetMapOperationConfig
+    : public ConfigBase<MemoryBudgetMapOperationConfig, 4> {
+  //! Time period controlling how often the memory budget is enforced.
+  Seconds<FloatingPoint> once_every = 10.f;
+  //! Maximum memory usage of the map, in megabytes.
+  int memory_budget_in_mb = 1024;
+  //! Maximum height up to which blocks are coarsened to meet the budget, before
+  //! resorting to evicting them. The blocks furthest from the most recently
+  //! updated block are coarsened first. Set to 0 to disable coarsening.
+  IndexElement max_coarsening_height = 3;
+  //! Whether to erase the furthest blocks if pruning and coarsening the map do
+  //! not suffice to meet the budget.
+  bool allow_block_eviction = true;
+
+  static MemberMap memberMap;
+
+  bool isValid(bool verbose) const override;
+};
+
+/**
+ * Keeps the map's memory usage within a budget. When the budget is exceeded,
+ * the map is pruned aggressively, then its furthest blocks are progressively
+ * coarsened and, if allowed, finally evicted. See edit::enforceMemoryBudget.
+ * Coarsening and eviction are only supported for hashed wavelet octrees,
+ * including their linear and quantized variants, and for hashed chunked
+ * wavelet octrees. Other maps are only pruned.
+ */
+class MemoryBudgetMapOperation : public MapOperationBase {
+ public:
+  MemoryBudgetMapOperation(const MemoryBudgetMapOperationConfig& config,
+                           MapBase::Ptr occupancy_map)
+      : MapOperationBase(std::move(occupancy_map)),
+        config_(config.checkValid()) {}
+
+  bool shouldRun(const Timestamp& current_time);
+
+  void run(bool force_run) override;
+
+ private:
+  const MemoryBudgetMapOperationConfig config_;
+  Timestamp last_run_timestamp_;
+};
+}  // namespace wavemap
+
+#endif  // WAVEMAP_PIPELINE_MAP_OPERATIONS_MEMORY_BUDGET_MAP_OPERATION_H_
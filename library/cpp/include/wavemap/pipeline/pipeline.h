@@ -9,6 +9,7 @@
 
 #include "wavemap/core/integrator/integrator_base.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/profile/metrics.h"
 #include "wavemap/core/utils/thread_pool.h"
 #include "wavemap/pipeline/map_operations/map_operation_base.h"
 #include "wavemap/pipeline/map_operations/map_operation_factory.h"
@@ -16,6 +17,10 @@
 namespace wavemap {
 /*
  * A class to build pipelines of measurement integrators and map operations
+ * NOTE: The pipeline's stages record their metrics in wavemap's process-wide
+ *       registry, which can be accessed through metrics::getRegistry(), e.g.
+ *       to export them. If the process runs multiple pipelines, their metrics
+ *       are aggregated.
  */
 class Pipeline {
  public:
@@ -66,6 +71,14 @@ class Pipeline {
   template <typename MeasurementT>
   bool runIntegrators(const std::vector<std::string>& integrator_names,
                       const MeasurementT& measurement);
+  //! Integrate a batch of measurements, where the i-th measurement is
+  //! integrated by the i-th integrator. Measurements handled by integrators
+  //! that support fused integration, such as hashed wavelet integrators, are
+  //! fused into a single map update per fusion group, such that each affected
+  //! block is only traversed once. All others are integrated sequentially.
+  template <typename MeasurementT>
+  bool runIntegratorsFused(const std::vector<std::string>& integrator_names,
+                           const std::vector<MeasurementT>& measurements);
   //! Run the map operations
   void runOperations(bool force_run_all = false);
 
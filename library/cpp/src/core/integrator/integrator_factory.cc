@@ -128,12 +128,31 @@ std::unique_ptr<IntegratorBase> IntegratorFactory::create(
             integrator_config.value(), projection_model, posed_range_image,
             beam_offset_image, measurement_model, std::move(hashed_wavelet_map),
             std::move(thread_pool));
-      } else {
-        LOG(ERROR) << "Integrator of type " << integrator_type.toStr()
-                   << " only supports data structures of type "
-                   << MapType::toStr(MapType::kHashedWaveletOctree)
-                   << ". Returning nullptr.";
       }
+      auto linear_hashed_wavelet_map =
+          std::dynamic_pointer_cast<LinearHashedWaveletOctree>(occupancy_map);
+      if (linear_hashed_wavelet_map) {
+        return std::make_unique<LinearHashedWaveletIntegrator>(
+            integrator_config.value(), projection_model, posed_range_image,
+            beam_offset_image, measurement_model,
+            std::move(linear_hashed_wavelet_map), std::move(thread_pool));
+      }
+      auto quantized_hashed_wavelet_map =
+          std::dynamic_pointer_cast<QuantizedHashedWaveletOctree>(
+              occupancy_map);
+      if (quantized_hashed_wavelet_map) {
+        return std::make_unique<QuantizedHashedWaveletIntegrator>(
+            integrator_config.value(), projection_model, posed_range_image,
+            beam_offset_image, measurement_model,
+            std::move(quantized_hashed_wavelet_map), std::move(thread_pool));
+      }
+      LOG(ERROR) << "Integrator of type " << integrator_type.toStr()
+                 << " only supports data structures of type "
+                 << MapType::toStr(MapType::kHashedWaveletOctree) << ", "
+                 << MapType::toStr(MapType::kQuantizedHashedWaveletOctree)
+                 << " and "
+                 << MapType::toStr(MapType::kLinearHashedWaveletOctree)
+                 << ". Returning nullptr.";
       break;
     }
     case IntegratorType::kHashedChunkedWaveletIntegrator: {
@@ -64,7 +64,7 @@ void CoarseToFineIntegrator::updateMap() {
     if (current_node.height == 0 ||
         measurement_model_->computeWorstCaseApproximationError(
             update_type, d_C_cell, bounding_sphere_radius) <
-            config_.termination_update_error) {
+            getTerminationUpdateError()) {
       const FloatingPoint sample = computeUpdate(C_node_center);
       if (kEpsilon < std::abs(sample)) {
         occupancy_map_->addToCellValue(current_node, sample);
@@ -5,6 +5,8 @@
 #include <stack>
 #include <utility>
 
+#include <wavemap/core/utils/cpu/dispatch.h>
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap {
@@ -30,6 +32,9 @@ void HashedChunkedWaveletIntegrator::updateMap() {
                       blocks_to_update);
     }
   }
+  static auto& num_updated_blocks =
+      metrics::getCounter("integrator_updated_blocks_total");
+  num_updated_blocks.increment(blocks_to_update.size());
 
   // Make sure the to-be-updated blocks are allocated
   for (const auto& block_index : blocks_to_update) {
@@ -82,6 +87,7 @@ void HashedChunkedWaveletIntegrator::updateBlock(
   block.setNeedsThresholding(block_needs_thresholding);
 }
 
+WAVEMAP_MULTIVERSIONED
 void HashedChunkedWaveletIntegrator::updateNodeRecursive(  // NOLINT
     HashedChunkedWaveletIntegrator::OctreeType::NodeRefType node,
     const OctreeIndex& node_index, FloatingPoint& node_value,
@@ -132,7 +138,7 @@ void HashedChunkedWaveletIntegrator::updateNodeRecursive(  // NOLINT
         kUnitCubeHalfDiagonal * child_width;
     if (measurement_model_->computeWorstCaseApproximationError(
             update_type, d_C_child, bounding_sphere_radius) <
-        config_.termination_update_error) {
+        getTerminationUpdateError()) {
       const FloatingPoint sample = computeUpdate(C_child_center);
       child_value += sample;
       block_needs_thresholding = true;
@@ -144,7 +150,7 @@ void HashedChunkedWaveletIntegrator::updateNodeRecursive(  // NOLINT
     auto& child_details = child_node.data();
 
     // If we're at the leaf level, directly compute the update
-    if (child_index.height <= termination_height_ + 1) {
+    if (child_index.height <= termination_height_ + coarsening_level_ + 1) {
       updateLeavesBatch(child_index, child_value, child_details);
     } else {
       // Otherwise, recurse
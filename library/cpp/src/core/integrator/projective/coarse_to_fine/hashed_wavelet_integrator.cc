@@ -2,34 +2,27 @@
 
 #include <algorithm>
 #include <memory>
-#include <stack>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
+#include <wavemap/core/utils/time/stopwatch.h>
 
 namespace wavemap {
-void HashedWaveletIntegrator::updateMap() {
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::updateMap() {
   ProfilerZoneScoped;
   // Update the range image intersector
-  {
-    ProfilerZoneScopedN("updateRangeImageIntersector");
-    range_image_intersector_ = std::make_shared<RangeImageIntersector>(
-        posed_range_image_, projection_model_, *measurement_model_,
-        config_.min_range, config_.max_range);
-  }
+  updateRangeImageIntersector();
 
   // Find all the indices of blocks that need updating
   BlockList blocks_to_update;
-  {
-    ProfilerZoneScopedN("selectBlocksToUpdate");
-    const auto [fov_min_idx, fov_max_idx] =
-        getFovMinMaxIndices(posed_range_image_->getOrigin());
-    for (const auto& block_index :
-         Grid(fov_min_idx.position, fov_max_idx.position)) {
-      recursiveTester(OctreeIndex{fov_min_idx.height, block_index},
-                      blocks_to_update);
-    }
-  }
+  selectBlocksToUpdate(blocks_to_update);
+  static auto& num_updated_blocks =
+      metrics::getCounter("integrator_updated_blocks_total");
+  num_updated_blocks.increment(blocks_to_update.size());
 
   // Make sure the to-be-updated blocks are allocated
   for (const auto& block_index : blocks_to_update) {
@@ -47,8 +40,131 @@ void HashedWaveletIntegrator::updateMap() {
   thread_pool_->wait_all();
 }
 
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::updateMapFused(
+    const std::vector<IntegratorBase*>& integrators) {
+  // NOTE: Only hashed wavelet integrators that update this integrator's map
+  //       share its fusion group.
+  std::vector<BasicHashedWaveletIntegrator*> fused_integrators;
+  fused_integrators.reserve(integrators.size());
+  for (auto* integrator : integrators) {
+    CHECK_NOTNULL(integrator);
+    CHECK_EQ(integrator->getFusionGroup(), getFusionGroup());
+    fused_integrators.emplace_back(
+        static_cast<BasicHashedWaveletIntegrator*>(integrator));
+  }
+  updateMapFused(fused_integrators);
+}
+
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::updateMapFused(
+    const std::vector<BasicHashedWaveletIntegrator*>& integrators) {
+  ProfilerZoneScoped;
+  if (integrators.empty()) {
+    return;
+  }
+  CHECK_LE(integrators.size(), kMaxNumFusedMeasurements);
+
+  // Measurements can only be fused if they update the same map, integrate all
+  // others separately
+  BasicHashedWaveletIntegrator* const leader =
+      CHECK_NOTNULL(integrators.front());
+  std::vector<BasicHashedWaveletIntegrator*> fused_integrators;
+  for (auto* integrator : integrators) {
+    CHECK_NOTNULL(integrator);
+    if (std::find(fused_integrators.begin(), fused_integrators.end(),
+                  integrator) != fused_integrators.end()) {
+      continue;
+    }
+    if (integrator->occupancy_map_ == leader->occupancy_map_) {
+      fused_integrators.emplace_back(integrator);
+    } else {
+      LOG(WARNING) << "Can not fuse measurements that update different maps. "
+                      "Integrating them separately.";
+      integrator->updateMapWithinBudget();
+    }
+  }
+  if (fused_integrators.size() == 1) {
+    leader->updateMapWithinBudget();
+    return;
+  }
+
+  // Update the range image intersectors and find all the blocks that need
+  // updating, together with the measurements that affect them
+  std::unordered_map<BlockIndex, MeasurementMask, IndexHash<3>>
+      blocks_to_update;
+  {
+    ProfilerZoneScopedN("selectBlocksToUpdate");
+    for (size_t idx = 0; idx < fused_integrators.size(); ++idx) {
+      auto* integrator = fused_integrators[idx];
+      integrator->updateRangeImageIntersector();
+      BlockList integrator_blocks;
+      integrator->selectBlocksToUpdate(integrator_blocks);
+      for (const auto& block_index : integrator_blocks) {
+        blocks_to_update[block_index].set(idx);
+      }
+    }
+  }
+
+  static auto& num_updated_blocks =
+      metrics::getCounter("integrator_updated_blocks_total");
+  num_updated_blocks.increment(blocks_to_update.size());
+
+  // Make sure the to-be-updated blocks are allocated
+  auto& occupancy_map = *leader->occupancy_map_;
+  for (const auto& [block_index, measurements] : blocks_to_update) {
+    occupancy_map.getOrAllocateBlock(block_index);
+  }
+
+  // Update them with the threadpool
+  Stopwatch integration_timer;
+  integration_timer.start();
+  for (const auto& [block_index, measurements] : blocks_to_update) {
+    leader->thread_pool_->add_task([&fused_integrators, &occupancy_map,
+                                    block_index = block_index,
+                                    measurements = measurements]() {
+      if (auto* block = occupancy_map.getBlock(block_index); block) {
+        updateBlockFused(fused_integrators, measurements, *block, block_index);
+      }
+    });
+  }
+  leader->thread_pool_->wait_all();
+  integration_timer.stop();
+
+  // Adapt the integrators to the time the whole batch took, if they have a
+  // time budget
+  for (auto* integrator : fused_integrators) {
+    if (0.f < integrator->config_.integration_time_budget) {
+      integrator->adaptToIntegrationTime(static_cast<FloatingPoint>(
+          integration_timer.getLastEpisodeDuration()));
+    }
+  }
+}
+
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::updateRangeImageIntersector() {
+  ProfilerZoneScoped;
+  range_image_intersector_ = std::make_shared<RangeImageIntersector>(
+      posed_range_image_, projection_model_, *measurement_model_,
+      config_.min_range, config_.max_range);
+}
+
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::selectBlocksToUpdate(
+    BlockList& blocks_to_update) {
+  ProfilerZoneScoped;
+  const auto [fov_min_idx, fov_max_idx] =
+      getFovMinMaxIndices(posed_range_image_->getOrigin());
+  for (const auto& block_index :
+       Grid(fov_min_idx.position, fov_max_idx.position)) {
+    recursiveTester(OctreeIndex{fov_min_idx.height, block_index},
+                    blocks_to_update);
+  }
+}
+
+template <typename MapT>
 std::pair<OctreeIndex, OctreeIndex>
-HashedWaveletIntegrator::getFovMinMaxIndices(
+BasicHashedWaveletIntegrator<MapT>::getFovMinMaxIndices(
     const Point3D& sensor_origin) const {
   const int height = 1 + std::max(static_cast<int>(std::ceil(std::log2(
                                       config_.max_range / min_cell_width_))),
@@ -68,136 +184,169 @@ HashedWaveletIntegrator::getFovMinMaxIndices(
   return {fov_min_idx, fov_max_idx};
 }
 
-void HashedWaveletIntegrator::updateBlock(
-    HashedWaveletOctree::Block& block,
-    const HashedWaveletOctree::BlockIndex& block_index) {
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::updateBlock(
+    Block& block, const BlockIndex& block_index) {
   ProfilerZoneScoped;
-  block.setNeedsPruning();
-  block.setLastUpdatedStamp();
-
-  struct StackElement {
-    OctreeType::NodeRefType parent_node;
-    const OctreeIndex parent_node_index;
-    NdtreeIndexRelativeChild next_child_idx;
-    HashedWaveletOctreeBlock::Coefficients::CoefficientsArray
-        child_scale_coefficients;
-  };
-  std::stack<StackElement> stack;
-
-  OctreeType::NodeRefType root_node = block.getRootNode();
-  HashedWaveletOctreeBlock::Coefficients::Scale& root_node_scale =
-      block.getRootScale();
-  stack.emplace(StackElement{root_node,
-                             {tree_height_, block_index},
-                             0,
-                             HashedWaveletOctreeBlock::Transform::backward(
-                                 {root_node_scale, root_node.data()})});
-
-  while (!stack.empty()) {
-    // If the current stack element has fully been processed, propagate upward
-    if (OctreeIndex::kNumChildren <= stack.top().next_child_idx) {
-      const auto [scale, details] =
-          HashedWaveletOctreeBlock::Transform::forward(
-              stack.top().child_scale_coefficients);
-      stack.top().parent_node.data() = details;
-      stack.pop();
-      if (stack.empty()) {
-        root_node_scale = scale;
-        return;
-      } else {
-        const NdtreeIndexRelativeChild current_child_idx =
-            stack.top().next_child_idx - 1;
-        stack.top().child_scale_coefficients[current_child_idx] = scale;
-        continue;
-      }
-    }
+  const IndexElement termination_height =
+      termination_height_ + coarsening_level_;
+  const FloatingPoint termination_update_error = getTerminationUpdateError();
 
-    // Evaluate stack element's active child
-    const NdtreeIndexRelativeChild current_child_idx =
-        stack.top().next_child_idx;
-    ++stack.top().next_child_idx;
-    DCHECK_GE(current_child_idx, 0);
-    DCHECK_LT(current_child_idx, OctreeIndex::kNumChildren);
-
-    OctreeType::NodeRefType parent_node = stack.top().parent_node;
-    FloatingPoint& node_value =
-        stack.top().child_scale_coefficients[current_child_idx];
-    const OctreeIndex node_index =
-        stack.top().parent_node_index.computeChildIndex(current_child_idx);
-    DCHECK_GE(node_index.height, 0);
-
-    // If we're at the leaf level, directly update the node
-    if (node_index.height <= termination_height_) {
-      const Point3D W_node_center =
-          convert::nodeIndexToCenterPoint(node_index, min_cell_width_);
-      const Point3D C_node_center =
-          posed_range_image_->getPoseInverse() * W_node_center;
-      const FloatingPoint sample = computeUpdate(C_node_center);
-      node_value =
-          std::clamp(sample + node_value, min_log_odds_ - kNoiseThreshold,
-                     max_log_odds_ + kNoiseThreshold);
-      continue;
-    }
+  // The integrator's measurement is tracked as the mask's only active bit
+  const MeasurementMask measurement{1u};
+  traverseBlock(
+      block, {tree_height_, block_index}, measurement,
+      [&](const OctreeIndex& node_index, bool node_has_children,
+          FloatingPoint& node_value,
+          const MeasurementMask& /*active_measurements*/) -> MeasurementMask {
+        // If we're at the leaf level, directly update the node
+        if (node_index.height <= termination_height) {
+          const Point3D W_node_center =
+              convert::nodeIndexToCenterPoint(node_index, min_cell_width_);
+          const Point3D C_node_center =
+              posed_range_image_->getPoseInverse() * W_node_center;
+          const FloatingPoint sample = computeUpdate(C_node_center);
+          node_value =
+              std::clamp(sample + node_value, min_log_odds_ - kNoiseThreshold,
+                         max_log_odds_ + kNoiseThreshold);
+          return {};
+        }
 
-    // Otherwise, test whether the current node is fully occupied;
-    // free or unknown; or fully unknown
-    const AABB<Point3D> W_cell_aabb =
-        convert::nodeIndexToAABB(node_index, min_cell_width_);
-    const UpdateType update_type =
-        range_image_intersector_->determineUpdateType(
-            W_cell_aabb, posed_range_image_->getRotationMatrixInverse(),
-            posed_range_image_->getOrigin());
-
-    // If we're fully in unknown space,
-    // there's no need to evaluate this node or its children
-    if (update_type == UpdateType::kFullyUnobserved) {
-      continue;
-    }
+        // Otherwise, test whether the current node is fully occupied;
+        // free or unknown; or fully unknown
+        const AABB<Point3D> W_cell_aabb =
+            convert::nodeIndexToAABB(node_index, min_cell_width_);
+        const UpdateType update_type =
+            range_image_intersector_->determineUpdateType(
+                W_cell_aabb, posed_range_image_->getRotationMatrixInverse(),
+                posed_range_image_->getOrigin());
 
-    // We can also stop here if the cell will result in a free space update
-    // (or zero) and the map is already saturated free
-    if (update_type != UpdateType::kPossiblyOccupied &&
-        node_value < min_log_odds_ + kNoiseThreshold / 10.f) {
-      continue;
-    }
+        // If we're fully in unknown space,
+        // there's no need to evaluate this node or its children
+        if (update_type == UpdateType::kFullyUnobserved) {
+          return {};
+        }
 
-    // Test if the worst-case error for the intersection type at the current
-    // resolution falls within the acceptable approximation error
-    const FloatingPoint node_width = W_cell_aabb.width<0>();
-    const Point3D W_node_center =
-        W_cell_aabb.min + Vector3D::Constant(node_width / 2.f);
-    const Point3D C_node_center =
-        posed_range_image_->getPoseInverse() * W_node_center;
-    const FloatingPoint d_C_cell =
-        projection_model_->cartesianToSensorZ(C_node_center);
-    const FloatingPoint bounding_sphere_radius =
-        kUnitCubeHalfDiagonal * node_width;
-    OctreeType::NodePtrType node =
-        parent_node.getChild(node_index.computeRelativeChildIndex());
-    if (measurement_model_->computeWorstCaseApproximationError(
-            update_type, d_C_cell, bounding_sphere_radius) <
-        config_.termination_update_error) {
-      const FloatingPoint sample = computeUpdate(C_node_center);
-      if (!node || !node->hasAtLeastOneChild()) {
-        node_value =
-            std::clamp(sample + node_value, min_log_odds_ - kNoiseThreshold,
-                       max_log_odds_ + kNoiseThreshold);
-      } else {
-        node_value += sample;
-        block.setNeedsThresholding();
-      }
-      continue;
-    }
+        // We can also stop here if the cell will result in a free space update
+        // (or zero) and the map is already saturated free
+        if (update_type != UpdateType::kPossiblyOccupied &&
+            node_value < min_log_odds_ + kNoiseThreshold / 10.f) {
+          return {};
+        }
 
-    // Since the approximation error would still be too big, refine
-    if (!node) {
-      // Allocate the current node if it has not yet been allocated
-      node = &parent_node.getOrAllocateChild(
-          node_index.computeRelativeChildIndex());
-    }
-    stack.emplace(StackElement{*node, node_index, 0,
-                               HashedWaveletOctreeBlock::Transform::backward(
-                                   {node_value, node->data()})});
-  }
+        // Test if the worst-case error for the intersection type at the
+        // current resolution falls within the acceptable approximation error
+        const FloatingPoint node_width = W_cell_aabb.width<0>();
+        const Point3D W_node_center =
+            W_cell_aabb.min + Vector3D::Constant(node_width / 2.f);
+        const Point3D C_node_center =
+            posed_range_image_->getPoseInverse() * W_node_center;
+        const FloatingPoint d_C_cell =
+            projection_model_->cartesianToSensorZ(C_node_center);
+        const FloatingPoint bounding_sphere_radius =
+            kUnitCubeHalfDiagonal * node_width;
+        if (measurement_model_->computeWorstCaseApproximationError(
+                update_type, d_C_cell, bounding_sphere_radius) <
+            termination_update_error) {
+          applyUpdate(computeUpdate(C_node_center), node_has_children,
+                      node_value, block);
+          return {};
+        }
+
+        // Since the approximation error would still be too big, refine
+        return measurement;
+      });
 }
+
+template <typename MapT>
+void BasicHashedWaveletIntegrator<MapT>::updateBlockFused(
+    const std::vector<BasicHashedWaveletIntegrator*>& integrators,
+    const MeasurementMask& block_measurements, Block& block,
+    const BlockIndex& block_index) {
+  ProfilerZoneScoped;
+  // All integrators update the same map, so its properties can be read from
+  // any of them
+  const BasicHashedWaveletIntegrator& leader = *integrators.front();
+  const FloatingPoint min_cell_width = leader.min_cell_width_;
+  const FloatingPoint min_log_odds = leader.min_log_odds_;
+
+  traverseBlock(
+      block, {leader.tree_height_, block_index}, block_measurements,
+      [&](const OctreeIndex& node_index, bool node_has_children,
+          FloatingPoint& node_value,
+          const MeasurementMask& active_measurements) -> MeasurementMask {
+        const AABB<Point3D> W_cell_aabb =
+            convert::nodeIndexToAABB(node_index, min_cell_width);
+        const FloatingPoint node_width = W_cell_aabb.width<0>();
+        const Point3D W_node_center =
+            W_cell_aabb.min + Vector3D::Constant(node_width / 2.f);
+        const FloatingPoint bounding_sphere_radius =
+            kUnitCubeHalfDiagonal * node_width;
+
+        // Sum the updates of all measurements that can be applied at the
+        // current resolution, and collect the ones that need to be refined
+        FloatingPoint summed_update = 0.f;
+        MeasurementMask measurements_to_refine;
+        for (size_t idx = 0; idx < integrators.size(); ++idx) {
+          if (!active_measurements[idx]) {
+            continue;
+          }
+          const BasicHashedWaveletIntegrator& integrator = *integrators[idx];
+
+          // If we're at the measurement's leaf level, directly update the node
+          if (node_index.height <=
+              integrator.termination_height_ + integrator.coarsening_level_) {
+            const Point3D C_node_center =
+                integrator.posed_range_image_->getPoseInverse() *
+                W_node_center;
+            summed_update += integrator.computeUpdate(C_node_center);
+            continue;
+          }
+
+          // Otherwise, test whether the current node is fully occupied;
+          // free or unknown; or fully unknown
+          const UpdateType update_type =
+              integrator.range_image_intersector_->determineUpdateType(
+                  W_cell_aabb,
+                  integrator.posed_range_image_->getRotationMatrixInverse(),
+                  integrator.posed_range_image_->getOrigin());
+          if (update_type == UpdateType::kFullyUnobserved) {
+            continue;
+          }
+          if (update_type != UpdateType::kPossiblyOccupied &&
+              node_value < min_log_odds + kNoiseThreshold / 10.f) {
+            continue;
+          }
+
+          // Test if the worst-case error for the intersection type at the
+          // current resolution falls within the acceptable approximation error
+          const Point3D C_node_center =
+              integrator.posed_range_image_->getPoseInverse() * W_node_center;
+          const FloatingPoint d_C_cell =
+              integrator.projection_model_->cartesianToSensorZ(C_node_center);
+          if (integrator.measurement_model_
+                  ->computeWorstCaseApproximationError(
+                      update_type, d_C_cell, bounding_sphere_radius) <
+              integrator.getTerminationUpdateError()) {
+            summed_update += integrator.computeUpdate(C_node_center);
+            continue;
+          }
+
+          // Since the approximation error would still be too big, refine
+          measurements_to_refine.set(idx);
+        }
+
+        // Apply the coarse updates to the node's scale coefficient, which is
+        // inherited by all its children if the remaining measurements are
+        // refined
+        leader.applyUpdate(summed_update,
+                           node_has_children || measurements_to_refine.any(),
+                           node_value, block);
+        return measurements_to_refine;
+      });
+}
+
+template class BasicHashedWaveletIntegrator<HashedWaveletOctree>;
+template class BasicHashedWaveletIntegrator<LinearHashedWaveletOctree>;
+template class BasicHashedWaveletIntegrator<QuantizedHashedWaveletOctree>;
 }  // namespace wavemap
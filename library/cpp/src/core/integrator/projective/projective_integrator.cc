@@ -1,14 +1,21 @@
 #include "wavemap/core/integrator/projective/projective_integrator.h"
 
+#include <algorithm>
+
+#include <wavemap/core/utils/cpu/dispatch.h>
 #include <wavemap/core/utils/data/eigen_checks.h>
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
+#include <wavemap/core/utils/time/stopwatch.h>
 
 namespace wavemap {
 DECLARE_CONFIG_MEMBERS(ProjectiveIntegratorConfig,
                       (min_range)
                       (max_range)
                       (max_update_resolution)
-                      (termination_update_error));
+                      (termination_update_error)
+                      (integration_time_budget)
+                      (max_num_coarsening_steps));
 
 bool ProjectiveIntegratorConfig::isValid(bool verbose) const {
   bool is_valid = true;
@@ -18,21 +25,46 @@ bool ProjectiveIntegratorConfig::isValid(bool verbose) const {
   is_valid &= IS_PARAM_LT(min_range, max_range, verbose);
   is_valid &= IS_PARAM_GE(max_update_resolution, 0.f, verbose);
   is_valid &= IS_PARAM_GT(termination_update_error, 0.f, verbose);
+  is_valid &= IS_PARAM_GE(integration_time_budget, 0.f, verbose);
+  is_valid &= IS_PARAM_GE(max_num_coarsening_steps, 0, verbose);
 
   return is_valid;
 }
 
 void ProjectiveIntegrator::integrate(const PosedPointcloud<>& pointcloud) {
   ProfilerZoneScoped;
-  if (!isPoseValid(pointcloud.getPose())) {
-    return;
+  static auto& integration_time =
+      metrics::getHistogram("integrator_integration_seconds");
+  static auto& num_points = metrics::getCounter("integrator_points_total");
+  metrics::ScopedTimer integration_timer(integration_time);
+  if (importMeasurement(pointcloud)) {
+    num_points.increment(pointcloud.size());
+    updateMapWithinBudget();
   }
-  importPointcloud(pointcloud);
-  updateMap();
 }
 
 void ProjectiveIntegrator::integrate(const PosedImage<>& range_image) {
   ProfilerZoneScoped;
+  static auto& integration_time =
+      metrics::getHistogram("integrator_integration_seconds");
+  static auto& num_points = metrics::getCounter("integrator_points_total");
+  metrics::ScopedTimer integration_timer(integration_time);
+  if (importMeasurement(range_image)) {
+    num_points.increment(range_image.getDimensions().prod());
+    updateMapWithinBudget();
+  }
+}
+
+bool ProjectiveIntegrator::importMeasurement(
+    const PosedPointcloud<>& pointcloud) {
+  if (!isPoseValid(pointcloud.getPose())) {
+    return false;
+  }
+  importPointcloud(pointcloud);
+  return true;
+}
+
+bool ProjectiveIntegrator::importMeasurement(const PosedImage<>& range_image) {
   CHECK_NOTNULL(projection_model_);
   if (range_image.getDimensions() != projection_model_->getDimensions()) {
     LOG(WARNING) << "Dimensions of range image"
@@ -40,13 +72,42 @@ void ProjectiveIntegrator::integrate(const PosedImage<>& range_image) {
                  << " do not match projection model"
                  << print::eigen::oneLine(projection_model_->getDimensions())
                  << ". Ignoring integration request.";
-    return;
+    return false;
   }
   if (!isPoseValid(range_image.getPose())) {
-    return;
+    return false;
   }
   importRangeImage(range_image);
+  return true;
+}
+
+void ProjectiveIntegrator::adaptToIntegrationTime(
+    FloatingPoint integration_time) {
+  // Coarsen when over budget, and only refine once there is enough headroom
+  // for the finer level's (roughly twice as expensive) update to also fit
+  constexpr FloatingPoint kRefinementThreshold = 0.4f;
+  const FloatingPoint budget = config_.integration_time_budget;
+  if (budget < integration_time) {
+    coarsening_level_ =
+        std::min(coarsening_level_ + 1, config_.max_num_coarsening_steps);
+  } else if (integration_time < kRefinementThreshold * budget) {
+    coarsening_level_ = std::max(coarsening_level_ - 1, 0);
+  }
+  ProfilerPlot("IntegrationTime", integration_time);
+  ProfilerPlot("CoarseningLevel", static_cast<int64_t>(coarsening_level_));
+}
+
+void ProjectiveIntegrator::updateMapWithinBudget() {
+  if (config_.integration_time_budget <= 0.f) {
+    updateMap();
+    return;
+  }
+  Stopwatch integration_timer;
+  integration_timer.start();
   updateMap();
+  integration_timer.stop();
+  adaptToIntegrationTime(
+      static_cast<FloatingPoint>(integration_timer.getLastEpisodeDuration()));
 }
 
 void ProjectiveIntegrator::importPointcloud(
@@ -58,6 +119,12 @@ void ProjectiveIntegrator::importPointcloud(
   beam_offset_image_->resetToInitialValue();
 
   // Import all the points
+  projectPointcloud(pointcloud);
+}
+
+WAVEMAP_MULTIVERSIONED
+void ProjectiveIntegrator::projectPointcloud(
+    const PosedPointcloud<>& pointcloud) {
   for (const auto& C_point : pointcloud.getPointsLocal()) {
     // Filter out noisy points and compute point's range
     if (!isMeasurementValid(C_point)) {
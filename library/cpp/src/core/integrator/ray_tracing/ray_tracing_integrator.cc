@@ -1,5 +1,7 @@
 #include "wavemap/core/integrator/ray_tracing/ray_tracing_integrator.h"
 
+#include <wavemap/core/utils/profile/metrics.h>
+
 namespace wavemap {
 DECLARE_CONFIG_MEMBERS(RayTracingIntegratorConfig,
                       (min_range)
@@ -16,9 +18,14 @@ bool RayTracingIntegratorConfig::isValid(bool verbose) const {
 }
 
 void RayTracingIntegrator::integrate(const PosedPointcloud<>& pointcloud) {
+  static auto& integration_time =
+      metrics::getHistogram("integrator_integration_seconds");
+  static auto& num_points = metrics::getCounter("integrator_points_total");
+  metrics::ScopedTimer integration_timer(integration_time);
   if (!isPoseValid(pointcloud.getPose())) {
     return;
   }
+  num_points.increment(pointcloud.size());
 
   const FloatingPoint min_cell_width = occupancy_map_->getMinCellWidth();
   const Point3D& W_start_point = pointcloud.getOrigin();
@@ -0,0 +1,64 @@
+#include "wavemap/core/map/coefficient_storage.h"
+
+#include <stack>
+#include <utility>
+
+#include <wavemap/core/utils/profile/profiler_interface.h>
+
+namespace wavemap {
+namespace {
+// Copy the structure of the source octree into the (empty) destination octree,
+// converting the data of each node
+template <typename SourceOctreeT, typename DestinationOctreeT,
+          typename ConversionFn>
+void convertOctree(const SourceOctreeT& source,
+                   DestinationOctreeT& destination, ConversionFn convert_fn) {
+  std::stack<std::pair<typename SourceOctreeT::NodeConstPtrType,
+                       typename DestinationOctreeT::NodePtrType>>
+      stack;
+  stack.emplace(&source.getRootNode(), &destination.getRootNode());
+  while (!stack.empty()) {
+    const auto [source_node, destination_node] = stack.top();
+    stack.pop();
+    destination_node->data() = convert_fn(source_node->data());
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      if (const auto* source_child = source_node->getChild(child_idx);
+          source_child) {
+        stack.emplace(source_child,
+                      &destination_node->getOrAllocateChild(child_idx));
+      }
+    }
+  }
+}
+}  // namespace
+
+void QuantizedCoefficientStorage::compress(OctreeType& octree) {
+  ProfilerZoneScoped;
+  DCHECK(!is_compressed_);
+  quantized_octree_.clear();
+  convertOctree(std::as_const(octree), quantized_octree_,
+                [this](const Coefficients::Details& details) {
+                  return quantize(details);
+                });
+  octree.clear();
+  is_compressed_ = true;
+}
+
+void QuantizedCoefficientStorage::decompress(OctreeType& octree) {
+  ProfilerZoneScoped;
+  DCHECK(is_compressed_);
+  DCHECK(octree.empty());
+  convertOctree(std::as_const(quantized_octree_), octree,
+                [this](const QuantizedDetails& details) {
+                  return dequantize(details);
+                });
+  quantized_octree_.clear();
+  is_compressed_ = false;
+}
+
+void QuantizedCoefficientStorage::clear() {
+  quantized_octree_.clear();
+  is_compressed_ = false;
+}
+}  // namespace wavemap
@@ -1,10 +1,45 @@
 #include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
 
 #include <unordered_set>
+#include <vector>
 
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap {
+namespace {
+void recordPruningMetrics(size_t num_pruned_blocks, size_t num_erased_blocks) {
+  static auto& pruned_blocks = metrics::getCounter("map_pruned_blocks_total");
+  static auto& erased_blocks = metrics::getCounter("map_erased_blocks_total");
+  pruned_blocks.increment(num_pruned_blocks);
+  erased_blocks.increment(num_erased_blocks);
+}
+
+// Attribute the memory of each chunk's child chunks to the height of their
+// top nodes, such that coarsening the blocks to a given height frees the
+// memory of all lower ones
+void addMemoryUsageByHeight(
+    const HashedChunkedWaveletOctree::Block::OctreeType::ChunkType& chunk,
+    IndexElement chunk_top_height,
+    std::vector<size_t>& memory_usage_by_height) {
+  if (!chunk.hasChildrenArray()) {
+    return;
+  }
+  const IndexElement child_chunk_top_height =
+      chunk_top_height - HashedChunkedWaveletOctree::Block::kChunkHeight;
+  memory_usage_by_height[child_chunk_top_height] += chunk.getMemoryUsage();
+  for (LinearIndex child_idx = 0;
+       child_idx < HashedChunkedWaveletOctree::Block::OctreeType::ChunkType::
+                       kNumChildren;
+       ++child_idx) {
+    if (const auto* child_chunk = chunk.getChild(child_idx); child_chunk) {
+      addMemoryUsageByHeight(*child_chunk, child_chunk_top_height,
+                             memory_usage_by_height);
+    }
+  }
+}
+}  // namespace
+
 DECLARE_CONFIG_MEMBERS(HashedChunkedWaveletOctreeConfig,
                       (min_cell_width)
                       (min_log_odds)
@@ -32,28 +67,33 @@ void HashedChunkedWaveletOctree::threshold() {
 
 void HashedChunkedWaveletOctree::prune() {
   ProfilerZoneScoped;
+  const size_t num_blocks = block_map_.size();
   block_map_.eraseBlockIf([](const BlockIndex& /*block_index*/, Block& block) {
     block.prune();
     return block.empty();
   });
+  recordPruningMetrics(num_blocks, num_blocks - block_map_.size());
 }
 
 void HashedChunkedWaveletOctree::pruneSmart() {
   ProfilerZoneScoped;
-  block_map_.eraseBlockIf(
-      [&config = config_](const BlockIndex& /*block_index*/, Block& block) {
-        if (config.only_prune_blocks_if_unused_for <
-            block.getTimeSinceLastUpdated()) {
-          block.prune();
-        }
-        return block.empty();
-      });
+  const size_t num_blocks = block_map_.size();
+  size_t num_pruned_blocks = 0u;
+  block_map_.eraseBlockIf([&config = config_, &num_pruned_blocks](
+                              const BlockIndex& /*block_index*/, Block& block) {
+    if (config.only_prune_blocks_if_unused_for <
+        block.getTimeSinceLastUpdated()) {
+      block.prune();
+      ++num_pruned_blocks;
+    }
+    return block.empty();
+  });
+  recordPruningMetrics(num_pruned_blocks, num_blocks - block_map_.size());
 }
 
 size_t HashedChunkedWaveletOctree::getMemoryUsage() const {
   ProfilerZoneScoped;
-  // TODO(victorr): Also include the memory usage of the unordered map itself
-  size_t memory_usage = 0u;
+  size_t memory_usage = block_map_.getMemoryUsage();
   forEachBlock(
       [&memory_usage](const BlockIndex& /*block_index*/, const Block& block) {
         memory_usage += block.getMemoryUsage();
@@ -61,6 +101,28 @@ size_t HashedChunkedWaveletOctree::getMemoryUsage() const {
   return memory_usage;
 }
 
+size_t HashedChunkedWaveletOctree::getBlockMemoryUsage(
+    const BlockIndex& block_index) const {
+  const Block* block = getBlock(block_index);
+  if (!block) {
+    return 0u;
+  }
+  return block_map_.getMemoryUsage() / block_map_.size() +
+         block->getMemoryUsage();
+}
+
+std::vector<size_t> HashedChunkedWaveletOctree::getMemoryUsageByHeight() const {
+  ProfilerZoneScoped;
+  std::vector<size_t> memory_usage_by_height(config_.tree_height + 1, 0u);
+  memory_usage_by_height.back() = block_map_.getMemoryUsage();
+  forEachBlock([&memory_usage_by_height, tree_height = config_.tree_height](
+                   const BlockIndex& /*block_index*/, const Block& block) {
+    addMemoryUsageByHeight(block.getRootChunk(), tree_height - 1,
+                           memory_usage_by_height);
+  });
+  return memory_usage_by_height;
+}
+
 Index3D HashedChunkedWaveletOctree::getMinIndex() const {
   return cells_per_block_side_ * getMinBlockIndex();
 }
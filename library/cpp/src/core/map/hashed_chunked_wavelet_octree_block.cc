@@ -4,6 +4,7 @@
 #include <utility>
 #include <vector>
 
+#include <wavemap/core/utils/cpu/dispatch.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap {
@@ -24,6 +25,29 @@ void HashedChunkedWaveletOctreeBlock::prune() {
   }
 }
 
+bool HashedChunkedWaveletOctreeBlock::coarsen(
+    IndexElement termination_height) {
+  ProfilerZoneScoped;
+  if (termination_height <= 0) {
+    return false;
+  }
+  // NOTE: The tree's root node stores the coefficients that resolve the cells
+  //       at height tree_height_ - 1. Coarsening the block to its full height
+  //       therefore only leaves its average value.
+  bool modified;
+  if (tree_height_ <= termination_height) {
+    modified = !ndtree_.empty();
+    ndtree_.clear();
+  } else {
+    modified = recursiveCoarsen(ndtree_.getRootChunk(), tree_height_ - 1,
+                                termination_height);
+  }
+  if (modified) {
+    setLastModifiedStamp();
+  }
+  return modified;
+}
+
 void HashedChunkedWaveletOctreeBlock::clear() {
   ProfilerZoneScoped;
   root_scale_coefficient_ = Coefficients::Scale{};
@@ -106,48 +130,7 @@ void HashedChunkedWaveletOctreeBlock::addToCellValue(const OctreeIndex& index,
   root_scale_coefficient_ += coefficients.scale;
 }
 
-void HashedChunkedWaveletOctreeBlock::forEachLeaf(
-    const BlockIndex& block_index,
-    MapBase::IndexedLeafVisitorFunction visitor_fn,
-    IndexElement termination_height) const {
-  ProfilerZoneScoped;
-  if (empty()) {
-    return;
-  }
-
-  struct StackElement {
-    const OctreeIndex node_index;
-    OctreeType::NodeConstRefType node;
-    const Coefficients::Scale scale_coefficient{};
-  };
-  std::stack<StackElement> stack;
-  stack.emplace(StackElement{{tree_height_, block_index},
-                             ndtree_.getRootNode(),
-                             root_scale_coefficient_});
-  while (!stack.empty()) {
-    const OctreeIndex index = stack.top().node_index;
-    const auto node = stack.top().node;
-    const FloatingPoint scale_coefficient = stack.top().scale_coefficient;
-    stack.pop();
-
-    const Coefficients::CoefficientsArray child_scale_coefficients =
-        Transform::backward({scale_coefficient, {node.data()}});
-    for (NdtreeIndexRelativeChild child_idx = 0;
-         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
-      const OctreeIndex child_node_index = index.computeChildIndex(child_idx);
-      const FloatingPoint child_scale_coefficient =
-          child_scale_coefficients[child_idx];
-      if (auto child_node = node.getChild(child_idx);
-          child_node && termination_height < child_node_index.height) {
-        stack.emplace(StackElement{child_node_index, *child_node,
-                                   child_scale_coefficient});
-      } else {
-        visitor_fn(child_node_index, child_scale_coefficient);
-      }
-    }
-  }
-}
-
+WAVEMAP_MULTIVERSIONED
 void HashedChunkedWaveletOctreeBlock::recursiveThreshold(  // NOLINT
     OctreeType::NodeRefType node, Coefficients::Scale& node_scale_coefficient) {
   // Decompress child values
@@ -173,6 +156,7 @@ void HashedChunkedWaveletOctreeBlock::recursiveThreshold(  // NOLINT
   node_scale_coefficient = new_scale;
 }
 
+WAVEMAP_MULTIVERSIONED
 void HashedChunkedWaveletOctreeBlock::recursivePrune(  // NOLINT
     HashedChunkedWaveletOctreeBlock::OctreeType::NodeRefType node) {
   bool has_at_least_one_child = false;
@@ -191,4 +175,48 @@ void HashedChunkedWaveletOctreeBlock::recursivePrune(  // NOLINT
   }
   node.hasAtLeastOneChild() = has_at_least_one_child;
 }
+
+bool HashedChunkedWaveletOctreeBlock::recursiveCoarsen(  // NOLINT
+    OctreeType::ChunkType& chunk, IndexElement chunk_top_height,
+    IndexElement termination_height) {
+  using ChunkType = OctreeType::ChunkType;
+  // If all of the chunk's nodes lie at or above the termination height, only
+  // its descendants need to be coarsened
+  const IndexElement child_chunk_top_height = chunk_top_height - kChunkHeight;
+  if (termination_height <= child_chunk_top_height) {
+    bool modified = false;
+    if (chunk.hasChildrenArray()) {
+      for (LinearIndex child_idx = 0; child_idx < ChunkType::kNumChildren;
+           ++child_idx) {
+        if (ChunkType* child_chunk = chunk.getChild(child_idx); child_chunk) {
+          modified |= recursiveCoarsen(*child_chunk, child_chunk_top_height,
+                                       termination_height);
+        }
+      }
+    }
+    return modified;
+  }
+
+  // Otherwise, the child chunks only contain nodes below the termination
+  // height and can be erased as a whole, while the nodes inside the chunk are
+  // cleared level by level
+  bool modified = chunk.hasChildrenArray();
+  chunk.deleteChildrenArray();
+  using tree_math::perfect_tree::num_total_nodes_fast;
+  const IndexElement termination_depth = chunk_top_height - termination_height;
+  const LinearIndex first_detached_node_idx =
+      num_total_nodes_fast<kDim>(termination_depth);
+  const LinearIndex first_cleared_node_idx =
+      num_total_nodes_fast<kDim>(termination_depth + 1);
+  for (LinearIndex node_idx = first_detached_node_idx;
+       node_idx < ChunkType::kNumInnerNodes; ++node_idx) {
+    modified |= std::as_const(chunk).nodeHasAtLeastOneChild(node_idx);
+    chunk.nodeHasAtLeastOneChild(node_idx) = false;
+    if (first_cleared_node_idx <= node_idx) {
+      modified |= chunk.nodeHasNonzeroData(node_idx);
+      chunk.nodeData(node_idx) = {};
+    }
+  }
+  return modified;
+}
 }  // namespace wavemap
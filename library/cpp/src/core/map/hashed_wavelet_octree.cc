@@ -1,10 +1,41 @@
 #include "wavemap/core/map/hashed_wavelet_octree.h"
 
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
+#include <wavemap/core/map/quantized_hashed_wavelet_octree.h>
+#include <wavemap/core/utils/profile/metrics.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap {
+namespace {
+void recordPruningMetrics(size_t num_pruned_blocks, size_t num_erased_blocks) {
+  static auto& pruned_blocks = metrics::getCounter("map_pruned_blocks_total");
+  static auto& erased_blocks = metrics::getCounter("map_erased_blocks_total");
+  pruned_blocks.increment(num_pruned_blocks);
+  erased_blocks.increment(num_erased_blocks);
+}
+
+// Attribute the memory of each node's children to their height, such that
+// coarsening the blocks to a given height frees the memory of all lower ones
+template <typename NodeT>
+void addMemoryUsageByHeight(const NodeT& node, IndexElement node_height,
+                            std::vector<size_t>& memory_usage_by_height) {
+  if (!node.hasChildrenArray()) {
+    return;
+  }
+  memory_usage_by_height[node_height - 1] += node.getMemoryUsage();
+  for (NdtreeIndexRelativeChild child_idx = 0;
+       child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+    if (const auto child = node.getChild(child_idx); child) {
+      addMemoryUsageByHeight(*child, node_height - 1, memory_usage_by_height);
+    }
+  }
+}
+}  // namespace
+
 DECLARE_CONFIG_MEMBERS(HashedWaveletOctreeConfig,
                       (min_cell_width)
                       (min_log_odds)
@@ -22,37 +53,71 @@ bool HashedWaveletOctreeConfig::isValid(bool verbose) const {
   return is_valid;
 }
 
-void HashedWaveletOctree::threshold() {
+template <typename BlockT>
+typename BasicHashedWaveletOctree<BlockT>::ConstPtr
+BasicHashedWaveletOctree<BlockT>::snapshot() const {
   ProfilerZoneScoped;
-  forEachBlock([](const BlockIndex& /*block_index*/, Block& block) {
-    block.threshold();
-  });
+  return ConstPtr{new BasicHashedWaveletOctree(config_, block_map_)};
 }
 
-void HashedWaveletOctree::prune() {
+// NOTE: The methods below only request write access to the blocks that need
+//       to change, such that blocks shared with snapshots are not copied
+//       needlessly.
+template <typename BlockT>
+void BasicHashedWaveletOctree<BlockT>::threshold() {
   ProfilerZoneScoped;
-  block_map_.eraseBlockIf([](const BlockIndex& /*block_index*/, Block& block) {
-    block.prune();
-    return block.empty();
-  });
+  std::as_const(block_map_).forEachBlock(
+      [this](const BlockIndex& block_index, const Block& block) {
+        if (block.getNeedsThresholding()) {
+          block_map_.getBlock(block_index)->threshold();
+        }
+      });
 }
 
-void HashedWaveletOctree::pruneSmart() {
+template <typename BlockT>
+void BasicHashedWaveletOctree<BlockT>::prune() {
   ProfilerZoneScoped;
+  const size_t num_blocks = block_map_.size();
+  size_t num_pruned_blocks = 0u;
   block_map_.eraseBlockIf(
-      [&config = config_](const BlockIndex& /*block_index*/, Block& block) {
-        if (config.only_prune_blocks_if_unused_for <
-            block.getTimeSinceLastUpdated()) {
-          block.prune();
+      [this, &num_pruned_blocks](const BlockIndex& block_index,
+                                 const Block& block) {
+        if (!block.getNeedsPruning()) {
+          return block.empty();
         }
-        return block.empty();
+        Block& unique_block = *block_map_.getBlock(block_index);
+        unique_block.prune();
+        ++num_pruned_blocks;
+        return unique_block.empty();
       });
+  recordPruningMetrics(num_pruned_blocks, num_blocks - block_map_.size());
 }
 
-size_t HashedWaveletOctree::getMemoryUsage() const {
+template <typename BlockT>
+void BasicHashedWaveletOctree<BlockT>::pruneSmart() {
   ProfilerZoneScoped;
-  // TODO(victorr): Also include the memory usage of the unordered map itself
-  size_t memory_usage = 0u;
+  const size_t num_blocks = block_map_.size();
+  size_t num_pruned_blocks = 0u;
+  block_map_.eraseBlockIf(
+      [this, &num_pruned_blocks](const BlockIndex& block_index,
+                                 const Block& block) {
+        if (!block.getNeedsPruning() ||
+            block.getTimeSinceLastUpdated() <=
+                config_.only_prune_blocks_if_unused_for) {
+          return block.empty();
+        }
+        Block& unique_block = *block_map_.getBlock(block_index);
+        unique_block.prune();
+        ++num_pruned_blocks;
+        return unique_block.empty();
+      });
+  recordPruningMetrics(num_pruned_blocks, num_blocks - block_map_.size());
+}
+
+template <typename BlockT>
+size_t BasicHashedWaveletOctree<BlockT>::getMemoryUsage() const {
+  ProfilerZoneScoped;
+  size_t memory_usage = block_map_.getMemoryUsage();
   forEachBlock(
       [&memory_usage](const BlockIndex& /*block_index*/, const Block& block) {
         memory_usage += block.getMemoryUsage();
@@ -60,18 +125,49 @@ size_t HashedWaveletOctree::getMemoryUsage() const {
   return memory_usage;
 }
 
-Index3D HashedWaveletOctree::getMinIndex() const {
+template <typename BlockT>
+size_t BasicHashedWaveletOctree<BlockT>::getBlockMemoryUsage(
+    const BlockIndex& block_index) const {
+  const Block* block = getBlock(block_index);
+  if (!block) {
+    return 0u;
+  }
+  return block_map_.getMemoryUsage() / block_map_.size() +
+         block->getMemoryUsage();
+}
+
+template <typename BlockT>
+std::vector<size_t> BasicHashedWaveletOctree<BlockT>::getMemoryUsageByHeight()
+    const {
+  ProfilerZoneScoped;
+  std::vector<size_t> memory_usage_by_height(config_.tree_height + 1, 0u);
+  memory_usage_by_height.back() = block_map_.getMemoryUsage();
+  forEachBlock([&memory_usage_by_height, tree_height = config_.tree_height](
+                   const BlockIndex& /*block_index*/, const Block& block) {
+    block.visitOctree([tree_height, &memory_usage_by_height](
+                          const auto& octree, auto /*load_details*/) {
+      addMemoryUsageByHeight(octree.getRootNode(), tree_height - 1,
+                             memory_usage_by_height);
+    });
+  });
+  return memory_usage_by_height;
+}
+
+template <typename BlockT>
+Index3D BasicHashedWaveletOctree<BlockT>::getMinIndex() const {
   return cells_per_block_side_ * getMinBlockIndex();
 }
 
-Index3D HashedWaveletOctree::getMaxIndex() const {
+template <typename BlockT>
+Index3D BasicHashedWaveletOctree<BlockT>::getMaxIndex() const {
   if (empty()) {
     return Index3D::Zero();
   }
   return cells_per_block_side_ * (getMaxBlockIndex().array() + 1) - 1;
 }
 
-void HashedWaveletOctree::forEachLeaf(
+template <typename BlockT>
+void BasicHashedWaveletOctree<BlockT>::forEachLeaf(
     MapBase::IndexedLeafVisitorFunction visitor_fn) const {
   forEachBlock(
       [&visitor_fn](const BlockIndex& block_index, const Block& block) {
@@ -79,4 +175,7 @@ void HashedWaveletOctree::forEachLeaf(
       });
 }
 
+template class BasicHashedWaveletOctree<HashedWaveletOctreeBlock>;
+template class BasicHashedWaveletOctree<QuantizedHashedWaveletOctreeBlock>;
+template class BasicHashedWaveletOctree<LinearHashedWaveletOctreeBlock>;
 }  // namespace wavemap
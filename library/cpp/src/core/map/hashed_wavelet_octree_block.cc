@@ -3,40 +3,85 @@
 #include <stack>
 #include <vector>
 
+#include <wavemap/core/utils/cpu/dispatch.h>
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
 namespace wavemap {
-void HashedWaveletOctreeBlock::threshold() {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::threshold() {
   ProfilerZoneScoped;
   if (getNeedsThresholding()) {
+    decompress();
     recursiveThreshold(ndtree_.getRootNode(), root_scale_coefficient_);
     setNeedsThresholding(false);
   }
 }
 
-void HashedWaveletOctreeBlock::prune() {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::prune() {
   ProfilerZoneScoped;
   if (getNeedsPruning()) {
+    decompress();
     threshold();
-    recursivePrune(ndtree_.getRootNode());
+    recursivePrune(ndtree_.getRootNode(),
+                   coefficient_storage_.getPruningThreshold());
+    compactIfFragmented();
     setNeedsPruning(false);
+    coefficient_storage_.compress(ndtree_);
   }
 }
 
-void HashedWaveletOctreeBlock::clear() {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+bool BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::coarsen(
+    IndexElement termination_height) {
+  ProfilerZoneScoped;
+  if (termination_height <= 0) {
+    return false;
+  }
+  decompress();
+  // NOTE: The tree's root node stores the coefficients that resolve the cells
+  //       at height tree_height_ - 1. Coarsening the block to its full height
+  //       therefore only leaves its average value.
+  bool modified;
+  if (tree_height_ <= termination_height) {
+    modified = !ndtree_.empty();
+    ndtree_.clear();
+  } else {
+    modified = recursiveCoarsen(ndtree_.getRootNode(), tree_height_ - 1,
+                                termination_height);
+  }
+  if (modified) {
+    // NOTE: Since blocks are coarsened to save memory, the space of the
+    //       discarded nodes is always reclaimed.
+    compact();
+    setLastModifiedStamp();
+  }
+  return modified;
+}
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::clear() {
   ProfilerZoneScoped;
   root_scale_coefficient_ = Coefficients::Scale{};
   ndtree_.clear();
+  coefficient_storage_.clear();
   setLastUpdatedStamp();
 }
 
-void HashedWaveletOctreeBlock::setCellValue(const OctreeIndex& index,
-                                            FloatingPoint new_value) {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::setCellValue(
+    const OctreeIndex& index, FloatingPoint new_value) {
+  decompress();
   setNeedsPruning();
   setNeedsThresholding();
   setLastUpdatedStamp();
   const MortonIndex morton_code = convert::nodeIndexToMorton(index);
-  std::vector<OctreeType::NodePtrType> ancestors;
+  std::vector<typename OctreeType::NodePtrType> ancestors;
   const int height_difference = tree_height_ - index.height;
   ancestors.reserve(height_difference);
   ancestors.emplace_back(&ndtree_.getRootNode());
@@ -45,10 +90,10 @@ void HashedWaveletOctreeBlock::setCellValue(const OctreeIndex& index,
        --parent_height) {
     const NdtreeIndexRelativeChild child_index =
         OctreeIndex::computeRelativeChildIndex(morton_code, parent_height);
-    OctreeType::NodePtrType current_parent = ancestors.back();
+    typename OctreeType::NodePtrType current_parent = ancestors.back();
     current_value = Transform::backwardSingleChild(
         {current_value, current_parent->data()}, child_index);
-    OctreeType::NodeRefType child =
+    typename OctreeType::NodeRefType child =
         current_parent->getOrAllocateChild(child_index);
     ancestors.emplace_back(&child);
   }
@@ -59,7 +104,7 @@ void HashedWaveletOctreeBlock::setCellValue(const OctreeIndex& index,
        ++parent_height) {
     const NdtreeIndexRelativeChild child_index =
         OctreeIndex::computeRelativeChildIndex(morton_code, parent_height);
-    OctreeType::NodePtrType current_node = ancestors.back();
+    typename OctreeType::NodePtrType current_node = ancestors.back();
     ancestors.pop_back();
     coefficients =
         Transform::forwardSingleChild(coefficients.scale, child_index);
@@ -69,14 +114,18 @@ void HashedWaveletOctreeBlock::setCellValue(const OctreeIndex& index,
   root_scale_coefficient_ += coefficients.scale;
 }
 
-void HashedWaveletOctreeBlock::addToCellValue(const OctreeIndex& index,
-                                              FloatingPoint update) {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+void
+BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::addToCellValue(
+    const OctreeIndex& index, FloatingPoint update) {
+  decompress();
   setNeedsPruning();
   setNeedsThresholding();
   setLastUpdatedStamp();
   const MortonIndex morton_code = convert::nodeIndexToMorton(index);
 
-  std::vector<OctreeType::NodePtrType> ancestors;
+  std::vector<typename OctreeType::NodePtrType> ancestors;
   const int height_difference = tree_height_ - index.height;
   ancestors.reserve(height_difference);
   ancestors.emplace_back(&ndtree_.getRootNode());
@@ -84,8 +133,8 @@ void HashedWaveletOctreeBlock::addToCellValue(const OctreeIndex& index,
        --parent_height) {
     const NdtreeIndexRelativeChild child_index =
         OctreeIndex::computeRelativeChildIndex(morton_code, parent_height);
-    OctreeType::NodePtrType current_parent = ancestors.back();
-    OctreeType::NodeRefType child =
+    typename OctreeType::NodePtrType current_parent = ancestors.back();
+    typename OctreeType::NodeRefType child =
         current_parent->getOrAllocateChild(child_index);
     ancestors.emplace_back(&child);
   }
@@ -94,7 +143,7 @@ void HashedWaveletOctreeBlock::addToCellValue(const OctreeIndex& index,
   Coefficients::Parent coefficients{update, {}};
   for (int parent_height = index.height + 1; parent_height <= tree_height_;
        ++parent_height) {
-    OctreeType::NodePtrType current_node = ancestors.back();
+    typename OctreeType::NodePtrType current_node = ancestors.back();
     ancestors.pop_back();
     const NdtreeIndexRelativeChild child_index =
         OctreeIndex::computeRelativeChildIndex(morton_code, parent_height);
@@ -105,50 +154,11 @@ void HashedWaveletOctreeBlock::addToCellValue(const OctreeIndex& index,
   root_scale_coefficient_ += coefficients.scale;
 }
 
-void HashedWaveletOctreeBlock::forEachLeaf(
-    const BlockIndex& block_index,
-    MapBase::IndexedLeafVisitorFunction visitor_fn,
-    IndexElement termination_height) const {
-  ProfilerZoneScoped;
-  if (empty()) {
-    return;
-  }
-
-  struct StackElement {
-    const OctreeIndex node_index;
-    OctreeType::NodeConstRefType node;
-    const Coefficients::Scale scale_coefficient{};
-  };
-  std::stack<StackElement> stack;
-  stack.emplace(StackElement{OctreeIndex{tree_height_, block_index},
-                             ndtree_.getRootNode(), root_scale_coefficient_});
-  while (!stack.empty()) {
-    const OctreeIndex node_index = stack.top().node_index;
-    OctreeType::NodeConstRefType node = stack.top().node;
-    const FloatingPoint node_scale_coefficient = stack.top().scale_coefficient;
-    stack.pop();
-
-    const Coefficients::CoefficientsArray child_scale_coefficients =
-        Transform::backward({node_scale_coefficient, {node.data()}});
-    for (NdtreeIndexRelativeChild child_idx = 0;
-         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
-      const OctreeIndex child_node_index =
-          node_index.computeChildIndex(child_idx);
-      const FloatingPoint child_scale_coefficient =
-          child_scale_coefficients[child_idx];
-      OctreeType::NodeConstPtrType child_node = node.getChild(child_idx);
-      if (child_node && termination_height < child_node_index.height) {
-        stack.emplace(StackElement{child_node_index, *child_node,
-                                   child_scale_coefficient});
-      } else {
-        visitor_fn(child_node_index, child_scale_coefficient);
-      }
-    }
-  }
-}
-
-void HashedWaveletOctreeBlock::recursiveThreshold(  // NOLINT
-    HashedWaveletOctreeBlock::OctreeType::NodeRefType node,
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+WAVEMAP_MULTIVERSIONED
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::recursiveThreshold(  // NOLINT
+    typename OctreeType::NodeRefType node,
     FloatingPoint& node_scale_coefficient) {
   // Decompress child values
   auto& node_detail_coefficients = node.data();
@@ -173,16 +183,20 @@ void HashedWaveletOctreeBlock::recursiveThreshold(  // NOLINT
   node_scale_coefficient = new_scale;
 }
 
-void HashedWaveletOctreeBlock::recursivePrune(  // NOLINT
-    HashedWaveletOctreeBlock::OctreeType::NodeRefType node) {
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+WAVEMAP_MULTIVERSIONED
+void BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::recursivePrune(  // NOLINT
+    typename OctreeType::NodeRefType node, FloatingPoint threshold) {
   bool has_at_least_one_child = false;
   for (NdtreeIndexRelativeChild child_idx = 0;
        child_idx < OctreeIndex::kNumChildren; ++child_idx) {
-    if (OctreeType::NodePtrType child_node = node.getChild(child_idx);
+    if (typename OctreeType::NodePtrType child_node =
+            node.getChild(child_idx);
         child_node) {
-      recursivePrune(*child_node);
+      recursivePrune(*child_node, threshold);
       if (!child_node->hasChildrenArray() &&
-          !child_node->hasNonzeroData(1e-3f)) {
+          !child_node->hasNonzeroData(threshold)) {
         node.eraseChild(child_idx);
       } else {
         has_at_least_one_child = true;
@@ -193,4 +207,34 @@ void HashedWaveletOctreeBlock::recursivePrune(  // NOLINT
     node.deleteChildrenArray();
   }
 }
+
+template <typename CoefficientStorageT,
+          template <typename, int> class NdtreeT>
+bool BasicHashedWaveletOctreeBlock<CoefficientStorageT, NdtreeT>::recursiveCoarsen(  // NOLINT
+    typename OctreeType::NodeRefType node, IndexElement node_height,
+    IndexElement termination_height) {
+  // The children of nodes at the termination height store the coefficients
+  // that resolve the cells below it
+  if (node_height <= termination_height) {
+    const bool had_children = node.hasChildrenArray();
+    node.deleteChildrenArray();
+    return had_children;
+  }
+  bool modified = false;
+  for (NdtreeIndexRelativeChild child_idx = 0;
+       child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+    if (typename OctreeType::NodePtrType child_node =
+            node.getChild(child_idx);
+        child_node) {
+      modified |=
+          recursiveCoarsen(*child_node, node_height - 1, termination_height);
+    }
+  }
+  return modified;
+}
+
+template class BasicHashedWaveletOctreeBlock<FullPrecisionCoefficientStorage>;
+template class BasicHashedWaveletOctreeBlock<QuantizedCoefficientStorage>;
+template class BasicHashedWaveletOctreeBlock<FullPrecisionCoefficientStorage,
+                                             LinearNdtree>;
 }  // namespace wavemap
@@ -5,6 +5,8 @@
 #include "wavemap/core/map/hashed_blocks.h"
 #include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
 #include "wavemap/core/map/volumetric_octree.h"
 #include "wavemap/core/map/wavelet_octree.h"
 
@@ -74,6 +76,24 @@ std::unique_ptr<MapBase> MapFactory::create(MapType map_type,
         return nullptr;
       }
     }
+    case MapType::kQuantizedHashedWaveletOctree: {
+      if (const auto config = HashedWaveletOctreeConfig::from(params); config) {
+        return std::make_unique<QuantizedHashedWaveletOctree>(config.value());
+      } else {
+        LOG(ERROR) << "Quantized hashed wavelet octree volumetric data "
+                      "structure config could not be loaded.";
+        return nullptr;
+      }
+    }
+    case MapType::kLinearHashedWaveletOctree: {
+      if (const auto config = HashedWaveletOctreeConfig::from(params); config) {
+        return std::make_unique<LinearHashedWaveletOctree>(config.value());
+      } else {
+        LOG(ERROR) << "Linear hashed wavelet octree volumetric data structure "
+                      "config could not be loaded.";
+        return nullptr;
+      }
+    }
     default:
       LOG(ERROR) << "Attempted to create data structure with unknown type ID: "
                  << map_type.toTypeId() << ". Returning nullptr.";
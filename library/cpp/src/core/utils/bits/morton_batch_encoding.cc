@@ -0,0 +1,211 @@
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
+
+#include "wavemap/core/utils/cpu/cpu_features.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MORTON_BATCH_DISPATCH_AVAILABLE
+#endif
+
+namespace wavemap::morton {
+namespace {
+// Each dimension's bits are interleaved with a stride of 3, starting from the
+// dimension's index. Since 64 is not a multiple of 3, the x-coordinate's 22nd
+// bit is stored in the Morton code's MSB.
+constexpr uint64_t kPattern = bit_ops::repeat_block<uint64_t>(3, 0b1);
+constexpr int kNumLowBits = 64 / 3;
+constexpr uint64_t kLowBitsMask = (uint64_t{1} << kNumLowBits) - 1u;
+
+void encodeScalar(const Index3D* indices, size_t num_indices,
+                  MortonIndex* codes) {
+  for (size_t idx = 0; idx < num_indices; ++idx) {
+    codes[idx] = encode<3>(indices[idx]);
+  }
+}
+
+void decodeScalar(const MortonIndex* codes, size_t num_codes,
+                  Index3D* indices) {
+  for (size_t idx = 0; idx < num_codes; ++idx) {
+    indices[idx] = decode<3>(codes[idx]);
+  }
+}
+
+#ifdef MORTON_BATCH_DISPATCH_AVAILABLE
+__attribute__((target("bmi2"))) void encodeBmi2(const Index3D* indices,
+                                                size_t num_indices,
+                                                MortonIndex* codes) {
+  for (size_t idx = 0; idx < num_indices; ++idx) {
+    const Index3D& index = indices[idx];
+    codes[idx] = _pdep_u64(static_cast<uint64_t>(index[0]), kPattern) |
+                 _pdep_u64(static_cast<uint64_t>(index[1]), kPattern << 1) |
+                 _pdep_u64(static_cast<uint64_t>(index[2]), kPattern << 2);
+  }
+}
+
+__attribute__((target("bmi2"))) void decodeBmi2(const MortonIndex* codes,
+                                                size_t num_codes,
+                                                Index3D* indices) {
+  for (size_t idx = 0; idx < num_codes; ++idx) {
+    const MortonIndex code = codes[idx];
+    indices[idx] = {static_cast<IndexElement>(_pext_u64(code, kPattern)),
+                    static_cast<IndexElement>(_pext_u64(code, kPattern << 1)),
+                    static_cast<IndexElement>(_pext_u64(code, kPattern << 2))};
+  }
+}
+
+// Spread the 21 low bits of each 64-bit lane such that bit i moves to bit 3*i
+__attribute__((target("avx2"))) inline __m256i spreadAvx2(__m256i x) {
+  x = _mm256_and_si256(x, _mm256_set1_epi64x(kLowBitsMask));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 32)),
+                       _mm256_set1_epi64x(0x001f00000000ffff));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 16)),
+                       _mm256_set1_epi64x(0x001f0000ff0000ff));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 8)),
+                       _mm256_set1_epi64x(0x100f00f00f00f00f));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 4)),
+                       _mm256_set1_epi64x(0x10c30c30c30c30c3));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 2)),
+                       _mm256_set1_epi64x(0x1249249249249249));
+  return x;
+}
+
+// Inverse of spreadAvx2, gathering every third bit into the 21 low bits
+__attribute__((target("avx2"))) inline __m256i compactAvx2(__m256i x) {
+  x = _mm256_and_si256(x, _mm256_set1_epi64x(0x1249249249249249));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 2)),
+                       _mm256_set1_epi64x(0x10c30c30c30c30c3));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 4)),
+                       _mm256_set1_epi64x(0x100f00f00f00f00f));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 8)),
+                       _mm256_set1_epi64x(0x001f0000ff0000ff));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 16)),
+                       _mm256_set1_epi64x(0x001f00000000ffff));
+  x = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 32)),
+                       _mm256_set1_epi64x(kLowBitsMask));
+  return x;
+}
+
+// Load the given coordinate of four consecutive indices into 64-bit lanes
+__attribute__((target("avx2"))) inline __m256i loadCoordinatesAvx2(
+    const Index3D* indices, int dim_idx) {
+  return _mm256_setr_epi64x(static_cast<uint32_t>(indices[0][dim_idx]),
+                            static_cast<uint32_t>(indices[1][dim_idx]),
+                            static_cast<uint32_t>(indices[2][dim_idx]),
+                            static_cast<uint32_t>(indices[3][dim_idx]));
+}
+
+__attribute__((target("avx2"))) void encodeAvx2(const Index3D* indices,
+                                                size_t num_indices,
+                                                MortonIndex* codes) {
+  const __m256i kOne = _mm256_set1_epi64x(1);
+  size_t idx = 0u;
+  for (; idx + 4u <= num_indices; idx += 4u) {
+    const __m256i x = loadCoordinatesAvx2(indices + idx, 0);
+    const __m256i y = loadCoordinatesAvx2(indices + idx, 1);
+    const __m256i z = loadCoordinatesAvx2(indices + idx, 2);
+    const __m256i x_high_bit = _mm256_slli_epi64(
+        _mm256_and_si256(_mm256_srli_epi64(x, kNumLowBits), kOne), 63);
+    const __m256i morton = _mm256_or_si256(
+        _mm256_or_si256(spreadAvx2(x), x_high_bit),
+        _mm256_or_si256(_mm256_slli_epi64(spreadAvx2(y), 1),
+                        _mm256_slli_epi64(spreadAvx2(z), 2)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + idx), morton);
+  }
+  encodeScalar(indices + idx, num_indices - idx, codes + idx);
+}
+
+__attribute__((target("avx2"))) void decodeAvx2(const MortonIndex* codes,
+                                                size_t num_codes,
+                                                Index3D* indices) {
+  const __m256i kOne = _mm256_set1_epi64x(1);
+  size_t idx = 0u;
+  for (; idx + 4u <= num_codes; idx += 4u) {
+    const __m256i morton =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + idx));
+    const __m256i x_high_bit = _mm256_slli_epi64(
+        _mm256_and_si256(_mm256_srli_epi64(morton, 63), kOne), kNumLowBits);
+    alignas(32) uint64_t x[4], y[4], z[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(x),
+                       _mm256_or_si256(compactAvx2(morton), x_high_bit));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(y),
+                       compactAvx2(_mm256_srli_epi64(morton, 1)));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(z),
+                       compactAvx2(_mm256_srli_epi64(morton, 2)));
+    for (int lane = 0; lane < 4; ++lane) {
+      indices[idx + lane] = {static_cast<IndexElement>(x[lane]),
+                             static_cast<IndexElement>(y[lane]),
+                             static_cast<IndexElement>(z[lane])};
+    }
+  }
+  decodeScalar(codes + idx, num_codes - idx, indices + idx);
+}
+#endif
+}  // namespace
+
+bool isSupported(BatchCodecType codec) {
+  switch (codec.toTypeId()) {
+    case BatchCodecType::kScalar:
+      return true;
+    case BatchCodecType::kBmi2:
+      return cpu::getFeatures().bmi2;
+    case BatchCodecType::kAvx2:
+      return cpu::getFeatures().avx2;
+    default:
+      return false;
+  }
+}
+
+BatchCodecType getDefaultBatchCodec() {
+  // NOTE: BMI2 is preferred, as pdep/pext outperform the AVX2 bit spreading on
+  //       CPUs that implement them in hardware. On AMD CPUs prior to Zen 3,
+  //       which emulate pdep/pext in microcode, the AVX2 codec can be faster
+  //       and can be selected explicitly.
+  static const BatchCodecType default_codec = []() {
+    if (isSupported(BatchCodecType::kBmi2)) {
+      return BatchCodecType{BatchCodecType::kBmi2};
+    }
+    if (isSupported(BatchCodecType::kAvx2)) {
+      return BatchCodecType{BatchCodecType::kAvx2};
+    }
+    return BatchCodecType{BatchCodecType::kScalar};
+  }();
+  return default_codec;
+}
+
+void encode_batch(const Index3D* indices, size_t num_indices,
+                  MortonIndex* codes, BatchCodecType codec) {
+  DCHECK(isSupported(codec));
+#ifdef MORTON_BATCH_DISPATCH_AVAILABLE
+  switch (codec.toTypeId()) {
+    case BatchCodecType::kBmi2:
+      encodeBmi2(indices, num_indices, codes);
+      return;
+    case BatchCodecType::kAvx2:
+      encodeAvx2(indices, num_indices, codes);
+      return;
+    default:
+      break;
+  }
+#endif
+  encodeScalar(indices, num_indices, codes);
+}
+
+void decode_batch(const MortonIndex* codes, size_t num_codes, Index3D* indices,
+                  BatchCodecType codec) {
+  DCHECK(isSupported(codec));
+#ifdef MORTON_BATCH_DISPATCH_AVAILABLE
+  switch (codec.toTypeId()) {
+    case BatchCodecType::kBmi2:
+      decodeBmi2(codes, num_codes, indices);
+      return;
+    case BatchCodecType::kAvx2:
+      decodeAvx2(codes, num_codes, indices);
+      return;
+    default:
+      break;
+  }
+#endif
+  decodeScalar(codes, num_codes, indices);
+}
+}  // namespace wavemap::morton
@@ -0,0 +1,36 @@
+#include "wavemap/core/utils/cpu/cpu_features.h"
+
+namespace wavemap::cpu {
+namespace {
+Features detectFeatures() {
+  Features features;
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+  // NOTE: The CPU model is normally initialized before main() runs, but this
+  //       method could be called from another static initializer.
+  __builtin_cpu_init();
+  features.bmi2 = __builtin_cpu_supports("bmi2");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.avx512f = __builtin_cpu_supports("avx512f");
+#if !defined(__clang__) && 12 <= __GNUC__
+  features.x86_64_v3 = __builtin_cpu_supports("x86-64-v3");
+  features.x86_64_v4 = __builtin_cpu_supports("x86-64-v4");
+#else
+  features.x86_64_v3 = features.avx2 && features.bmi2 &&
+                       __builtin_cpu_supports("fma");
+  features.x86_64_v4 = features.x86_64_v3 && features.avx512f &&
+                       __builtin_cpu_supports("avx512bw") &&
+                       __builtin_cpu_supports("avx512cd") &&
+                       __builtin_cpu_supports("avx512dq") &&
+                       __builtin_cpu_supports("avx512vl");
+#endif
+#endif
+  return features;
+}
+}  // namespace
+
+const Features& getFeatures() {
+  static const Features features = detectFeatures();
+  return features;
+}
+}  // namespace wavemap::cpu
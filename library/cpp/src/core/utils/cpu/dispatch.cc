@@ -0,0 +1,74 @@
+#include "wavemap/core/utils/cpu/dispatch.h"
+
+#include <sstream>
+
+#include "wavemap/core/utils/bits/bit_operations.h"
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
+#include "wavemap/core/utils/cpu/cpu_features.h"
+
+namespace wavemap::cpu {
+namespace {
+// Instruction set the library was compiled for, e.g. through -march
+std::string getBaselineStr() {
+#if defined(__AVX512F__)
+  return "avx512f";
+#elif defined(__AVX2__)
+  return "avx2";
+#elif defined(__SSE4_2__)
+  return "sse4.2";
+#elif defined(__SSE2__)
+  return "sse2";
+#else
+  return "generic";
+#endif
+}
+
+// Path used by the kernels annotated with WAVEMAP_MULTIVERSIONED, which
+// mirrors the selection made by the variants' resolver
+std::string getMultiversionedPath() {
+#ifdef WAVEMAP_MULTIVERSIONING_ENABLED
+  const Features& features = getFeatures();
+  if (features.x86_64_v4) {
+    return "x86-64-v4 (runtime)";
+  }
+  if (features.x86_64_v3) {
+    return "x86-64-v3 (runtime)";
+  }
+  return "default (runtime)";
+#else
+  return getBaselineStr() + " (compile time)";
+#endif
+}
+}  // namespace
+
+std::vector<KernelPath> getActiveKernelPaths() {
+  const std::string multiversioned_path = getMultiversionedPath();
+  // NOTE: The measurement and projection models are called through virtual
+  //       methods, which cannot be multiversioned. They therefore always run
+  //       the instruction set the library was compiled for.
+  const std::string baseline_path = getBaselineStr() + " (compile time)";
+#ifdef BIT_EXPAND_AVAILABLE
+  const std::string morton_path = "bmi2 (compile time)";
+#else
+  const std::string morton_path = "lookup tables (compile time)";
+#endif
+  return {
+      {"haar_transforms", multiversioned_path},
+      {"measurement_models", baseline_path},
+      {"range_image_projection", baseline_path},
+      {"morton_coding", morton_path},
+      {"morton_batch_coding",
+       morton::getDefaultBatchCodec().toStr() + " (runtime)"},
+  };
+}
+
+std::string getActiveKernelPathsStr() {
+  std::stringstream ss;
+  ss << "Active kernel paths (library compiled for " << getBaselineStr()
+     << "):";
+  for (const auto& [kernel, path] : getActiveKernelPaths()) {
+    ss << "\n- " << kernel << ": " << path;
+  }
+  return ss.str();
+}
+}  // namespace wavemap::cpu
@@ -0,0 +1,187 @@
+#include "wavemap/core/utils/mesh/surface_extractor.h"
+
+#include <algorithm>
+
+#include <wavemap/core/utils/profile/profiler_interface.h>
+
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/query/occupancy_classifier.h"
+
+namespace wavemap {
+DECLARE_CONFIG_MEMBERS(SurfaceExtractorConfig,
+                      (occupancy_threshold));
+
+bool SurfaceExtractorConfig::isValid(bool verbose) const {
+  bool is_valid = true;
+
+  is_valid &= IS_PARAM_GE(occupancy_threshold,
+                          OccupancyClassifier::getUnobservedThreshold(),
+                          verbose);
+
+  return is_valid;
+}
+
+void SurfaceMesh::clear() {
+  vertices.clear();
+  triangles.clear();
+}
+
+void SurfaceMesh::append(const SurfaceMesh& other) {
+  const auto vertex_offset = static_cast<VertexIndex>(vertices.size());
+  vertices.insert(vertices.end(), other.vertices.cbegin(),
+                  other.vertices.cend());
+  triangles.reserve(triangles.size() + other.triangles.size());
+  for (const Triangle& triangle : other.triangles) {
+    triangles.emplace_back(Triangle{triangle[0] + vertex_offset,
+                                    triangle[1] + vertex_offset,
+                                    triangle[2] + vertex_offset});
+  }
+}
+
+SurfaceMesh SurfaceExtractor::getMesh() const {
+  ProfilerZoneScoped;
+  SurfaceMesh mesh;
+  size_t num_vertices = 0u;
+  size_t num_triangles = 0u;
+  for (const auto& [block_index, block_mesh] : block_meshes_) {
+    num_vertices += block_mesh.vertices.size();
+    num_triangles += block_mesh.triangles.size();
+  }
+  mesh.vertices.reserve(num_vertices);
+  mesh.triangles.reserve(num_triangles);
+  for (const auto& [block_index, block_mesh] : block_meshes_) {
+    mesh.append(block_mesh);
+  }
+  return mesh;
+}
+
+void SurfaceExtractor::clear() {
+  block_meshes_.clear();
+  block_stamps_.clear();
+}
+
+namespace {
+// Decomposition of the cube into six tetrahedra that share its main diagonal.
+// Since every cube is split the same way, the faces of neighboring
+// tetrahedra always match, also across cubes and blocks.
+constexpr std::array<std::array<int, 4>, 6> kTetrahedra{{{0, 1, 3, 7},
+                                                         {0, 1, 5, 7},
+                                                         {0, 2, 3, 7},
+                                                         {0, 2, 6, 7},
+                                                         {0, 4, 5, 7},
+                                                         {0, 4, 6, 7}}};
+}  // namespace
+
+void SurfaceExtractor::CubeMesher::addCube(
+    const Index3D& min_corner,
+    const std::array<FloatingPoint, 8>& corner_values) {
+  // Skip cubes that do not intersect the surface
+  const int num_occupied = static_cast<int>(
+      std::count_if(corner_values.cbegin(), corner_values.cend(),
+                    [this](FloatingPoint value) { return isovalue_ < value; }));
+  if (num_occupied == 0 || num_occupied == 8) {
+    return;
+  }
+
+  for (const auto& tetrahedron : kTetrahedra) {
+    // Split the tetrahedron's corners into occupied and free corners
+    std::array<int, 4> occupied{};
+    std::array<int, 4> free{};
+    int num_tet_occupied = 0;
+    int num_tet_free = 0;
+    Point3D occupied_centroid = Point3D::Zero();
+    Point3D free_centroid = Point3D::Zero();
+    for (const int corner_idx : tetrahedron) {
+      const Point3D offset = cornerOffset(corner_idx).cast<FloatingPoint>();
+      if (isovalue_ < corner_values[corner_idx]) {
+        occupied[num_tet_occupied++] = corner_idx;
+        occupied_centroid += offset;
+      } else {
+        free[num_tet_free++] = corner_idx;
+        free_centroid += offset;
+      }
+    }
+    if (num_tet_occupied == 0 || num_tet_free == 0) {
+      continue;
+    }
+    const Point3D towards_free_space =
+        free_centroid / static_cast<FloatingPoint>(num_tet_free) -
+        occupied_centroid / static_cast<FloatingPoint>(num_tet_occupied);
+
+    // Polygonize the tetrahedron
+    auto vertex = [&](int corner_a, int corner_b) {
+      return getOrAddVertex(min_corner, corner_values, corner_a, corner_b);
+    };
+    if (num_tet_occupied == 1) {
+      addTriangle({vertex(occupied[0], free[0]), vertex(occupied[0], free[1]),
+                   vertex(occupied[0], free[2])},
+                  towards_free_space);
+    } else if (num_tet_occupied == 3) {
+      addTriangle({vertex(free[0], occupied[0]), vertex(free[0], occupied[1]),
+                   vertex(free[0], occupied[2])},
+                  towards_free_space);
+    } else if (num_tet_occupied == 2) {
+      // The intersection is a quad, which we split into two triangles
+      const SurfaceMesh::VertexIndex vertex_ac = vertex(occupied[0], free[0]);
+      const SurfaceMesh::VertexIndex vertex_ad = vertex(occupied[0], free[1]);
+      const SurfaceMesh::VertexIndex vertex_bd = vertex(occupied[1], free[1]);
+      const SurfaceMesh::VertexIndex vertex_bc = vertex(occupied[1], free[0]);
+      addTriangle({vertex_ac, vertex_ad, vertex_bd}, towards_free_space);
+      addTriangle({vertex_ac, vertex_bd, vertex_bc}, towards_free_space);
+    }
+  }
+}
+
+SurfaceMesh::VertexIndex SurfaceExtractor::CubeMesher::getOrAddVertex(
+    const Index3D& min_corner,
+    const std::array<FloatingPoint, 8>& corner_values, int corner_a,
+    int corner_b) {
+  // All edges of the tetrahedra point along positive directions, so one of
+  // their corners' offsets is always a subset of the other's
+  const bool a_is_lower = (corner_a & corner_b) == corner_a;
+  const int lower_corner = a_is_lower ? corner_a : corner_b;
+  const int upper_corner = a_is_lower ? corner_b : corner_a;
+  const Index3D lower_index = min_corner + cornerOffset(lower_corner);
+  const Index<4> vertex_key{lower_index.x(), lower_index.y(), lower_index.z(),
+                            lower_corner ^ upper_corner};
+  const auto [it, inserted] = vertex_ids_.try_emplace(
+      vertex_key, static_cast<SurfaceMesh::VertexIndex>(mesh_.vertices.size()));
+  if (inserted) {
+    // Place the vertex where the linearly interpolated value crosses the
+    // isovalue
+    const FloatingPoint lower_value = corner_values[lower_corner];
+    const FloatingPoint upper_value = corner_values[upper_corner];
+    const FloatingPoint t = std::clamp(
+        (isovalue_ - lower_value) / (upper_value - lower_value), 0.f, 1.f);
+    const Index3D upper_index = min_corner + cornerOffset(upper_corner);
+    mesh_.vertices.emplace_back(
+        (1.f - t) * convert::indexToCenterPoint(lower_index, min_cell_width_) +
+        t * convert::indexToCenterPoint(upper_index, min_cell_width_));
+  }
+  return it->second;
+}
+
+void SurfaceExtractor::CubeMesher::addTriangle(
+    const std::array<SurfaceMesh::VertexIndex, 3>& vertices,
+    const Point3D& towards_free_space) {
+  const Point3D& vertex_0 = mesh_.vertices[vertices[0]];
+  const Point3D& vertex_1 = mesh_.vertices[vertices[1]];
+  const Point3D& vertex_2 = mesh_.vertices[vertices[2]];
+  const Point3D normal = (vertex_1 - vertex_0).cross(vertex_2 - vertex_0);
+
+  // Skip degenerate triangles, which occur when the surface passes exactly
+  // through a cell center
+  constexpr FloatingPoint kMinRelativeArea = 1e-6f;
+  if (normal.norm() < kMinRelativeArea * min_cell_width_ * min_cell_width_) {
+    return;
+  }
+
+  // Orient the triangle such that its normal points towards free space
+  if (0.f <= normal.dot(towards_free_space)) {
+    mesh_.triangles.emplace_back(vertices);
+  } else {
+    mesh_.triangles.emplace_back(
+        SurfaceMesh::Triangle{vertices[0], vertices[2], vertices[1]});
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,169 @@
+#include "wavemap/core/utils/profile/metrics.h"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace wavemap::metrics {
+namespace {
+void atomicAdd(std::atomic<double>& value, double amount) {
+  double current_value = value.load(std::memory_order_relaxed);
+  while (!value.compare_exchange_weak(current_value, current_value + amount,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+template <typename MetricT>
+MetricT& getOrCreate(std::map<std::string, std::unique_ptr<MetricT>>& metrics,
+                     const std::string& name) {
+  auto& metric = metrics[name];
+  if (!metric) {
+    metric = std::make_unique<MetricT>();
+  }
+  return *metric;
+}
+
+std::ostream& setPrecision(std::ostream& ostream) {
+  return ostream << std::setprecision(std::numeric_limits<double>::digits10);
+}
+
+// Format the bucket's upper bound as done by Prometheus, using +Inf for the
+// overflow bucket
+std::string formatUpperBound(int bucket_idx) {
+  if (bucket_idx == Histogram::kNumBuckets) {
+    return "+Inf";
+  }
+  std::ostringstream ostream;
+  ostream << setPrecision << Histogram::getBucketUpperBound(bucket_idx);
+  return ostream.str();
+}
+}  // namespace
+
+void Gauge::add(double amount) { atomicAdd(value_, amount); }
+
+void Histogram::observe(double value) {
+  int bucket_idx = 0;
+  if (kMinUpperBound < value) {
+    const double scaled_value = std::ceil(std::log2(value / kMinUpperBound));
+    bucket_idx = scaled_value < kNumBuckets ? static_cast<int>(scaled_value)
+                                            : kNumBuckets;
+  } else if (std::isnan(value)) {
+    return;
+  }
+  bucket_counts_[bucket_idx].fetch_add(1u, std::memory_order_relaxed);
+  count_.fetch_add(1u, std::memory_order_relaxed);
+  atomicAdd(sum_, value);
+}
+
+double Histogram::getBucketUpperBound(int bucket_idx) {
+  if (kNumBuckets <= bucket_idx) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return std::ldexp(kMinUpperBound, bucket_idx);
+}
+
+void Histogram::reset() {
+  for (auto& bucket_count : bucket_counts_) {
+    bucket_count.store(0u, std::memory_order_relaxed);
+  }
+  count_.store(0u, std::memory_order_relaxed);
+  sum_.store(0.0, std::memory_order_relaxed);
+}
+
+Counter& Registry::getCounter(const std::string& name) {
+  std::scoped_lock lock(mutex_);
+  return getOrCreate(counters_, name);
+}
+
+Gauge& Registry::getGauge(const std::string& name) {
+  std::scoped_lock lock(mutex_);
+  return getOrCreate(gauges_, name);
+}
+
+Histogram& Registry::getHistogram(const std::string& name) {
+  std::scoped_lock lock(mutex_);
+  return getOrCreate(histograms_, name);
+}
+
+void Registry::reset() {
+  std::scoped_lock lock(mutex_);
+  for (auto& [name, counter] : counters_) {
+    counter->reset();
+  }
+  for (auto& [name, gauge] : gauges_) {
+    gauge->reset();
+  }
+  for (auto& [name, histogram] : histograms_) {
+    histogram->reset();
+  }
+}
+
+std::string Registry::toJson() const {
+  std::scoped_lock lock(mutex_);
+  std::ostringstream ostream;
+  ostream << setPrecision << "{\"counters\":{";
+  for (auto it = counters_.begin(); it != counters_.end(); ++it) {
+    ostream << (it == counters_.begin() ? "" : ",") << "\"" << it->first
+            << "\":" << it->second->get();
+  }
+  ostream << "},\"gauges\":{";
+  for (auto it = gauges_.begin(); it != gauges_.end(); ++it) {
+    ostream << (it == gauges_.begin() ? "" : ",") << "\"" << it->first
+            << "\":" << it->second->get();
+  }
+  ostream << "},\"histograms\":{";
+  for (auto it = histograms_.begin(); it != histograms_.end(); ++it) {
+    const Histogram& histogram = *it->second;
+    ostream << (it == histograms_.begin() ? "" : ",") << "\"" << it->first
+            << "\":{\"count\":" << histogram.getCount()
+            << ",\"sum\":" << histogram.getSum() << ",\"buckets\":[";
+    // NOTE: As for Prometheus, the bucket counts are cumulative
+    uint64_t cumulative_count = 0u;
+    for (int bucket_idx = 0; bucket_idx <= Histogram::kNumBuckets;
+         ++bucket_idx) {
+      cumulative_count += histogram.getBucketCount(bucket_idx);
+      ostream << (bucket_idx == 0 ? "" : ",") << "{\"le\":\""
+              << formatUpperBound(bucket_idx)
+              << "\",\"count\":" << cumulative_count << "}";
+    }
+    ostream << "]}";
+  }
+  ostream << "}}";
+  return ostream.str();
+}
+
+std::string Registry::toPrometheus(const std::string& name_prefix) const {
+  std::scoped_lock lock(mutex_);
+  std::ostringstream ostream;
+  ostream << setPrecision;
+  for (const auto& [name, counter] : counters_) {
+    ostream << "# TYPE " << name_prefix << name << " counter\n"
+            << name_prefix << name << " " << counter->get() << "\n";
+  }
+  for (const auto& [name, gauge] : gauges_) {
+    ostream << "# TYPE " << name_prefix << name << " gauge\n"
+            << name_prefix << name << " " << gauge->get() << "\n";
+  }
+  for (const auto& [name, histogram] : histograms_) {
+    ostream << "# TYPE " << name_prefix << name << " histogram\n";
+    uint64_t cumulative_count = 0u;
+    for (int bucket_idx = 0; bucket_idx <= Histogram::kNumBuckets;
+         ++bucket_idx) {
+      cumulative_count += histogram->getBucketCount(bucket_idx);
+      ostream << name_prefix << name << "_bucket{le=\""
+              << formatUpperBound(bucket_idx) << "\"} " << cumulative_count
+              << "\n";
+    }
+    ostream << name_prefix << name << "_sum " << histogram->getSum() << "\n"
+            << name_prefix << name << "_count " << histogram->getCount()
+            << "\n";
+  }
+  return ostream.str();
+}
+
+Registry& getRegistry() {
+  static Registry registry;
+  return registry;
+}
+}  // namespace wavemap::metrics
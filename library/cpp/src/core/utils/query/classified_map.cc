@@ -1,9 +1,7 @@
 #include "wavemap/core/utils/query/classified_map.h"
 
 #include <limits>
-#include <stack>
 #include <utility>
-#include <vector>
 
 #include <wavemap/core/utils/profile/profiler_interface.h>
 
@@ -111,76 +109,6 @@ ClassifiedMap::getValueOrAncestor(const OctreeIndex& index) const {
   return {std::nullopt, getTreeHeight()};
 }
 
-void ClassifiedMap::forEachLeaf(IndexedLeafVisitorFunction visitor_fn,
-                                IndexElement termination_height) const {
-  forEachBlock([&visitor_fn, termination_height](const Index3D& block_index,
-                                                 const Block& block) {
-    struct StackElement {
-      const OctreeIndex node_index;
-      const Node& node;
-    };
-    std::stack<StackElement> stack;
-    stack.emplace(StackElement{OctreeIndex{block.getMaxHeight(), block_index},
-                               block.getRootNode()});
-    while (!stack.empty()) {
-      const OctreeIndex node_index = stack.top().node_index;
-      const Node& node = stack.top().node;
-      stack.pop();
-
-      for (NdtreeIndexRelativeChild child_idx = 0;
-           child_idx < OctreeIndex::kNumChildren; ++child_idx) {
-        const OctreeIndex child_node_index =
-            node_index.computeChildIndex(child_idx);
-        const Node* child_node = node.getChild(child_idx);
-        if (child_node && termination_height < child_node_index.height) {
-          stack.emplace(StackElement{child_node_index, *child_node});
-        } else {
-          const Occupancy::Mask child_occupancy =
-              node.data().childOccupancyMask(child_idx);
-          std::invoke(visitor_fn, child_node_index, child_occupancy);
-        }
-      }
-    }
-  });
-}
-
-void ClassifiedMap::forEachLeafMatching(Occupancy::Mask occupancy_mask,
-                                        IndexedLeafVisitorFunction visitor_fn,
-                                        IndexElement termination_height) const {
-  block_map_.forEachBlock([occupancy_mask, termination_height, &visitor_fn](
-                              const Index3D& block_index, const Block& block) {
-    struct StackElement {
-      const OctreeIndex node_index;
-      const Node& node;
-    };
-    std::stack<StackElement, std::vector<StackElement>> stack;
-    stack.emplace(StackElement{OctreeIndex{block.getMaxHeight(), block_index},
-                               block.getRootNode()});
-    while (!stack.empty()) {
-      const OctreeIndex node_index = stack.top().node_index;
-      const Node& node = stack.top().node;
-      stack.pop();
-
-      for (NdtreeIndexRelativeChild child_idx = 0;
-           child_idx < OctreeIndex::kNumChildren; ++child_idx) {
-        const auto child_occupancy = node.data().childOccupancyMask(child_idx);
-        if (!OccupancyClassifier::has(child_occupancy, occupancy_mask)) {
-          continue;
-        }
-        const OctreeIndex child_node_index =
-            node_index.computeChildIndex(child_idx);
-        if (OccupancyClassifier::isFully(child_occupancy, occupancy_mask) ||
-            child_node_index.height <= termination_height) {
-          std::invoke(visitor_fn, child_node_index, child_occupancy);
-        } else if (const Node* child_node = node.getChild(child_idx);
-                   child_node) {
-          stack.emplace(StackElement{child_node_index, *child_node});
-        }
-      }
-    }
-  });
-}
-
 std::pair<const ClassifiedMap::Node*, ClassifiedMap::HeightType>
 ClassifiedMap::QueryCache::getNodeOrAncestor(
     const OctreeIndex& index, const ClassifiedMap::BlockHashMap& block_map) {
@@ -0,0 +1,276 @@
+#include "wavemap/core/utils/query/neighbor_search.h"
+
+#include <algorithm>
+#include <queue>
+#include <stack>
+
+#include <wavemap/core/utils/profile/profiler_interface.h>
+
+#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/core/utils/shape/sphere.h"
+
+namespace wavemap {
+namespace {
+// Call the visitor for each index whose Chebyshev distance to the center
+// equals the given distance
+template <typename IndexVisitor>
+void forEachIndexInShell(const Index3D& center, IndexElement distance,
+                         IndexVisitor visitor_fn) {
+  if (distance == 0) {
+    visitor_fn(center);
+    return;
+  }
+  for (IndexElement x = -distance; x <= distance; ++x) {
+    for (IndexElement y = -distance; y <= distance; ++y) {
+      const bool on_side = std::abs(x) == distance || std::abs(y) == distance;
+      const IndexElement z_step = on_side ? 1 : 2 * distance;
+      for (IndexElement z = -distance; z <= distance; z += z_step) {
+        visitor_fn(Index3D{center.x() + x, center.y() + y, center.z() + z});
+      }
+    }
+  }
+}
+}  // namespace
+
+template <typename NeighborVisitor>
+void NeighborSearch::forEachNeighborByDistance(
+    const Point3D& point, FloatingPoint max_distance,
+    NeighborVisitor visitor_fn) const {
+  const ClassifiedMap& classified_map = *classified_map_;
+  const ClassifiedMap::BlockHashMap& block_map = classified_map.getBlockMap();
+  const FloatingPoint min_cell_width = classified_map.getMinCellWidth();
+  const IndexElement tree_height = classified_map.getTreeHeight();
+  const FloatingPoint block_width =
+      convert::heightToCellWidth(min_cell_width, tree_height);
+  const auto unobserved_mask = Occupancy::toMask(Occupancy::kUnobserved);
+  const bool unobserved_is_target =
+      OccupancyClassifier::has(unobserved_mask, target_mask_);
+  if (!unobserved_is_target && classified_map.empty()) {
+    return;
+  }
+
+  // Candidate nodes, ordered by their distance to the query point. Nodes that
+  // are not allocated have a homogeneous occupancy and a null node pointer.
+  struct Candidate {
+    FloatingPoint distance;
+    OctreeIndex node_index;
+    const ClassifiedMap::Node* node;
+    Occupancy::Mask occupancy;
+  };
+  auto is_farther = [](const Candidate& lhs, const Candidate& rhs) {
+    return rhs.distance < lhs.distance;
+  };
+  std::priority_queue<Candidate, std::vector<Candidate>, decltype(is_farther)>
+      candidates(is_farther);
+  auto add_candidate = [&](const OctreeIndex& node_index,
+                           const ClassifiedMap::Node* node,
+                           Occupancy::Mask occupancy) {
+    if (!OccupancyClassifier::has(occupancy, target_mask_)) {
+      return;
+    }
+    const FloatingPoint distance =
+        convert::nodeIndexToAABB(node_index, min_cell_width)
+            .minDistanceTo(point);
+    if (distance <= max_distance) {
+      candidates.emplace(Candidate{distance, node_index, node, occupancy});
+    }
+  };
+
+  // Blocks are added lazily, in shells of increasing Chebyshev distance
+  // around the query point's block. Since all blocks in shell d are at least
+  // (d - 1) block widths away, a shell only needs to be added once the
+  // nearest candidate is farther away than this bound.
+  const Index3D center_block_index =
+      convert::pointToNearestIndex(point, 1.f / block_width);
+  const Index3D min_block_index = classified_map.getMinBlockIndex();
+  const Index3D max_block_index = classified_map.getMaxBlockIndex();
+  IndexElement next_shell = 0;
+  auto shell_lower_bound = [block_width](IndexElement shell) {
+    return static_cast<FloatingPoint>(std::max(shell - 1, 0)) * block_width;
+  };
+  auto shells_remain = [&]() {
+    if (max_distance < shell_lower_bound(next_shell)) {
+      return false;
+    }
+    // Without unobserved targets, no matches remain once the previous shells
+    // cover all allocated blocks
+    if (!unobserved_is_target && 0 < next_shell) {
+      const Index3D covered_min = center_block_index.array() - next_shell + 1;
+      const Index3D covered_max = center_block_index.array() + next_shell - 1;
+      return (min_block_index.array() < covered_min.array() ||
+              covered_max.array() < max_block_index.array())
+          .any();
+    }
+    return true;
+  };
+  auto add_shell = [&]() {
+    forEachIndexInShell(
+        center_block_index, next_shell, [&](const Index3D& block_index) {
+          const OctreeIndex block_node_index{tree_height, block_index};
+          if (const auto* block = block_map.getBlock(block_index); block) {
+            const auto& root_node = block->getRootNode();
+            add_candidate(block_node_index, &root_node,
+                          root_node.data().occupancyMask());
+          } else {
+            add_candidate(block_node_index, nullptr, unobserved_mask);
+          }
+        });
+    ++next_shell;
+  };
+
+  while (true) {
+    while ((candidates.empty() ||
+            shell_lower_bound(next_shell) <= candidates.top().distance) &&
+           shells_remain()) {
+      add_shell();
+    }
+    if (candidates.empty()) {
+      return;
+    }
+    const Candidate candidate = candidates.top();
+    candidates.pop();
+    if (candidate.node_index.height == 0) {
+      if (!visitor_fn(Neighbor{candidate.node_index.position,
+                               candidate.distance})) {
+        return;
+      }
+      continue;
+    }
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      const OctreeIndex child_node_index =
+          candidate.node_index.computeChildIndex(child_idx);
+      if (candidate.node) {
+        add_candidate(child_node_index, candidate.node->getChild(child_idx),
+                      candidate.node->data().childOccupancyMask(child_idx));
+      } else {
+        add_candidate(child_node_index, nullptr, candidate.occupancy);
+      }
+    }
+  }
+}
+
+std::optional<NeighborSearch::Neighbor> NeighborSearch::findNearest(
+    const Point3D& point, FloatingPoint max_distance) const {
+  std::optional<Neighbor> nearest;
+  forEachNeighborByDistance(point, max_distance,
+                            [&nearest](const Neighbor& neighbor) {
+                              nearest = neighbor;
+                              return false;
+                            });
+  return nearest;
+}
+
+std::vector<NeighborSearch::Neighbor> NeighborSearch::findKNearest(
+    const Point3D& point, size_t k, FloatingPoint max_distance) const {
+  std::vector<Neighbor> neighbors;
+  if (k == 0u) {
+    return neighbors;
+  }
+  neighbors.reserve(k);
+  forEachNeighborByDistance(point, max_distance,
+                            [&neighbors, k](const Neighbor& neighbor) {
+                              neighbors.emplace_back(neighbor);
+                              return neighbors.size() < k;
+                            });
+  return neighbors;
+}
+
+std::vector<OctreeIndex> NeighborSearch::findWithinRadius(
+    const Point3D& center, FloatingPoint radius) const {
+  ProfilerZoneScoped;
+  std::vector<OctreeIndex> matches;
+  if (radius < 0.f) {
+    return matches;
+  }
+  const ClassifiedMap& classified_map = *classified_map_;
+  const FloatingPoint min_cell_width = classified_map.getMinCellWidth();
+  const IndexElement tree_height = classified_map.getTreeHeight();
+  const FloatingPoint block_width =
+      convert::heightToCellWidth(min_cell_width, tree_height);
+  const Sphere<Point3D> sphere{center, radius};
+  const auto unobserved_mask = Occupancy::toMask(Occupancy::kUnobserved);
+
+  struct StackElement {
+    OctreeIndex node_index;
+    const ClassifiedMap::Node* node;
+    Occupancy::Mask occupancy;
+  };
+  std::stack<StackElement, std::vector<StackElement>> stack;
+  const auto [min_block_index, max_block_index] =
+      convert::aabbToBlockIndexRange(static_cast<AABB<Point3D>>(sphere),
+                                     1.f / block_width);
+  for (const Index3D& block_index :
+       Grid<3>(min_block_index, max_block_index)) {
+    const OctreeIndex block_node_index{tree_height, block_index};
+    if (const auto* block = classified_map.getBlockMap().getBlock(block_index);
+        block) {
+      const auto& root_node = block->getRootNode();
+      stack.emplace(StackElement{block_node_index, &root_node,
+                                 root_node.data().occupancyMask()});
+    } else {
+      stack.emplace(StackElement{block_node_index, nullptr, unobserved_mask});
+    }
+  }
+
+  while (!stack.empty()) {
+    const StackElement element = stack.top();
+    stack.pop();
+    if (!OccupancyClassifier::has(element.occupancy, target_mask_)) {
+      continue;
+    }
+    const auto aabb =
+        convert::nodeIndexToAABB(element.node_index, min_cell_width);
+    if (!shape::overlaps(aabb, sphere)) {
+      continue;
+    }
+    if (element.node_index.height == 0 ||
+        (OccupancyClassifier::isFully(element.occupancy, target_mask_) &&
+         shape::is_inside(aabb, sphere))) {
+      matches.emplace_back(element.node_index);
+      continue;
+    }
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      const OctreeIndex child_node_index =
+          element.node_index.computeChildIndex(child_idx);
+      if (element.node) {
+        stack.emplace(
+            StackElement{child_node_index, element.node->getChild(child_idx),
+                         element.node->data().childOccupancyMask(child_idx)});
+      } else {
+        stack.emplace(
+            StackElement{child_node_index, nullptr, element.occupancy});
+      }
+    }
+  }
+  return matches;
+}
+
+std::vector<FloatingPoint> NeighborSearch::getNearestDistances(
+    const std::vector<Point3D>& points, FloatingPoint max_distance) const {
+  ProfilerZoneScoped;
+  std::vector<FloatingPoint> distances(points.size(), max_distance);
+  for (size_t task_begin = 0; task_begin < points.size();
+       task_begin += kPointsPerTask) {
+    const size_t task_end =
+        std::min(task_begin + kPointsPerTask, points.size());
+    thread_pool_->add_task(
+        [this, &points, &distances, max_distance, task_begin, task_end]() {
+          for (size_t point_idx = task_begin; point_idx < task_end;
+               ++point_idx) {
+            if (const auto nearest =
+                    findNearest(points[point_idx], max_distance);
+                nearest) {
+              distances[point_idx] = nearest->distance;
+            }
+          }
+        });
+  }
+  thread_pool_->wait_all();
+  return distances;
+}
+}  // namespace wavemap
@@ -1,20 +1,66 @@
 #include "wavemap/core/utils/query/point_sampler.h"
 
+#include <algorithm>
+
+#include <wavemap/core/utils/profile/profiler_interface.h>
+
 namespace wavemap {
+PointSampler::PointSampler(ClassifiedMap::ConstPtr classified_map,
+                           size_t random_seed)
+    : classified_map_(std::move(classified_map)), rng_(random_seed) {
+  update();
+}
+
+void PointSampler::update() {
+  ProfilerZoneScoped;
+  block_indices_.clear();
+  block_indices_.reserve(classified_map_->getHashMap().size());
+  classified_map_->forEachBlock([this](const Index3D& block_index,
+                                       const ClassifiedMap::Block& /*block*/) {
+    block_indices_.emplace_back(block_index);
+  });
+  for (auto& matching_regions : matching_regions_) {
+    matching_regions.reset();
+  }
+}
+
 std::optional<Index3D> PointSampler::getRandomBlock() {
-  if (classified_map_->empty()) {
+  if (block_indices_.empty()) {
     return std::nullopt;
   }
 
-  const size_t num_blocks = classified_map_->getHashMap().size();
-  const size_t nth_block = rng_.getRandomInteger(0ul, num_blocks - 1ul);
-  auto it = classified_map_->getHashMap().begin();
-  std::advance(it, nth_block);
-  if (it == classified_map_->getHashMap().end()) {
-    return std::nullopt;
+  const size_t nth_block =
+      rng_.getRandomInteger(0ul, block_indices_.size() - 1ul);
+  return block_indices_[nth_block];
+}
+
+const PointSampler::MatchingRegions& PointSampler::getMatchingRegions(
+    Occupancy::Mask occupancy_mask) {
+  // Trim stray bits beyond the mask width, such that each cache slot always
+  // corresponds to the same set of matching leaves
+  occupancy_mask &= kNumOccupancyMasks - 1;
+  auto& matching_regions = matching_regions_[occupancy_mask];
+  if (matching_regions) {
+    return matching_regions.value();
   }
 
-  return it->first;
+  // Index all regions that fully match the occupancy mask
+  ProfilerZoneScoped;
+  matching_regions.emplace();
+  classified_map_->forEachLeafMatching(
+      occupancy_mask, [&regions = matching_regions.value(), occupancy_mask](
+                          const OctreeIndex& node_index,
+                          Occupancy::Mask region_occupancy) {
+        if (!OccupancyClassifier::isFully(region_occupancy, occupancy_mask)) {
+          return;
+        }
+        const uint64_t node_volume = uint64_t{1}
+                                     << (OctreeIndex::kDim * node_index.height);
+        regions.node_indices.emplace_back(node_index);
+        regions.cumulative_volumes.emplace_back(regions.getTotalVolume() +
+                                                node_volume);
+      });
+  return matching_regions.value();
 }
 
 std::optional<Point3D> PointSampler::getRandomPointImpl(
@@ -41,4 +87,38 @@ std::optional<Point3D> PointSampler::getRandomPointImpl(
 
   return std::nullopt;
 }
+
+std::optional<Point3D> PointSampler::getRandomMatchingPoint(
+    Occupancy::Mask occupancy_mask, size_t max_attempts) {
+  const MatchingRegions& regions = getMatchingRegions(occupancy_mask);
+  const uint64_t total_volume = regions.getTotalVolume();
+  if (total_volume == 0u) {
+    return std::nullopt;
+  }
+
+  // Draw a region with a probability proportional to its volume
+  const uint64_t random_volume =
+      rng_.getRandomInteger(uint64_t{0}, total_volume - 1u);
+  const auto it =
+      std::upper_bound(regions.cumulative_volumes.begin(),
+                       regions.cumulative_volumes.end(), random_volume);
+  const auto region_idx = std::distance(regions.cumulative_volumes.begin(), it);
+  const OctreeIndex& node_index = regions.node_indices[region_idx];
+
+  // Draw a point inside the region
+  // NOTE: Due to floating point rounding, points drawn on the region's
+  //       boundary can be assigned to a neighboring cell. These are redrawn.
+  const Index3D min_index = convert::nodeIndexToMinCornerIndex(node_index);
+  const Index3D max_index = convert::nodeIndexToMaxCornerIndex(node_index);
+  for (size_t attempt_idx = 0; attempt_idx < max_attempts; ++attempt_idx) {
+    const Point3D point = getRandomPointInNode(node_index);
+    const auto index = convert::pointToNearestIndex(point, min_cell_width_inv_);
+    if ((min_index.array() <= index.array()).all() &&
+        (index.array() <= max_index.array()).all()) {
+      return point;
+    }
+  }
+
+  return std::nullopt;
+}
 }  // namespace wavemap
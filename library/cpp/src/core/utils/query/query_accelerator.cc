@@ -1,9 +1,70 @@
 #include "wavemap/core/utils/query/query_accelerator.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <vector>
+
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
 
 namespace wavemap {
-void QueryAccelerator<HashedWaveletOctree>::reset() {
+namespace {
+template <typename QueryAcceleratorT>
+std::vector<FloatingPoint> getCellValuesInMortonOrder(
+    QueryAcceleratorT& query_accelerator, const std::vector<Index3D>& indices,
+    IndexElement tree_height) {
+  std::vector<FloatingPoint> values(indices.size());
+  if (indices.empty()) {
+    return values;
+  }
+
+  // Express the indices relative to the batch's block-aligned minimum corner,
+  // such that sorting them in Morton order also groups them by block
+  Index3D min_index = indices.front();
+  Index3D max_index = indices.front();
+  for (const Index3D& index : indices) {
+    min_index = min_index.cwiseMin(index);
+    max_index = max_index.cwiseMax(index);
+  }
+  const Index3D origin =
+      int_math::div_exp2_floor(min_index, tree_height) *
+      int_math::exp2(tree_height);
+  const bool fits_in_morton_code =
+      ((max_index.cast<int64_t>() - origin.cast<int64_t>()).array() <=
+       morton::kMaxSingleCoordinate<3>)
+          .all();
+  if (!fits_in_morton_code) {
+    // Fall back to querying the indices in the order they were given
+    for (size_t idx = 0; idx < indices.size(); ++idx) {
+      values[idx] = query_accelerator.getCellValue(indices[idx]);
+    }
+    return values;
+  }
+
+  // Sort the indices in Morton order
+  std::vector<Index3D> relative_indices;
+  relative_indices.reserve(indices.size());
+  for (const Index3D& index : indices) {
+    relative_indices.emplace_back(index - origin);
+  }
+  const std::vector<MortonIndex> morton_codes =
+      morton::encode_batch(relative_indices);
+  std::vector<size_t> order(indices.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&morton_codes](size_t a, size_t b) {
+    return morton_codes[a] < morton_codes[b];
+  });
+
+  // Query the values
+  for (const size_t idx : order) {
+    values[idx] = query_accelerator.getCellValue(indices[idx]);
+  }
+  return values;
+}
+}  // namespace
+
+template <typename BlockT>
+void QueryAccelerator<BasicHashedWaveletOctree<BlockT>>::reset() {
   node_stack_.fill({});
   value_stack_.fill({});
 
@@ -12,7 +73,8 @@ void QueryAccelerator<HashedWaveletOctree>::reset() {
   height_ = tree_height_;
 }
 
-FloatingPoint QueryAccelerator<HashedWaveletOctree>::getCellValue(
+template <typename BlockT>
+FloatingPoint QueryAccelerator<BasicHashedWaveletOctree<BlockT>>::getCellValue(
     const OctreeIndex& index) {
   // Remember previous query indices and compute new ones
   const BlockIndex previous_block_index = block_index_;
@@ -42,7 +104,7 @@ FloatingPoint QueryAccelerator<HashedWaveletOctree>::getCellValue(
       height_ = tree_height_;
     } else {
       // Otherwise remember that it doesn't exist and return 'unknown'
-      node_stack_[tree_height_] = nullptr;
+      node_stack_[tree_height_] = {};
       value_stack_[tree_height_] = 0.f;
       height_ = tree_height_;
       return 0.f;
@@ -69,15 +131,24 @@ FloatingPoint QueryAccelerator<HashedWaveletOctree>::getCellValue(
     const NdtreeIndexRelativeChild child_idx =
         OctreeIndex::computeRelativeChildIndex(morton_code_, height_);
     --height_;
-    value_stack_[height_] =
-        HashedWaveletOctree::Block::Transform::backwardSingleChild(
-            {parent_value, parent_node->data()}, child_idx);
+    value_stack_[height_] = BlockT::Transform::backwardSingleChild(
+        {parent_value, parent_node->data()}, child_idx);
     node_stack_[height_] = parent_node->getChild(child_idx);
   }
 
   return value_stack_[height_];
 }
 
+template <typename BlockT>
+std::vector<FloatingPoint>
+QueryAccelerator<BasicHashedWaveletOctree<BlockT>>::getCellValues(
+    const std::vector<Index3D>& indices) {
+  return getCellValuesInMortonOrder(*this, indices, tree_height_);
+}
+
+template class QueryAccelerator<HashedWaveletOctree>;
+template class QueryAccelerator<LinearHashedWaveletOctree>;
+
 void QueryAccelerator<HashedChunkedWaveletOctree>::reset() {
   node_stack_.fill({});
   value_stack_.fill({});
@@ -152,4 +223,10 @@ FloatingPoint QueryAccelerator<HashedChunkedWaveletOctree>::getCellValue(
 
   return value_stack_[height_];
 }
+
+std::vector<FloatingPoint>
+QueryAccelerator<HashedChunkedWaveletOctree>::getCellValues(
+    const std::vector<Index3D>& indices) {
+  return getCellValuesInMortonOrder(*this, indices, tree_height_);
+}
 }  // namespace wavemap
@@ -0,0 +1,191 @@
+#include "wavemap/core/utils/query/raycaster.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include <wavemap/core/utils/profile/profiler_interface.h>
+
+#include "wavemap/core/indexing/index_conversions.h"
+
+namespace wavemap {
+std::optional<FloatingPoint> Raycaster::castRay(const Point3D& W_start,
+                                                const Vector3D& W_direction,
+                                                FloatingPoint max_range) const {
+  const FloatingPoint direction_norm = W_direction.norm();
+  if (direction_norm <= 0.f || max_range < 0.f) {
+    return std::nullopt;
+  }
+  const Vector3D direction = W_direction / direction_norm;
+  const bool unobserved_is_hit = OccupancyClassifier::has(
+      Occupancy::toMask(Occupancy::kUnobserved), hit_mask_);
+
+  // Walk through the blocks along the ray with a 3D DDA
+  const ClassifiedMap::BlockHashMap& block_map = classified_map_->getBlockMap();
+  const FloatingPoint block_width = convert::heightToCellWidth(
+      classified_map_->getMinCellWidth(), classified_map_->getTreeHeight());
+  Index3D block_index =
+      convert::pointToNearestIndex(W_start, 1.f / block_width);
+  Index3D step;
+  Vector3D t_to_next_boundary;
+  Vector3D t_step;
+  for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+    if (direction[dim_idx] == 0.f) {
+      step[dim_idx] = 0;
+      t_to_next_boundary[dim_idx] = std::numeric_limits<FloatingPoint>::max();
+      t_step[dim_idx] = std::numeric_limits<FloatingPoint>::max();
+    } else {
+      step[dim_idx] = 0.f < direction[dim_idx] ? 1 : -1;
+      const FloatingPoint next_boundary =
+          static_cast<FloatingPoint>(block_index[dim_idx] +
+                                     std::max(step[dim_idx], 0)) *
+          block_width;
+      t_to_next_boundary[dim_idx] =
+          (next_boundary - W_start[dim_idx]) / direction[dim_idx];
+      t_step[dim_idx] = block_width / std::abs(direction[dim_idx]);
+    }
+  }
+
+  FloatingPoint t_block_entry = 0.f;
+  while (t_block_entry <= max_range) {
+    if (const auto* block = block_map.getBlock(block_index); block) {
+      if (const auto hit = castRayThroughBlock(W_start, direction, max_range,
+                                               block_index, *block);
+          hit) {
+        return hit;
+      }
+    } else if (unobserved_is_hit) {
+      return t_block_entry;
+    }
+    int step_dim_idx;
+    t_block_entry = t_to_next_boundary.minCoeff(&step_dim_idx);
+    t_to_next_boundary[step_dim_idx] += t_step[step_dim_idx];
+    block_index[step_dim_idx] += step[step_dim_idx];
+  }
+  return std::nullopt;
+}
+
+Image<> Raycaster::renderRangeImage(const ProjectorBase& projection_model,
+                                    const Transformation3D& T_W_C,
+                                    FloatingPoint max_range) const {
+  ProfilerZoneScoped;
+  Image<> range_image(projection_model.getDimensions());
+  const Point3D& W_start = T_W_C.getPosition();
+  for (IndexElement row_idx = 0; row_idx < range_image.getNumRows();
+       ++row_idx) {
+    thread_pool_->add_task([this, &projection_model, &T_W_C, &W_start,
+                            &range_image, max_range, row_idx]() {
+      for (IndexElement column_idx = 0;
+           column_idx < range_image.getNumColumns(); ++column_idx) {
+        const Index2D index{row_idx, column_idx};
+        const Vector3D C_direction =
+            projection_model
+                .sensorToCartesian(projection_model.indexToImage(index), 1.f)
+                .normalized();
+        const Vector3D W_direction = T_W_C.getRotation().rotate(C_direction);
+        if (const auto distance = castRay(W_start, W_direction, max_range);
+            distance) {
+          range_image.at(index) =
+              projection_model.cartesianToSensorZ(distance.value() *
+                                                  C_direction);
+        }
+      }
+    });
+  }
+  thread_pool_->wait_all();
+  return range_image;
+}
+
+std::pair<FloatingPoint, FloatingPoint> Raycaster::intersectBox(
+    const Point3D& start, const Vector3D& direction,
+    const AABB<Point3D>& box) {
+  FloatingPoint t_entry = std::numeric_limits<FloatingPoint>::lowest();
+  FloatingPoint t_exit = std::numeric_limits<FloatingPoint>::max();
+  for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+    if (direction[dim_idx] == 0.f) {
+      if (start[dim_idx] < box.min[dim_idx] ||
+          box.max[dim_idx] < start[dim_idx]) {
+        return {1.f, 0.f};
+      }
+      continue;
+    }
+    const FloatingPoint direction_inv = 1.f / direction[dim_idx];
+    FloatingPoint t_min = (box.min[dim_idx] - start[dim_idx]) * direction_inv;
+    FloatingPoint t_max = (box.max[dim_idx] - start[dim_idx]) * direction_inv;
+    if (t_max < t_min) {
+      std::swap(t_min, t_max);
+    }
+    t_entry = std::max(t_entry, t_min);
+    t_exit = std::min(t_exit, t_max);
+  }
+  return {t_entry, t_exit};
+}
+
+std::optional<FloatingPoint> Raycaster::castRayThroughBlock(
+    const Point3D& start, const Vector3D& direction, FloatingPoint max_range,
+    const Index3D& block_index, const ClassifiedMap::Block& block) const {
+  const FloatingPoint min_cell_width = classified_map_->getMinCellWidth();
+
+  // Since the children of a node partition it, the ray passes through them
+  // one after the other. Visiting them in order of entry, depth-first, thus
+  // yields the matching nodes in the order the ray hits them.
+  struct StackElement {
+    OctreeIndex node_index;
+    const ClassifiedMap::Node* node;
+    Occupancy::Mask occupancy;
+    FloatingPoint t_entry;
+  };
+  std::vector<StackElement> stack;
+  auto push_children = [&](const OctreeIndex& node_index,
+                           const ClassifiedMap::Node& node) {
+    std::array<StackElement, OctreeIndex::kNumChildren> children;
+    int num_children = 0;
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      const auto child_occupancy = node.data().childOccupancyMask(child_idx);
+      if (!OccupancyClassifier::has(child_occupancy, hit_mask_)) {
+        continue;
+      }
+      const OctreeIndex child_node_index =
+          node_index.computeChildIndex(child_idx);
+      const auto [t_entry, t_exit] = intersectBox(
+          start, direction,
+          convert::nodeIndexToAABB(child_node_index, min_cell_width));
+      if (t_exit < std::max(t_entry, 0.f) || max_range < t_entry) {
+        continue;
+      }
+      children[num_children++] =
+          StackElement{child_node_index, node.getChild(child_idx),
+                       child_occupancy, std::max(t_entry, 0.f)};
+    }
+    // Push the children such that the nearest one ends up on top
+    // NOTE: Since there are at most 8 children, we sort them by decreasing
+    //       entry distance with an insertion sort.
+    for (int sorted_idx = 1; sorted_idx < num_children; ++sorted_idx) {
+      const StackElement child = children[sorted_idx];
+      int insert_idx = sorted_idx;
+      for (; 0 < insert_idx && children[insert_idx - 1].t_entry < child.t_entry;
+           --insert_idx) {
+        children[insert_idx] = children[insert_idx - 1];
+      }
+      children[insert_idx] = child;
+    }
+    stack.insert(stack.end(), children.begin(),
+                 children.begin() + num_children);
+  };
+
+  push_children(OctreeIndex{block.getMaxHeight(), block_index},
+                block.getRootNode());
+  while (!stack.empty()) {
+    const StackElement element = stack.back();
+    stack.pop_back();
+    if (OccupancyClassifier::isFully(element.occupancy, hit_mask_) ||
+        !element.node) {
+      return element.t_entry;
+    }
+    push_children(element.node_index, *element.node);
+  }
+  return std::nullopt;
+}
+}  // namespace wavemap
@@ -1,11 +1,28 @@
 #include "wavemap/core/utils/undistortion/pointcloud_undistortion.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
+
+#include <wavemap/core/utils/profile/profiler_interface.h>
+
+namespace wavemap::undistortion {
+PosedPointcloud<> compensate_motion(
+    const StampedPoseBuffer& pose_buffer, StampedPointcloud& stamped_pointcloud,
+    const std::shared_ptr<ThreadPool>& thread_pool) {
+  PosedPointcloud<> undistorted_pointcloud;
+  compensate_motion(pose_buffer, stamped_pointcloud, undistorted_pointcloud,
+                    thread_pool);
+  return undistorted_pointcloud;
+}
+
+void compensate_motion(const StampedPoseBuffer& pose_buffer,
+                       StampedPointcloud& stamped_pointcloud,
+                       PosedPointcloud<>& undistorted_pointcloud,
+                       const std::shared_ptr<ThreadPool>& thread_pool) {
+  ProfilerZoneScoped;
+  CHECK_GE(pose_buffer.size(), 2u);
 
-namespace wavemap {
-PosedPointcloud<> undistortion::compensate_motion(
-    const StampedPoseBuffer& pose_buffer,
-    undistortion::StampedPointcloud& stamped_pointcloud) {
   // Check that timestamps of all points fall within range of pose buffer
   {
     const auto& buffer_start_time = pose_buffer.front().stamp;
@@ -14,57 +31,96 @@ PosedPointcloud<> undistortion::compensate_motion(
     CHECK_LE(stamped_pointcloud.getEndTime(), buffer_end_time);
   }
 
+  // Returns the index of the pose buffer interval that contains the given time
+  const auto find_interval = [&pose_buffer](TimeAbsolute time) {
+    const auto right_it = std::lower_bound(
+        std::next(pose_buffer.begin()), std::prev(pose_buffer.end()), time,
+        [](const StampedPose& pose, TimeAbsolute stamp) {
+          return pose.stamp < stamp;
+        });
+    return static_cast<size_t>(
+        std::distance(pose_buffer.begin(), std::prev(right_it)));
+  };
+
+  // Get the sensor's pose at the median time, which is used as the frame of
+  // the undistorted pointcloud
+  const auto interpolate = [](const StampedPose& left, const StampedPose& right,
+                              TimeAbsolute time) {
+    const FloatingPoint a =
+        static_cast<FloatingPoint>(time - left.stamp) /
+        static_cast<FloatingPoint>(right.stamp - left.stamp);
+    DCHECK_GE(a, 0.f);
+    DCHECK_LE(a, 1.f);
+    return interpolateComponentwise(left.pose, right.pose, a);
+  };
+  const TimeAbsolute median_time = stamped_pointcloud.getMedianTime();
+  const size_t median_interval = find_interval(median_time);
+  const Transformation3D T_WCmedian =
+      interpolate(pose_buffer[median_interval],
+                  pose_buffer[median_interval + 1], median_time);
+
+  // Precompute the buffered poses relative to the median pose
+  // NOTE: Since the translations are interpolated linearly and the rotations
+  //       with slerp, which is bi-invariant, interpolating the relative poses
+  //       directly yields each point's pose in the median sensor frame.
+  //       This saves transforming the points back from the world frame.
+  const Transformation3D T_CmedianW = T_WCmedian.inverse();
+  StampedPoseBuffer relative_pose_buffer;
+  relative_pose_buffer.reserve(pose_buffer.size());
+  for (const auto& stamped_pose : pose_buffer) {
+    relative_pose_buffer.emplace_back(stamped_pose.stamp,
+                                      T_CmedianW * stamped_pose.pose);
+  }
+
   // Motion undistort
-  // NOTE: The undistortion is done by transforming the points into a fixed
-  //       (inertial) frame using the sensor's pose at each point's timestamp.
   const auto& points = stamped_pointcloud.getPoints();
-  const auto num_points = static_cast<int>(points.size());
-  const auto num_time_steps = static_cast<int>(pose_buffer.size());
-  Eigen::Matrix<FloatingPoint, 3, Eigen::Dynamic> t_W_points;
-  t_W_points.setZero(3, num_points);
-  TimeAbsolute previous_point_time = -1u;
-  int pose_left_idx = 0u;
-  Transformation3D T_WCi;
-  Transformation3D T_WCmedian;
-  for (int idx = 0u; idx < num_points; ++idx) {
-    const auto& point = points[idx];
-    const Point3D& Ci_p = point.position;
-
-    // Get the sensor pose at the current point's time stamp
-    const TimeAbsolute time =
-        stamped_pointcloud.getTimeBase() + point.time_offset;
-    if (time != previous_point_time) {
-      previous_point_time = time;
-      while (pose_buffer[pose_left_idx + 1].stamp < time &&
-             pose_left_idx + 2 < num_time_steps) {
-        ++pose_left_idx;
+  const TimeAbsolute time_base = stamped_pointcloud.getTimeBase();
+  const auto num_points = static_cast<Eigen::Index>(points.size());
+  auto& t_C_points = undistorted_pointcloud.data();
+  t_C_points.resize(3, num_points);
+  const auto undistort_chunk = [&](Eigen::Index start_idx,
+                                   Eigen::Index end_idx) {
+    // Find the interval containing the chunk's first point
+    size_t pose_left_idx =
+        find_interval(time_base + points[start_idx].time_offset);
+    TimeAbsolute previous_point_time = -1u;
+    Transformation3D::RotationMatrix R_CmedianCi;
+    Point3D t_CmedianCi;
+    for (Eigen::Index idx = start_idx; idx < end_idx; ++idx) {
+      const auto& point = points[idx];
+      // Only interpolate the pose if the timestamp changed
+      const TimeAbsolute time = time_base + point.time_offset;
+      if (time != previous_point_time) {
+        previous_point_time = time;
+        while (relative_pose_buffer[pose_left_idx + 1].stamp < time &&
+               pose_left_idx + 2 < relative_pose_buffer.size()) {
+          ++pose_left_idx;
+        }
+        const Transformation3D T_CmedianCi =
+            interpolate(relative_pose_buffer[pose_left_idx],
+                        relative_pose_buffer[pose_left_idx + 1], time);
+        R_CmedianCi = T_CmedianCi.getRotationMatrix();
+        t_CmedianCi = T_CmedianCi.getPosition();
       }
-      CHECK_LT(pose_left_idx + 1, pose_buffer.size());
-      const TimeAbsolute time_left = pose_buffer[pose_left_idx].stamp;
-      const TimeAbsolute time_right = pose_buffer[pose_left_idx + 1].stamp;
-      const Transformation3D& T_WCleft = pose_buffer[pose_left_idx].pose;
-      const Transformation3D& T_WCright = pose_buffer[pose_left_idx + 1].pose;
-      FloatingPoint a = static_cast<FloatingPoint>((time - time_left)) /
-                        static_cast<FloatingPoint>((time_right - time_left));
-      DCHECK_GE(a, 0.f);
-      DCHECK_LE(a, 1.f);
-      T_WCi = interpolateComponentwise(T_WCleft, T_WCright, a);
+      t_C_points.col(idx) = R_CmedianCi * point.position + t_CmedianCi;
     }
+  };
 
-    // Transform the current point into the fixed frame
-    t_W_points.col(idx) = T_WCi * Ci_p;
-
-    // Store the sensor's pose at the median timestamp
-    if (idx == num_points / 2) {
-      T_WCmedian = T_WCi;
+  // Process the points in chunks, in parallel if a thread pool is available
+  constexpr Eigen::Index kChunkSize = 4096;
+  if (thread_pool && kChunkSize < num_points) {
+    for (Eigen::Index start_idx = 0; start_idx < num_points;
+         start_idx += kChunkSize) {
+      const Eigen::Index end_idx = std::min(start_idx + kChunkSize, num_points);
+      thread_pool->add_task([&undistort_chunk, start_idx, end_idx]() {
+        undistort_chunk(start_idx, end_idx);
+      });
     }
+    thread_pool->wait_all();
+  } else if (0 < num_points) {
+    undistort_chunk(0, num_points);
   }
 
-  // Transform the undistorted pointcloud back into sensor frame,
-  // as needed by the integrators
-  auto t_C_points = T_WCmedian.inverse().transformVectorized(t_W_points);
-
-  // Return the result
-  return PosedPointcloud<>{T_WCmedian, std::move(t_C_points)};
+  undistorted_pointcloud.setPose(T_WCmedian);
 }
-}  // namespace wavemap
+}  // namespace wavemap::undistortion
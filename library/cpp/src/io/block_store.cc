@@ -0,0 +1,113 @@
+#include "wavemap/io/block_store.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "wavemap/core/utils/profile/metrics.h"
+#include "wavemap/io/stream_conversions.h"
+
+namespace wavemap::io {
+BlockStore::BlockStore(std::filesystem::path directory)
+    : directory_(std::move(directory)) {
+  CHECK(!directory_.empty()) << "The block store's directory must be set.";
+  std::error_code error_code;
+  std::filesystem::create_directories(directory_, error_code);
+  CHECK(!error_code) << "Could not create block store directory "
+                     << directory_ << ". Error: " << error_code.message();
+}
+
+void BlockStore::clear() {
+  for (const Index3D& block_index : block_indices_) {
+    std::error_code error_code;
+    std::filesystem::remove(getBlockFilePath(block_index), error_code);
+  }
+  block_indices_.clear();
+}
+
+bool BlockStore::storeBlock(const Index3D& block_index,
+                            const HashedWaveletOctreeBlock& block,
+                            FloatingPoint min_log_odds,
+                            FloatingPoint max_log_odds) {
+  // Write to a temporary file first, such that a failed write can never
+  // corrupt the previously stored version of the block
+  const std::filesystem::path file_path = getBlockFilePath(block_index);
+  std::filesystem::path temporary_file_path = file_path;
+  temporary_file_path += ".tmp";
+  {
+    std::ofstream file_ostream(temporary_file_path,
+                               std::ofstream::out | std::ofstream::binary);
+    if (!file_ostream.is_open()) {
+      LOG(WARNING) << "Could not open file " << temporary_file_path
+                   << " for writing. Error: " << strerror(errno);
+      return false;
+    }
+    if (!blockToStream(block_index, block, min_log_odds, max_log_odds,
+                       file_ostream)) {
+      LOG(WARNING) << "Failed to write block to file " << temporary_file_path
+                   << ".";
+      return false;
+    }
+    file_ostream.close();
+    if (!file_ostream) {
+      return false;
+    }
+  }
+
+  std::error_code error_code;
+  std::filesystem::rename(temporary_file_path, file_path, error_code);
+  if (error_code) {
+    LOG(WARNING) << "Could not move block file to " << file_path
+                 << ". Error: " << error_code.message();
+    return false;
+  }
+  block_indices_.emplace(block_index);
+  static auto& stored_blocks = metrics::getCounter("io_stored_blocks_total");
+  stored_blocks.increment();
+  return true;
+}
+
+bool BlockStore::loadBlock(const Index3D& block_index,
+                           HashedWaveletOctreeBlock& block) const {
+  if (!hasBlock(block_index)) {
+    return false;
+  }
+
+  const std::filesystem::path file_path = getBlockFilePath(block_index);
+  std::ifstream file_istream(file_path,
+                             std::ifstream::in | std::ifstream::binary);
+  if (!file_istream.is_open()) {
+    LOG(WARNING) << "Could not open file " << file_path
+                 << " for reading. Error: " << strerror(errno);
+    return false;
+  }
+
+  Index3D read_block_index;
+  if (!streamToBlock(file_istream, read_block_index, block) ||
+      read_block_index != block_index) {
+    LOG(WARNING) << "Failed to parse block from file " << file_path << ".";
+    return false;
+  }
+  static auto& loaded_blocks = metrics::getCounter("io_loaded_blocks_total");
+  loaded_blocks.increment();
+  return true;
+}
+
+bool BlockStore::eraseBlock(const Index3D& block_index) {
+  if (!block_indices_.erase(block_index)) {
+    return false;
+  }
+  std::error_code error_code;
+  std::filesystem::remove(getBlockFilePath(block_index), error_code);
+  return !error_code;
+}
+
+std::filesystem::path BlockStore::getBlockFilePath(
+    const Index3D& block_index) const {
+  return directory_ / ("block_" + std::to_string(block_index.x()) + "_" +
+                       std::to_string(block_index.y()) + "_" +
+                       std::to_string(block_index.z()) + ".wvmb");
+}
+}  // namespace wavemap::io
@@ -1,6 +1,9 @@
 #include "wavemap/io/file_conversions.h"
 
 #include <fstream>
+#include <system_error>
+
+#include <wavemap/core/utils/profile/metrics.h>
 
 namespace wavemap::io {
 bool mapToFile(const MapBase& map, const std::filesystem::path& file_path) {
@@ -10,6 +13,10 @@ bool mapToFile(const MapBase& map, const std::filesystem::path& file_path) {
     return false;
   }
 
+  static auto& writing_time = metrics::getHistogram("io_map_writing_seconds");
+  static auto& bytes_written = metrics::getCounter("io_bytes_written_total");
+  metrics::ScopedTimer writing_timer(writing_time);
+
   // Open the file for writing
   std::ofstream file_ostream(file_path,
                              std::ofstream::out | std::ofstream::binary);
@@ -26,7 +33,15 @@ bool mapToFile(const MapBase& map, const std::filesystem::path& file_path) {
 
   // Close the file and communicate whether writing succeeded
   file_ostream.close();
-  return static_cast<bool>(file_ostream);
+  if (!file_ostream) {
+    return false;
+  }
+  std::error_code error_code;
+  if (const auto file_size = std::filesystem::file_size(file_path, error_code);
+      !error_code) {
+    bytes_written.increment(file_size);
+  }
+  return true;
 }
 
 bool fileToMap(const std::filesystem::path& file_path, MapBase::Ptr& map) {
@@ -36,6 +51,10 @@ bool fileToMap(const std::filesystem::path& file_path, MapBase::Ptr& map) {
     return false;
   }
 
+  static auto& reading_time = metrics::getHistogram("io_map_reading_seconds");
+  static auto& bytes_read = metrics::getCounter("io_bytes_read_total");
+  metrics::ScopedTimer reading_timer(reading_time);
+
   // Open the file for reading
   std::ifstream file_istream(file_path,
                              std::ifstream::in | std::ifstream::binary);
@@ -51,6 +70,11 @@ bool fileToMap(const std::filesystem::path& file_path, MapBase::Ptr& map) {
     return false;
   }
 
+  std::error_code error_code;
+  if (const auto file_size = std::filesystem::file_size(file_path, error_code);
+      !error_code) {
+    bytes_read.increment(file_size);
+  }
   return true;
 }
 }  // namespace wavemap::io
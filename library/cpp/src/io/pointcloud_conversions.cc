@@ -0,0 +1,354 @@
+#include "wavemap/io/pointcloud_conversions.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <wavemap/core/indexing/index_conversions.h>
+#include <wavemap/core/map/hashed_chunked_wavelet_octree.h>
+#include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
+#include <wavemap/core/utils/iterate/grid_iterator.h>
+#include <wavemap/core/utils/math/int_math.h>
+#include <wavemap/core/utils/profile/profiler_interface.h>
+#include <wavemap/core/utils/shape/intersection_tests.h>
+
+namespace wavemap::io {
+DECLARE_CONFIG_MEMBERS(OccupiedPointcloudConfig,
+                      (format)
+                      (occupancy_threshold)
+                      (output_height)
+                      (max_blocks_per_batch));
+
+bool OccupiedPointcloudConfig::isValid(bool verbose) const {
+  bool is_valid = true;
+
+  is_valid &= IS_PARAM_TRUE(format.isValid(), verbose);
+  is_valid &= IS_PARAM_GE(output_height, 0, verbose);
+  is_valid &= IS_PARAM_GT(max_blocks_per_batch, 0, verbose);
+
+  return is_valid;
+}
+
+namespace {
+// The points are written by copying Point3Ds directly into the stream
+static_assert(sizeof(Point3D) == 3 * sizeof(float));
+
+bool isLittleEndian() {
+  constexpr uint16_t kTestValue = 1u;
+  std::array<char, sizeof(kTestValue)> bytes{};
+  std::memcpy(bytes.data(), &kTestValue, sizeof(kTestValue));
+  return bytes[0] == 1;
+}
+
+void writeHeader(std::ostream& ostream, PointcloudFormat format,
+                 size_t num_points, FloatingPoint point_spacing) {
+  switch (format) {
+    case PointcloudFormat::kPly:
+      // clang-format off
+      ostream << "ply\n"
+                 "format "
+              << (isLittleEndian() ? "binary_little_endian"
+                                   : "binary_big_endian") << " 1.0\n"
+                 "comment The voxel size is " << point_spacing << " meters.\n"
+                 "element vertex " << num_points << "\n"
+                 "property float x\n"
+                 "property float y\n"
+                 "property float z\n"
+                 "end_header\n";
+      // clang-format on
+      break;
+    case PointcloudFormat::kPcd:
+      // clang-format off
+      ostream << "# .PCD v0.7 - Point Cloud Data file format\n"
+                 "# The voxel size is " << point_spacing << " meters.\n"
+                 "VERSION 0.7\n"
+                 "FIELDS x y z\n"
+                 "SIZE 4 4 4\n"
+                 "TYPE F F F\n"
+                 "COUNT 1 1 1\n"
+                 "WIDTH " << num_points << "\n"
+                 "HEIGHT 1\n"
+                 "VIEWPOINT 0 0 0 1 0 0 0\n"
+                 "POINTS " << num_points << "\n"
+                 "DATA binary\n";
+      // clang-format on
+      break;
+  }
+}
+
+void writePoints(std::ostream& ostream, const std::vector<Point3D>& points) {
+  ostream.write(reinterpret_cast<const char*>(points.data()),
+                static_cast<std::streamsize>(points.size() * sizeof(Point3D)));
+}
+
+// Limit the requested output height to the height of the map's coarsest leaves
+// NOTE: The blocks' root nodes are never visited as leaves, the coarsest
+//       leaves are their children.
+IndexElement getOutputHeight(const OccupiedPointcloudConfig& config,
+                             IndexElement tree_height) {
+  const IndexElement output_height =
+      std::min(config.output_height, std::max(tree_height - 1, 0));
+  if (output_height < config.output_height) {
+    LOG(WARNING) << "Requested output height " << config.output_height
+                 << " exceeds the maximum supported height. Using "
+                 << output_height << " instead.";
+  }
+  return output_height;
+}
+
+// Visit the centers of the nodes at the output height that are covered by a
+// leaf, without materializing them. Leaves below the output height are
+// visited at their own resolution.
+template <typename PointVisitor>
+void forEachPointInLeaf(const OctreeIndex& leaf_index,
+                        IndexElement output_height,
+                        FloatingPoint min_cell_width,
+                        const std::optional<AABB<Point3D>>& region,
+                        PointVisitor&& visitor_fn) {
+  if (leaf_index.height <= output_height) {
+    if (!region || shape::overlaps(convert::nodeIndexToAABB(
+                                       leaf_index, min_cell_width),
+                                   region.value())) {
+      visitor_fn(convert::nodeIndexToCenterPoint(leaf_index, min_cell_width));
+    }
+    return;
+  }
+
+  // Only check the nodes individually if the leaf is partially in the region
+  const bool check_region =
+      region && !shape::is_inside(
+                    convert::nodeIndexToAABB(leaf_index, min_cell_width),
+                    region.value());
+  const IndexElement nodes_per_side =
+      int_math::exp2(leaf_index.height - output_height);
+  const Index3D min_position = nodes_per_side * leaf_index.position;
+  const Index3D max_position = min_position.array() + (nodes_per_side - 1);
+  for (const Index3D& position : Grid<3>(min_position, max_position)) {
+    const OctreeIndex node_index{output_height, position};
+    if (check_region &&
+        !shape::overlaps(convert::nodeIndexToAABB(node_index, min_cell_width),
+                         region.value())) {
+      continue;
+    }
+    visitor_fn(convert::nodeIndexToCenterPoint(node_index, min_cell_width));
+  }
+}
+
+template <typename MapT>
+bool hashedMapToStream(const MapT& map, std::ostream& ostream,
+                       const OccupiedPointcloudConfig& config,
+                       const std::optional<AABB<Point3D>>& region,
+                       ThreadPool& thread_pool) {
+  ProfilerZoneScoped;
+  const FloatingPoint min_cell_width = map.getMinCellWidth();
+  const IndexElement output_height =
+      getOutputHeight(config, map.getTreeHeight());
+
+  // Index the blocks that can contain points
+  using Block = typename MapT::Block;
+  std::vector<std::pair<Index3D, const Block*>> blocks;
+  auto add_block = [&blocks](const Index3D& block_index, const Block& block) {
+    blocks.emplace_back(block_index, &block);
+  };
+  if (region) {
+    map.forEachBlockInRegion(region.value(), add_block);
+  } else {
+    map.forEachBlock(add_block);
+  }
+
+  auto for_each_point_in_block = [&](size_t block_idx, auto&& visitor_fn) {
+    const auto& [block_index, block] = blocks[block_idx];
+    auto visit_leaf = [&](const OctreeIndex& leaf_index,
+                          FloatingPoint log_odds) {
+      if (config.occupancy_threshold < log_odds) {
+        forEachPointInLeaf(leaf_index, output_height, min_cell_width, region,
+                           visitor_fn);
+      }
+    };
+    if (region) {
+      auto overlaps_region = [&region,
+                              min_cell_width](const OctreeIndex& node_index) {
+        return shape::overlaps(
+            convert::nodeIndexToAABB(node_index, min_cell_width),
+            region.value());
+      };
+      block->forEachLeafIf(block_index, overlaps_region, visit_leaf,
+                           output_height);
+    } else {
+      block->forEachLeaf(block_index, visit_leaf, output_height);
+    }
+  };
+
+  // Count the points in each block, such that the header can be written first
+  std::vector<size_t> num_points_per_block(blocks.size(), 0u);
+  for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
+    thread_pool.add_task([&, block_idx]() {
+      size_t& num_points = num_points_per_block[block_idx];
+      for_each_point_in_block(block_idx,
+                              [&num_points](const Point3D&) { ++num_points; });
+    });
+  }
+  thread_pool.wait_all();
+  const size_t total_num_points = std::accumulate(
+      num_points_per_block.begin(), num_points_per_block.end(), size_t{0});
+  writeHeader(ostream, config.format, total_num_points,
+              convert::heightToCellWidth(min_cell_width, output_height));
+
+  // Convert the blocks in batches, writing each batch out in the original
+  // block order while the next batch is converted
+  const size_t batch_size = config.max_blocks_per_batch;
+  std::array<std::vector<std::vector<Point3D>>, 2> batch_buffers;
+  for (auto& batch_buffer : batch_buffers) {
+    batch_buffer.resize(batch_size);
+  }
+  auto convert_batch = [&](size_t batch_idx) {
+    auto& batch_buffer = batch_buffers[batch_idx % 2];
+    const size_t batch_start = batch_idx * batch_size;
+    const size_t batch_end = std::min(batch_start + batch_size, blocks.size());
+    for (size_t block_idx = batch_start; block_idx < batch_end; ++block_idx) {
+      std::vector<Point3D>* points = &batch_buffer[block_idx - batch_start];
+      points->clear();
+      if (num_points_per_block[block_idx] == 0u) {
+        continue;
+      }
+      thread_pool.add_task([&for_each_point_in_block, &num_points_per_block,
+                            block_idx, points]() {
+        points->reserve(num_points_per_block[block_idx]);
+        for_each_point_in_block(block_idx, [points](const Point3D& point) {
+          points->emplace_back(point);
+        });
+      });
+    }
+  };
+  auto write_batch = [&](size_t batch_idx) {
+    const auto& batch_buffer = batch_buffers[batch_idx % 2];
+    const size_t batch_start = batch_idx * batch_size;
+    const size_t batch_end = std::min(batch_start + batch_size, blocks.size());
+    for (size_t block_idx = batch_start; block_idx < batch_end; ++block_idx) {
+      writePoints(ostream, batch_buffer[block_idx - batch_start]);
+    }
+  };
+  const size_t num_batches = (blocks.size() + batch_size - 1) / batch_size;
+  if (0 < num_batches) {
+    convert_batch(0);
+    thread_pool.wait_all();
+  }
+  for (size_t batch_idx = 0; batch_idx < num_batches; ++batch_idx) {
+    if (batch_idx + 1 < num_batches) {
+      convert_batch(batch_idx + 1);
+    }
+    write_batch(batch_idx);
+    thread_pool.wait_all();
+  }
+
+  return static_cast<bool>(ostream);
+}
+
+bool mapBaseToStream(const MapBase& map, std::ostream& ostream,
+                     const OccupiedPointcloudConfig& config,
+                     const std::optional<AABB<Point3D>>& region) {
+  ProfilerZoneScoped;
+  const FloatingPoint min_cell_width = map.getMinCellWidth();
+  const IndexElement output_height =
+      getOutputHeight(config, map.getTreeHeight());
+  auto for_each_point = [&](auto&& visitor_fn) {
+    map.forEachLeaf(
+        [&](const OctreeIndex& leaf_index, FloatingPoint log_odds) {
+          if (config.occupancy_threshold < log_odds) {
+            forEachPointInLeaf(leaf_index, output_height, min_cell_width,
+                               region, visitor_fn);
+          }
+        });
+  };
+
+  // Count the points, such that the header can be written first
+  size_t total_num_points = 0u;
+  for_each_point([&total_num_points](const Point3D&) { ++total_num_points; });
+  writeHeader(ostream, config.format, total_num_points,
+              convert::heightToCellWidth(min_cell_width, output_height));
+
+  // Write the points through a fixed size buffer
+  constexpr size_t kBufferSize = 1 << 16;
+  std::vector<Point3D> buffer;
+  buffer.reserve(kBufferSize);
+  for_each_point([&buffer, &ostream](const Point3D& point) {
+    buffer.emplace_back(point);
+    if (kBufferSize <= buffer.size()) {
+      writePoints(ostream, buffer);
+      buffer.clear();
+    }
+  });
+  writePoints(ostream, buffer);
+
+  return static_cast<bool>(ostream);
+}
+}  // namespace
+
+bool occupiedCellsToStream(const MapBase& map, std::ostream& ostream,
+                           const OccupiedPointcloudConfig& config,
+                           const std::optional<AABB<Point3D>>& region,
+                           std::shared_ptr<ThreadPool> thread_pool) {
+  if (!config.isValid(true)) {
+    return false;
+  }
+  if (!thread_pool) {
+    thread_pool = std::make_shared<ThreadPool>();
+  }
+
+  if (const auto* hashed_wavelet_octree =
+          dynamic_cast<const HashedWaveletOctree*>(&map);
+      hashed_wavelet_octree) {
+    return hashedMapToStream(*hashed_wavelet_octree, ostream, config, region,
+                             *thread_pool);
+  }
+  if (const auto* linear_hashed_wavelet_octree =
+          dynamic_cast<const LinearHashedWaveletOctree*>(&map);
+      linear_hashed_wavelet_octree) {
+    return hashedMapToStream(*linear_hashed_wavelet_octree, ostream, config,
+                             region, *thread_pool);
+  }
+  if (const auto* hashed_chunked_wavelet_octree =
+          dynamic_cast<const HashedChunkedWaveletOctree*>(&map);
+      hashed_chunked_wavelet_octree) {
+    return hashedMapToStream(*hashed_chunked_wavelet_octree, ostream, config,
+                             region, *thread_pool);
+  }
+  return mapBaseToStream(map, ostream, config, region);
+}
+
+bool occupiedCellsToFile(const MapBase& map,
+                         const std::filesystem::path& file_path,
+                         const OccupiedPointcloudConfig& config,
+                         const std::optional<AABB<Point3D>>& region,
+                         std::shared_ptr<ThreadPool> thread_pool) {
+  if (file_path.empty()) {
+    LOG(WARNING)
+        << "Could not open file for writing. Specified file path is empty.";
+    return false;
+  }
+
+  // Open the file for writing
+  std::ofstream file_ostream(file_path,
+                             std::ofstream::out | std::ofstream::binary);
+  if (!file_ostream.is_open()) {
+    LOG(WARNING) << "Could not open file " << file_path
+                 << " for writing. Error: " << strerror(errno);
+    return false;
+  }
+
+  // Write the pointcloud
+  if (!occupiedCellsToStream(map, file_ostream, config, region,
+                             std::move(thread_pool))) {
+    return false;
+  }
+
+  // Close the file and communicate whether writing succeeded
+  file_ostream.close();
+  return static_cast<bool>(file_ostream);
+}
+}  // namespace wavemap::io
@@ -0,0 +1,261 @@
+#include "wavemap/io/sliding_window_map.h"
+
+#include <algorithm>
+#include <stack>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <wavemap/core/indexing/index_conversions.h>
+#include <wavemap/core/utils/iterate/grid_iterator.h>
+#include <wavemap/core/utils/print/eigen.h>
+#include <wavemap/core/utils/profile/profiler_interface.h>
+#include <wavemap/core/utils/shape/intersection_tests.h>
+
+namespace wavemap::io {
+DECLARE_CONFIG_MEMBERS(SlidingWindowMapConfig,
+                      (radius)
+                      (memory_budget_in_mb)
+                      (storage_directory));
+
+bool SlidingWindowMapConfig::isValid(bool verbose) const {
+  bool is_valid = true;
+
+  is_valid &= IS_PARAM_GT(radius, 0.f, verbose);
+  is_valid &= IS_PARAM_GE(memory_budget_in_mb, 0, verbose);
+  is_valid &= IS_PARAM_NE(storage_directory, "", verbose);
+
+  return is_valid;
+}
+
+namespace {
+// Add the values of the source block to the destination block. Since the
+// wavelet transform is linear, this amounts to adding their coefficients.
+void addBlock(const HashedWaveletOctreeBlock& source,
+              HashedWaveletOctreeBlock& destination) {
+  using OctreeType = HashedWaveletOctreeBlock::OctreeType;
+  destination.getRootScale() += source.getRootScale();
+  std::stack<std::pair<OctreeType::NodeConstPtrType, OctreeType::NodePtrType>>
+      stack;
+  stack.emplace(&source.getRootNode(), &destination.getRootNode());
+  while (!stack.empty()) {
+    const auto [source_node, destination_node] = stack.top();
+    stack.pop();
+    destination_node->data() += source_node->data();
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      if (const auto* source_child = source_node->getChild(child_idx);
+          source_child) {
+        stack.emplace(source_child,
+                      &destination_node->getOrAllocateChild(child_idx));
+      }
+    }
+  }
+  destination.setNeedsThresholding();
+  destination.setNeedsPruning();
+  destination.setLastUpdatedStamp();
+}
+}  // namespace
+
+SlidingWindowMap::SlidingWindowMap(const SlidingWindowMapConfig& config,
+                                   HashedWaveletOctree::Ptr map)
+    : config_(config.checkValid()),
+      map_(std::move(CHECK_NOTNULL(map))),
+      block_store_(config_.storage_directory) {}
+
+void SlidingWindowMap::update(const Point3D& center) {
+  ProfilerZoneScoped;
+  // Page in the stored blocks that the window now covers
+  const auto& stored_block_indices = block_store_.getBlockIndices();
+  std::vector<Index3D> blocks_to_load;
+  std::copy_if(stored_block_indices.begin(), stored_block_indices.end(),
+               std::back_inserter(blocks_to_load),
+               [this, &center](const Index3D& block_index) {
+                 const FloatingPoint distance =
+                     getBlockAABB(block_index).minDistanceTo(center);
+                 return distance <= config_.radius &&
+                        (!budget_radius_ || distance < budget_radius_.value());
+               });
+  for (const Index3D& block_index : blocks_to_load) {
+    loadBlock(block_index);
+  }
+
+  // Evict the blocks outside the window
+  // NOTE: The blocks are only inspected through const references, such that
+  //       blocks shared with map snapshots are not copied.
+  std::vector<std::tuple<FloatingPoint, Index3D, size_t>> resident_blocks;
+  std::vector<Index3D> blocks_to_evict;
+  size_t memory_usage = 0u;
+  const bool has_budget = 0 < config_.memory_budget_in_mb;
+  std::as_const(*map_).forEachBlock(
+      [this, &center, &resident_blocks, &blocks_to_evict, &memory_usage,
+       has_budget](const Index3D& block_index,
+                   const HashedWaveletOctree::Block& block) {
+        const FloatingPoint distance =
+            getBlockAABB(block_index).minDistanceTo(center);
+        if (config_.radius < distance) {
+          blocks_to_evict.emplace_back(block_index);
+        } else if (has_budget) {
+          const size_t block_memory_usage = block.getMemoryUsage();
+          resident_blocks.emplace_back(distance, block_index,
+                                       block_memory_usage);
+          memory_usage += block_memory_usage;
+        }
+      });
+  for (const Index3D& block_index : blocks_to_evict) {
+    evictBlock(block_index);
+  }
+  if (!has_budget) {
+    return;
+  }
+
+  // Evict the furthest remaining blocks until the memory budget is met
+  const size_t memory_budget =
+      static_cast<size_t>(config_.memory_budget_in_mb) * 1024u * 1024u;
+  if (memory_usage <= memory_budget) {
+    // Only let the window grow back once there is enough headroom, to avoid
+    // alternately paging in and evicting the same blocks
+    if (memory_usage <= memory_budget / 4u * 3u) {
+      budget_radius_.reset();
+    }
+    return;
+  }
+  std::sort(resident_blocks.begin(), resident_blocks.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return std::get<0>(rhs) < std::get<0>(lhs);
+            });
+  for (const auto& [distance, block_index, block_memory_usage] :
+       resident_blocks) {
+    if (memory_usage <= memory_budget) {
+      break;
+    }
+    if (evictBlock(block_index)) {
+      memory_usage -= block_memory_usage;
+      budget_radius_ = distance;
+    }
+  }
+}
+
+void SlidingWindowMap::loadRegion(const AABB<Point3D>& region) {
+  ProfilerZoneScoped;
+  const FloatingPoint block_width = convert::heightToCellWidth(
+      map_->getMinCellWidth(), map_->getTreeHeight());
+  const auto [min_block_index, max_block_index] =
+      convert::aabbToBlockIndexRange(region, 1.f / block_width);
+  const auto range_widths = max_block_index.cast<double>().array() -
+                            min_block_index.cast<double>().array() + 1.0;
+  // Look the blocks up individually if the region is small compared to the
+  // store, and scan the store otherwise
+  std::vector<Index3D> blocks_to_load;
+  if (range_widths.prod() < static_cast<double>(block_store_.size())) {
+    for (const Index3D& block_index :
+         Grid<3>(min_block_index, max_block_index)) {
+      if (block_store_.hasBlock(block_index)) {
+        blocks_to_load.emplace_back(block_index);
+      }
+    }
+  } else {
+    for (const Index3D& block_index : block_store_.getBlockIndices()) {
+      if ((min_block_index.array() <= block_index.array() &&
+           block_index.array() <= max_block_index.array())
+              .all()) {
+        blocks_to_load.emplace_back(block_index);
+      }
+    }
+  }
+  for (const Index3D& block_index : blocks_to_load) {
+    if (shape::overlaps(getBlockAABB(block_index), region)) {
+      loadBlock(block_index);
+    }
+  }
+}
+
+void SlidingWindowMap::loadAll() {
+  ProfilerZoneScoped;
+  const std::vector<Index3D> blocks_to_load(
+      block_store_.getBlockIndices().begin(),
+      block_store_.getBlockIndices().end());
+  for (const Index3D& block_index : blocks_to_load) {
+    loadBlock(block_index);
+  }
+}
+
+FloatingPoint SlidingWindowMap::getCellValue(const Index3D& index) {
+  return getCellValue(OctreeIndex{0, index});
+}
+
+FloatingPoint SlidingWindowMap::getCellValue(const OctreeIndex& index) {
+  const Index3D block_index = map_->indexToBlockIndex(index);
+  if (block_store_.hasBlock(block_index)) {
+    loadBlock(block_index);
+  }
+  return map_->getCellValue(index);
+}
+
+bool SlidingWindowMap::loadBlock(const Index3D& block_index) {
+  ProfilerZoneScoped;
+  const auto& map_config = map_->getConfig();
+  if (map_->hasBlock(block_index)) {
+    // The block was reallocated since it was evicted, merge both versions
+    HashedWaveletOctree::Block stored_block(map_config.tree_height,
+                                            map_config.min_log_odds,
+                                            map_config.max_log_odds);
+    if (!block_store_.loadBlock(block_index, stored_block)) {
+      return false;
+    }
+    addBlock(stored_block, *map_->getBlock(block_index));
+  } else {
+    auto& block = map_->getOrAllocateBlock(block_index);
+    if (!block_store_.loadBlock(block_index, block)) {
+      map_->eraseBlock(block_index);
+      return false;
+    }
+    block.setLastUpdatedStamp();
+  }
+  return block_store_.eraseBlock(block_index);
+}
+
+bool SlidingWindowMap::evictBlock(const Index3D& block_index) {
+  ProfilerZoneScoped;
+  if (!map_->hasBlock(block_index)) {
+    return false;
+  }
+
+  // If the block was reallocated since it was last evicted, merge in the
+  // stored version first, such that storing the block does not overwrite it
+  if (block_store_.hasBlock(block_index) && !loadBlock(block_index)) {
+    LOG(WARNING) << "Could not merge block "
+                 << print::eigen::oneLine(block_index)
+                 << " with its stored version. Keeping it in memory.";
+    return false;
+  }
+
+  // Threshold the block first, since saturated subtrees are not stored
+  // NOTE: Write access is only requested if needed, to avoid copying blocks
+  //       that are shared with map snapshots.
+  const HashedWaveletOctree::Block* block =
+      std::as_const(*map_).getBlock(block_index);
+  if (!block) {
+    return false;
+  }
+  if (block->getNeedsThresholding()) {
+    HashedWaveletOctree::Block* mutable_block = map_->getBlock(block_index);
+    mutable_block->threshold();
+    block = mutable_block;
+  }
+  if (!block_store_.storeBlock(block_index, *block, map_->getMinLogOdds(),
+                               map_->getMaxLogOdds())) {
+    LOG(WARNING) << "Could not evict block "
+                 << print::eigen::oneLine(block_index)
+                 << ". Keeping it in memory.";
+    return false;
+  }
+  return map_->eraseBlock(block_index);
+}
+
+AABB<Point3D> SlidingWindowMap::getBlockAABB(const Index3D& block_index) const {
+  return convert::nodeIndexToAABB(
+      OctreeIndex{map_->getTreeHeight(), block_index},
+      map_->getMinCellWidth());
+}
+}  // namespace wavemap::io
@@ -3,8 +3,243 @@
 #include <algorithm>
 #include <memory>
 #include <stack>
+#include <type_traits>
 
 namespace wavemap::io {
+namespace {
+// Deserialize the octree nodes of a block whose header was already read
+template <typename BlockT>
+void streamToBlockNodes(std::istream& istream, BlockT& block) {
+  std::stack<typename BlockT::OctreeType::NodePtrType> stack;
+  stack.emplace(&block.getRootNode());
+  while (!stack.empty() && istream.good()) {
+    auto node = stack.top();
+    stack.pop();
+
+    // Deserialize the node's (wavelet) detail coefficients
+    const auto read_node = streamable::WaveletOctreeNode::read(istream);
+    std::copy(read_node.detail_coefficients.begin(),
+              read_node.detail_coefficients.end(), node->data().begin());
+
+    // Allocate the node's children
+    // NOTE: Allocating a child can move its siblings in linear octrees, so we
+    //       only look the children up once they have all been allocated.
+    for (int relative_child_idx = 0;
+         relative_child_idx < wavemap::OctreeIndex::kNumChildren;
+         ++relative_child_idx) {
+      if (bit_ops::is_bit_set(read_node.allocated_children_bitset,
+                              relative_child_idx)) {
+        node->getOrAllocateChild(relative_child_idx);
+      }
+    }
+
+    // Evaluate which of the node's children are coming next
+    // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
+    //       the nodes are popped from the stack in increasing order.
+    for (int relative_child_idx = wavemap::OctreeIndex::kNumChildren - 1;
+         0 <= relative_child_idx; --relative_child_idx) {
+      const bool child_exists = bit_ops::is_bit_set(
+          read_node.allocated_children_bitset, relative_child_idx);
+      if (child_exists) {
+        stack.emplace(node->getChild(relative_child_idx));
+      }
+    }
+  }
+
+  // Blocks whose coefficient storage compresses them are only compressed once
+  // they are pruned, so we prune them directly to store them compactly
+  if constexpr (BlockT::CoefficientStorage::kMayCompress) {
+    block.setNeedsPruning();
+    block.prune();
+  }
+}
+
+template <typename MapT>
+bool hashedWaveletOctreeToStream(const MapT& map, std::ostream& ostream) {
+  // Check if the output stream can be written to
+  if (!ostream.good()) {
+    return false;
+  }
+
+  // Indicate the map's data structure type
+  streamable::StorageFormat storage_format =
+      streamable::StorageFormat::kHashedWaveletOctree;
+  storage_format.write(ostream);
+
+  // Serialize the map and data structure's metadata
+  streamable::HashedWaveletOctreeHeader hashed_wavelet_octree_header;
+  hashed_wavelet_octree_header.min_cell_width = map.getMinCellWidth();
+  hashed_wavelet_octree_header.min_log_odds = map.getMinLogOdds();
+  hashed_wavelet_octree_header.max_log_odds = map.getMaxLogOdds();
+  hashed_wavelet_octree_header.tree_height = map.getTreeHeight();
+  hashed_wavelet_octree_header.num_blocks = map.getHashMap().size();
+  hashed_wavelet_octree_header.write(ostream);
+
+  // Iterate over all the map's blocks
+  map.forEachBlock([&ostream, min_log_odds = map.getMinLogOdds(),
+                    max_log_odds = map.getMaxLogOdds()](
+                       const Index3D& block_index, const auto& block) {
+    // Stop if any writing errors occurred
+    if (!ostream.good()) {
+      return;
+    }
+    blockToStream(block_index, block, min_log_odds, max_log_odds, ostream);
+  });
+
+  // Return true if no write errors occurred
+  return ostream.good();
+}
+
+template <typename MapT>
+bool streamToHashedWaveletOctree(std::istream& istream,
+                                 typename MapT::Ptr& map) {
+  // Check if the input stream can be read from
+  if (!istream.good()) {
+    return false;
+  }
+
+  // Make sure the map in the input stream is of the correct type
+  if (streamable::StorageFormat::read(istream) !=
+      streamable::StorageFormat::kHashedWaveletOctree) {
+    return false;
+  }
+
+  // Deserialize the map's config and initialize the data structure
+  const auto hashed_wavelet_octree_header =
+      streamable::HashedWaveletOctreeHeader::read(istream);
+  HashedWaveletOctreeConfig config;
+  config.min_cell_width = hashed_wavelet_octree_header.min_cell_width;
+  config.min_log_odds = hashed_wavelet_octree_header.min_log_odds;
+  config.max_log_odds = hashed_wavelet_octree_header.max_log_odds;
+  config.tree_height = hashed_wavelet_octree_header.tree_height;
+  map = std::make_shared<MapT>(config);
+
+  // Deserialize all the blocks
+  for (size_t block_idx = 0;
+       block_idx < hashed_wavelet_octree_header.num_blocks; ++block_idx) {
+    // Stop if any reading errors occurred
+    if (!istream.good()) {
+      return false;
+    }
+
+    // Deserialize the block header, containing its position and scale coeff.
+    const auto block_header =
+        streamable::HashedWaveletOctreeBlockHeader::read(istream);
+    const Index3D block_index{block_header.root_node_offset.x,
+                              block_header.root_node_offset.y,
+                              block_header.root_node_offset.z};
+    auto& block = map->getOrAllocateBlock(block_index);
+    // Wavelet scale coefficient of the block's root node
+    block.getRootScale() = block_header.root_node_scale_coefficient;
+
+    // Deserialize the block's remaining data into octree nodes
+    streamToBlockNodes(istream, block);
+  }
+
+  // Return true if no read errors occurred
+  return istream.good();
+}
+
+template <typename BlockT>
+bool hashedWaveletOctreeBlockToStream(const Index3D& block_index,
+                                      const BlockT& block,
+                                      FloatingPoint min_log_odds,
+                                      FloatingPoint max_log_odds,
+                                      std::ostream& ostream) {
+  // Check if the output stream can be written to
+  if (!ostream.good()) {
+    return false;
+  }
+
+  // Define convenience constants
+  constexpr FloatingPoint kNumericalNoise = 1e-3f;
+  min_log_odds += kNumericalNoise;
+  max_log_odds -= kNumericalNoise;
+
+  // Serialize the block's metadata
+  streamable::HashedWaveletOctreeBlockHeader block_header;
+  block_header.root_node_offset = {block_index.x(), block_index.y(),
+                                   block_index.z()};
+  // Wavelet scale coefficient of the block's root node
+  block_header.root_node_scale_coefficient = block.getRootScale();
+  block_header.write(ostream);
+
+  // Serialize the block's data (all nodes of its octree)
+  // NOTE: Blocks whose coefficients are stored in compressed form are
+  //       serialized at full precision.
+  block.visitOctree([&](const auto& octree, auto load_details) {
+    using NodeConstRefType =
+        typename std::decay_t<decltype(octree)>::NodeConstRefType;
+    struct StackElement {
+      const FloatingPoint scale;
+      NodeConstRefType node;
+    };
+    std::stack<StackElement> stack;
+    stack.emplace(StackElement{block.getRootScale(), octree.getRootNode()});
+    while (!stack.empty()) {
+      const FloatingPoint scale = stack.top().scale;
+      NodeConstRefType node = stack.top().node;
+      stack.pop();
+
+      // Serialize the node's data
+      const auto& details = load_details(node.data());
+      streamable::WaveletOctreeNode streamable_node;
+      std::copy(details.begin(), details.end(),
+                streamable_node.detail_coefficients.begin());
+
+      // Evaluate which of its children should be serialized
+      const auto child_scales = BlockT::Transform::backward({scale, details});
+      // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
+      //       the nodes are popped from the stack in increasing order.
+      for (int relative_child_idx = OctreeIndex::kNumChildren - 1;
+           0 <= relative_child_idx; --relative_child_idx) {
+        // If the child is saturated, we don't need to store its descendants
+        const auto child_scale = child_scales[relative_child_idx];
+        if (child_scale < min_log_odds || max_log_odds < child_scale) {
+          continue;
+        }
+        // Otherwise, indicate that the child will be serialized
+        // and add it to the stack
+        const auto child = node.getChild(relative_child_idx);
+        if (child) {
+          stack.emplace(StackElement{child_scale, *child});
+          streamable_node.allocated_children_bitset +=
+              (1 << relative_child_idx);
+        }
+      }
+      streamable_node.write(ostream);
+    }
+  });
+
+  // Return true if no write errors occurred
+  return ostream.good();
+}
+
+template <typename BlockT>
+bool streamToHashedWaveletOctreeBlock(std::istream& istream,
+                                      Index3D& block_index, BlockT& block) {
+  // Check if the input stream can be read from
+  if (!istream.good()) {
+    return false;
+  }
+
+  // Deserialize the block header, containing its position and scale coeff.
+  const auto block_header =
+      streamable::HashedWaveletOctreeBlockHeader::read(istream);
+  block_index = {block_header.root_node_offset.x,
+                 block_header.root_node_offset.y,
+                 block_header.root_node_offset.z};
+  // Wavelet scale coefficient of the block's root node
+  block.getRootScale() = block_header.root_node_scale_coefficient;
+
+  // Deserialize the block's remaining data into octree nodes
+  streamToBlockNodes(istream, block);
+
+  // Return true if no read errors occurred
+  return istream.good();
+}
+}  // namespace
+
 bool mapToStream(const MapBase& map, std::ostream& ostream) {
   // Call the appropriate mapToStream converter based on the map's derived type
   if (const auto* hashed_blocks = dynamic_cast<const HashedBlocks*>(&map);
@@ -20,6 +255,16 @@ bool mapToStream(const MapBase& map, std::ostream& ostream) {
       hashed_wavelet_octree) {
     return io::mapToStream(*hashed_wavelet_octree, ostream);
   }
+  if (const auto* linear_hashed_wavelet_octree =
+          dynamic_cast<const LinearHashedWaveletOctree*>(&map);
+      linear_hashed_wavelet_octree) {
+    return io::mapToStream(*linear_hashed_wavelet_octree, ostream);
+  }
+  if (const auto* quantized_hashed_wavelet_octree =
+          dynamic_cast<const QuantizedHashedWaveletOctree*>(&map);
+      quantized_hashed_wavelet_octree) {
+    return io::mapToStream(*quantized_hashed_wavelet_octree, ostream);
+  }
   if (const auto* hashed_chunked_wavelet_octree =
           dynamic_cast<const HashedChunkedWaveletOctree*>(&map);
       hashed_chunked_wavelet_octree) {
@@ -57,6 +302,24 @@ bool streamToMap(std::istream& istream, MapBase::Ptr& map) {
       return true;
     }
     case streamable::StorageFormat::kHashedWaveletOctree: {
+      if (auto linear_hashed_wavelet_octree =
+              std::dynamic_pointer_cast<LinearHashedWaveletOctree>(map);
+          linear_hashed_wavelet_octree) {
+        if (!streamToMap(istream, linear_hashed_wavelet_octree)) {
+          return false;
+        }
+        map = linear_hashed_wavelet_octree;
+        return true;
+      }
+      if (auto quantized_hashed_wavelet_octree =
+              std::dynamic_pointer_cast<QuantizedHashedWaveletOctree>(map);
+          quantized_hashed_wavelet_octree) {
+        if (!streamToMap(istream, quantized_hashed_wavelet_octree)) {
+          return false;
+        }
+        map = quantized_hashed_wavelet_octree;
+        return true;
+      }
       auto hashed_wavelet_octree =
           std::dynamic_pointer_cast<HashedWaveletOctree>(map);
       if (!streamToMap(istream, hashed_wavelet_octree)) {
@@ -267,160 +530,69 @@ bool streamToMap(std::istream& istream, WaveletOctree::Ptr& map) {
 }
 
 bool mapToStream(const HashedWaveletOctree& map, std::ostream& ostream) {
-  // Check if the output stream can be written to
-  if (!ostream.good()) {
-    return false;
-  }
-
-  // Define convenience types and constants
-  struct StackElement {
-    const FloatingPoint scale;
-    HashedWaveletOctreeBlock::OctreeType::NodeConstRefType node;
-  };
-  constexpr FloatingPoint kNumericalNoise = 1e-3f;
-  const auto min_log_odds = map.getMinLogOdds() + kNumericalNoise;
-  const auto max_log_odds = map.getMaxLogOdds() - kNumericalNoise;
-
-  // Indicate the map's data structure type
-  streamable::StorageFormat storage_format =
-      streamable::StorageFormat::kHashedWaveletOctree;
-  storage_format.write(ostream);
-
-  // Serialize the map and data structure's metadata
-  streamable::HashedWaveletOctreeHeader hashed_wavelet_octree_header;
-  hashed_wavelet_octree_header.min_cell_width = map.getMinCellWidth();
-  hashed_wavelet_octree_header.min_log_odds = map.getMinLogOdds();
-  hashed_wavelet_octree_header.max_log_odds = map.getMaxLogOdds();
-  hashed_wavelet_octree_header.tree_height = map.getTreeHeight();
-  hashed_wavelet_octree_header.num_blocks = map.getHashMap().size();
-  hashed_wavelet_octree_header.write(ostream);
-
-  // Iterate over all the map's blocks
-  map.forEachBlock([&ostream, min_log_odds, max_log_odds](
-                       const Index3D& block_index, const auto& block) {
-    // Stop if any writing errors occurred
-    if (!ostream.good()) {
-      return;
-    }
-
-    // Serialize the block's metadata
-    streamable::HashedWaveletOctreeBlockHeader block_header;
-    block_header.root_node_offset = {block_index.x(), block_index.y(),
-                                     block_index.z()};
-    // Wavelet scale coefficient of the block's root node
-    block_header.root_node_scale_coefficient = block.getRootScale();
-    block_header.write(ostream);
-
-    // Serialize the block's data (all nodes of its octree)
-    std::stack<StackElement> stack;
-    stack.emplace(StackElement{block.getRootScale(), block.getRootNode()});
-    while (!stack.empty()) {
-      const FloatingPoint scale = stack.top().scale;
-      const auto& node = stack.top().node;
-      stack.pop();
-
-      // Serialize the node's data
-      streamable::WaveletOctreeNode streamable_node;
-      std::copy(node.data().begin(), node.data().end(),
-                streamable_node.detail_coefficients.begin());
+  return hashedWaveletOctreeToStream(map, ostream);
+}
 
-      // Evaluate which of its children should be serialized
-      const auto child_scales =
-          HashedWaveletOctreeBlock::Transform::backward({scale, node.data()});
-      // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
-      //       the nodes are popped from the stack in increasing order.
-      for (int relative_child_idx = OctreeIndex::kNumChildren - 1;
-           0 <= relative_child_idx; --relative_child_idx) {
-        // If the child is saturated, we don't need to store its descendants
-        const auto child_scale = child_scales[relative_child_idx];
-        if (child_scale < min_log_odds || max_log_odds < child_scale) {
-          continue;
-        }
-        // Otherwise, indicate that the child will be serialized
-        // and add it to the stack
-        const auto* child = node.getChild(relative_child_idx);
-        if (child) {
-          stack.emplace(StackElement{child_scale, *child});
-          streamable_node.allocated_children_bitset +=
-              (1 << relative_child_idx);
-        }
-      }
-      streamable_node.write(ostream);
-    }
-  });
+bool streamToMap(std::istream& istream, HashedWaveletOctree::Ptr& map) {
+  return streamToHashedWaveletOctree<HashedWaveletOctree>(istream, map);
+}
 
-  // Return true if no write errors occurred
-  return ostream.good();
+bool mapToStream(const LinearHashedWaveletOctree& map, std::ostream& ostream) {
+  return hashedWaveletOctreeToStream(map, ostream);
 }
 
-bool streamToMap(std::istream& istream, HashedWaveletOctree::Ptr& map) {
-  // Check if the input stream can be read from
-  if (!istream.good()) {
-    return false;
-  }
+bool streamToMap(std::istream& istream, LinearHashedWaveletOctree::Ptr& map) {
+  return streamToHashedWaveletOctree<LinearHashedWaveletOctree>(istream, map);
+}
 
-  // Make sure the map in the input stream is of the correct type
-  if (streamable::StorageFormat::read(istream) !=
-      streamable::StorageFormat::kHashedWaveletOctree) {
-    return false;
-  }
+bool mapToStream(const QuantizedHashedWaveletOctree& map,
+                 std::ostream& ostream) {
+  return hashedWaveletOctreeToStream(map, ostream);
+}
 
-  // Deserialize the map's config and initialize the data structure
-  const auto hashed_wavelet_octree_header =
-      streamable::HashedWaveletOctreeHeader::read(istream);
-  HashedWaveletOctreeConfig config;
-  config.min_cell_width = hashed_wavelet_octree_header.min_cell_width;
-  config.min_log_odds = hashed_wavelet_octree_header.min_log_odds;
-  config.max_log_odds = hashed_wavelet_octree_header.max_log_odds;
-  config.tree_height = hashed_wavelet_octree_header.tree_height;
-  map = std::make_shared<HashedWaveletOctree>(config);
+bool streamToMap(std::istream& istream,
+                 QuantizedHashedWaveletOctree::Ptr& map) {
+  return streamToHashedWaveletOctree<QuantizedHashedWaveletOctree>(istream,
+                                                                   map);
+}
 
-  // Deserialize all the blocks
-  for (size_t block_idx = 0;
-       block_idx < hashed_wavelet_octree_header.num_blocks; ++block_idx) {
-    // Stop if any reading errors occurred
-    if (!istream.good()) {
-      return false;
-    }
+bool blockToStream(const Index3D& block_index,
+                   const HashedWaveletOctreeBlock& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   std::ostream& ostream) {
+  return hashedWaveletOctreeBlockToStream(block_index, block, min_log_odds,
+                                          max_log_odds, ostream);
+}
 
-    // Deserialize the block header, containing its position and scale coeff.
-    const auto block_header =
-        streamable::HashedWaveletOctreeBlockHeader::read(istream);
-    const Index3D block_index{block_header.root_node_offset.x,
-                              block_header.root_node_offset.y,
-                              block_header.root_node_offset.z};
-    auto& block = map->getOrAllocateBlock(block_index);
-    // Wavelet scale coefficient of the block's root node
-    block.getRootScale() = block_header.root_node_scale_coefficient;
+bool streamToBlock(std::istream& istream, Index3D& block_index,
+                   HashedWaveletOctreeBlock& block) {
+  return streamToHashedWaveletOctreeBlock(istream, block_index, block);
+}
 
-    // Deserialize the block's remaining data into octree nodes
-    std::stack<WaveletOctree::NodeType*> stack;
-    stack.emplace(&block.getRootNode());
-    while (!stack.empty()) {
-      WaveletOctree::NodeType* node = stack.top();
-      stack.pop();
+bool blockToStream(const Index3D& block_index,
+                   const LinearHashedWaveletOctreeBlock& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   std::ostream& ostream) {
+  return hashedWaveletOctreeBlockToStream(block_index, block, min_log_odds,
+                                          max_log_odds, ostream);
+}
 
-      // Deserialize the node's (wavelet) detail coefficients
-      const auto read_node = streamable::WaveletOctreeNode::read(istream);
-      std::copy(read_node.detail_coefficients.begin(),
-                read_node.detail_coefficients.end(), node->data().begin());
+bool streamToBlock(std::istream& istream, Index3D& block_index,
+                   LinearHashedWaveletOctreeBlock& block) {
+  return streamToHashedWaveletOctreeBlock(istream, block_index, block);
+}
 
-      // Evaluate which of the node's children are coming next
-      // NOTE: We iterate and add nodes to the stack in decreasing order s.t.
-      //       the nodes are popped from the stack in increasing order.
-      for (int relative_child_idx = wavemap::OctreeIndex::kNumChildren - 1;
-           0 <= relative_child_idx; --relative_child_idx) {
-        const bool child_exists = bit_ops::is_bit_set(
-            read_node.allocated_children_bitset, relative_child_idx);
-        if (child_exists) {
-          stack.emplace(&node->getOrAllocateChild(relative_child_idx));
-        }
-      }
-    }
-  }
+bool blockToStream(const Index3D& block_index,
+                   const QuantizedHashedWaveletOctreeBlock& block,
+                   FloatingPoint min_log_odds, FloatingPoint max_log_odds,
+                   std::ostream& ostream) {
+  return hashedWaveletOctreeBlockToStream(block_index, block, min_log_odds,
+                                          max_log_odds, ostream);
+}
 
-  // Return true if no read errors occurred
-  return istream.good();
+bool streamToBlock(std::istream& istream, Index3D& block_index,
+                   QuantizedHashedWaveletOctreeBlock& block) {
+  return streamToHashedWaveletOctreeBlock(istream, block_index, block);
 }
 
 bool mapToStream(const HashedChunkedWaveletOctree& map, std::ostream& ostream) {
@@ -0,0 +1,88 @@
+#include "wavemap/pipeline/map_operations/coarsen_map_operation.h"
+
+#include <memory>
+
+#include <glog/logging.h>
+
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/coarsen.h"
+#include "wavemap/core/utils/profile/metrics.h"
+
+namespace wavemap {
+namespace {
+template <typename MapT>
+void coarsen(MapT& map, const CoarsenMapOperationConfig& config,
+             const std::shared_ptr<ThreadPool>& thread_pool) {
+  const Point3D center = edit::getMostRecentlyUpdatedBlockCenter(map);
+  edit::coarsen(map, config.termination_height, center, config.radius,
+                config.max_block_age, thread_pool);
+}
+}  // namespace
+
+DECLARE_CONFIG_MEMBERS(CoarsenMapOperationConfig,
+                      (once_every)
+                      (termination_height)
+                      (radius)
+                      (max_block_age));
+
+bool CoarsenMapOperationConfig::isValid(bool verbose) const {
+  bool is_valid = true;
+
+  is_valid &= IS_PARAM_GT(once_every, 0.f, verbose);
+  is_valid &= IS_PARAM_GT(termination_height, 0, verbose);
+  is_valid &= IS_PARAM_GE(radius, 0.f, verbose);
+  is_valid &= IS_PARAM_GE(max_block_age, 0.f, verbose);
+  is_valid &= IS_PARAM_TRUE(0.f < radius || 0.f < max_block_age, verbose);
+
+  return is_valid;
+}
+
+bool CoarsenMapOperation::shouldRun(const Timestamp& current_time) {
+  return config_.once_every <
+         time::to_seconds<FloatingPoint>(current_time - last_run_timestamp_);
+}
+
+void CoarsenMapOperation::run(bool force_run) {
+  const Timestamp current_time = Time::now();
+  if (!force_run && !shouldRun(current_time)) {
+    return;
+  }
+  last_run_timestamp_ = current_time;
+
+  // If the map is empty, there's no work to do
+  if (occupancy_map_->empty()) {
+    return;
+  }
+
+  static auto& coarsening_time =
+      metrics::getHistogram("map_coarsening_seconds");
+  metrics::ScopedTimer coarsening_timer(coarsening_time);
+  if (auto* hashed_wavelet_octree =
+          dynamic_cast<HashedWaveletOctree*>(occupancy_map_.get());
+      hashed_wavelet_octree) {
+    coarsen(*hashed_wavelet_octree, config_, thread_pool_);
+  } else if (auto* hashed_chunked_wavelet_octree =
+                 dynamic_cast<HashedChunkedWaveletOctree*>(
+                     occupancy_map_.get());
+             hashed_chunked_wavelet_octree) {
+    coarsen(*hashed_chunked_wavelet_octree, config_, thread_pool_);
+  } else if (auto* linear_hashed_wavelet_octree =
+                 dynamic_cast<LinearHashedWaveletOctree*>(
+                     occupancy_map_.get());
+             linear_hashed_wavelet_octree) {
+    coarsen(*linear_hashed_wavelet_octree, config_, thread_pool_);
+  } else if (auto* quantized_hashed_wavelet_octree =
+                 dynamic_cast<QuantizedHashedWaveletOctree*>(
+                     occupancy_map_.get());
+             quantized_hashed_wavelet_octree) {
+    coarsen(*quantized_hashed_wavelet_octree, config_, thread_pool_);
+  } else {
+    LOG_FIRST_N(WARNING, 1)
+        << "Map coarsening is only supported for hashed wavelet octrees and "
+           "hashed chunked wavelet octrees.";
+  }
+}
+}  // namespace wavemap
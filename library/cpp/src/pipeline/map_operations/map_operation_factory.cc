@@ -3,14 +3,18 @@
 #include <memory>
 #include <utility>
 
+#include "wavemap/pipeline/map_operations/coarsen_map_operation.h"
+#include "wavemap/pipeline/map_operations/memory_budget_map_operation.h"
 #include "wavemap/pipeline/map_operations/prune_map_operation.h"
 #include "wavemap/pipeline/map_operations/threshold_map_operation.h"
 
 namespace wavemap {
 std::unique_ptr<MapOperationBase> MapOperationFactory::create(
-    const param::Value& params, MapBase::Ptr occupancy_map) {
+    const param::Value& params, MapBase::Ptr occupancy_map,
+    std::shared_ptr<ThreadPool> thread_pool) {
   if (const auto type = MapOperationType::from(params); type) {
-    return create(type.value(), params, std::move(occupancy_map));
+    return create(type.value(), params, std::move(occupancy_map),
+                  std::move(thread_pool));
   }
 
   LOG(ERROR) << "Could not create map operation. Returning nullptr.";
@@ -19,7 +23,7 @@ std::unique_ptr<MapOperationBase> MapOperationFactory::create(
 
 std::unique_ptr<MapOperationBase> MapOperationFactory::create(
     MapOperationType operation_type, const param::Value& params,
-    MapBase::Ptr occupancy_map) {
+    MapBase::Ptr occupancy_map, std::shared_ptr<ThreadPool> thread_pool) {
   if (!operation_type.isValid()) {
     LOG(ERROR) << "Received request to create map operation with invalid type.";
     return nullptr;
@@ -44,6 +48,25 @@ std::unique_ptr<MapOperationBase> MapOperationFactory::create(
         LOG(ERROR) << "Prune map operation config could not be loaded.";
         return nullptr;
       }
+    case MapOperationType::kEnforceMemoryBudget:
+      if (const auto config = MemoryBudgetMapOperationConfig::from(params);
+          config) {
+        return std::make_unique<MemoryBudgetMapOperation>(
+            config.value(), std::move(occupancy_map));
+      } else {
+        LOG(ERROR) << "Memory budget map operation config could not be "
+                      "loaded.";
+        return nullptr;
+      }
+    case MapOperationType::kCoarsenMap:
+      if (const auto config = CoarsenMapOperationConfig::from(params);
+          config) {
+        return std::make_unique<CoarsenMapOperation>(
+            config.value(), std::move(occupancy_map), std::move(thread_pool));
+      } else {
+        LOG(ERROR) << "Coarsen map operation config could not be loaded.";
+        return nullptr;
+      }
   }
 
   LOG(ERROR) << "Factory does not (yet) support creation of map operation type "
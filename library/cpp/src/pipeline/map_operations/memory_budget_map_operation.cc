@@ -0,0 +1,93 @@
+#include "wavemap/pipeline/map_operations/memory_budget_map_operation.h"
+
+#include <memory>
+
+#include <glog/logging.h>
+
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/coarsen.h"
+#include "wavemap/core/utils/edit/enforce_memory_budget.h"
+#include "wavemap/core/utils/profile/metrics.h"
+
+namespace wavemap {
+namespace {
+template <typename MapT>
+size_t enforceMemoryBudget(MapT& map,
+                           const MemoryBudgetMapOperationConfig& config) {
+  const size_t memory_budget =
+      static_cast<size_t>(config.memory_budget_in_mb) * 1024u * 1024u;
+  const Point3D focus_point = edit::getMostRecentlyUpdatedBlockCenter(map);
+  return edit::enforceMemoryBudget(map, memory_budget, focus_point,
+                                   config.max_coarsening_height,
+                                   config.allow_block_eviction);
+}
+}  // namespace
+
+DECLARE_CONFIG_MEMBERS(MemoryBudgetMapOperationConfig,
+                      (once_every)
+                      (memory_budget_in_mb)
+                      (max_coarsening_height)
+                      (allow_block_eviction));
+
+bool MemoryBudgetMapOperationConfig::isValid(bool verbose) const {
+  bool is_valid = true;
+
+  is_valid &= IS_PARAM_GT(once_every, 0.f, verbose);
+  is_valid &= IS_PARAM_GT(memory_budget_in_mb, 0, verbose);
+  is_valid &= IS_PARAM_GE(max_coarsening_height, 0, verbose);
+
+  return is_valid;
+}
+
+bool MemoryBudgetMapOperation::shouldRun(const Timestamp& current_time) {
+  return config_.once_every <
+         time::to_seconds<FloatingPoint>(current_time - last_run_timestamp_);
+}
+
+void MemoryBudgetMapOperation::run(bool force_run) {
+  const Timestamp current_time = Time::now();
+  if (!force_run && !shouldRun(current_time)) {
+    return;
+  }
+
+  static auto& enforcement_time =
+      metrics::getHistogram("map_memory_budget_seconds");
+  static auto& memory_usage = metrics::getGauge("map_memory_usage_bytes");
+  metrics::ScopedTimer enforcement_timer(enforcement_time);
+  if (auto hashed_wavelet_octree =
+          std::dynamic_pointer_cast<HashedWaveletOctree>(occupancy_map_);
+      hashed_wavelet_octree) {
+    memory_usage.set(static_cast<double>(
+        enforceMemoryBudget(*hashed_wavelet_octree, config_)));
+  } else if (auto hashed_chunked_wavelet_octree =
+                 std::dynamic_pointer_cast<HashedChunkedWaveletOctree>(
+                     occupancy_map_);
+             hashed_chunked_wavelet_octree) {
+    memory_usage.set(static_cast<double>(
+        enforceMemoryBudget(*hashed_chunked_wavelet_octree, config_)));
+  } else if (auto linear_hashed_wavelet_octree =
+                 std::dynamic_pointer_cast<LinearHashedWaveletOctree>(
+                     occupancy_map_);
+             linear_hashed_wavelet_octree) {
+    memory_usage.set(static_cast<double>(
+        enforceMemoryBudget(*linear_hashed_wavelet_octree, config_)));
+  } else if (auto quantized_hashed_wavelet_octree =
+                 std::dynamic_pointer_cast<QuantizedHashedWaveletOctree>(
+                     occupancy_map_);
+             quantized_hashed_wavelet_octree) {
+    memory_usage.set(static_cast<double>(
+        enforceMemoryBudget(*quantized_hashed_wavelet_octree, config_)));
+  } else {
+    LOG_FIRST_N(WARNING, 1)
+        << "Coarsening and evicting blocks to meet the memory budget is only "
+           "supported for hashed (chunked) wavelet octrees. The map will only "
+           "be pruned.";
+    occupancy_map_->prune();
+    memory_usage.set(static_cast<double>(occupancy_map_->getMemoryUsage()));
+  }
+  last_run_timestamp_ = current_time;
+}
+}  // namespace wavemap
@@ -1,5 +1,7 @@
 #include "wavemap/pipeline/map_operations/prune_map_operation.h"
 
+#include <wavemap/core/utils/profile/metrics.h>
+
 namespace wavemap {
 DECLARE_CONFIG_MEMBERS(PruneMapOperationConfig,
                       (once_every));
@@ -16,7 +18,15 @@ bool PruneMapOperation::shouldRun(const Timestamp& current_time) {
 void PruneMapOperation::run(bool force_run) {
   const Timestamp current_time = Time::now();
   if (force_run || shouldRun(current_time)) {
-    occupancy_map_->pruneSmart();
+    static auto& pruning_time = metrics::getHistogram("map_pruning_seconds");
+    static auto& memory_usage = metrics::getGauge("map_memory_usage_bytes");
+    {
+      metrics::ScopedTimer pruning_timer(pruning_time);
+      occupancy_map_->pruneSmart();
+    }
+    // NOTE: Computing the memory usage requires traversing all blocks, so it
+    //       is only refreshed after pruning.
+    memory_usage.set(static_cast<double>(occupancy_map_->getMemoryUsage()));
     last_run_timestamp_ = current_time;
   }
 }
@@ -1,5 +1,7 @@
 #include "wavemap/pipeline/map_operations/threshold_map_operation.h"
 
+#include <wavemap/core/utils/profile/metrics.h>
+
 namespace wavemap {
 DECLARE_CONFIG_MEMBERS(ThresholdMapOperationConfig,
                       (once_every));
@@ -16,6 +18,9 @@ bool ThresholdMapOperation::shouldRun(const Timestamp& current_time) {
 void ThresholdMapOperation::run(bool force_run) {
   const Timestamp current_time = Time::now();
   if (force_run || shouldRun(current_time)) {
+    static auto& thresholding_time =
+        metrics::getHistogram("map_thresholding_seconds");
+    metrics::ScopedTimer thresholding_timer(thresholding_time);
     occupancy_map_->threshold();
     last_run_timestamp_ = current_time;
   }
@@ -54,8 +54,8 @@ IntegratorBase* Pipeline::addIntegrator(
 }
 
 MapOperationBase* Pipeline::addOperation(const param::Value& operation_params) {
-  auto operation_handler =
-      MapOperationFactory::create(operation_params, occupancy_map_);
+  auto operation_handler = MapOperationFactory::create(
+      operation_params, occupancy_map_, thread_pool_);
   return addOperation(std::move(operation_handler));
 }
 
@@ -66,6 +66,9 @@ MapOperationBase* Pipeline::addOperation(
 }
 
 void Pipeline::runOperations(bool force_run_all) {
+  static auto& operations_time =
+      metrics::getHistogram("pipeline_operations_seconds");
+  metrics::ScopedTimer operations_timer(operations_time);
   for (auto& operation : operations_) {
     operation->run(force_run_all);
   }
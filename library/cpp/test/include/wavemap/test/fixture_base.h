@@ -1,6 +1,8 @@
 #ifndef WAVEMAP_TEST_FIXTURE_BASE_H_
 #define WAVEMAP_TEST_FIXTURE_BASE_H_
 
+#include <cstdlib>
+
 #include <gtest/gtest.h>
 
 #include "wavemap/core/common.h"
@@ -12,6 +14,9 @@ class FixtureBase : public ::testing::Test {
   void SetUp() override {
     constexpr size_t kFixedRandomSeed = 0u;
     random_number_generator_ = RandomNumberGenerator(kFixedRandomSeed);
+    // Eigen's Random() draws from the global std::rand(), which is also
+    // reseeded such that tests do not depend on which tests ran before them
+    std::srand(kFixedRandomSeed);
   }
 
   template <typename T = int>
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/shape/capsule.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class CapsuleTest : public FixtureBase, public GeometryGenerator {
+ protected:
+  Capsule<Point3D> getRandomCapsule() {
+    const Point3D start = getRandomPoint<3>(0.f, 10.f);
+    // Also cover capsules that degenerate to spheres
+    const Point3D end = getRandomInteger(0, 9) == 0
+                            ? start
+                            : Point3D{getRandomPoint<3>(0.f, 10.f)};
+    return {start, end, getRandomSignedDistance(0.1f, 3.f)};
+  }
+
+  AABB<Point3D> getRandomAabb() {
+    const Point3D corner_a = getRandomPoint<3>(0.f, 10.f);
+    const Point3D corner_b = getRandomPoint<3>(0.f, 10.f);
+    return {corner_a.cwiseMin(corner_b), corner_a.cwiseMax(corner_b)};
+  }
+
+  Point3D getRandomPointInCapsule(const Capsule<Point3D>& capsule) {
+    const FloatingPoint t = getRandomFloat(0.f, 1.f);
+    const Point3D point_on_axis =
+        capsule.start + t * (capsule.end - capsule.start);
+    const Vector3D direction = getRandomPoint<3>(0.1f, 1.f).normalized();
+    return point_on_axis +
+           getRandomFloat(0.f, capsule.radius * 0.999f) * direction;
+  }
+
+  // Approximate the distance from the capsule's axis to the AABB by densely
+  // sampling the axis
+  static FloatingPoint approximateAxisDistance(const Capsule<Point3D>& capsule,
+                                               const AABB<Point3D>& aabb) {
+    constexpr int kNumSamples = 1000;
+    FloatingPoint min_distance = std::numeric_limits<FloatingPoint>::max();
+    for (int sample_idx = 0; sample_idx <= kNumSamples; ++sample_idx) {
+      const FloatingPoint t = static_cast<FloatingPoint>(sample_idx) /
+                              static_cast<FloatingPoint>(kNumSamples);
+      const Point3D point =
+          capsule.start + t * (capsule.end - capsule.start);
+      min_distance = std::min(min_distance, aabb.minDistanceTo(point));
+    }
+    return min_distance;
+  }
+};
+
+TEST_F(CapsuleTest, ContainmentAndBoundingBox) {
+  constexpr int kNumRepetitions = 100;
+  constexpr FloatingPoint kTolerance = 1e-4f;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto capsule = getRandomCapsule();
+    const AABB<Point3D> bounding_box = capsule;
+    const AABB<Point3D> padded_bounding_box{
+        bounding_box.min.array() - kTolerance,
+        bounding_box.max.array() + kTolerance};
+    for (int point_idx = 0; point_idx < 100; ++point_idx) {
+      const Point3D point = getRandomPointInCapsule(capsule);
+      EXPECT_TRUE(capsule.contains(point))
+          << "For capsule " << capsule.toString() << " and point "
+          << print::eigen::oneLine(point);
+      EXPECT_TRUE(padded_bounding_box.contains(point))
+          << "For capsule " << capsule.toString() << " and point "
+          << print::eigen::oneLine(point);
+    }
+    // Points just beyond the start cap lie outside the capsule
+    const Vector3D outwards = capsule.start == capsule.end
+                                  ? Vector3D::UnitX()
+                                  : Vector3D{capsule.start - capsule.end};
+    const Point3D outside_point =
+        capsule.start + 1.01f * capsule.radius * outwards.normalized();
+    EXPECT_FALSE(capsule.contains(outside_point));
+  }
+  // Uninitialized capsules should have empty bounding boxes
+  const AABB<Point3D> empty_bounding_box = Capsule<Point3D>{};
+  EXPECT_TRUE((empty_bounding_box.max.array() < empty_bounding_box.min.array())
+                  .all());
+}
+
+TEST_F(CapsuleTest, AabbIntersectionTests) {
+  constexpr int kNumRepetitions = 1000;
+  constexpr FloatingPoint kTolerance = 1e-2f;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto capsule = getRandomCapsule();
+    const auto aabb = getRandomAabb();
+    const bool overlaps = shape::overlaps(aabb, capsule);
+    EXPECT_EQ(overlaps, shape::overlaps(capsule, aabb));
+
+    // Compare against the distance from the capsule's axis to the AABB
+    const FloatingPoint axis_distance = approximateAxisDistance(capsule, aabb);
+    if (axis_distance < capsule.radius - kTolerance) {
+      EXPECT_TRUE(overlaps) << "For capsule " << capsule.toString()
+                            << " and AABB " << aabb.toString();
+    } else if (capsule.radius + kTolerance < axis_distance) {
+      EXPECT_FALSE(overlaps) << "For capsule " << capsule.toString()
+                             << " and AABB " << aabb.toString();
+    }
+    // Containment implies overlap
+    if (shape::is_inside(aabb, capsule)) {
+      EXPECT_TRUE(overlaps);
+      EXPECT_TRUE(capsule.contains((aabb.min + aabb.max) / 2.f));
+    }
+    // Capsules that degenerate to spheres should behave exactly like spheres
+    const Capsule<Point3D> sphere_capsule{capsule.start, capsule.start,
+                                          capsule.radius};
+    const Sphere<Point3D> sphere{capsule.start, capsule.radius};
+    EXPECT_EQ(shape::overlaps(aabb, sphere_capsule),
+              shape::overlaps(aabb, sphere));
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,141 @@
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/flat_hash_map.h"
+#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/indexing/index_hashes.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class FlatHashMapTest : public FixtureBase, public GeometryGenerator {
+ protected:
+  using HashMap = FlatHashMap<Index3D, int, MixingIndex3DHash>;
+  using ReferenceMap = std::unordered_map<Index3D, int, Index3DHash>;
+
+  static void expectEqual(const HashMap& hash_map,
+                          const ReferenceMap& reference_map) {
+    ASSERT_EQ(hash_map.size(), reference_map.size());
+    size_t num_visited_elements = 0u;
+    for (const auto& [key, value] : hash_map) {
+      ++num_visited_elements;
+      const auto it = reference_map.find(key);
+      ASSERT_NE(it, reference_map.end());
+      EXPECT_EQ(value, it->second);
+    }
+    EXPECT_EQ(num_visited_elements, reference_map.size());
+    for (const auto& [key, value] : reference_map) {
+      const auto it = hash_map.find(key);
+      ASSERT_NE(it, hash_map.end());
+      EXPECT_EQ(it->second, value);
+    }
+  }
+};
+
+TEST_F(FlatHashMapTest, MatchesUnorderedMap) {
+  constexpr int kNumRepetitions = 10;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    HashMap hash_map;
+    ReferenceMap reference_map;
+    // Use a small index range, such that keys are often inserted repeatedly
+    const Index3D min_index = Index3D::Constant(-10);
+    const Index3D max_index = Index3D::Constant(10);
+    for (const Index3D& index :
+         getRandomIndexVector<3>(min_index, max_index, 1000u, 5000u)) {
+      const int value = getRandomIndexElement(-100, 100);
+      if (getRandomIndexElement(0, 3) == 0) {
+        EXPECT_EQ(hash_map.erase(index), reference_map.erase(index));
+      } else {
+        const auto [it, inserted] = hash_map.try_emplace(index, value);
+        const auto [reference_it, reference_inserted] =
+            reference_map.try_emplace(index, value);
+        EXPECT_EQ(inserted, reference_inserted);
+        EXPECT_EQ(it->first, reference_it->first);
+        EXPECT_EQ(it->second, reference_it->second);
+      }
+      EXPECT_EQ(hash_map.count(index), reference_map.count(index));
+    }
+    expectEqual(hash_map, reference_map);
+
+    // Copies should be deep
+    const HashMap hash_map_copy = hash_map;
+    expectEqual(hash_map_copy, reference_map);
+    for (auto& [key, value] : hash_map) {
+      ++value;
+    }
+    expectEqual(hash_map_copy, reference_map);
+
+    // Erase elements while iterating over the map
+    for (auto it = hash_map.begin(); it != hash_map.end();) {
+      if (0 < it->first.x()) {
+        reference_map.erase(it->first);
+        it = hash_map.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    for (auto& [key, value] : reference_map) {
+      ++value;
+    }
+    expectEqual(hash_map, reference_map);
+
+    hash_map.clear();
+    EXPECT_TRUE(hash_map.empty());
+    EXPECT_EQ(hash_map.begin(), hash_map.end());
+    EXPECT_EQ(hash_map.find(Index3D::Zero()), hash_map.end());
+  }
+}
+
+TEST_F(FlatHashMapTest, StableElementAddresses) {
+  HashMap hash_map;
+  const auto indices = getRandomIndexVector<3>(1000u, 2000u);
+  std::vector<const int*> value_ptrs;
+  for (const Index3D& index : indices) {
+    value_ptrs.emplace_back(&hash_map[index]);
+  }
+  hash_map.reserve(10u * hash_map.size());
+  for (size_t idx = 0u; idx < indices.size(); ++idx) {
+    EXPECT_EQ(&hash_map[indices[idx]], value_ptrs[idx]);
+  }
+}
+
+TEST_F(FlatHashMapTest, SpatialHashBackend) {
+  SpatialHash<int, 3> reference_hash;
+  SpatialHash<int, 3, FlatHashMapBackend> flat_hash;
+  for (const Index3D& block_index : getRandomIndexVector<3>(500u, 1000u)) {
+    const int value = getRandomIndexElement(-100, 100);
+    reference_hash.getOrAllocateBlock(block_index, value);
+    flat_hash.getOrAllocateBlock(block_index, value);
+  }
+  reference_hash.eraseBlockIf(
+      [](const Index3D& block_index, int /*value*/) {
+        return block_index.y() < 0;
+      });
+  flat_hash.eraseBlockIf([](const Index3D& block_index, int /*value*/) {
+    return block_index.y() < 0;
+  });
+
+  EXPECT_EQ(flat_hash.size(), reference_hash.size());
+  EXPECT_EQ(flat_hash.getMinBlockIndex(), reference_hash.getMinBlockIndex());
+  EXPECT_EQ(flat_hash.getMaxBlockIndex(), reference_hash.getMaxBlockIndex());
+  reference_hash.forEachBlock([&flat_hash](const Index3D& block_index,
+                                           int value) {
+    const int* flat_value = flat_hash.getBlock(block_index);
+    ASSERT_NE(flat_value, nullptr);
+    EXPECT_EQ(*flat_value, value);
+  });
+  const Index3D min_block_index = Index3D::Constant(-100);
+  const Index3D max_block_index = Index3D::Constant(100);
+  size_t num_blocks_in_range = 0u;
+  reference_hash.forEachBlockInRange(
+      min_block_index, max_block_index,
+      [&num_blocks_in_range](const Index3D&, int) { ++num_blocks_in_range; });
+  flat_hash.forEachBlockInRange(
+      min_block_index, max_block_index,
+      [&num_blocks_in_range](const Index3D&, int) { --num_blocks_in_range; });
+  EXPECT_EQ(num_blocks_in_range, 0u);
+}
+}  // namespace wavemap
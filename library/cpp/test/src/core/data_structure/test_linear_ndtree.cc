@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "wavemap/core/data_structure/linear_ndtree/linear_ndtree.h"
+#include "wavemap/core/data_structure/ndtree/ndtree.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class LinearNdtreeTest : public FixtureBase, public GeometryGenerator {
+ protected:
+  using ReferenceTree = Octree<int>;
+  using LinearTree = LinearOctree<int>;
+
+  // Check that both subtrees have the same structure and values
+  static void expectEqual(ReferenceTree::NodeConstRefType reference_node,
+                          LinearTree::NodeConstRefType linear_node,
+                          const OctreeIndex& node_index) {
+    EXPECT_EQ(linear_node.data(), reference_node.data())
+        << "At index " << node_index.toString();
+    for (NdtreeIndexRelativeChild child_idx = 0;
+         child_idx < OctreeIndex::kNumChildren; ++child_idx) {
+      const auto* reference_child = reference_node.getChild(child_idx);
+      const auto linear_child = linear_node.getChild(child_idx);
+      ASSERT_EQ(static_cast<bool>(linear_child), reference_child != nullptr)
+          << "At index " << node_index.computeChildIndex(child_idx).toString();
+      if (reference_child) {
+        expectEqual(*reference_child, *linear_child,
+                    node_index.computeChildIndex(child_idx));
+      }
+    }
+  }
+};
+
+TEST_F(LinearNdtreeTest, AllocationErasureAndCompaction) {
+  constexpr int kNumRepetitions = 10;
+  constexpr int kNumInsertions = 500;
+  constexpr int kNumErasures = 100;
+  for (int repetition = 0; repetition < kNumRepetitions; ++repetition) {
+    const int tree_height = getRandomNdtreeIndexHeight(2, 8);
+    ReferenceTree reference_tree(tree_height);
+    LinearTree linear_tree(tree_height);
+    const OctreeIndex root_index{tree_height, Index3D::Zero()};
+    const Index3D min_index = convert::nodeIndexToMinCornerIndex(root_index);
+    const Index3D max_index = convert::nodeIndexToMaxCornerIndex(root_index);
+
+    // Insert random values in random order
+    for (int insertion_idx = 0; insertion_idx < kNumInsertions;
+         ++insertion_idx) {
+      const auto index =
+          getRandomNdtreeIndex<OctreeIndex>(min_index, max_index, 0, 0)
+              .computeParentIndex(getRandomInteger(0, tree_height - 1));
+      const int value = getRandomInteger(1, 100000);
+      reference_tree.getOrAllocateNode(index).data() = value;
+      linear_tree.getOrAllocateNode(index).data() = value;
+    }
+    expectEqual(reference_tree.getRootNode(), linear_tree.getRootNode(),
+                root_index);
+    EXPECT_EQ(linear_tree.size(), reference_tree.size());
+
+    // Erase random subtrees
+    for (int erasure_idx = 0; erasure_idx < kNumErasures; ++erasure_idx) {
+      const auto index =
+          getRandomNdtreeIndex<OctreeIndex>(min_index, max_index, 0, 0)
+              .computeParentIndex(getRandomInteger(0, tree_height - 1));
+      // Alternate between erasing single children and all of a node's children
+      if (erasure_idx % 2) {
+        if (auto* reference_node = reference_tree.getNode(index);
+            reference_node) {
+          reference_node->deleteChildrenArray();
+        }
+        if (auto linear_node = linear_tree.getNode(index); linear_node) {
+          linear_node->deleteChildrenArray();
+          EXPECT_FALSE(linear_node->hasChildrenArray());
+          EXPECT_EQ(linear_node->getMemoryUsage(), 0u);
+        }
+        continue;
+      }
+      const OctreeIndex parent_index = index.computeParentIndex();
+      const NdtreeIndexRelativeChild child_idx =
+          index.computeRelativeChildIndex();
+      if (auto* reference_parent = reference_tree.getNode(parent_index);
+          reference_parent) {
+        reference_parent->eraseChild(child_idx);
+      }
+      if (auto linear_parent = linear_tree.getNode(parent_index);
+          linear_parent) {
+        linear_parent->eraseChild(child_idx);
+      }
+    }
+    expectEqual(reference_tree.getRootNode(), linear_tree.getRootNode(),
+                root_index);
+    EXPECT_EQ(linear_tree.size(), reference_tree.size());
+
+    // Compact
+    const size_t num_nodes = linear_tree.size();
+    const size_t memory_usage = linear_tree.getMemoryUsage();
+    linear_tree.compact();
+    EXPECT_EQ(linear_tree.getNumUnusedNodes(), 0u);
+    EXPECT_EQ(linear_tree.size(), num_nodes);
+    EXPECT_LE(linear_tree.getMemoryUsage(), memory_usage);
+    expectEqual(reference_tree.getRootNode(), linear_tree.getRootNode(),
+                root_index);
+
+    // Clear
+    linear_tree.clear();
+    EXPECT_TRUE(linear_tree.empty());
+    EXPECT_EQ(linear_tree.size(), 1u);
+  }
+}
+
+TEST_F(LinearNdtreeTest, Pruning) {
+  constexpr int kNumRepetitions = 10;
+  constexpr int kNumInsertions = 200;
+  for (int repetition = 0; repetition < kNumRepetitions; ++repetition) {
+    const int tree_height = getRandomNdtreeIndexHeight(2, 8);
+    ReferenceTree reference_tree(tree_height);
+    LinearTree linear_tree(tree_height);
+    const OctreeIndex root_index{tree_height, Index3D::Zero()};
+    const Index3D min_index = convert::nodeIndexToMinCornerIndex(root_index);
+    const Index3D max_index = convert::nodeIndexToMaxCornerIndex(root_index);
+
+    // Insert a mix of zero and non-zero values
+    for (int insertion_idx = 0; insertion_idx < kNumInsertions;
+         ++insertion_idx) {
+      const auto index =
+          getRandomNdtreeIndex<OctreeIndex>(min_index, max_index, 0, 0)
+              .computeParentIndex(getRandomInteger(0, tree_height - 1));
+      const int value = getRandomInteger(0, 1) * getRandomInteger(1, 100000);
+      reference_tree.getOrAllocateNode(index).data() = value;
+      linear_tree.getOrAllocateNode(index).data() = value;
+    }
+
+    reference_tree.prune();
+    linear_tree.prune();
+    expectEqual(reference_tree.getRootNode(), linear_tree.getRootNode(),
+                root_index);
+    EXPECT_EQ(linear_tree.size(), reference_tree.size());
+    EXPECT_LT(linear_tree.getNumUnusedNodes(), linear_tree.size());
+  }
+}
+}  // namespace wavemap
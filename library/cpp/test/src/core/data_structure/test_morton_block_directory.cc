@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/dense_block_hash.h"
+#include "wavemap/core/data_structure/spatial_hash.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/query/query_accelerator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class MortonBlockDirectoryTest : public FixtureBase, public GeometryGenerator {
+ protected:
+  template <typename SpatialHashT>
+  static void checkDirectory(SpatialHashT& spatial_hash) {
+    using BlockDirectory = typename SpatialHashT::BlockDirectory;
+    const BlockDirectory* block_directory = spatial_hash.getBlockDirectory();
+    ASSERT_NE(block_directory, nullptr);
+    ASSERT_EQ(block_directory->size(), spatial_hash.size());
+
+    // The blocks should be visited in Morton order
+    std::vector<MortonIndex> visited_mortons;
+    spatial_hash.forEachBlock([&](const Index3D& block_index, auto& block) {
+      EXPECT_EQ(&block, spatial_hash.getBlock(block_index));
+      visited_mortons.emplace_back(
+          BlockDirectory::blockIndexToMorton(block_index));
+    });
+    EXPECT_EQ(visited_mortons.size(), spatial_hash.size());
+    EXPECT_TRUE(std::is_sorted(visited_mortons.begin(), visited_mortons.end()));
+
+    // The neighbor links should match the blocks in the hash
+    block_directory->forEachEntry(
+        [&spatial_hash](const typename BlockDirectory::Entry& entry) {
+          EXPECT_EQ(entry.block, spatial_hash.getBlock(entry.block_index));
+          for (const Index3D& offset :
+               Grid<3>(Index3D::Constant(-1), Index3D::Constant(1))) {
+            const Index3D neighbor_index = entry.block_index + offset;
+            const auto* neighbor = entry.getNeighbor(offset);
+            if (spatial_hash.hasBlock(neighbor_index)) {
+              ASSERT_NE(neighbor, nullptr);
+              EXPECT_EQ(neighbor->block_index, neighbor_index);
+              EXPECT_EQ(neighbor->block, spatial_hash.getBlock(neighbor_index));
+            } else {
+              EXPECT_EQ(neighbor, nullptr);
+            }
+          }
+        });
+  }
+};
+
+TEST_F(MortonBlockDirectoryTest, MortonOrderIsMonotonic) {
+  using BlockDirectory = MortonBlockDirectory<int, 3>;
+  // Along each axis, including across the origin
+  for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+    for (IndexElement coordinate = -100; coordinate < 100; ++coordinate) {
+      const Index3D index = Index3D::Unit(dim_idx) * coordinate;
+      const Index3D next_index = Index3D::Unit(dim_idx) * (coordinate + 1);
+      EXPECT_LT(BlockDirectory::blockIndexToMorton(index),
+                BlockDirectory::blockIndexToMorton(next_index));
+    }
+  }
+  // Neighbor offsets should round trip
+  for (int neighbor_idx = 0; neighbor_idx < BlockDirectory::kNeighborhoodSize;
+       ++neighbor_idx) {
+    EXPECT_EQ(BlockDirectory::neighborOffsetToIdx(
+                  BlockDirectory::neighborIdxToOffset(neighbor_idx)),
+              neighbor_idx);
+  }
+  EXPECT_EQ(BlockDirectory::neighborIdxToOffset(
+                BlockDirectory::kSelfNeighborIdx),
+            Index3D::Zero());
+}
+
+TEST_F(MortonBlockDirectoryTest, IncrementalMaintenance) {
+  constexpr int kNumRepetitions = 5;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    // Use a small index range, such that most blocks have neighbors
+    const Index3D min_index = Index3D::Constant(-8);
+    const Index3D max_index = Index3D::Constant(8);
+    SpatialHash<int, 3> spatial_hash;
+    for (const Index3D& block_index :
+         getRandomIndexVector<3>(min_index, max_index, 100u, 500u)) {
+      spatial_hash.getOrAllocateBlock(block_index, 1);
+    }
+    spatial_hash.enableBlockDirectory();
+    checkDirectory(spatial_hash);
+
+    // Allocate and erase blocks
+    for (const Index3D& block_index :
+         getRandomIndexVector<3>(min_index, max_index, 100u, 500u)) {
+      spatial_hash.getOrAllocateBlock(block_index, 2);
+    }
+    for (const Index3D& block_index :
+         getRandomIndexVector<3>(min_index, max_index, 100u, 500u)) {
+      spatial_hash.eraseBlock(block_index);
+    }
+    spatial_hash.eraseBlockIf(
+        [](const Index3D& block_index, int /*value*/) {
+          return block_index.x() == 0;
+        });
+    checkDirectory(spatial_hash);
+
+    // Copies should have their own directory
+    auto spatial_hash_copy = spatial_hash;
+    checkDirectory(spatial_hash_copy);
+    spatial_hash.clear();
+    EXPECT_TRUE(spatial_hash.getBlockDirectory()->empty());
+    checkDirectory(spatial_hash_copy);
+  }
+}
+
+TEST_F(MortonBlockDirectoryTest, FlatHashMapBackend) {
+  SpatialHash<int, 3, FlatHashMapBackend> spatial_hash;
+  spatial_hash.enableBlockDirectory();
+  for (const Index3D& block_index : getRandomIndexVector<3>(
+           Index3D::Constant(-8), Index3D::Constant(8), 500u, 1000u)) {
+    spatial_hash.getOrAllocateBlock(block_index, 1);
+  }
+  checkDirectory(spatial_hash);
+}
+
+TEST_F(MortonBlockDirectoryTest, QueryAcceleratorNeighborLinks) {
+  constexpr FloatingPoint kDefaultValue = -1.f;
+  DenseBlockHash<FloatingPoint, 3, 4> dense_block_hash(kDefaultValue);
+  const Index3D min_index = Index3D::Constant(-20);
+  const Index3D max_index = Index3D::Constant(20);
+  for (const Index3D& index :
+       getRandomIndexVector<3>(min_index, max_index, 1000u, 2000u)) {
+    dense_block_hash.getOrAllocateValue(index) =
+        static_cast<FloatingPoint>(index.sum());
+  }
+  dense_block_hash.enableBlockDirectory();
+
+  // Walk through the map in steps that cross block boundaries, including
+  // through unallocated blocks
+  QueryAccelerator query_accelerator(dense_block_hash);
+  for (const Index3D& index : Grid<3>(min_index, max_index)) {
+    const FloatingPoint* value = query_accelerator.getValue(index);
+    const FloatingPoint* expected_value = dense_block_hash.getValue(index);
+    EXPECT_EQ(value, expected_value);
+  }
+  for (const Index3D& index :
+       getRandomIndexVector<3>(min_index, max_index, 1000u, 2000u)) {
+    EXPECT_EQ(query_accelerator.getValue(index),
+              dense_block_hash.getValue(index));
+  }
+}
+}  // namespace wavemap
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "wavemap/core/data_structure/chunked_ndtree/chunked_ndtree.h"
+#include "wavemap/core/data_structure/linear_ndtree/linear_ndtree.h"
 #include "wavemap/core/data_structure/ndtree/ndtree.h"
 #include "wavemap/core/indexing/index_hashes.h"
 #include "wavemap/test/fixture_base.h"
@@ -17,7 +18,8 @@ class NdtreeTest : public FixtureBase, public GeometryGenerator {};
 using NdtreeTypes =
     ::testing::Types<Ndtree<int, 1>, Ndtree<int, 2>, Ndtree<int, 3>,
                      ChunkedNdtree<int, 1, 3>, ChunkedNdtree<int, 2, 3>,
-                     ChunkedNdtree<int, 3, 3>>;
+                     ChunkedNdtree<int, 3, 3>, LinearNdtree<int, 1>,
+                     LinearNdtree<int, 2>, LinearNdtree<int, 3>>;
 TYPED_TEST_SUITE(NdtreeTest, NdtreeTypes, );
 
 TYPED_TEST(NdtreeTest, AllocatingAndClearing) {
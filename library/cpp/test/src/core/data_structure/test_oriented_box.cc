@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/core/utils/shape/oriented_box.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class OrientedBoxTest : public FixtureBase, public GeometryGenerator {
+ protected:
+  OrientedBox<Point3D> getRandomOrientedBox() {
+    const Point3D half_extents{getRandomSignedDistance(0.1f, 5.f),
+                               getRandomSignedDistance(0.1f, 5.f),
+                               getRandomSignedDistance(0.1f, 5.f)};
+    return {getRandomTranslation<3>(), half_extents,
+            getRandomTransformation().getRotationMatrix()};
+  }
+
+  AABB<Point3D> getRandomAabb() {
+    const Point3D corner_a = getRandomPoint<3>(0.f, 10.f);
+    const Point3D corner_b = getRandomPoint<3>(0.f, 10.f);
+    return {corner_a.cwiseMin(corner_b), corner_a.cwiseMax(corner_b)};
+  }
+
+  Point3D getRandomPointInBox(const OrientedBox<Point3D>& box) {
+    Point3D point_in_box_frame;
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      point_in_box_frame[dim_idx] = getRandomSignedDistance(
+          -box.half_extents[dim_idx], box.half_extents[dim_idx]);
+    }
+    return box.center + box.rotation * point_in_box_frame;
+  }
+};
+
+TEST_F(OrientedBoxTest, ContainmentAndBoundingBox) {
+  constexpr int kNumRepetitions = 100;
+  constexpr FloatingPoint kTolerance = 1e-4f;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto box = getRandomOrientedBox();
+    const AABB<Point3D> bounding_box = box;
+    const AABB<Point3D> padded_bounding_box{
+        bounding_box.min.array() - kTolerance,
+        bounding_box.max.array() + kTolerance};
+    for (int point_idx = 0; point_idx < 100; ++point_idx) {
+      const Point3D point = getRandomPointInBox(box);
+      EXPECT_TRUE(padded_bounding_box.contains(point))
+          << "For box " << box.toString() << " and point "
+          << print::eigen::oneLine(point);
+    }
+    for (int corner_idx = 0; corner_idx < AABB<Point3D>::kNumCorners;
+         ++corner_idx) {
+      const Point3D shrunk_point =
+          box.center + 0.99f * box.rotation *
+                           (box.half_extents.array() *
+                            AABB<Point3D>{-Point3D::Ones(), Point3D::Ones()}
+                                .corner_point(corner_idx)
+                                .array())
+                               .matrix();
+      EXPECT_TRUE(box.contains(shrunk_point));
+      const Point3D grown_point =
+          box.center + 1.01f * (shrunk_point - box.center) / 0.99f;
+      EXPECT_FALSE(box.contains(grown_point));
+    }
+  }
+}
+
+TEST_F(OrientedBoxTest, AabbIntersectionTests) {
+  constexpr int kNumRepetitions = 1000;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto box = getRandomOrientedBox();
+    const auto aabb = getRandomAabb();
+    const bool overlaps = shape::overlaps(aabb, box);
+    EXPECT_EQ(overlaps, shape::overlaps(box, aabb));
+
+    // Overlaps can never be ruled out if the shapes share a point
+    for (int point_idx = 0; point_idx < 100; ++point_idx) {
+      if (aabb.contains(getRandomPointInBox(box))) {
+        EXPECT_TRUE(overlaps) << "For box " << box.toString()
+                              << " and AABB " << aabb.toString();
+        break;
+      }
+    }
+    // The shapes can not overlap if their bounding boxes do not
+    if (!shape::overlaps(aabb, static_cast<AABB<Point3D>>(box))) {
+      EXPECT_FALSE(overlaps);
+    }
+    // Containment implies overlap
+    if (shape::is_inside(aabb, box)) {
+      EXPECT_TRUE(overlaps);
+      EXPECT_TRUE(box.contains((aabb.min + aabb.max) / 2.f));
+    }
+
+    // Axis-aligned boxes should behave exactly like AABBs
+    const OrientedBox<Point3D> axis_aligned_box{
+        box.center, box.half_extents, Eigen::Matrix3f::Identity()};
+    const AABB<Point3D> axis_aligned_box_as_aabb = axis_aligned_box;
+    EXPECT_EQ(shape::overlaps(aabb, axis_aligned_box),
+              shape::overlaps(aabb, axis_aligned_box_as_aabb));
+    EXPECT_EQ(shape::is_inside(aabb, axis_aligned_box),
+              shape::is_inside(aabb, axis_aligned_box_as_aabb));
+  }
+}
+}  // namespace wavemap
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -16,7 +18,9 @@
 #include "wavemap/core/integrator/ray_tracing/ray_tracing_integrator.h"
 #include "wavemap/core/map/hashed_blocks.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
 #include "wavemap/core/map/volumetric_octree.h"
 #include "wavemap/core/map/wavelet_octree.h"
 #include "wavemap/core/utils/iterate/grid_iterator.h"
@@ -69,6 +73,10 @@ using IntegratorTypes = ::testing::Types<
     IntegratorDataStructurePair<CoarseToFineIntegrator, VolumetricOctree>,
     IntegratorDataStructurePair<WaveletIntegrator, WaveletOctree>,
     IntegratorDataStructurePair<HashedWaveletIntegrator, HashedWaveletOctree>,
+    IntegratorDataStructurePair<LinearHashedWaveletIntegrator,
+                                LinearHashedWaveletOctree>,
+    IntegratorDataStructurePair<QuantizedHashedWaveletIntegrator,
+                                QuantizedHashedWaveletOctree>,
     IntegratorDataStructurePair<HashedChunkedWaveletIntegrator,
                                 HashedChunkedWaveletOctree>>;
 TYPED_TEST_SUITE(PointcloudIntegratorTypedTest, IntegratorTypes, );
@@ -146,6 +154,134 @@ TYPED_TEST(PointcloudIntegratorTypedTest,
   }
 }
 
+TEST_F(PointcloudIntegratorTest, FusedHashedWaveletIntegration) {
+  constexpr int kNumRepetitions = 3;
+  constexpr int kNumMeasurements = 3;
+  for (int idx = 0; idx < kNumRepetitions; ++idx) {
+    const auto projective_integrator_config =
+        getRandomConfig<ProjectiveIntegratorConfig>();
+    // Widen the log-odds bounds, such that the results do not depend on the
+    // order in which the updates are clamped
+    auto data_structure_config = getRandomConfig<HashedWaveletOctreeConfig>();
+    data_structure_config.min_log_odds = -1e3f;
+    data_structure_config.max_log_odds = 1e3f;
+
+    auto fused_occupancy_map =
+        std::make_shared<HashedWaveletOctree>(data_structure_config);
+    auto sequential_occupancy_map =
+        std::make_shared<HashedWaveletOctree>(data_structure_config);
+
+    // Create one integrator per measurement, each with its own sensor model
+    std::vector<std::unique_ptr<HashedWaveletIntegrator>> fused_integrators;
+    std::vector<std::unique_ptr<HashedWaveletIntegrator>>
+        sequential_integrators;
+    std::vector<PosedPointcloud<>> pointclouds;
+    for (int measurement_idx = 0; measurement_idx < kNumMeasurements;
+         ++measurement_idx) {
+      const auto projection_model = std::make_shared<SphericalProjector>(
+          getRandomConfig<SphericalProjectorConfig>());
+      const auto posed_range_image =
+          std::make_shared<PosedImage<>>(projection_model->getDimensions());
+      const auto beam_offset_image =
+          std::make_shared<Image<Vector2D>>(projection_model->getDimensions());
+      const auto measurement_model = std::make_shared<ContinuousBeam>(
+          getRandomConfig<ContinuousBeamConfig>(*projection_model),
+          projection_model, posed_range_image, beam_offset_image);
+      fused_integrators.emplace_back(std::make_unique<HashedWaveletIntegrator>(
+          projective_integrator_config, projection_model, posed_range_image,
+          beam_offset_image, measurement_model, fused_occupancy_map));
+      sequential_integrators.emplace_back(
+          std::make_unique<HashedWaveletIntegrator>(
+              projective_integrator_config, projection_model,
+              posed_range_image, beam_offset_image, measurement_model,
+              sequential_occupancy_map));
+      pointclouds.emplace_back(getRandomPointcloud(*projection_model));
+    }
+
+    // Integrate the measurements jointly
+    std::vector<IntegratorBase*> loaded_integrators;
+    for (int measurement_idx = 0; measurement_idx < kNumMeasurements;
+         ++measurement_idx) {
+      auto& integrator = fused_integrators[measurement_idx];
+      ASSERT_TRUE(integrator->importMeasurement(pointclouds[measurement_idx]));
+      loaded_integrators.emplace_back(integrator.get());
+    }
+    loaded_integrators.front()->updateMapFused(loaded_integrators);
+
+    // Integrate them sequentially
+    // NOTE: Free space is only integrated into blocks that already exist. In a
+    //       fused update, this is decided based on the map before the batch.
+    //       We therefore allocate all blocks upfront, such that the sequential
+    //       integration order does not matter.
+    fused_occupancy_map->forEachBlock(
+        [&sequential_occupancy_map](const Index3D& block_index,
+                                    const auto& /*block*/) {
+          sequential_occupancy_map->getOrAllocateBlock(block_index);
+        });
+    for (int measurement_idx = 0; measurement_idx < kNumMeasurements;
+         ++measurement_idx) {
+      sequential_integrators[measurement_idx]->integrate(
+          pointclouds[measurement_idx]);
+    }
+
+    // Each measurement's update can deviate from its exact value by up to the
+    // termination error, in either map
+    const FloatingPoint kTolerance =
+        2.f * kNumMeasurements *
+        projective_integrator_config.termination_update_error;
+    const auto compare_maps = [kTolerance](const HashedWaveletOctree& map_a,
+                                           const HashedWaveletOctree& map_b) {
+      map_a.forEachLeaf([&](const OctreeIndex& node_index,
+                            FloatingPoint value_a) {
+        const Index3D index = convert::nodeIndexToMinCornerIndex(node_index);
+        EXPECT_NEAR(value_a, map_b.getCellValue(index), kTolerance)
+            << "For cell index " << print::eigen::oneLine(index);
+      });
+    };
+    compare_maps(*fused_occupancy_map, *sequential_occupancy_map);
+    compare_maps(*sequential_occupancy_map, *fused_occupancy_map);
+  }
+}
+
+TEST_F(PointcloudIntegratorTest, IntegrationTimeBudget) {
+  constexpr int kNumPointclouds = 5;
+  const auto data_structure_config =
+      getRandomConfig<HashedWaveletOctreeConfig>();
+  const auto projection_model = std::make_shared<SphericalProjector>(
+      getRandomConfig<SphericalProjectorConfig>());
+  const auto posed_range_image =
+      std::make_shared<PosedImage<>>(projection_model->getDimensions());
+  const auto beam_offset_image =
+      std::make_shared<Image<Vector2D>>(projection_model->getDimensions());
+  const auto measurement_model = std::make_shared<ContinuousBeam>(
+      getRandomConfig<ContinuousBeamConfig>(*projection_model),
+      projection_model, posed_range_image, beam_offset_image);
+
+  const auto create_integrator = [&](FloatingPoint time_budget) {
+    auto config = getRandomConfig<ProjectiveIntegratorConfig>();
+    config.integration_time_budget = time_budget;
+    config.max_num_coarsening_steps = 2;
+    return std::make_unique<HashedWaveletIntegrator>(
+        config, projection_model, posed_range_image, beam_offset_image,
+        measurement_model,
+        std::make_shared<HashedWaveletOctree>(data_structure_config));
+  };
+
+  // An unattainable budget should make the integrator coarsen up to its limit
+  auto overloaded_integrator = create_integrator(1e-9f);
+  // With a generous budget, it should keep integrating at full resolution
+  auto idle_integrator = create_integrator(1e3f);
+  for (int cloud_idx = 0; cloud_idx < kNumPointclouds; ++cloud_idx) {
+    const PosedPointcloud<> random_pointcloud =
+        getRandomPointcloud(*projection_model);
+    overloaded_integrator->integrate(random_pointcloud);
+    idle_integrator->integrate(random_pointcloud);
+    EXPECT_EQ(overloaded_integrator->getCoarseningLevel(),
+              std::min(cloud_idx + 1, 2));
+    EXPECT_EQ(idle_integrator->getCoarseningLevel(), 0);
+  }
+}
+
 TEST_F(PointcloudIntegratorTest, RayTracingIntegrator) {
   for (int idx = 0; idx < 3; ++idx) {
     const auto ray_tracing_integrator_config =
@@ -0,0 +1,220 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/indexing/index_hashes.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/coarsen.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class HashedWaveletOctreeSnapshotTest : public FixtureBase,
+                                        public GeometryGenerator,
+                                        public ConfigGenerator {
+ protected:
+  using CellValueMap = std::unordered_map<Index3D, FloatingPoint, Index3DHash>;
+
+  static CellValueMap getCellValues(const HashedWaveletOctree& map,
+                                    const std::vector<Index3D>& indices) {
+    CellValueMap values;
+    for (const Index3D& index : indices) {
+      values.emplace(index, map.getCellValue(index));
+    }
+    return values;
+  }
+};
+
+TEST_F(HashedWaveletOctreeSnapshotTest, SnapshotsAreImmutable) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    HashedWaveletOctree map(config);
+    const std::vector<Index3D> random_indices = getRandomIndexVector<3>(
+        500u, 1000u, Index3D::Constant(-200), Index3D::Constant(200));
+    for (const Index3D& index : random_indices) {
+      map.addToCellValue(index, getRandomUpdate());
+    }
+    const CellValueMap original_values = getCellValues(map, random_indices);
+
+    // Take a snapshot and modify the map in every possible way
+    const auto snapshot = map.snapshot();
+    ASSERT_NE(snapshot, nullptr);
+    for (const Index3D& index : random_indices) {
+      map.addToCellValue(index, getRandomUpdate());
+    }
+    map.threshold();
+    map.pruneSmart();
+    map.prune();
+    const Index3D erased_block_index =
+        convert::indexToBlockIndex(random_indices.front(), config.tree_height);
+    map.eraseBlock(erased_block_index);
+
+    // Check that the snapshot still holds the original values
+    EXPECT_EQ(snapshot->getConfig(), map.getConfig());
+    EXPECT_TRUE(snapshot->hasBlock(erased_block_index));
+    for (const auto& [index, value] : original_values) {
+      EXPECT_EQ(snapshot->getCellValue(index), value)
+          << "At index " << print::eigen::oneLine(index);
+    }
+
+    // Check that clearing the map does not affect the snapshot either
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(getCellValues(*snapshot, random_indices), original_values);
+  }
+}
+
+TEST_F(HashedWaveletOctreeSnapshotTest, OnlyModifiedBlocksAreCopied) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    HashedWaveletOctree map(config);
+    for (const Index3D& index : getRandomIndexVector<3>(
+             500u, 1000u, Index3D::Constant(-200), Index3D::Constant(200))) {
+      map.addToCellValue(index, getRandomUpdate());
+    }
+    map.threshold();
+    map.prune();
+
+    // Taking a snapshot, thresholding and pruning should not copy any blocks
+    const auto snapshot = map.snapshot();
+    map.threshold();
+    map.prune();
+    std::as_const(map).forEachBlock(
+        [&snapshot](const Index3D& block_index,
+                    const HashedWaveletOctree::Block& block) {
+          EXPECT_EQ(&block, snapshot->getBlock(block_index));
+        });
+
+    // Updating a cell should only copy the block that contains it
+    const Index3D updated_index = getRandomIndex<3>(Index3D::Constant(-200),
+                                                    Index3D::Constant(200));
+    const Index3D updated_block_index =
+        convert::indexToBlockIndex(updated_index, config.tree_height);
+    const FloatingPoint original_value = map.getCellValue(updated_index);
+    map.addToCellValue(updated_index, 0.5f);
+    std::as_const(map).forEachBlock(
+        [&snapshot, &updated_block_index](
+            const Index3D& block_index,
+            const HashedWaveletOctree::Block& block) {
+          if (block_index == updated_block_index) {
+            EXPECT_NE(&block, snapshot->getBlock(block_index));
+          } else {
+            EXPECT_EQ(&block, snapshot->getBlock(block_index));
+          }
+        });
+    EXPECT_EQ(snapshot->getCellValue(updated_index), original_value);
+    EXPECT_NEAR(map.getCellValue(updated_index), original_value + 0.5f,
+                1e-3f);
+  }
+}
+
+TEST_F(HashedWaveletOctreeSnapshotTest, OnlyCoarsenedBlocksAreCopied) {
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (const bool use_thread_pool : {false, true}) {
+    auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    config.tree_height = 6;
+    HashedWaveletOctree map(config);
+    for (const Index3D& index : getRandomIndexVector<3>(
+             500u, 1000u, Index3D::Constant(-200), Index3D::Constant(200))) {
+      map.addToCellValue(index, getRandomUpdate());
+    }
+    map.prune();
+
+    // Coarsening should only copy the blocks that were selected
+    const auto snapshot = map.snapshot();
+    auto is_selected = [](const Index3D& block_index,
+                          const HashedWaveletOctree::Block& /*block*/) {
+      return 0 <= block_index.x();
+    };
+    const auto maybe_thread_pool = use_thread_pool ? thread_pool : nullptr;
+    const size_t num_coarsened_blocks =
+        edit::coarsenIf(map, 1, is_selected, maybe_thread_pool);
+    EXPECT_LT(0u, num_coarsened_blocks);
+    size_t num_copied_blocks = 0u;
+    std::as_const(map).forEachBlock(
+        [&snapshot, &is_selected, &num_copied_blocks](
+            const Index3D& block_index,
+            const HashedWaveletOctree::Block& block) {
+          if (!is_selected(block_index, block)) {
+            EXPECT_EQ(&block, snapshot->getBlock(block_index));
+          } else if (&block != snapshot->getBlock(block_index)) {
+            ++num_copied_blocks;
+          }
+        });
+    EXPECT_LE(num_coarsened_blocks, num_copied_blocks);
+
+    // Blocks that are already coarse should not be counted again
+    EXPECT_EQ(edit::coarsenIf(map, 1, is_selected, maybe_thread_pool), 0u);
+  }
+}
+
+TEST_F(HashedWaveletOctreeSnapshotTest, ConcurrentReadsDuringUpdates) {
+  const auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+  const std::vector<Index3D> indices = getRandomIndexVector<3>(
+      100u, 200u, Index3D::Constant(-100), Index3D::Constant(100));
+  const std::unordered_set<Index3D, Index3DHash> unique_indices(
+      indices.begin(), indices.end());
+  constexpr FloatingPoint kTolerance = 1e-3f;
+  constexpr FloatingPoint kUpdate = 0.01f;
+
+  // The writer increments all cells by the same amount in each iteration, and
+  // publishes a snapshot after each iteration
+  HashedWaveletOctree map(config);
+  HashedWaveletOctree::ConstPtr latest_snapshot = map.snapshot();
+  std::atomic<bool> done = false;
+  constexpr int kNumIterations = 200;
+  std::thread writer([&]() {
+    for (int iteration = 0; iteration < kNumIterations; ++iteration) {
+      for (const Index3D& index : unique_indices) {
+        map.addToCellValue(index, kUpdate);
+      }
+      std::atomic_store(&latest_snapshot, map.snapshot());
+    }
+    done = true;
+  });
+
+  // The readers should always see all cells at the same value
+  std::vector<std::thread> readers;
+  std::atomic<int> num_torn_snapshots = 0;
+  for (int reader_idx = 0; reader_idx < 2; ++reader_idx) {
+    readers.emplace_back([&]() {
+      while (!done) {
+        const auto snapshot = std::atomic_load(&latest_snapshot);
+        const FloatingPoint first_value =
+            snapshot->getCellValue(indices.front());
+        for (const Index3D& index : indices) {
+          if (kTolerance <
+              std::abs(snapshot->getCellValue(index) - first_value)) {
+            ++num_torn_snapshots;
+            break;
+          }
+        }
+      }
+    });
+  }
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(num_torn_snapshots, 0);
+
+  // Check that the last snapshot matches the final state of the map
+  const auto final_snapshot = std::atomic_load(&latest_snapshot);
+  for (const Index3D& index : indices) {
+    EXPECT_NEAR(final_snapshot->getCellValue(index),
+                kNumIterations * kUpdate, kTolerance);
+  }
+}
+}  // namespace wavemap
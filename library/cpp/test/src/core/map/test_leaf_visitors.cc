@@ -0,0 +1,265 @@
+#include <array>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_blocks.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/map_base.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/core/utils/shape/oriented_box.h"
+#include "wavemap/core/utils/shape/sphere.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+template <typename MapType>
+class LeafVisitorTest : public FixtureBase,
+                        public GeometryGenerator,
+                        public ConfigGenerator {
+ protected:
+  // Leaves keyed by their height and position, in a deterministic order
+  using LeafMap =
+      std::map<std::pair<IndexElement, std::array<IndexElement, 3>>,
+               FloatingPoint>;
+  static void addLeaf(LeafMap& leaf_map, const OctreeIndex& node_index,
+                      FloatingPoint value) {
+    const auto& position = node_index.position;
+    const auto key = std::make_pair(
+        node_index.height,
+        std::array<IndexElement, 3>{position.x(), position.y(), position.z()});
+    EXPECT_EQ(leaf_map.count(key), 0u)
+        << "Leaf " << node_index.toString() << " visited twice";
+    leaf_map.emplace(key, value);
+  }
+
+  std::unique_ptr<MapType> getRandomMap() {
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename MapType::Config>();
+    auto map = std::make_unique<MapType>(config);
+    for (const Index3D& index : GeometryGenerator::getRandomIndexVector<3>(
+             50u, 100u, Index3D::Constant(-500), Index3D::Constant(500))) {
+      map->addToCellValue(index, getRandomUpdate());
+    }
+    map->prune();
+    return map;
+  }
+
+  AABB<Point3D> getRandomRegion(FloatingPoint min_cell_width) {
+    const Point3D corner_a =
+        min_cell_width * getRandomIndex<3>(Index3D::Constant(-600),
+                                           Index3D::Constant(600))
+                             .template cast<FloatingPoint>();
+    const Point3D corner_b =
+        min_cell_width * getRandomIndex<3>(Index3D::Constant(-600),
+                                           Index3D::Constant(600))
+                             .template cast<FloatingPoint>();
+    return {corner_a.cwiseMin(corner_b), corner_a.cwiseMax(corner_b)};
+  }
+
+  // Check that the region visitors visit exactly the leaves and blocks that
+  // overlap the region
+  template <typename ShapeT>
+  static void checkRegionVisitors(const MapType& map, const ShapeT& region) {
+    const FloatingPoint min_cell_width = map.getMinCellWidth();
+    LeafMap reference_leaves;
+    map.forEachLeaf([&](const OctreeIndex& node_index, FloatingPoint value) {
+      if (shape::overlaps(convert::nodeIndexToAABB(node_index, min_cell_width),
+                          region)) {
+        addLeaf(reference_leaves, node_index, value);
+      }
+    });
+    LeafMap leaves;
+    map.forEachLeafInRegion(
+        region, [&leaves](const OctreeIndex& node_index, FloatingPoint value) {
+          addLeaf(leaves, node_index, value);
+        });
+    EXPECT_EQ(leaves, reference_leaves) << "For region " << region.toString();
+
+    IndexElement block_height = map.getTreeHeight();
+    if constexpr (std::is_same_v<MapType, HashedBlocks>) {
+      block_height = HashedBlocks::kCellsPerSideLog2;
+    }
+    size_t num_reference_blocks = 0u;
+    map.forEachBlock([&](const Index3D& block_index, const auto& /*block*/) {
+      const OctreeIndex block_node_index{block_height, block_index};
+      if (shape::overlaps(
+              convert::nodeIndexToAABB(block_node_index, min_cell_width),
+              region)) {
+        ++num_reference_blocks;
+      }
+    });
+    size_t num_blocks = 0u;
+    map.forEachBlockInRegion(
+        region, [&](const Index3D& block_index, const auto& /*block*/) {
+          const OctreeIndex block_node_index{block_height, block_index};
+          EXPECT_TRUE(shape::overlaps(
+              convert::nodeIndexToAABB(block_node_index, min_cell_width),
+              region));
+          ++num_blocks;
+        });
+    EXPECT_EQ(num_blocks, num_reference_blocks);
+  }
+};
+
+using MapTypes = ::testing::Types<HashedBlocks, HashedWaveletOctree,
+                                  HashedChunkedWaveletOctree>;
+TYPED_TEST_SUITE(LeafVisitorTest, MapTypes, );
+
+TYPED_TEST(LeafVisitorTest, TemplatedVisitorsMatchVirtualVisitor) {
+  using LeafMap = typename TestFixture::LeafMap;
+  constexpr int kNumRepetitions = 3;
+  ThreadPool thread_pool;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = TestFixture::getRandomMap();
+    const MapBase& map_base = *map;
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    const AABB<Point3D> region =
+        TestFixture::getRandomRegion(min_cell_width);
+
+    // Collect the reference leaves through the virtual interface
+    LeafMap reference_leaves;
+    LeafMap reference_region_leaves;
+    map_base.forEachLeaf([&](const OctreeIndex& node_index,
+                             FloatingPoint value) {
+      TestFixture::addLeaf(reference_leaves, node_index, value);
+      if (shape::overlaps(convert::nodeIndexToAABB(node_index, min_cell_width),
+                          region)) {
+        TestFixture::addLeaf(reference_region_leaves, node_index, value);
+      }
+    });
+
+    // Check the templated serial visitors
+    LeafMap leaves;
+    map->forEachLeaf([&leaves](const OctreeIndex& node_index,
+                               FloatingPoint value) {
+      TestFixture::addLeaf(leaves, node_index, value);
+    });
+    EXPECT_EQ(leaves, reference_leaves);
+
+    LeafMap region_leaves;
+    map->forEachLeafInRegion(
+        region, [&region_leaves](const OctreeIndex& node_index,
+                                 FloatingPoint value) {
+          TestFixture::addLeaf(region_leaves, node_index, value);
+        });
+    EXPECT_EQ(region_leaves, reference_region_leaves);
+
+    // Check the block-parallel visitors
+    std::mutex mutex;
+    LeafMap parallel_leaves;
+    map->forEachLeafParallel(
+        thread_pool, [&mutex, &parallel_leaves](const OctreeIndex& node_index,
+                                                FloatingPoint value) {
+          std::scoped_lock lock(mutex);
+          TestFixture::addLeaf(parallel_leaves, node_index, value);
+        });
+    EXPECT_EQ(parallel_leaves, reference_leaves);
+
+    LeafMap parallel_region_leaves;
+    map->forEachLeafParallel(
+        thread_pool,
+        [&mutex, &parallel_region_leaves](const OctreeIndex& node_index,
+                                          FloatingPoint value) {
+          std::scoped_lock lock(mutex);
+          TestFixture::addLeaf(parallel_region_leaves, node_index, value);
+        },
+        region);
+    EXPECT_EQ(parallel_region_leaves, reference_region_leaves);
+  }
+}
+
+TYPED_TEST(LeafVisitorTest, RegionShapes) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = TestFixture::getRandomMap();
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    const Point3D center =
+        min_cell_width *
+        TestFixture::template getRandomIndex<3>(Index3D::Constant(-500),
+                                                Index3D::Constant(500))
+            .template cast<FloatingPoint>();
+
+    // Small and large axis-aligned regions
+    TestFixture::checkRegionVisitors(
+        *map, AABB<Point3D>{center, center + Point3D::Constant(
+                                                 20.f * min_cell_width)});
+    TestFixture::checkRegionVisitors(
+        *map, TestFixture::getRandomRegion(min_cell_width));
+
+    // Spheres
+    for (const FloatingPoint radius : {2.f, 50.f, 500.f}) {
+      TestFixture::checkRegionVisitors(
+          *map, Sphere<Point3D>{center, radius * min_cell_width});
+    }
+
+    // Oriented boxes
+    Point3D half_extents;
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      half_extents[dim_idx] =
+          min_cell_width * TestFixture::getRandomSignedDistance(1.f, 200.f);
+    }
+    TestFixture::checkRegionVisitors(
+        *map, OrientedBox<Point3D>{
+                  center, half_extents,
+                  TestFixture::getRandomTransformation().getRotationMatrix()});
+
+    // Empty regions
+    TestFixture::checkRegionVisitors(*map, AABB<Point3D>{});
+    TestFixture::checkRegionVisitors(*map, Sphere<Point3D>{});
+  }
+}
+
+TYPED_TEST(LeafVisitorTest, EarlyTermination) {
+  const auto map = TestFixture::getRandomMap();
+  size_t num_leaves = 0u;
+  map->forEachLeaf([&num_leaves](const OctreeIndex& /*node_index*/,
+                                 FloatingPoint /*value*/) { ++num_leaves; });
+  ASSERT_LT(10u, num_leaves);
+  const AABB<Point3D> unbounded_region{
+      Point3D::Constant(std::numeric_limits<FloatingPoint>::lowest()),
+      Point3D::Constant(std::numeric_limits<FloatingPoint>::max())};
+
+  // Check that the iteration stops as soon as the visitor returns false
+  for (const size_t max_num_leaves : {size_t{1}, size_t{10}, num_leaves}) {
+    size_t num_visited_leaves = 0u;
+    map->forEachLeaf([&num_visited_leaves, max_num_leaves](
+                         const OctreeIndex& /*node_index*/,
+                         FloatingPoint /*value*/) {
+      ++num_visited_leaves;
+      return num_visited_leaves < max_num_leaves;
+    });
+    EXPECT_EQ(num_visited_leaves, max_num_leaves);
+
+    num_visited_leaves = 0u;
+    map->forEachLeafInRegion(
+        unbounded_region,
+        [&num_visited_leaves, max_num_leaves](const OctreeIndex& /*node_index*/,
+                                              FloatingPoint /*value*/) {
+          ++num_visited_leaves;
+          return num_visited_leaves < max_num_leaves;
+        });
+    EXPECT_EQ(num_visited_leaves, max_num_leaves);
+  }
+
+  size_t num_visited_blocks = 0u;
+  map->forEachBlockInRegion(
+      unbounded_region,
+      [&num_visited_blocks](const Index3D& /*block_index*/,
+                            const auto& /*block*/) {
+        ++num_visited_blocks;
+        return false;
+      });
+  EXPECT_EQ(num_visited_blocks, 1u);
+}
+}  // namespace wavemap
@@ -1,5 +1,6 @@
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -11,7 +12,9 @@
 #include "wavemap/core/map/hashed_blocks.h"
 #include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
 #include "wavemap/core/map/volumetric_octree.h"
 #include "wavemap/core/map/wavelet_octree.h"
 #include "wavemap/test/config_generator.h"
@@ -26,11 +29,25 @@ class MapTest : public FixtureBase,
                 public ConfigGenerator {
  protected:
   static constexpr FloatingPoint kAcceptableReconstructionError = 5e-2f;
+
+  // Maps that compress their pruned blocks only preserve values up to the
+  // error that the compression introduces, all other maps preserve them
+  // exactly
+  static FloatingPoint getMaxCompressionError(
+      const typename MapType::Config& config) {
+    if constexpr (std::is_same_v<MapType, QuantizedHashedWaveletOctree>) {
+      return QuantizedCoefficientStorage::getMaxQuantizationError(
+          config.tree_height, config.min_log_odds, config.max_log_odds);
+    } else {
+      return 0.f;
+    }
+  }
 };
 
 using MapTypes =
     ::testing::Types<HashedBlocks, VolumetricOctree, WaveletOctree,
-                     HashedWaveletOctree, HashedChunkedWaveletOctree>;
+                     HashedWaveletOctree, HashedChunkedWaveletOctree,
+                     QuantizedHashedWaveletOctree, LinearHashedWaveletOctree>;
 TYPED_TEST_SUITE(MapTest, MapTypes, );
 
 TYPED_TEST(MapTest, InitializationAndClearing) {
@@ -92,8 +109,9 @@ TYPED_TEST(MapTest, Pruning) {
   EXPECT_FALSE(map_base_ptr->empty());
   EXPECT_LE(map_base_ptr->size(), size_before_pruning);
   EXPECT_LE(map_base_ptr->getMemoryUsage(), memory_usage_before_pruning);
+  const FloatingPoint max_error = TestFixture::getMaxCompressionError(config);
   for (const Index3D& index : nonzero_cell_indexes) {
-    EXPECT_EQ(map_base_ptr->getCellValue(index), 1.f);
+    EXPECT_NEAR(map_base_ptr->getCellValue(index), 1.f, max_error);
   }
 }
 
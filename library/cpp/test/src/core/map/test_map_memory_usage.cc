@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/coarsen.h"
+#include "wavemap/core/utils/edit/enforce_memory_budget.h"
+#include "wavemap/core/utils/shape/aabb.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+template <typename MapType>
+class MapMemoryUsageTest : public FixtureBase,
+                           public GeometryGenerator,
+                           public ConfigGenerator {
+ protected:
+  std::vector<Index3D> fillRandomly(MapType& map) {
+    const std::vector<Index3D> random_indices = getRandomIndexVector<3>(
+        500u, 1000u, Index3D::Constant(-200), Index3D::Constant(200));
+    for (const Index3D& index : random_indices) {
+      map.addToCellValue(index, getRandomUpdate());
+    }
+    map.threshold();
+    return random_indices;
+  }
+};
+
+using MapTypes =
+    ::testing::Types<HashedWaveletOctree, HashedChunkedWaveletOctree>;
+TYPED_TEST_SUITE(MapMemoryUsageTest, MapTypes, );
+
+TYPED_TEST(MapMemoryUsageTest, Accounting) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+    TypeParam map(config);
+    EXPECT_EQ(map.getMemoryUsage(), 0u);
+    this->fillRandomly(map);
+
+    // The total should include the hash map and the blocks' storage
+    const size_t memory_usage = map.getMemoryUsage();
+    size_t block_memory_usage = 0u;
+    map.forEachBlock([&block_memory_usage](const Index3D& /*block_index*/,
+                                           const auto& block) {
+      block_memory_usage += block.getMemoryUsage();
+    });
+    EXPECT_GT(memory_usage,
+              block_memory_usage + map.getHashMap().size() *
+                                       sizeof(typename TypeParam::Block));
+
+    // The per height and per block breakdowns should add up to the total
+    const auto memory_usage_by_height = map.getMemoryUsageByHeight();
+    ASSERT_EQ(memory_usage_by_height.size(), config.tree_height + 1);
+    EXPECT_EQ(std::accumulate(memory_usage_by_height.begin(),
+                              memory_usage_by_height.end(), size_t{0u}),
+              memory_usage);
+    size_t summed_block_memory_usage = 0u;
+    map.forEachBlock([&map, &summed_block_memory_usage](
+                         const Index3D& block_index, const auto& /*block*/) {
+      summed_block_memory_usage += map.getBlockMemoryUsage(block_index);
+    });
+    EXPECT_LE(summed_block_memory_usage, memory_usage);
+    EXPECT_GT(summed_block_memory_usage + map.getHashMap().size(),
+              memory_usage);
+    EXPECT_EQ(map.getBlockMemoryUsage(Index3D::Constant(1000)), 0u);
+
+    // Regions should only include the blocks they overlap
+    const AABB<Point3D> all_blocks{
+        convert::indexToMinCorner(map.getMinIndex(), map.getMinCellWidth()),
+        convert::indexToMinCorner(map.getMaxIndex(), map.getMinCellWidth())};
+    EXPECT_EQ(map.getMemoryUsageInRegion(all_blocks),
+              summed_block_memory_usage);
+    const AABB<Point3D> no_blocks{Point3D::Constant(1e5f),
+                                  Point3D::Constant(1e5f + 1.f)};
+    EXPECT_EQ(map.getMemoryUsageInRegion(no_blocks), 0u);
+
+    // Erasing all blocks should release all memory
+    map.clear();
+    EXPECT_EQ(map.getMemoryUsage(), 0u);
+  }
+}
+
+TYPED_TEST(MapMemoryUsageTest, Coarsening) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+    TypeParam map(config);
+    const auto random_indices = this->fillRandomly(map);
+    const auto memory_usage_by_height = map.getMemoryUsageByHeight();
+
+    const IndexElement termination_height =
+        TestFixture::getRandomInteger(1, config.tree_height);
+    std::vector<FloatingPoint> coarse_values;
+    for (const Index3D& index : random_indices) {
+      const OctreeIndex coarse_index =
+          convert::indexAndHeightToNodeIndex(index, termination_height);
+      coarse_values.emplace_back(map.getCellValue(coarse_index));
+    }
+    std::vector<Timestamp> updated_stamps;
+    std::vector<Timestamp> modified_stamps;
+    map.forEachBlock([&updated_stamps, &modified_stamps](
+                         const Index3D& /*block_index*/, const auto& block) {
+      updated_stamps.emplace_back(block.getLastUpdatedStamp());
+      modified_stamps.emplace_back(block.getLastModifiedStamp());
+    });
+    map.forEachBlock(
+        [termination_height](const Index3D& /*block_index*/, auto& block) {
+          block.coarsen(termination_height);
+        });
+
+    // Coarsening should mark the blocks as modified, but not as updated, and
+    // coarsening them again should not change them
+    size_t block_idx = 0u;
+    std::vector<Timestamp> coarsened_modified_stamps;
+    map.forEachBlock([&](const Index3D& /*block_index*/, auto& block) {
+      EXPECT_EQ(block.getLastUpdatedStamp(), updated_stamps[block_idx]);
+      EXPECT_GE(block.getLastModifiedStamp(), modified_stamps[block_idx]);
+      coarsened_modified_stamps.emplace_back(block.getLastModifiedStamp());
+      block.coarsen(termination_height);
+      EXPECT_EQ(block.getLastModifiedStamp(),
+                coarsened_modified_stamps[block_idx]);
+      ++block_idx;
+    });
+
+    // The memory used by the coefficients below the termination height should
+    // be freed, while all other memory remains in use
+    const auto coarsened_memory_usage_by_height = map.getMemoryUsageByHeight();
+    for (IndexElement height = 0; height <= config.tree_height; ++height) {
+      if (height < termination_height) {
+        EXPECT_EQ(coarsened_memory_usage_by_height[height], 0u);
+      } else {
+        EXPECT_EQ(coarsened_memory_usage_by_height[height],
+                  memory_usage_by_height[height]);
+      }
+    }
+
+    // The values at and above the termination height should be preserved
+    for (size_t idx = 0; idx < random_indices.size(); ++idx) {
+      const Index3D& index = random_indices[idx];
+      const OctreeIndex coarse_index =
+          convert::indexAndHeightToNodeIndex(index, termination_height);
+      EXPECT_FLOAT_EQ(map.getCellValue(coarse_index), coarse_values[idx]);
+      EXPECT_FLOAT_EQ(map.getCellValue(index), coarse_values[idx]);
+    }
+  }
+}
+
+TYPED_TEST(MapMemoryUsageTest, CoarseningByDistance) {
+  constexpr int kNumRepetitions = 4;
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+    TypeParam map(config);
+    this->fillRandomly(map);
+    std::vector<std::pair<Index3D, size_t>> block_memory_usages;
+    map.forEachBlock([&block_memory_usages](const Index3D& block_index,
+                                            const auto& block) {
+      block_memory_usages.emplace_back(block_index, block.getMemoryUsage());
+    });
+
+    const IndexElement termination_height =
+        TestFixture::getRandomInteger(1, config.tree_height);
+    const Point3D center = Point3D::Zero();
+    const FloatingPoint radius = TestFixture::getRandomFloat(0.f, 100.f);
+    const auto& maybe_thread_pool = i % 2 ? thread_pool : nullptr;
+    const size_t num_coarsened_blocks = edit::coarsen(
+        map, termination_height, center, radius, 0.f, maybe_thread_pool);
+
+    // Only the blocks that are fully outside the radius should be coarsened
+    size_t num_blocks_outside_radius = 0u;
+    for (const auto& [block_index, memory_usage] : block_memory_usages) {
+      auto* block = map.getBlock(block_index);
+      ASSERT_NE(block, nullptr);
+      const OctreeIndex block_node_index{config.tree_height, block_index};
+      const auto block_aabb =
+          convert::nodeIndexToAABB(block_node_index, config.min_cell_width);
+      if (block_aabb.minDistanceTo(center) <= radius) {
+        EXPECT_EQ(block->getMemoryUsage(), memory_usage);
+        continue;
+      }
+      ++num_blocks_outside_radius;
+      const size_t coarsened_memory_usage = block->getMemoryUsage();
+      EXPECT_LE(coarsened_memory_usage, memory_usage);
+      block->coarsen(termination_height);
+      EXPECT_EQ(block->getMemoryUsage(), coarsened_memory_usage);
+    }
+    EXPECT_EQ(num_coarsened_blocks, num_blocks_outside_radius);
+    EXPECT_EQ(map.getHashMap().size(), block_memory_usages.size());
+  }
+}
+
+TYPED_TEST(MapMemoryUsageTest, EnforceMemoryBudget) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    // NOTE: The tree height is fixed such that most of the memory is used by
+    //       the blocks' nodes, which coarsening can free.
+    auto config =
+        ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+    config.tree_height = 6;
+    TypeParam map(config);
+    this->fillRandomly(map);
+    const size_t memory_usage = map.getMemoryUsage();
+    const size_t num_blocks = map.getHashMap().size();
+    const Point3D focus_point = Point3D::Zero();
+
+    // Budgets that are met should leave the map untouched
+    EXPECT_EQ(
+        edit::enforceMemoryBudget(map, memory_usage, focus_point, 0, true),
+        memory_usage);
+    EXPECT_EQ(map.getHashMap().size(), num_blocks);
+
+    // Coarsening should suffice to halve the memory usage
+    std::vector<std::pair<Timestamp, Timestamp>> stamps;
+    map.forEachBlock(
+        [&stamps](const Index3D& /*block_index*/, const auto& block) {
+          stamps.emplace_back(block.getLastUpdatedStamp(),
+                              block.getLastModifiedStamp());
+        });
+    const size_t coarsening_budget = memory_usage / 2u;
+    EXPECT_LE(edit::enforceMemoryBudget(map, coarsening_budget, focus_point,
+                                        config.tree_height, false),
+              coarsening_budget);
+    EXPECT_LE(map.getMemoryUsage(), coarsening_budget);
+    EXPECT_EQ(map.getHashMap().size(), num_blocks);
+
+    // The coarsened blocks should be marked as modified, but not as updated
+    size_t block_idx = 0u;
+    bool any_block_modified = false;
+    map.forEachBlock([&](const Index3D& /*block_index*/, const auto& block) {
+      const auto& [updated_stamp, modified_stamp] = stamps[block_idx++];
+      EXPECT_EQ(block.getLastUpdatedStamp(), updated_stamp);
+      EXPECT_GE(block.getLastModifiedStamp(), modified_stamp);
+      any_block_modified |= modified_stamp < block.getLastModifiedStamp();
+    });
+    EXPECT_TRUE(any_block_modified);
+
+    // Without coarsening, blocks have to be evicted, furthest first
+    std::vector<std::pair<Index3D, FloatingPoint>> block_distances;
+    map.forEachBlock([&map, &focus_point, &block_distances](
+                         const Index3D& block_index, const auto& /*block*/) {
+      const OctreeIndex block_node_index{map.getTreeHeight(), block_index};
+      block_distances.emplace_back(
+          block_index,
+          convert::nodeIndexToAABB(block_node_index, map.getMinCellWidth())
+              .minDistanceTo(focus_point));
+    });
+    const size_t eviction_budget = map.getMemoryUsage() / 2u;
+    EXPECT_LE(
+        edit::enforceMemoryBudget(map, eviction_budget, focus_point, 0, true),
+        eviction_budget);
+    EXPECT_LE(map.getMemoryUsage(), eviction_budget);
+    EXPECT_LT(map.getHashMap().size(), num_blocks);
+    FloatingPoint max_remaining_distance = 0.f;
+    FloatingPoint min_evicted_distance = std::numeric_limits<float>::max();
+    for (const auto& [block_index, distance] : block_distances) {
+      if (map.hasBlock(block_index)) {
+        max_remaining_distance = std::max(max_remaining_distance, distance);
+      } else {
+        min_evicted_distance = std::min(min_evicted_distance, distance);
+      }
+    }
+    EXPECT_LE(max_remaining_distance, min_evicted_distance);
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,179 @@
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/sum.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class QuantizedHashedWaveletOctreeTest : public FixtureBase,
+                                         public GeometryGenerator,
+                                         public ConfigGenerator {
+ protected:
+  static constexpr FloatingPoint kAcceptableReconstructionError = 5e-2f;
+};
+
+TEST_F(QuantizedHashedWaveletOctreeTest, QuantizationErrorBound) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    // Create a random map at full and at quantized precision
+    const auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    HashedWaveletOctree map(config);
+    QuantizedHashedWaveletOctree quantized_map(config);
+    auto update_randomly = [this, &map, &quantized_map]() {
+      for (const Index3D& index : getRandomIndexVector<3>(
+               1000u, 2000u, Index3D::Constant(-500), Index3D::Constant(500))) {
+        const FloatingPoint update = getRandomFloat(-3.f, 3.f);
+        map.addToCellValue(index, update);
+        quantized_map.addToCellValue(index, update);
+      }
+    };
+    auto expect_values_near = [&map, &quantized_map](FloatingPoint max_error) {
+      map.forEachLeaf([&map, &quantized_map, max_error](
+                          const OctreeIndex& node_index,
+                          FloatingPoint /*value*/) {
+        EXPECT_NEAR(quantized_map.getCellValue(node_index),
+                    map.getCellValue(node_index), max_error)
+            << "At node index " << node_index.toString();
+      });
+    };
+
+    // Check that blocks are updated and thresholded at full precision
+    update_randomly();
+    expect_values_near(0.f);
+    map.threshold();
+    quantized_map.threshold();
+    expect_values_near(0.f);
+    EXPECT_EQ(quantized_map.size(), map.size());
+
+    // Check that pruning quantizes the blocks, and that all values remain
+    // within the documented error bound
+    map.prune();
+    quantized_map.prune();
+    const FloatingPoint max_error =
+        QuantizedCoefficientStorage::getMaxQuantizationError(
+            config.tree_height, config.min_log_odds, config.max_log_odds) +
+        kEpsilon;
+    EXPECT_LE(quantized_map.size(), map.size());
+    EXPECT_LT(quantized_map.getMemoryUsage(), map.getMemoryUsage());
+    expect_values_near(max_error);
+
+    // Check that updating quantized blocks restores them at full precision
+    update_randomly();
+    map.threshold();
+    quantized_map.threshold();
+    expect_values_near(max_error);
+    quantized_map.forEachBlock(
+        [](const Index3D& /*block_index*/,
+           const QuantizedHashedWaveletOctree::Block& block) {
+          if (block.getNeedsPruning()) {
+            EXPECT_FALSE(block.getCoefficientStorage().isCompressed());
+          }
+        });
+  }
+}
+
+TEST_F(QuantizedHashedWaveletOctreeTest, PruneSmart) {
+  // Check that blocks that are still being updated are not quantized
+  auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+  config.only_prune_blocks_if_unused_for = 1e3f;
+  HashedWaveletOctree map(config);
+  QuantizedHashedWaveletOctree quantized_map(config);
+  for (const Index3D& index : getRandomIndexVector<3>()) {
+    const FloatingPoint update = getRandomFloat(-3.f, 3.f);
+    map.addToCellValue(index, update);
+    quantized_map.addToCellValue(index, update);
+  }
+  map.pruneSmart();
+  quantized_map.pruneSmart();
+  EXPECT_EQ(quantized_map.size(), map.size());
+  quantized_map.forEachBlock(
+      [](const Index3D& /*block_index*/,
+         const QuantizedHashedWaveletOctree::Block& block) {
+        EXPECT_FALSE(block.getCoefficientStorage().isCompressed());
+      });
+  map.forEachLeaf([&map, &quantized_map](const OctreeIndex& node_index,
+                                         FloatingPoint /*value*/) {
+    EXPECT_EQ(quantized_map.getCellValue(node_index),
+              map.getCellValue(node_index))
+        << "At node index " << node_index.toString();
+  });
+}
+
+TEST_F(QuantizedHashedWaveletOctreeTest, InsertionAndPruning) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    QuantizedHashedWaveletOctree map(config);
+    const size_t empty_map_memory_usage = map.getMemoryUsage();
+
+    // Check that pruning removes all zero cells
+    for (const Index3D& index : getRandomIndexVector<3>()) {
+      map.setCellValue(index, 0.f);
+    }
+    map.prune();
+    EXPECT_TRUE(map.empty());
+    EXPECT_LE(map.getMemoryUsage(), empty_map_memory_usage);
+
+    // Check that setting cells to values within the map's bounds is accurate
+    // and that pruning preserves them
+    const std::vector<Index3D> random_indices = getRandomIndexVector<3>();
+    std::vector<FloatingPoint> random_values;
+    for (const Index3D& index : random_indices) {
+      random_values.emplace_back(
+          getRandomFloat(config.min_log_odds, config.max_log_odds));
+      map.setCellValue(index, random_values.back());
+    }
+    map.prune();
+    EXPECT_FALSE(map.empty());
+    for (size_t idx = 0; idx < random_indices.size(); ++idx) {
+      EXPECT_NEAR(map.getCellValue(random_indices[idx]), random_values[idx],
+                  kAcceptableReconstructionError);
+    }
+  }
+}
+
+TEST_F(QuantizedHashedWaveletOctreeTest, Sum) {
+  // Check that summing reads the coefficients of quantized blocks
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (const bool use_thread_pool : {false, true}) {
+    auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    config.min_log_odds = -1e2f;
+    config.max_log_odds = 1e2f;
+    QuantizedHashedWaveletOctree map_A(config);
+    QuantizedHashedWaveletOctree map_B(config);
+    const std::vector<Index3D> random_indices = getRandomIndexVector<3>(
+        200u, 500u, Index3D::Constant(-100), Index3D::Constant(100));
+    for (const Index3D& index : random_indices) {
+      map_A.addToCellValue(index, getRandomFloat(-3.f, 3.f));
+      map_B.addToCellValue(index, getRandomFloat(-3.f, 3.f));
+    }
+    map_A.prune();
+    map_B.prune();
+    std::vector<FloatingPoint> expected_values;
+    for (const Index3D& index : random_indices) {
+      expected_values.emplace_back(map_A.getCellValue(index) +
+                                   map_B.getCellValue(index));
+    }
+
+    edit::sum(map_A, map_B, use_thread_pool ? thread_pool : nullptr);
+    map_A.prune();
+    const FloatingPoint max_error =
+        2.f * QuantizedCoefficientStorage::getMaxQuantizationError(
+                  config.tree_height, config.min_log_odds,
+                  config.max_log_odds) +
+        kEpsilon;
+    for (size_t idx = 0; idx < random_indices.size(); ++idx) {
+      EXPECT_NEAR(map_A.getCellValue(random_indices[idx]),
+                  expected_values[idx], max_error);
+    }
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,97 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
+#include "wavemap/core/utils/bits/morton_encoding.h"
+#include "wavemap/core/utils/print/eigen.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class MortonBatchEncodingTest : public FixtureBase, public GeometryGenerator {
+ protected:
+  static std::vector<morton::BatchCodecType> getSupportedCodecs() {
+    std::vector<morton::BatchCodecType> supported_codecs;
+    for (int codec_id = 0;
+         codec_id < static_cast<int>(morton::BatchCodecType::names.size());
+         ++codec_id) {
+      if (morton::isSupported(codec_id)) {
+        supported_codecs.emplace_back(codec_id);
+      }
+    }
+    return supported_codecs;
+  }
+};
+
+TEST_F(MortonBatchEncodingTest, DefaultCodec) {
+  EXPECT_TRUE(morton::isSupported(morton::BatchCodecType::kScalar));
+  EXPECT_TRUE(morton::isSupported(morton::getDefaultBatchCodec()));
+}
+
+TEST_F(MortonBatchEncodingTest, Equivalence) {
+  constexpr IndexElement kMaxCoordinate = morton::kMaxSingleCoordinate<3>;
+  for (const auto& codec : getSupportedCodecs()) {
+    for (int repetition = 0; repetition < 10; ++repetition) {
+      // NOTE: Negative coordinates are included since Morton codes are also
+      //       used as relative offsets.
+      std::vector<Index3D> indices = getRandomIndexVector<3>(
+          1u, 1000u, Index3D::Constant(-kMaxCoordinate),
+          Index3D::Constant(kMaxCoordinate));
+      indices.emplace_back(Index3D::Zero());
+      indices.emplace_back(Index3D::Constant(kMaxCoordinate));
+      indices.emplace_back(Index3D::Constant(-1));
+
+      // All codecs should match the scalar encoder, including for negative
+      // coordinates
+      std::vector<MortonIndex> codes(indices.size());
+      morton::encode_batch(indices.data(), indices.size(), codes.data(), codec);
+      for (size_t idx = 0; idx < indices.size(); ++idx) {
+        EXPECT_EQ(codes[idx], morton::encode<3>(indices[idx]))
+            << "For codec " << codec.toStr() << " and index "
+            << print::eigen::oneLine(indices[idx]);
+      }
+
+      // NOTE: Since negative signs are not preserved, only codes of positive
+      //       indices are valid inputs for the decoders.
+      std::vector<MortonIndex> valid_codes;
+      std::vector<Index3D> positive_indices;
+      for (size_t idx = 0; idx < indices.size(); ++idx) {
+        if ((indices[idx].array() >= 0).all()) {
+          valid_codes.emplace_back(codes[idx]);
+          positive_indices.emplace_back(indices[idx]);
+        }
+      }
+      std::vector<Index3D> decoded_indices(valid_codes.size());
+      morton::decode_batch(valid_codes.data(), valid_codes.size(),
+                           decoded_indices.data(), codec);
+      for (size_t idx = 0; idx < valid_codes.size(); ++idx) {
+        EXPECT_EQ(decoded_indices[idx], morton::decode<3>(valid_codes[idx]))
+            << "For codec " << codec.toStr() << " and Morton code "
+            << valid_codes[idx];
+        EXPECT_EQ(decoded_indices[idx], positive_indices[idx]);
+      }
+    }
+  }
+}
+
+TEST_F(MortonBatchEncodingTest, NodeIndexConversions) {
+  for (int repetition = 0; repetition < 10; ++repetition) {
+    std::vector<OctreeIndex> node_indices;
+    for (const Index3D& position : getRandomIndexVector<3>(
+             1u, 100u, Index3D::Zero(), Index3D::Constant(1000))) {
+      node_indices.emplace_back(
+          OctreeIndex{getRandomInteger(0, 10), position});
+    }
+    const std::vector<MortonIndex> morton_codes =
+        convert::nodeIndicesToMorton(node_indices);
+    ASSERT_EQ(morton_codes.size(), node_indices.size());
+    for (size_t idx = 0; idx < node_indices.size(); ++idx) {
+      EXPECT_EQ(morton_codes[idx],
+                convert::nodeIndexToMorton(node_indices[idx]));
+    }
+  }
+}
+}  // namespace wavemap
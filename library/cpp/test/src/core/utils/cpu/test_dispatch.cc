@@ -0,0 +1,51 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/utils/bits/morton_batch_encoding.h"
+#include "wavemap/core/utils/cpu/cpu_features.h"
+#include "wavemap/core/utils/cpu/dispatch.h"
+
+namespace wavemap {
+TEST(CpuDispatchTest, Features) {
+  // Feature detection should be consistent across calls
+  const cpu::Features& features = cpu::getFeatures();
+  EXPECT_EQ(&features, &cpu::getFeatures());
+
+  // Higher microarchitecture levels include the lower ones' features
+  if (features.x86_64_v4) {
+    EXPECT_TRUE(features.x86_64_v3);
+    EXPECT_TRUE(features.avx512f);
+  }
+  if (features.x86_64_v3) {
+    EXPECT_TRUE(features.avx2);
+    EXPECT_TRUE(features.bmi2);
+  }
+
+  // Code compiled for a given instruction set can only run on CPUs with it
+#ifdef __AVX2__
+  EXPECT_TRUE(features.avx2);
+#endif
+#ifdef __BMI2__
+  EXPECT_TRUE(features.bmi2);
+#endif
+}
+
+TEST(CpuDispatchTest, ActiveKernelPaths) {
+  const auto kernel_paths = cpu::getActiveKernelPaths();
+  EXPECT_FALSE(kernel_paths.empty());
+  const std::string report = cpu::getActiveKernelPathsStr();
+  for (const auto& [kernel, path] : kernel_paths) {
+    EXPECT_FALSE(kernel.empty());
+    EXPECT_FALSE(path.empty());
+    EXPECT_NE(report.find(kernel + ": " + path), std::string::npos);
+    if (kernel == "morton_batch_coding") {
+      EXPECT_EQ(path.find(morton::getDefaultBatchCodec().toStr()), 0u);
+    }
+    // Kernels called through virtual methods cannot be multiversioned
+    if (kernel == "measurement_models" || kernel == "range_image_projection") {
+      EXPECT_NE(path.find("(compile time)"), std::string::npos);
+    }
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,163 @@
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/crop.h"
+#include "wavemap/core/utils/edit/multiply.h"
+#include "wavemap/core/utils/edit/sum.h"
+#include "wavemap/core/utils/shape/sphere.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+// NOTE: Hashed chunked wavelet octrees are edited chunk by chunk, while hashed
+//       wavelet octrees are edited node by node. The tests below check that
+//       both implementations produce the same maps.
+class MapEditsTest : public FixtureBase,
+                     public GeometryGenerator,
+                     public ConfigGenerator {
+ protected:
+  static constexpr FloatingPoint kTolerance = 1e-4f;
+
+  struct MapPair {
+    explicit MapPair(const HashedChunkedWaveletOctreeConfig& config)
+        : chunked_map(config), map(getEquivalentConfig(config)) {}
+
+    HashedChunkedWaveletOctree chunked_map;
+    HashedWaveletOctree map;
+  };
+
+  static HashedWaveletOctreeConfig getEquivalentConfig(
+      const HashedChunkedWaveletOctreeConfig& config) {
+    HashedWaveletOctreeConfig equivalent_config;
+    equivalent_config.min_cell_width = config.min_cell_width;
+    equivalent_config.min_log_odds = config.min_log_odds;
+    equivalent_config.max_log_odds = config.max_log_odds;
+    equivalent_config.tree_height = config.tree_height;
+    return equivalent_config;
+  }
+
+  std::vector<Index3D> fillRandomly(MapPair& maps) {
+    const std::vector<Index3D> random_indices = getRandomIndexVector<3>(
+        200u, 500u, Index3D::Constant(-100), Index3D::Constant(100));
+    for (const Index3D& index : random_indices) {
+      const FloatingPoint update = getRandomUpdate(-1e1f, 1e1f);
+      maps.chunked_map.addToCellValue(index, update);
+      maps.map.addToCellValue(index, update);
+    }
+    return random_indices;
+  }
+
+  static void expectEqualValues(const MapPair& maps,
+                                const std::vector<Index3D>& indices) {
+    for (const Index3D& index : indices) {
+      const FloatingPoint expected_value = maps.map.getCellValue(index);
+      EXPECT_NEAR(maps.chunked_map.getCellValue(index), expected_value,
+                  kTolerance * (1.f + std::abs(expected_value)));
+    }
+  }
+};
+
+TEST_F(MapEditsTest, Multiply) {
+  constexpr int kNumRepetitions = 4;
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config = getRandomConfig<HashedChunkedWaveletOctreeConfig>();
+    MapPair maps(config);
+    const auto random_indices = fillRandomly(maps);
+    std::vector<FloatingPoint> original_values;
+    for (const Index3D& index : random_indices) {
+      original_values.emplace_back(maps.chunked_map.getCellValue(index));
+    }
+
+    const FloatingPoint multiplier = getRandomFloat(-2.f, 2.f);
+    const auto& maybe_thread_pool = i % 2 ? thread_pool : nullptr;
+    edit::multiply(maps.chunked_map, multiplier, maybe_thread_pool);
+    edit::multiply(maps.map, multiplier, maybe_thread_pool);
+
+    expectEqualValues(maps, random_indices);
+    for (size_t idx = 0; idx < random_indices.size(); ++idx) {
+      const FloatingPoint expected_value = multiplier * original_values[idx];
+      EXPECT_NEAR(maps.chunked_map.getCellValue(random_indices[idx]),
+                  expected_value,
+                  kTolerance * (1.f + std::abs(expected_value)));
+    }
+  }
+}
+
+TEST_F(MapEditsTest, Sum) {
+  constexpr int kNumRepetitions = 4;
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    // NOTE: Summing prunes the updated blocks, which also thresholds them. We
+    //       therefore widen the thresholds, such that the sums are preserved.
+    auto config = getRandomConfig<HashedChunkedWaveletOctreeConfig>();
+    config.min_log_odds = -1e3f;
+    config.max_log_odds = 1e3f;
+    MapPair maps_A(config);
+    MapPair maps_B(config);
+    auto random_indices = fillRandomly(maps_A);
+    const auto random_indices_B = fillRandomly(maps_B);
+    random_indices.insert(random_indices.end(), random_indices_B.begin(),
+                          random_indices_B.end());
+    std::vector<FloatingPoint> expected_values;
+    for (const Index3D& index : random_indices) {
+      expected_values.emplace_back(maps_A.chunked_map.getCellValue(index) +
+                                   maps_B.chunked_map.getCellValue(index));
+    }
+
+    const auto& maybe_thread_pool = i % 2 ? thread_pool : nullptr;
+    edit::sum(maps_A.chunked_map, maps_B.chunked_map, maybe_thread_pool);
+    edit::sum(maps_A.map, maps_B.map, maybe_thread_pool);
+
+    expectEqualValues(maps_A, random_indices);
+    for (size_t idx = 0; idx < random_indices.size(); ++idx) {
+      EXPECT_NEAR(maps_A.chunked_map.getCellValue(random_indices[idx]),
+                  expected_values[idx],
+                  kTolerance * (1.f + std::abs(expected_values[idx])));
+    }
+    EXPECT_EQ(maps_A.chunked_map.getHashMap().size(),
+              maps_A.map.getHashMap().size());
+  }
+}
+TEST_F(MapEditsTest, CropLinear) {
+  // Check that linear octrees, whose nodes move when children are allocated or
+  // erased, are cropped the same way as regular ones
+  constexpr int kNumRepetitions = 4;
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config = getRandomConfig<HashedWaveletOctreeConfig>();
+    HashedWaveletOctree map(config);
+    LinearHashedWaveletOctree linear_map(config);
+    const std::vector<Index3D> random_indices = getRandomIndexVector<3>(
+        200u, 500u, Index3D::Constant(-100), Index3D::Constant(100));
+    for (const Index3D& index : random_indices) {
+      const FloatingPoint update = getRandomUpdate(-1e1f, 1e1f);
+      map.addToCellValue(index, update);
+      linear_map.addToCellValue(index, update);
+    }
+
+    const FloatingPoint radius =
+        getRandomFloat(10.f, 50.f) * config.min_cell_width;
+    const Sphere<Point3D> mask{Point3D::Zero(), radius};
+    const auto& maybe_thread_pool = i % 2 ? thread_pool : nullptr;
+    edit::crop(map, mask, 0, maybe_thread_pool);
+    edit::crop(linear_map, mask, 0, maybe_thread_pool);
+
+    for (const Index3D& index : random_indices) {
+      const FloatingPoint expected_value = map.getCellValue(index);
+      EXPECT_NEAR(linear_map.getCellValue(index), expected_value,
+                  kTolerance * (1.f + std::abs(expected_value)));
+    }
+    EXPECT_EQ(linear_map.getHashMap().size(), map.getHashMap().size());
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,191 @@
+#include <array>
+#include <cmath>
+#include <map>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/edit/coarsen.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/mesh/surface_extractor.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+template <typename MapType>
+class SurfaceExtractorTest : public FixtureBase,
+                             public GeometryGenerator,
+                             public ConfigGenerator {
+ protected:
+  // Fill a cube of cells with free space, containing an occupied ball
+  static void addBall(MapType& map, const Index3D& center,
+                      IndexElement radius) {
+    const FloatingPoint occupied_value = map.getMaxLogOdds();
+    const FloatingPoint free_value = map.getMinLogOdds();
+    for (const Index3D& index : Grid<3>(center.array() - radius - 2,
+                                        center.array() + radius + 2)) {
+      const bool is_inside = (index - center).squaredNorm() <= radius * radius;
+      map.setCellValue(index, is_inside ? occupied_value : free_value);
+    }
+  }
+
+  // Check that every edge is shared by exactly two triangles with opposite
+  // orientations, which implies that the mesh is closed and consistently
+  // oriented. Vertices are identified by their positions, since vertices that
+  // lie on block seams are duplicated in the meshes of each block.
+  static void expectClosedAndOriented(const SurfaceMesh& mesh) {
+    using Vertex = std::array<FloatingPoint, 3>;
+    std::map<std::pair<Vertex, Vertex>, int> directed_edge_counts;
+    for (const auto& triangle : mesh.triangles) {
+      for (int edge_idx = 0; edge_idx < 3; ++edge_idx) {
+        const Point3D& start = mesh.vertices[triangle[edge_idx]];
+        const Point3D& end = mesh.vertices[triangle[(edge_idx + 1) % 3]];
+        ++directed_edge_counts[{{start.x(), start.y(), start.z()},
+                                {end.x(), end.y(), end.z()}}];
+      }
+    }
+    for (const auto& [edge, count] : directed_edge_counts) {
+      EXPECT_EQ(count, 1);
+      const auto reverse_edge = directed_edge_counts.find({edge.second,
+                                                           edge.first});
+      ASSERT_NE(reverse_edge, directed_edge_counts.end());
+      EXPECT_EQ(reverse_edge->second, 1);
+    }
+  }
+};
+
+using MapTypes =
+    ::testing::Types<HashedWaveletOctree, HashedChunkedWaveletOctree>;
+TYPED_TEST_SUITE(SurfaceExtractorTest, MapTypes, );
+
+TYPED_TEST(SurfaceExtractorTest, BallSurface) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+    TypeParam map{config};
+    const Index3D center =
+        GeometryGenerator::getRandomIndex<3>(Index3D::Constant(-50),
+                                             Index3D::Constant(50));
+    const IndexElement radius = TestFixture::getRandomInteger(2, 12);
+    TestFixture::addBall(map, center, radius);
+    map.prune();
+
+    SurfaceExtractor surface_extractor;
+    surface_extractor.update(map);
+    const SurfaceMesh mesh = surface_extractor.getMesh();
+    ASSERT_FALSE(mesh.empty());
+    TestFixture::expectClosedAndOriented(mesh);
+
+    // All vertices lie between the occupied and free cells
+    const FloatingPoint min_cell_width = map.getMinCellWidth();
+    const Point3D center_point =
+        convert::indexToCenterPoint(center, min_cell_width);
+    for (const Point3D& vertex : mesh.vertices) {
+      const FloatingPoint distance = (vertex - center_point).norm();
+      EXPECT_LE(distance, (radius + std::sqrt(3.f)) * min_cell_width);
+    }
+
+    // The normals point out of the ball, which means that the mesh's signed
+    // volume is positive and close to the volume of the ball
+    FloatingPoint volume = 0.f;
+    for (const auto& triangle : mesh.triangles) {
+      const Point3D vertex_0 = mesh.vertices[triangle[0]] - center_point;
+      const Point3D vertex_1 = mesh.vertices[triangle[1]] - center_point;
+      const Point3D vertex_2 = mesh.vertices[triangle[2]] - center_point;
+      volume += vertex_0.dot(vertex_1.cross(vertex_2)) / 6.f;
+    }
+    const FloatingPoint ball_volume = 4.f / 3.f * kPi *
+                                      std::pow(radius * min_cell_width, 3.f);
+    EXPECT_GT(volume, 0.5f * ball_volume);
+    EXPECT_LT(volume, 2.f * ball_volume);
+  }
+}
+
+TYPED_TEST(SurfaceExtractorTest, IncrementalUpdates) {
+  const auto config =
+      ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+  TypeParam map{config};
+  TestFixture::addBall(map, Index3D::Constant(-20), 6);
+  TestFixture::addBall(map, Index3D::Constant(20), 6);
+
+  SurfaceExtractor incremental_extractor;
+  const auto initially_updated_blocks = incremental_extractor.update(map);
+  EXPECT_FALSE(initially_updated_blocks.empty());
+  EXPECT_TRUE(incremental_extractor.update(map).empty());
+
+  // Change one of the balls, after which only the blocks that overlap it or
+  // neighbor it in the negative direction should be remeshed
+  const Index3D changed_min = Index3D::Constant(20 - 3 - 2);
+  const Index3D changed_max = Index3D::Constant(20 + 3 + 2);
+  TestFixture::addBall(map, Index3D::Constant(20), 3);
+  const auto updated_blocks = incremental_extractor.update(map);
+  EXPECT_FALSE(updated_blocks.empty());
+  const IndexElement tree_height = map.getTreeHeight();
+  const IndexElement cells_per_block_side = int_math::exp2(tree_height);
+  for (const Index3D& block_index : updated_blocks) {
+    const OctreeIndex block_node_index{tree_height, block_index};
+    const Index3D block_min =
+        convert::nodeIndexToMinCornerIndex(block_node_index);
+    const Index3D block_max =
+        convert::nodeIndexToMaxCornerIndex(block_node_index);
+    EXPECT_TRUE((block_min.array() <= changed_max.array()).all());
+    EXPECT_TRUE(
+        (changed_min.array() <= block_max.array() + cells_per_block_side)
+            .all());
+  }
+
+  // The incrementally updated meshes should match meshes built from scratch
+  SurfaceExtractor batch_extractor;
+  batch_extractor.update(map);
+  const auto& incremental_meshes = incremental_extractor.getBlockMeshes();
+  const auto& batch_meshes = batch_extractor.getBlockMeshes();
+  ASSERT_EQ(incremental_meshes.size(), batch_meshes.size());
+  for (const auto& [block_index, batch_mesh] : batch_meshes) {
+    const auto it = incremental_meshes.find(block_index);
+    ASSERT_NE(it, incremental_meshes.end());
+    EXPECT_EQ(it->second.vertices, batch_mesh.vertices);
+    EXPECT_EQ(it->second.triangles, batch_mesh.triangles);
+  }
+
+  // Removing all blocks should remove all meshes
+  map.clear();
+  incremental_extractor.update(map);
+  EXPECT_TRUE(incremental_extractor.getBlockMeshes().empty());
+}
+
+TYPED_TEST(SurfaceExtractorTest, Coarsening) {
+  const auto config =
+      ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+  TypeParam map{config};
+  TestFixture::addBall(map, Index3D::Constant(0), 8);
+  SurfaceExtractor incremental_extractor;
+  incremental_extractor.update(map);
+  ASSERT_TRUE(incremental_extractor.update(map).empty());
+
+  // Coarsening changes the blocks' values without observing them, but should
+  // still cause them to be remeshed
+  const size_t num_coarsened_blocks = edit::coarsenIf(
+      map, 1, [](const Index3D& /*block_index*/, const auto& /*block*/) {
+        return true;
+      });
+  ASSERT_EQ(num_coarsened_blocks, map.getHashMap().size());
+  EXPECT_FALSE(incremental_extractor.update(map).empty());
+
+  SurfaceExtractor batch_extractor;
+  batch_extractor.update(map);
+  const auto& incremental_meshes = incremental_extractor.getBlockMeshes();
+  const auto& batch_meshes = batch_extractor.getBlockMeshes();
+  ASSERT_EQ(incremental_meshes.size(), batch_meshes.size());
+  for (const auto& [block_index, batch_mesh] : batch_meshes) {
+    const auto it = incremental_meshes.find(block_index);
+    ASSERT_NE(it, incremental_meshes.end());
+    EXPECT_EQ(it->second.vertices, batch_mesh.vertices);
+    EXPECT_EQ(it->second.triangles, batch_mesh.triangles);
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,113 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/profile/metrics.h"
+
+namespace wavemap {
+TEST(MetricsTest, CountersAndGauges) {
+  metrics::Registry registry;
+  auto& counter = registry.getCounter("test_total");
+  EXPECT_EQ(&counter, &registry.getCounter("test_total"));
+  EXPECT_EQ(counter.get(), 0u);
+  counter.increment();
+  counter.increment(4u);
+  EXPECT_EQ(counter.get(), 5u);
+
+  auto& gauge = registry.getGauge("test_gauge");
+  gauge.set(2.5);
+  gauge.add(-1.0);
+  EXPECT_DOUBLE_EQ(gauge.get(), 1.5);
+
+  registry.reset();
+  EXPECT_EQ(counter.get(), 0u);
+  EXPECT_EQ(gauge.get(), 0.0);
+}
+
+TEST(MetricsTest, HistogramBuckets) {
+  metrics::Histogram histogram;
+  const double min_bound = metrics::Histogram::kMinUpperBound;
+  histogram.observe(0.0);
+  histogram.observe(min_bound);
+  histogram.observe(1.5 * min_bound);
+  histogram.observe(3.0 * min_bound);
+  histogram.observe(1e9);
+  EXPECT_EQ(histogram.getCount(), 5u);
+  EXPECT_DOUBLE_EQ(histogram.getSum(), 5.5 * min_bound + 1e9);
+  EXPECT_EQ(histogram.getBucketCount(0), 2u);
+  EXPECT_EQ(histogram.getBucketCount(1), 1u);
+  EXPECT_EQ(histogram.getBucketCount(2), 1u);
+  EXPECT_EQ(histogram.getBucketCount(metrics::Histogram::kNumBuckets), 1u);
+  for (int bucket_idx = 0; bucket_idx < metrics::Histogram::kNumBuckets;
+       ++bucket_idx) {
+    EXPECT_LT(histogram.getBucketUpperBound(bucket_idx),
+              histogram.getBucketUpperBound(bucket_idx + 1));
+  }
+}
+
+TEST(MetricsTest, ConcurrentUpdates) {
+  metrics::Registry registry;
+  constexpr int kNumThreads = 4;
+  constexpr int kNumUpdatesPerThread = 10000;
+  std::vector<std::thread> threads;
+  for (int thread_idx = 0; thread_idx < kNumThreads; ++thread_idx) {
+    threads.emplace_back([&registry]() {
+      auto& counter = registry.getCounter("test_total");
+      auto& histogram = registry.getHistogram("test_seconds");
+      for (int update_idx = 0; update_idx < kNumUpdatesPerThread;
+           ++update_idx) {
+        counter.increment();
+        histogram.observe(1.0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(registry.getCounter("test_total").get(),
+            kNumThreads * kNumUpdatesPerThread);
+  EXPECT_EQ(registry.getHistogram("test_seconds").getCount(),
+            kNumThreads * kNumUpdatesPerThread);
+  EXPECT_DOUBLE_EQ(registry.getHistogram("test_seconds").getSum(),
+                   kNumThreads * kNumUpdatesPerThread);
+}
+
+TEST(MetricsTest, Export) {
+  metrics::Registry registry;
+  registry.getCounter("test_total").increment(3u);
+  registry.getGauge("test_gauge").set(0.5);
+  registry.getHistogram("test_seconds").observe(0.1);
+
+  const std::string json = registry.toJson();
+  EXPECT_NE(json.find("\"counters\":{\"test_total\":3}"), std::string::npos);
+  EXPECT_NE(json.find("\"gauges\":{\"test_gauge\":0.5}"), std::string::npos);
+  EXPECT_NE(json.find("\"test_seconds\":{\"count\":1,\"sum\":0.1,"),
+            std::string::npos);
+  EXPECT_NE(json.find("{\"le\":\"+Inf\",\"count\":1}"), std::string::npos);
+
+  const std::string prometheus = registry.toPrometheus();
+  EXPECT_NE(prometheus.find("# TYPE wavemap_test_total counter\n"
+                            "wavemap_test_total 3\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("wavemap_test_gauge 0.5\n"), std::string::npos);
+  EXPECT_NE(prometheus.find("wavemap_test_seconds_bucket{le=\"+Inf\"} 1\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("wavemap_test_seconds_count 1\n"),
+            std::string::npos);
+}
+
+TEST(MetricsTest, MapPruning) {
+  auto& erased_blocks = metrics::getCounter("map_erased_blocks_total");
+  const uint64_t initial_num_erased_blocks = erased_blocks.get();
+
+  HashedWaveletOctree map(HashedWaveletOctreeConfig{});
+  map.getOrAllocateBlock(Index3D::Zero());
+  map.getOrAllocateBlock(Index3D::Ones());
+  map.prune();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(erased_blocks.get(), initial_num_erased_blocks + 2u);
+}
+}  // namespace wavemap
@@ -0,0 +1,179 @@
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/query/collision_checker.h"
+#include "wavemap/core/utils/shape/capsule.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/core/utils/shape/oriented_box.h"
+#include "wavemap/core/utils/shape/sphere.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class CollisionCheckerTest : public FixtureBase,
+                             public GeometryGenerator,
+                             public ConfigGenerator {
+ protected:
+  static constexpr IndexElement kMapExtent = 60;
+
+  std::unique_ptr<HashedWaveletOctree> getRandomMap() {
+    const auto config =
+        ConfigGenerator::getRandomConfig<HashedWaveletOctree::Config>();
+    auto map = std::make_unique<HashedWaveletOctree>(config);
+    for (const Index3D& index : GeometryGenerator::getRandomIndexVector<3>(
+             2000u, 4000u, Index3D::Constant(-kMapExtent),
+             Index3D::Constant(kMapExtent))) {
+      map->addToCellValue(index, getRandomFloat(-2.f, 2.f));
+    }
+    map->prune();
+    return map;
+  }
+
+  Point3D getRandomPointInMap(FloatingPoint min_cell_width) {
+    Point3D point;
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      point[dim_idx] = min_cell_width * getRandomFloat(-1.2f * kMapExtent,
+                                                       1.2f * kMapExtent);
+    }
+    return point;
+  }
+
+  Sphere<Point3D> getRandomSphere(FloatingPoint min_cell_width) {
+    return {getRandomPointInMap(min_cell_width),
+            min_cell_width * getRandomFloat(0.1f, 6.f)};
+  }
+
+  Capsule<Point3D> getRandomCapsule(FloatingPoint min_cell_width) {
+    const Point3D start = getRandomPointInMap(min_cell_width);
+    const Point3D end =
+        start + min_cell_width * getRandomFloat(0.f, 10.f) *
+                    Point3D{getRandomPoint<3>(0.1f, 1.f)}.normalized();
+    return {start, end, min_cell_width * getRandomFloat(0.1f, 4.f)};
+  }
+
+  OrientedBox<Point3D> getRandomOrientedBox(FloatingPoint min_cell_width) {
+    const Point3D half_extents =
+        min_cell_width * Point3D{getRandomFloat(0.1f, 5.f),
+                                 getRandomFloat(0.1f, 5.f),
+                                 getRandomFloat(0.1f, 5.f)};
+    return {getRandomPointInMap(min_cell_width), half_extents,
+            getRandomTransformation().getRotationMatrix()};
+  }
+
+  // Check the shape by classifying every cell it overlaps
+  template <typename ShapeT>
+  static bool isCollidingBruteForce(const HashedWaveletOctree& map,
+                                    const OccupancyClassifier& classifier,
+                                    const ShapeT& shape,
+                                    Occupancy::Mask collision_mask) {
+    const FloatingPoint min_cell_width = map.getMinCellWidth();
+    const AABB<Point3D> aabb = static_cast<AABB<Point3D>>(shape);
+    const Index3D min_index =
+        convert::pointToFloorIndex(aabb.min, 1.f / min_cell_width).array() - 1;
+    const Index3D max_index =
+        convert::pointToCeilIndex(aabb.max, 1.f / min_cell_width).array() + 1;
+    for (const Index3D& index : Grid<3>(min_index, max_index)) {
+      const auto cell_aabb =
+          convert::nodeIndexToAABB(OctreeIndex{0, index}, min_cell_width);
+      if (!shape::overlaps(cell_aabb, shape)) {
+        continue;
+      }
+      // NOTE: Cells outside the map's blocks have value 0 and are therefore
+      //       classified as unobserved.
+      const auto cell_occupancy = classifier.classify(map.getCellValue(index));
+      if (OccupancyClassifier::has(Occupancy::toMask(cell_occupancy),
+                                   collision_mask)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+TEST_F(CollisionCheckerTest, SingleShapes) {
+  constexpr int kNumRepetitions = 3;
+  constexpr int kNumShapes = 100;
+  const OccupancyClassifier classifier;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = getRandomMap();
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    const auto classified_map =
+        std::make_shared<ClassifiedMap>(*map, classifier);
+    for (const Occupancy::Mask collision_mask :
+         {Occupancy::toMask(false, true, true),
+          Occupancy::toMask(Occupancy::kOccupied),
+          Occupancy::toMask(Occupancy::kFree)}) {
+      const CollisionChecker collision_checker{classified_map, collision_mask};
+      for (int shape_idx = 0; shape_idx < kNumShapes; ++shape_idx) {
+        const auto sphere = getRandomSphere(min_cell_width);
+        EXPECT_EQ(collision_checker.isColliding(sphere),
+                  isCollidingBruteForce(*map, classifier, sphere,
+                                        collision_mask))
+            << "For sphere " << sphere.toString();
+        const auto capsule = getRandomCapsule(min_cell_width);
+        EXPECT_EQ(collision_checker.isColliding(capsule),
+                  isCollidingBruteForce(*map, classifier, capsule,
+                                        collision_mask))
+            << "For capsule " << capsule.toString();
+        const auto box = getRandomOrientedBox(min_cell_width);
+        EXPECT_EQ(
+            collision_checker.isColliding(box),
+            isCollidingBruteForce(*map, classifier, box, collision_mask))
+            << "For oriented box " << box.toString();
+      }
+    }
+  }
+}
+
+TEST_F(CollisionCheckerTest, Batches) {
+  constexpr int kNumRepetitions = 3;
+  const OccupancyClassifier classifier;
+  const auto thread_pool = std::make_shared<ThreadPool>();
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = getRandomMap();
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    const CollisionChecker collision_checker{
+        std::make_shared<ClassifiedMap>(*map, classifier),
+        Occupancy::toMask(Occupancy::kOccupied), thread_pool};
+
+    // Robot poses, each approximated by a few spheres
+    std::vector<std::vector<Sphere<Point3D>>> poses(getRandomInteger(1, 300));
+    for (auto& pose : poses) {
+      pose.resize(getRandomInteger(1, 4));
+      for (auto& sphere : pose) {
+        sphere = getRandomSphere(min_cell_width);
+      }
+    }
+
+    const std::vector<bool> is_colliding =
+        collision_checker.checkCollisions(poses);
+    ASSERT_EQ(is_colliding.size(), poses.size());
+    std::optional<size_t> expected_first_collision;
+    for (size_t pose_idx = 0; pose_idx < poses.size(); ++pose_idx) {
+      bool expected_is_colliding = false;
+      for (const auto& sphere : poses[pose_idx]) {
+        expected_is_colliding |= collision_checker.isColliding(sphere);
+      }
+      EXPECT_EQ(is_colliding[pose_idx], expected_is_colliding);
+      if (expected_is_colliding && !expected_first_collision) {
+        expected_first_collision = pose_idx;
+      }
+    }
+    EXPECT_EQ(collision_checker.findFirstCollision(poses),
+              expected_first_collision);
+  }
+  const CollisionChecker empty_checker{std::make_shared<ClassifiedMap>(
+      1.f, 3, classifier)};
+  EXPECT_EQ(empty_checker.findFirstCollision(std::vector<Sphere<Point3D>>{}),
+            std::nullopt);
+  EXPECT_TRUE(empty_checker.checkCollisions(std::vector<Sphere<Point3D>>{})
+                  .empty());
+}
+}  // namespace wavemap
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/query/neighbor_search.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/core/utils/shape/sphere.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class NeighborSearchTest : public FixtureBase,
+                           public GeometryGenerator,
+                           public ConfigGenerator {
+ protected:
+  static constexpr IndexElement kMapExtent = 40;
+
+  std::shared_ptr<ClassifiedMap> getRandomClassifiedMap() {
+    const auto config =
+        ConfigGenerator::getRandomConfig<HashedWaveletOctree::Config>();
+    HashedWaveletOctree map{config};
+    for (const Index3D& index : GeometryGenerator::getRandomIndexVector<3>(
+             500u, 1000u, Index3D::Constant(-kMapExtent),
+             Index3D::Constant(kMapExtent))) {
+      map.addToCellValue(index, getRandomFloat(-2.f, 2.f));
+    }
+    map.prune();
+    return std::make_shared<ClassifiedMap>(map, OccupancyClassifier{});
+  }
+
+  Point3D getRandomPointInMap(FloatingPoint min_cell_width) {
+    Point3D point;
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      point[dim_idx] = min_cell_width * getRandomFloat(-1.5f * kMapExtent,
+                                                       1.5f * kMapExtent);
+    }
+    return point;
+  }
+
+  // Get all occupied cells at the maximum resolution
+  static std::vector<Index3D> getOccupiedCells(
+      const ClassifiedMap& classified_map) {
+    std::vector<Index3D> cells;
+    classified_map.forEachLeafMatching(
+        Occupancy::kOccupied, [&cells](const OctreeIndex& node_index,
+                                       Occupancy::Mask /*occupancy*/) {
+          for (const Index3D& index :
+               Grid<3>(convert::nodeIndexToMinCornerIndex(node_index),
+                       convert::nodeIndexToMaxCornerIndex(node_index))) {
+            cells.emplace_back(index);
+          }
+        });
+    return cells;
+  }
+
+  static FloatingPoint cellDistance(const Index3D& cell_index,
+                                    const Point3D& point,
+                                    FloatingPoint min_cell_width) {
+    return convert::nodeIndexToAABB(OctreeIndex{0, cell_index}, min_cell_width)
+        .minDistanceTo(point);
+  }
+};
+
+TEST_F(NeighborSearchTest, NearestNeighbors) {
+  constexpr int kNumRepetitions = 3;
+  constexpr int kNumQueries = 50;
+  constexpr size_t kK = 10u;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto classified_map = getRandomClassifiedMap();
+    const FloatingPoint min_cell_width = classified_map->getMinCellWidth();
+    const auto occupied_cells = getOccupiedCells(*classified_map);
+    const NeighborSearch neighbor_search{classified_map};
+    for (int query_idx = 0; query_idx < kNumQueries; ++query_idx) {
+      const Point3D point = getRandomPointInMap(min_cell_width);
+      std::vector<FloatingPoint> expected_distances;
+      for (const Index3D& cell_index : occupied_cells) {
+        expected_distances.emplace_back(
+            cellDistance(cell_index, point, min_cell_width));
+      }
+      std::sort(expected_distances.begin(), expected_distances.end());
+
+      // Nearest neighbor
+      const auto nearest = neighbor_search.findNearest(point);
+      ASSERT_EQ(nearest.has_value(), !expected_distances.empty());
+      if (nearest) {
+        EXPECT_NEAR(nearest->distance, expected_distances.front(), kEpsilon);
+        EXPECT_NEAR(
+            cellDistance(nearest->cell_index, point, min_cell_width),
+            nearest->distance, kEpsilon);
+        EXPECT_TRUE(classified_map->isFully(nearest->cell_index,
+                                            Occupancy::kOccupied));
+      }
+
+      // K nearest neighbors
+      const auto k_nearest = neighbor_search.findKNearest(point, kK);
+      ASSERT_EQ(k_nearest.size(), std::min(kK, expected_distances.size()));
+      std::set<std::array<IndexElement, 3>> unique_cells;
+      for (size_t neighbor_idx = 0; neighbor_idx < k_nearest.size();
+           ++neighbor_idx) {
+        const auto& neighbor = k_nearest[neighbor_idx];
+        EXPECT_NEAR(neighbor.distance, expected_distances[neighbor_idx],
+                    kEpsilon);
+        EXPECT_TRUE(unique_cells
+                        .insert({neighbor.cell_index.x(),
+                                 neighbor.cell_index.y(),
+                                 neighbor.cell_index.z()})
+                        .second);
+      }
+
+      // Distance limits
+      if (nearest) {
+        const FloatingPoint max_distance = 0.5f * nearest->distance;
+        EXPECT_EQ(neighbor_search.findNearest(point, max_distance).has_value(),
+                  nearest->distance <= max_distance);
+      }
+    }
+  }
+}
+
+TEST_F(NeighborSearchTest, RadiusSearch) {
+  constexpr int kNumRepetitions = 3;
+  constexpr int kNumQueries = 20;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto classified_map = getRandomClassifiedMap();
+    const FloatingPoint min_cell_width = classified_map->getMinCellWidth();
+    const auto occupied_cells = getOccupiedCells(*classified_map);
+    const NeighborSearch neighbor_search{classified_map};
+    for (int query_idx = 0; query_idx < kNumQueries; ++query_idx) {
+      const Sphere<Point3D> sphere{
+          getRandomPointInMap(min_cell_width),
+          min_cell_width * getRandomFloat(0.f, 0.5f * kMapExtent)};
+      std::set<std::array<IndexElement, 3>> expected_cells;
+      for (const Index3D& cell_index : occupied_cells) {
+        if (shape::overlaps(convert::nodeIndexToAABB(OctreeIndex{0, cell_index},
+                                                     min_cell_width),
+                            sphere)) {
+          expected_cells.insert({cell_index.x(), cell_index.y(),
+                                 cell_index.z()});
+        }
+      }
+
+      std::set<std::array<IndexElement, 3>> found_cells;
+      for (const OctreeIndex& node_index :
+           neighbor_search.findWithinRadius(sphere.center, sphere.radius)) {
+        EXPECT_TRUE(classified_map->isFully(node_index, Occupancy::kOccupied));
+        for (const Index3D& index :
+             Grid<3>(convert::nodeIndexToMinCornerIndex(node_index),
+                     convert::nodeIndexToMaxCornerIndex(node_index))) {
+          EXPECT_TRUE(found_cells.insert({index.x(), index.y(), index.z()})
+                          .second)
+              << "Duplicate cell " << print::eigen::oneLine(index);
+        }
+      }
+      EXPECT_EQ(found_cells, expected_cells);
+    }
+  }
+}
+
+TEST_F(NeighborSearchTest, BatchedDistances) {
+  const auto classified_map = getRandomClassifiedMap();
+  const FloatingPoint min_cell_width = classified_map->getMinCellWidth();
+  const NeighborSearch neighbor_search{classified_map};
+  std::vector<Point3D> points(getRandomInteger(1, 500));
+  std::generate(points.begin(), points.end(),
+                [&]() { return getRandomPointInMap(min_cell_width); });
+  const FloatingPoint max_distance = 10.f * min_cell_width;
+  const auto distances =
+      neighbor_search.getNearestDistances(points, max_distance);
+  ASSERT_EQ(distances.size(), points.size());
+  for (size_t point_idx = 0; point_idx < points.size(); ++point_idx) {
+    const auto nearest =
+        neighbor_search.findNearest(points[point_idx], max_distance);
+    EXPECT_EQ(distances[point_idx],
+              nearest ? nearest->distance : max_distance);
+  }
+}
+
+TEST_F(NeighborSearchTest, UnobservedSpace) {
+  const auto classified_map = getRandomClassifiedMap();
+  const FloatingPoint min_cell_width = classified_map->getMinCellWidth();
+  const NeighborSearch neighbor_search{
+      classified_map, Occupancy::toMask(Occupancy::kUnobserved)};
+  // Points far outside the mapped area lie in unobserved space
+  const Point3D far_point =
+      Point3D::Constant(1e3f * kMapExtent * min_cell_width);
+  const auto nearest = neighbor_search.findNearest(far_point);
+  ASSERT_TRUE(nearest.has_value());
+  EXPECT_EQ(nearest->distance, 0.f);
+  // Cells that are not covered by any block are found as well
+  for (int query_idx = 0; query_idx < 20; ++query_idx) {
+    const Point3D point = getRandomPointInMap(min_cell_width);
+    const auto neighbor = neighbor_search.findNearest(point);
+    ASSERT_TRUE(neighbor.has_value());
+    EXPECT_TRUE(!classified_map->hasBlock(int_math::div_exp2_floor(
+                    neighbor->cell_index, classified_map->getTreeHeight())) ||
+                classified_map->has(neighbor->cell_index,
+                                    Occupancy::kUnobserved));
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,111 @@
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_hashes.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/print/eigen.h"
+#include "wavemap/core/utils/query/classified_map.h"
+#include "wavemap/core/utils/query/point_sampler.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class PointSamplerTest : public FixtureBase,
+                         public GeometryGenerator,
+                         public ConfigGenerator {
+ protected:
+  std::unique_ptr<HashedWaveletOctree> getRandomMap() {
+    const auto config =
+        ConfigGenerator::getRandomConfig<HashedWaveletOctree::Config>();
+    auto map = std::make_unique<HashedWaveletOctree>(config);
+    for (const Index3D& index : GeometryGenerator::getRandomIndexVector<3>(
+             1000u, 2000u, Index3D::Constant(-500), Index3D::Constant(500))) {
+      map->addToCellValue(index, getRandomUpdate());
+    }
+    map->prune();
+    return map;
+  }
+};
+
+TEST_F(PointSamplerTest, RandomBlocks) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = getRandomMap();
+    const OccupancyClassifier classifier;
+    auto classified_map = std::make_shared<ClassifiedMap>(*map, classifier);
+    PointSampler point_sampler{classified_map};
+
+    // Check that only existing blocks are drawn, and that all are reachable
+    const size_t num_blocks = classified_map->getHashMap().size();
+    std::unordered_set<Index3D, IndexHash<3>> drawn_blocks;
+    for (size_t draw_idx = 0; draw_idx < 100u * num_blocks; ++draw_idx) {
+      const auto block_index = point_sampler.getRandomBlock();
+      ASSERT_TRUE(block_index.has_value());
+      EXPECT_TRUE(classified_map->hasBlock(block_index.value()));
+      drawn_blocks.emplace(block_index.value());
+    }
+    EXPECT_EQ(drawn_blocks.size(), num_blocks);
+  }
+}
+
+TEST_F(PointSamplerTest, MatchingPoints) {
+  constexpr int kNumRepetitions = 3;
+  constexpr int kNumDraws = 1000;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = getRandomMap();
+    const OccupancyClassifier classifier;
+    auto classified_map = std::make_shared<ClassifiedMap>(*map, classifier);
+    PointSampler point_sampler{classified_map};
+    const FloatingPoint min_cell_width_inv = 1.f / map->getMinCellWidth();
+
+    for (const auto occupancy_type :
+         {Occupancy::kFree, Occupancy::kOccupied, Occupancy::kUnobserved,
+          Occupancy::kObserved, Occupancy::kAny}) {
+      // Check that the sampled volume matches the map's
+      uint64_t expected_volume = 0u;
+      map->forEachLeaf([&classifier, &expected_volume, occupancy_type](
+                          const OctreeIndex& cell_index,
+                          FloatingPoint cell_log_odds) {
+        if (classifier.is(cell_log_odds, occupancy_type)) {
+          expected_volume += uint64_t{1} << (3 * cell_index.height);
+        }
+      });
+      EXPECT_EQ(point_sampler.getMatchingVolume(occupancy_type),
+                expected_volume);
+
+      // Check that all sampled points match the requested occupancy
+      for (int draw_idx = 0; draw_idx < kNumDraws; ++draw_idx) {
+        const auto point = point_sampler.getRandomPoint(occupancy_type);
+        ASSERT_EQ(point.has_value(), expected_volume != 0u);
+        if (!point) {
+          break;
+        }
+        const Index3D index =
+            convert::pointToNearestIndex(point.value(), min_cell_width_inv);
+        EXPECT_TRUE(classifier.is(map->getCellValue(index), occupancy_type))
+            << "For point " << print::eigen::oneLine(point.value());
+      }
+    }
+  }
+}
+
+TEST_F(PointSamplerTest, Update) {
+  const auto map = getRandomMap();
+  const OccupancyClassifier classifier;
+  auto classified_map = std::make_shared<ClassifiedMap>(
+      map->getMinCellWidth(), map->getTreeHeight(), classifier);
+  PointSampler point_sampler{classified_map};
+  EXPECT_FALSE(point_sampler.getRandomBlock().has_value());
+  EXPECT_FALSE(point_sampler.getRandomPoint(Occupancy::kAny).has_value());
+
+  classified_map->update(*map);
+  point_sampler.update();
+  EXPECT_TRUE(point_sampler.getRandomBlock().has_value());
+  EXPECT_TRUE(point_sampler.getRandomPoint(Occupancy::kAny).has_value());
+}
+}  // namespace wavemap
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <wavemap/core/common.h>
 #include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/map/linear_hashed_wavelet_octree.h>
 #include <wavemap/core/map/wavelet_octree.h>
 #include <wavemap/test/config_generator.h>
 #include <wavemap/test/fixture_base.h>
@@ -20,7 +21,8 @@ class QueryAcceleratorTest : public FixtureBase,
 };
 
 using MapTypes =
-    ::testing::Types<HashedWaveletOctree, HashedChunkedWaveletOctree>;
+    ::testing::Types<HashedWaveletOctree, HashedChunkedWaveletOctree,
+                     LinearHashedWaveletOctree>;
 TYPED_TEST_SUITE(QueryAcceleratorTest, MapTypes, );
 
 TYPED_TEST(QueryAcceleratorTest, Equivalence) {
@@ -75,4 +77,38 @@ TYPED_TEST(QueryAcceleratorTest, Equivalence) {
     }
   }
 }
+
+TYPED_TEST(QueryAcceleratorTest, BatchQueries) {
+  constexpr int kNumRepetitions = 10;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    // Create a random map
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename TypeParam::Config>();
+    TypeParam map(config);
+    const std::vector<Index3D> random_indices =
+        GeometryGenerator::getRandomIndexVector<3>(
+            1000u, 2000u, Index3D::Constant(-500), Index3D::Constant(500));
+    for (const Index3D& index : random_indices) {
+      map.addToCellValue(index, TestFixture::getRandomUpdate());
+    }
+    map.prune();
+
+    // Query the map at the updated and at random indices, in random order
+    std::vector<Index3D> query_indices =
+        GeometryGenerator::getRandomIndexVector<3>(
+            1000u, 2000u, Index3D::Constant(-600), Index3D::Constant(600));
+    query_indices.insert(query_indices.end(), random_indices.begin(),
+                         random_indices.end());
+    QueryAccelerator query_accelerator(map);
+    const std::vector<FloatingPoint> values =
+        query_accelerator.getCellValues(query_indices);
+    ASSERT_EQ(values.size(), query_indices.size());
+    for (size_t idx = 0; idx < query_indices.size(); ++idx) {
+      EXPECT_NEAR(values[idx], map.getCellValue(query_indices[idx]),
+                  TestFixture::kNumericalNoise)
+          << "For index " << print::eigen::oneLine(query_indices[idx]);
+    }
+    EXPECT_TRUE(query_accelerator.getCellValues({}).empty());
+  }
+}
 }  // namespace wavemap
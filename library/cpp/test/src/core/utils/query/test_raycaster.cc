@@ -0,0 +1,152 @@
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/integrator/projection_model/spherical_projector.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/query/raycaster.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class RaycasterTest : public FixtureBase,
+                      public GeometryGenerator,
+                      public ConfigGenerator {
+ protected:
+  static constexpr IndexElement kMapExtent = 30;
+
+  std::unique_ptr<HashedWaveletOctree> getRandomMap() {
+    const auto config =
+        ConfigGenerator::getRandomConfig<HashedWaveletOctree::Config>();
+    auto map = std::make_unique<HashedWaveletOctree>(config);
+    for (const Index3D& index : GeometryGenerator::getRandomIndexVector<3>(
+             500u, 1000u, Index3D::Constant(-kMapExtent),
+             Index3D::Constant(kMapExtent))) {
+      map->addToCellValue(index, getRandomFloat(-2.f, 2.f));
+    }
+    map->prune();
+    return map;
+  }
+
+  Point3D getRandomPointInMap(FloatingPoint min_cell_width) {
+    Point3D point;
+    for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+      point[dim_idx] = min_cell_width * getRandomFloat(-1.2f * kMapExtent,
+                                                       1.2f * kMapExtent);
+    }
+    return point;
+  }
+
+  // Find the nearest hit by intersecting the ray with every matching cell
+  static std::optional<FloatingPoint> castRayBruteForce(
+      const HashedWaveletOctree& map, const OccupancyClassifier& classifier,
+      const Point3D& start, const Vector3D& direction, FloatingPoint max_range,
+      Occupancy::Mask hit_mask) {
+    const FloatingPoint min_cell_width = map.getMinCellWidth();
+    const Point3D end = start + max_range * direction;
+    const Index3D min_index =
+        convert::pointToNearestIndex(Point3D{start.cwiseMin(end)},
+                                   1.f / min_cell_width);
+    const Index3D max_index =
+        convert::pointToNearestIndex(Point3D{start.cwiseMax(end)},
+                                   1.f / min_cell_width);
+    std::optional<FloatingPoint> nearest_hit;
+    for (const Index3D& index : Grid<3>(min_index, max_index)) {
+      const auto cell_occupancy = classifier.classify(map.getCellValue(index));
+      if (!OccupancyClassifier::has(Occupancy::toMask(cell_occupancy),
+                                    hit_mask)) {
+        continue;
+      }
+      const auto cell_aabb =
+          convert::nodeIndexToAABB(OctreeIndex{0, index}, min_cell_width);
+      FloatingPoint t_entry = 0.f;
+      FloatingPoint t_exit = max_range;
+      for (int dim_idx = 0; dim_idx < 3; ++dim_idx) {
+        FloatingPoint t_min =
+            (cell_aabb.min[dim_idx] - start[dim_idx]) / direction[dim_idx];
+        FloatingPoint t_max =
+            (cell_aabb.max[dim_idx] - start[dim_idx]) / direction[dim_idx];
+        if (t_max < t_min) {
+          std::swap(t_min, t_max);
+        }
+        t_entry = std::max(t_entry, t_min);
+        t_exit = std::min(t_exit, t_max);
+      }
+      if (t_entry <= t_exit &&
+          (!nearest_hit || t_entry < nearest_hit.value())) {
+        nearest_hit = t_entry;
+      }
+    }
+    return nearest_hit;
+  }
+};
+
+TEST_F(RaycasterTest, SingleRays) {
+  constexpr int kNumRepetitions = 3;
+  constexpr int kNumRays = 50;
+  const OccupancyClassifier classifier;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = getRandomMap();
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    const auto classified_map =
+        std::make_shared<ClassifiedMap>(*map, classifier);
+    for (const Occupancy::Mask hit_mask :
+         {Occupancy::toMask(Occupancy::kOccupied),
+          Occupancy::toMask(false, true, true)}) {
+      const Raycaster raycaster{classified_map, hit_mask};
+      for (int ray_idx = 0; ray_idx < kNumRays; ++ray_idx) {
+        const Point3D start = getRandomPointInMap(min_cell_width);
+        const Vector3D direction =
+            Vector3D{getRandomPoint<3>(0.1f, 1.f)}.normalized();
+        const FloatingPoint max_range =
+            min_cell_width * getRandomFloat(1.f, 2.f * kMapExtent);
+        const auto hit = raycaster.castRay(start, direction, max_range);
+        const auto expected_hit = castRayBruteForce(
+            *map, classifier, start, direction, max_range, hit_mask);
+        ASSERT_EQ(hit.has_value(), expected_hit.has_value())
+            << "For ray from " << print::eigen::oneLine(start)
+            << " in direction " << print::eigen::oneLine(direction);
+        if (hit) {
+          EXPECT_NEAR(hit.value(), expected_hit.value(),
+                      1e-3f * min_cell_width);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(RaycasterTest, RangeImages) {
+  const OccupancyClassifier classifier;
+  const auto map = getRandomMap();
+  const FloatingPoint min_cell_width = map->getMinCellWidth();
+  const Raycaster raycaster{std::make_shared<ClassifiedMap>(*map, classifier)};
+  const SphericalProjector spherical_projector(
+      ConfigGenerator::getRandomConfig<SphericalProjectorConfig>());
+  const ProjectorBase& projection_model = spherical_projector;
+  const Transformation3D T_W_C{getRandomTransformation().getRotation(),
+                               getRandomPointInMap(min_cell_width)};
+  const FloatingPoint max_range = 2.f * kMapExtent * min_cell_width;
+
+  const Image<> range_image =
+      raycaster.renderRangeImage(projection_model, T_W_C, max_range);
+  ASSERT_EQ(range_image.getDimensions(), projection_model.getDimensions());
+  for (const Index2D& index :
+       Grid<2>(Index2D::Zero(), range_image.getDimensions().array() - 1)) {
+    const Vector3D C_direction =
+        projection_model
+            .sensorToCartesian(projection_model.indexToImage(index), 1.f)
+            .normalized();
+    const auto hit = raycaster.castRay(
+        T_W_C.getPosition(), T_W_C.getRotation().rotate(C_direction),
+        max_range);
+    EXPECT_NEAR(range_image.at(index), hit.value_or(0.f),
+                1e-3f * min_cell_width);
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,105 @@
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/core/utils/undistortion/pointcloud_undistortion.h"
+#include "wavemap/test/eigen_utils.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap::undistortion {
+class PointcloudUndistortionTest : public FixtureBase,
+                                   public GeometryGenerator {
+ protected:
+  static constexpr TimeAbsolute kTimeBase = 1'000'000'000u;
+  static constexpr TimeOffset kScanDuration = 100'000'000u;
+
+  StampedPoseBuffer getRandomPoseBuffer(int num_intervals) {
+    // NOTE: The buffer starts one step before and ends at least one step
+    //       after the scan, such that it covers all the points' timestamps.
+    const TimeAbsolute step_size = kScanDuration / num_intervals;
+    StampedPoseBuffer pose_buffer;
+    for (TimeAbsolute stamp = kTimeBase - step_size;
+         stamp <= kTimeBase + kScanDuration + step_size; stamp += step_size) {
+      pose_buffer.emplace_back(stamp, getRandomTransformation());
+    }
+    return pose_buffer;
+  }
+
+  StampedPointcloud getRandomStampedPointcloud(int num_points) {
+    StampedPointcloud stamped_pointcloud(kTimeBase, "sensor", num_points);
+    // NOTE: Points are stamped with a limited number of distinct time
+    //       offsets, as for LiDARs that fire several beams simultaneously.
+    constexpr int kNumDistinctOffsets = 1000;
+    for (int point_idx = 0; point_idx < num_points; ++point_idx) {
+      const Point3D point = getRandomPoint<3>();
+      const auto time_offset = static_cast<TimeOffset>(
+          getRandomInteger(0, kNumDistinctOffsets) *
+          (kScanDuration / kNumDistinctOffsets));
+      stamped_pointcloud.emplace(point.x(), point.y(), point.z(),
+                                 time_offset);
+    }
+    return stamped_pointcloud;
+  }
+
+  static Transformation3D interpolatePoseReference(
+      const StampedPoseBuffer& pose_buffer, TimeAbsolute time) {
+    size_t left_idx = 0u;
+    while (pose_buffer[left_idx + 1].stamp < time &&
+           left_idx + 2 < pose_buffer.size()) {
+      ++left_idx;
+    }
+    const auto& left = pose_buffer[left_idx];
+    const auto& right = pose_buffer[left_idx + 1];
+    const FloatingPoint a =
+        static_cast<FloatingPoint>(time - left.stamp) /
+        static_cast<FloatingPoint>(right.stamp - left.stamp);
+    return interpolateComponentwise(left.pose, right.pose, a);
+  }
+};
+
+TEST_F(PointcloudUndistortionTest, EquivalenceToPerPointInterpolation) {
+  constexpr int kNumRepetitions = 5;
+  const auto thread_pool = std::make_shared<ThreadPool>();
+  for (int idx = 0; idx < kNumRepetitions; ++idx) {
+    const StampedPoseBuffer pose_buffer =
+        getRandomPoseBuffer(getRandomInteger(2, 100));
+    StampedPointcloud stamped_pointcloud =
+        getRandomStampedPointcloud(getRandomInteger(1, 20000));
+
+    const PosedPointcloud<> serial_result =
+        compensate_motion(pose_buffer, stamped_pointcloud);
+    PosedPointcloud<> parallel_result;
+    compensate_motion(pose_buffer, stamped_pointcloud, parallel_result,
+                      thread_pool);
+
+    // The pointcloud should be expressed in the sensor frame at median time
+    const Transformation3D& T_WCmedian = serial_result.getPose();
+    EXPECT_EIGEN_NEAR(
+        T_WCmedian.getTransformationMatrix(),
+        interpolatePoseReference(pose_buffer,
+                                 stamped_pointcloud.getMedianTime())
+            .getTransformationMatrix(),
+        kEpsilon);
+    EXPECT_EIGEN_EQ(parallel_result.getPose().getTransformationMatrix(),
+                    T_WCmedian.getTransformationMatrix());
+
+    ASSERT_EQ(serial_result.size(), stamped_pointcloud.getPoints().size());
+    ASSERT_EQ(parallel_result.size(), stamped_pointcloud.getPoints().size());
+    for (size_t point_idx = 0; point_idx < serial_result.size(); ++point_idx) {
+      const auto& stamped_point = stamped_pointcloud[point_idx];
+      const Transformation3D T_WCi = interpolatePoseReference(
+          pose_buffer,
+          stamped_pointcloud.getTimeBase() + stamped_point.time_offset);
+      const Point3D expected_point =
+          T_WCmedian.inverse() * (T_WCi * stamped_point.position);
+      const Point3D serial_point = serial_result[point_idx];
+      const Point3D parallel_point = parallel_result[point_idx];
+      EXPECT_EIGEN_NEAR(serial_point, expected_point, 1e-3f);
+      EXPECT_EIGEN_EQ(parallel_point, serial_point);
+    }
+  }
+}
+}  // namespace wavemap::undistortion
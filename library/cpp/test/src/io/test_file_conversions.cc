@@ -6,7 +6,9 @@
 #include "wavemap/core/common.h"
 #include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
 #include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
 #include "wavemap/core/map/map_base.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
 #include "wavemap/core/map/wavelet_octree.h"
 #include "wavemap/io/file_conversions.h"
 #include "wavemap/test/config_generator.h"
@@ -21,11 +23,24 @@ class FileConversionsTest : public FixtureBase,
  protected:
   static constexpr FloatingPoint kAcceptableReconstructionError = 5e-2f;
   static constexpr auto kTemporaryFilePath = "/tmp/tmp.wvmp";
+
+  // Linear and quantized hashed wavelet octrees are stored in the same format
+  // as regular ones, and are only loaded as such if the map to load into is
+  // of the same type
+  static MapBase::Ptr getMapToLoadInto(
+      const typename MapType::Config& config) {
+    if constexpr (std::is_same_v<MapType, LinearHashedWaveletOctree> ||
+                  std::is_same_v<MapType, QuantizedHashedWaveletOctree>) {
+      return std::make_shared<MapType>(config);
+    }
+    return nullptr;
+  }
 };
 
 using MapTypes =
     ::testing::Types<HashedBlocks, WaveletOctree, HashedWaveletOctree,
-                     HashedChunkedWaveletOctree>;
+                     HashedChunkedWaveletOctree, LinearHashedWaveletOctree,
+                     QuantizedHashedWaveletOctree>;
 TYPED_TEST_SUITE(FileConversionsTest, MapTypes, );
 
 TYPED_TEST(FileConversionsTest, MetadataPreservation) {
@@ -49,7 +64,7 @@ TYPED_TEST(FileConversionsTest, MetadataPreservation) {
 
   // Serialize and deserialize
   ASSERT_TRUE(io::mapToFile(*map_base, TestFixture::kTemporaryFilePath));
-  MapBase::Ptr map_base_round_trip;
+  MapBase::Ptr map_base_round_trip = TestFixture::getMapToLoadInto(config);
   ASSERT_TRUE(
       io::fileToMap(TestFixture::kTemporaryFilePath, map_base_round_trip));
   ASSERT_TRUE(map_base_round_trip);
@@ -100,7 +115,7 @@ TYPED_TEST(FileConversionsTest, InsertionAndLeafVisitor) {
 
     // Serialize and deserialize
     ASSERT_TRUE(io::mapToFile(map_original, TestFixture::kTemporaryFilePath));
-    MapBase::Ptr map_base_round_trip;
+    MapBase::Ptr map_base_round_trip = TestFixture::getMapToLoadInto(config);
     ASSERT_TRUE(
         io::fileToMap(TestFixture::kTemporaryFilePath, map_base_round_trip));
     ASSERT_TRUE(map_base_round_trip);
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/map/hashed_blocks.h"
+#include "wavemap/core/map/hashed_chunked_wavelet_octree.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/iterate/grid_iterator.h"
+#include "wavemap/core/utils/shape/intersection_tests.h"
+#include "wavemap/io/pointcloud_conversions.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+template <typename MapType>
+class PointcloudConversionsTest : public FixtureBase,
+                                  public GeometryGenerator,
+                                  public ConfigGenerator {
+ protected:
+  using PointSet = std::set<std::array<FloatingPoint, 3>>;
+
+  std::unique_ptr<MapType> getRandomMap() {
+    const auto config =
+        ConfigGenerator::getRandomConfig<typename MapType::Config>();
+    auto map = std::make_unique<MapType>(config);
+    for (const Index3D& index : GeometryGenerator::getRandomIndexVector<3>(
+             500u, 1000u, Index3D::Constant(-100), Index3D::Constant(100))) {
+      map->addToCellValue(index, getRandomUpdate());
+    }
+    map->prune();
+    return map;
+  }
+
+  // Parse the header and points of a binary PLY or PCD stream
+  static PointSet parsePointcloud(std::istream& istream,
+                                  io::PointcloudFormat format) {
+    const std::string count_keyword =
+        format == io::PointcloudFormat::kPly ? "element vertex" : "POINTS";
+    const std::string end_keyword =
+        format == io::PointcloudFormat::kPly ? "end_header" : "DATA binary";
+    size_t num_points = 0u;
+    for (std::string line; std::getline(istream, line);) {
+      if (line.rfind(count_keyword, 0) == 0) {
+        num_points = std::stoul(line.substr(count_keyword.size()));
+      }
+      if (line == end_keyword) {
+        break;
+      }
+    }
+    PointSet points;
+    for (size_t point_idx = 0; point_idx < num_points; ++point_idx) {
+      std::array<FloatingPoint, 3> point{};
+      istream.read(reinterpret_cast<char*>(point.data()), sizeof(point));
+      EXPECT_TRUE(istream);
+      EXPECT_TRUE(points.emplace(point).second) << "Duplicate point";
+    }
+    // Check that the stream contains no trailing data
+    EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+    return points;
+  }
+
+  // Compute the expected points at the maximum resolution
+  static PointSet getReferencePoints(
+      const MapType& map, FloatingPoint occupancy_threshold,
+      const std::optional<AABB<Point3D>>& region = std::nullopt) {
+    const FloatingPoint min_cell_width = map.getMinCellWidth();
+    PointSet points;
+    map.forEachLeaf([&](const OctreeIndex& node_index, FloatingPoint value) {
+      if (value <= occupancy_threshold) {
+        return;
+      }
+      for (const Index3D& index :
+           Grid<3>(convert::nodeIndexToMinCornerIndex(node_index),
+                   convert::nodeIndexToMaxCornerIndex(node_index))) {
+        const OctreeIndex cell_index{0, index};
+        if (region && !shape::overlaps(convert::nodeIndexToAABB(
+                                           cell_index, min_cell_width),
+                                       region.value())) {
+          continue;
+        }
+        const Point3D center =
+            convert::nodeIndexToCenterPoint(cell_index, min_cell_width);
+        points.insert({center.x(), center.y(), center.z()});
+      }
+    });
+    return points;
+  }
+};
+
+using MapTypes =
+    ::testing::Types<HashedBlocks, HashedWaveletOctree,
+                     HashedChunkedWaveletOctree, LinearHashedWaveletOctree>;
+TYPED_TEST_SUITE(PointcloudConversionsTest, MapTypes, );
+
+TYPED_TEST(PointcloudConversionsTest, OccupiedCells) {
+  const auto thread_pool = std::make_shared<ThreadPool>();
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    const auto map = TestFixture::getRandomMap();
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    const AABB<Point3D> region{Point3D::Constant(-50.f * min_cell_width),
+                               Point3D::Constant(20.f * min_cell_width)};
+    for (const auto format :
+         {io::PointcloudFormat::kPly, io::PointcloudFormat::kPcd}) {
+      io::OccupiedPointcloudConfig config;
+      config.format = format;
+      config.occupancy_threshold = 0.05f;
+      config.max_blocks_per_batch = 3;
+
+      // Export the whole map
+      std::stringstream stream;
+      ASSERT_TRUE(io::occupiedCellsToStream(*map, stream, config, std::nullopt,
+                                            thread_pool));
+      EXPECT_EQ(TestFixture::parsePointcloud(stream, format),
+                TestFixture::getReferencePoints(*map,
+                                                config.occupancy_threshold));
+
+      // Export a region
+      std::stringstream region_stream;
+      ASSERT_TRUE(io::occupiedCellsToStream(*map, region_stream, config,
+                                            region, thread_pool));
+      EXPECT_EQ(TestFixture::parsePointcloud(region_stream, format),
+                TestFixture::getReferencePoints(
+                    *map, config.occupancy_threshold, region));
+    }
+  }
+}
+
+TYPED_TEST(PointcloudConversionsTest, Decimation) {
+  if constexpr (std::is_same_v<TypeParam, HashedBlocks>) {
+    GTEST_SKIP() << "Decimation is only supported for wavelet octrees.";
+  } else {
+    const auto map = TestFixture::getRandomMap();
+    const FloatingPoint min_cell_width = map->getMinCellWidth();
+    io::OccupiedPointcloudConfig config;
+    config.output_height = 1;
+
+    // The expected points are the centers of the occupied nodes at the output
+    // height or, for coarser leaves, of their descendants at this height
+    typename TestFixture::PointSet expected_points;
+    map->forEachLeaf(
+        [&](const OctreeIndex& node_index, FloatingPoint value) {
+          if (value <= config.occupancy_threshold) {
+            return;
+          }
+          const IndexElement nodes_per_side =
+              int_math::exp2(node_index.height - config.output_height);
+          const Index3D min_position = nodes_per_side * node_index.position;
+          const Index3D max_position =
+              min_position.array() + (nodes_per_side - 1);
+          for (const Index3D& position :
+               Grid<3>(min_position, max_position)) {
+            const Point3D center = convert::nodeIndexToCenterPoint(
+                OctreeIndex{config.output_height, position}, min_cell_width);
+            expected_points.insert({center.x(), center.y(), center.z()});
+          }
+        },
+        config.output_height);
+
+    std::stringstream stream;
+    ASSERT_TRUE(io::occupiedCellsToStream(*map, stream, config));
+    EXPECT_EQ(TestFixture::parsePointcloud(stream, config.format),
+              expected_points);
+  }
+}
+
+TYPED_TEST(PointcloudConversionsTest, OutputHeightIsClamped) {
+  const auto map = TestFixture::getRandomMap();
+  const IndexElement max_output_height =
+      std::max(map->getTreeHeight() - 1, 0);
+  io::OccupiedPointcloudConfig config;
+  config.output_height = max_output_height;
+  std::stringstream reference_stream;
+  ASSERT_TRUE(io::occupiedCellsToStream(*map, reference_stream, config));
+
+  // Requesting a height beyond the coarsest leaves should be equivalent to
+  // requesting the coarsest leaves' height
+  config.output_height = max_output_height + 2;
+  std::stringstream stream;
+  ASSERT_TRUE(io::occupiedCellsToStream(*map, stream, config));
+  EXPECT_EQ(stream.str(), reference_stream.str());
+}
+}  // namespace wavemap
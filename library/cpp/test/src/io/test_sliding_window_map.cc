@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/indexing/index_conversions.h"
+#include "wavemap/core/indexing/index_hashes.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/io/sliding_window_map.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class SlidingWindowMapTest : public FixtureBase,
+                             public GeometryGenerator,
+                             public ConfigGenerator {
+ protected:
+  using CellValueMap = std::unordered_map<Index3D, FloatingPoint, Index3DHash>;
+
+  static constexpr FloatingPoint kAcceptableReconstructionError = 5e-2f;
+  const std::filesystem::path kStorageDirectory =
+      std::filesystem::temp_directory_path() / "wavemap_sliding_window_test";
+
+  void SetUp() override {
+    FixtureBase::SetUp();
+    std::filesystem::remove_all(kStorageDirectory);
+  }
+  void TearDown() override { std::filesystem::remove_all(kStorageDirectory); }
+
+  HashedWaveletOctree::Ptr getRandomMap(size_t num_updates,
+                                        IndexElement max_coordinate) {
+    auto map = std::make_shared<HashedWaveletOctree>(
+        getRandomConfig<HashedWaveletOctreeConfig>());
+    for (const Index3D& index : getRandomIndexVector<3>(
+             num_updates, num_updates, Index3D::Constant(-max_coordinate),
+             Index3D::Constant(max_coordinate))) {
+      map->addToCellValue(index, getRandomUpdate());
+    }
+    map->threshold();
+    return map;
+  }
+
+  // Point further than the radius from all blocks of maps returned by
+  // getRandomMap(num_updates, max_coordinate)
+  static Point3D getFarAwayPoint(const HashedWaveletOctree& map,
+                                 IndexElement max_coordinate) {
+    const FloatingPoint block_width = convert::heightToCellWidth(
+        map.getMinCellWidth(), map.getTreeHeight());
+    return Point3D::Constant(
+        4.f * (block_width + static_cast<FloatingPoint>(max_coordinate) *
+                                 map.getMinCellWidth()));
+  }
+
+  static CellValueMap getCellValues(const HashedWaveletOctree& map) {
+    CellValueMap values;
+    map.forEachLeaf([&values](const OctreeIndex& node_index,
+                              FloatingPoint value) {
+      if (node_index.height == 0) {
+        values.emplace(node_index.position, value);
+      }
+    });
+    return values;
+  }
+};
+
+TEST_F(SlidingWindowMapTest, EvictionAndPagingIn) {
+  constexpr int kNumRepetitions = 3;
+  for (int i = 0; i < kNumRepetitions; ++i) {
+    std::filesystem::remove_all(kStorageDirectory);
+    const auto map = getRandomMap(1000u, 200);
+    const size_t num_blocks = map->getHashMap().size();
+    const CellValueMap original_values = getCellValues(*map);
+
+    io::SlidingWindowMapConfig config;
+    config.radius = 10.f * map->getMinCellWidth();
+    config.storage_directory = kStorageDirectory.string();
+    io::SlidingWindowMap sliding_window(config, map);
+
+    // Moving the window far away from the map should evict all blocks
+    sliding_window.update(getFarAwayPoint(*map, 200));
+    EXPECT_TRUE(map->empty());
+    EXPECT_EQ(sliding_window.getBlockStore().size(), num_blocks);
+
+    // Querying a cell should page its block back in
+    const auto& [queried_index, queried_value] = *original_values.begin();
+    EXPECT_NEAR(sliding_window.getCellValue(queried_index), queried_value,
+                kAcceptableReconstructionError);
+    const Index3D queried_block_index =
+        convert::indexToBlockIndex(queried_index, map->getTreeHeight());
+    EXPECT_TRUE(map->hasBlock(queried_block_index));
+    EXPECT_FALSE(sliding_window.isBlockStored(queried_block_index));
+
+    // Moving the window back should page in all blocks within its radius
+    sliding_window.update(Point3D::Zero());
+    for (const auto& block_index :
+         sliding_window.getBlockStore().getBlockIndices()) {
+      const AABB<Point3D> block_aabb = convert::nodeIndexToAABB(
+          OctreeIndex{map->getTreeHeight(), block_index},
+          map->getMinCellWidth());
+      EXPECT_LT(sliding_window.getConfig().radius,
+                block_aabb.minDistanceTo(Point3D::Zero()));
+    }
+    sliding_window.loadAll();
+    EXPECT_TRUE(sliding_window.getBlockStore().empty());
+    EXPECT_EQ(map->getHashMap().size(), num_blocks);
+    for (const auto& [index, value] : original_values) {
+      EXPECT_NEAR(map->getCellValue(index), value,
+                  kAcceptableReconstructionError)
+          << "At index " << print::eigen::oneLine(index);
+    }
+  }
+}
+
+TEST_F(SlidingWindowMapTest, MergeReallocatedBlocks) {
+  const auto map = getRandomMap(1000u, 200);
+  const CellValueMap original_values = getCellValues(*map);
+
+  io::SlidingWindowMapConfig config;
+  config.radius = map->getMinCellWidth();
+  config.storage_directory = kStorageDirectory.string();
+  io::SlidingWindowMap sliding_window(config, map);
+  sliding_window.update(getFarAwayPoint(*map, 200));
+  ASSERT_TRUE(map->empty());
+
+  // Update cells whose blocks were evicted, as an integrator reaching beyond
+  // the window would
+  constexpr FloatingPoint kUpdate = 0.5f;
+  for (const auto& [index, value] : original_values) {
+    map->addToCellValue(index, kUpdate);
+  }
+
+  // Evict the reallocated blocks again, before their stored versions were
+  // paged back in, and check that no information is lost
+  // NOTE: Evicted blocks are thresholded, so the sums saturate.
+  sliding_window.update(getFarAwayPoint(*map, 200));
+  ASSERT_TRUE(map->empty());
+  for (const auto& [index, value] : original_values) {
+    const FloatingPoint expected_value = std::clamp(
+        value + kUpdate, map->getMinLogOdds(), map->getMaxLogOdds());
+    EXPECT_NEAR(sliding_window.getCellValue(index), expected_value,
+                kAcceptableReconstructionError)
+        << "At index " << print::eigen::oneLine(index);
+  }
+  EXPECT_TRUE(sliding_window.getBlockStore().empty());
+}
+
+TEST_F(SlidingWindowMapTest, MemoryBudget) {
+  const auto map = getRandomMap(50000u, 500);
+  constexpr size_t kBytesPerMegabyte = 1024u * 1024u;
+  const size_t original_memory_usage = map->getMemoryUsage();
+  ASSERT_GT(original_memory_usage, 2u * kBytesPerMegabyte);
+  const CellValueMap original_values = getCellValues(*map);
+
+  io::SlidingWindowMapConfig config;
+  config.radius = 1e4f * map->getMinCellWidth();
+  config.memory_budget_in_mb =
+      static_cast<int>(original_memory_usage / kBytesPerMegabyte / 2u);
+  config.storage_directory = kStorageDirectory.string();
+  io::SlidingWindowMap sliding_window(config, map);
+
+  // The budget should be met by evicting the blocks furthest from the center
+  sliding_window.update(Point3D::Zero());
+  EXPECT_LE(map->getMemoryUsage(),
+            config.memory_budget_in_mb * kBytesPerMegabyte);
+  FloatingPoint max_resident_distance = 0.f;
+  map->forEachBlock([&](const Index3D& block_index, const auto& /*block*/) {
+    max_resident_distance = std::max(
+        max_resident_distance,
+        convert::nodeIndexToAABB(OctreeIndex{map->getTreeHeight(), block_index},
+                                 map->getMinCellWidth())
+            .minDistanceTo(Point3D::Zero()));
+  });
+  for (const auto& block_index :
+       sliding_window.getBlockStore().getBlockIndices()) {
+    EXPECT_LE(max_resident_distance,
+              convert::nodeIndexToAABB(
+                  OctreeIndex{map->getTreeHeight(), block_index},
+                  map->getMinCellWidth())
+                  .minDistanceTo(Point3D::Zero()));
+  }
+
+  // Updating the window again should not page the evicted blocks back in
+  const size_t num_stored_blocks = sliding_window.getBlockStore().size();
+  sliding_window.update(Point3D::Zero());
+  EXPECT_EQ(sliding_window.getBlockStore().size(), num_stored_blocks);
+
+  // All values should remain accessible
+  for (const auto& [index, value] : original_values) {
+    EXPECT_NEAR(sliding_window.getCellValue(index), value,
+                kAcceptableReconstructionError);
+  }
+}
+}  // namespace wavemap
@@ -0,0 +1,107 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/map/linear_hashed_wavelet_octree.h"
+#include "wavemap/core/map/map_base.h"
+#include "wavemap/core/map/quantized_hashed_wavelet_octree.h"
+#include "wavemap/core/utils/thread_pool.h"
+#include "wavemap/pipeline/map_operations/coarsen_map_operation.h"
+#include "wavemap/pipeline/map_operations/memory_budget_map_operation.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+template <typename MapType>
+class MapOperationsTest : public FixtureBase,
+                          public GeometryGenerator,
+                          public ConfigGenerator {
+ protected:
+  std::vector<std::pair<Index3D, FloatingPoint>> getRandomUpdates(
+      size_t num_updates, IndexElement max_index) {
+    std::vector<std::pair<Index3D, FloatingPoint>> updates;
+    for (const Index3D& index : getRandomIndexVector<3>(
+             num_updates, num_updates, Index3D::Constant(-max_index),
+             Index3D::Constant(max_index))) {
+      updates.emplace_back(index, getRandomFloat(-3.f, 3.f));
+    }
+    return updates;
+  }
+};
+
+using MapTypes =
+    ::testing::Types<LinearHashedWaveletOctree, QuantizedHashedWaveletOctree>;
+TYPED_TEST_SUITE(MapOperationsTest, MapTypes, );
+
+TYPED_TEST(MapOperationsTest, Coarsen) {
+  auto thread_pool = std::make_shared<ThreadPool>(2);
+  for (const bool use_thread_pool : {false, true}) {
+    // Create a random map and its reference
+    auto config = ConfigGenerator::getRandomConfig<HashedWaveletOctreeConfig>();
+    config.tree_height = 6;
+    auto map = std::make_shared<TypeParam>(config);
+    auto reference_map = std::make_shared<HashedWaveletOctree>(config);
+    for (const auto& [index, update] :
+         TestFixture::getRandomUpdates(1000u, 500)) {
+      map->addToCellValue(index, update);
+      reference_map->addToCellValue(index, update);
+    }
+    const size_t original_size = map->size();
+    ASSERT_EQ(original_size, reference_map->size());
+
+    // Coarsen all blocks except for the most recently updated one
+    CoarsenMapOperationConfig operation_config;
+    operation_config.termination_height = 2;
+    operation_config.radius = 1e-3f;
+    const auto operation_thread_pool = use_thread_pool ? thread_pool : nullptr;
+    CoarsenMapOperation(operation_config, map, operation_thread_pool)
+        .run(true);
+    CoarsenMapOperation(operation_config, reference_map, operation_thread_pool)
+        .run(true);
+
+    // Check that the map was coarsened, identically to the reference
+    EXPECT_LT(map->size(), original_size);
+    EXPECT_EQ(map->size(), reference_map->size());
+    reference_map->forEachLeaf(
+        [&map](const OctreeIndex& node_index, FloatingPoint reference_value) {
+          EXPECT_NEAR(map->getCellValue(node_index), reference_value, kEpsilon)
+              << "At node index " << node_index.toString();
+        });
+  }
+}
+
+TYPED_TEST(MapOperationsTest, MemoryBudget) {
+  for (const bool allow_block_eviction : {false, true}) {
+    // Create a random map whose memory usage exceeds the budget
+    auto config = ConfigGenerator::getRandomConfig<HashedWaveletOctreeConfig>();
+    config.tree_height = 6;
+    auto map = std::make_shared<TypeParam>(config);
+    for (const auto& [index, update] :
+         TestFixture::getRandomUpdates(20000u, 2000)) {
+      map->addToCellValue(index, update);
+    }
+    MemoryBudgetMapOperationConfig operation_config;
+    operation_config.memory_budget_in_mb = 1;
+    operation_config.max_coarsening_height = 1;
+    operation_config.allow_block_eviction = allow_block_eviction;
+    const size_t memory_budget = 1024u * 1024u;
+    const size_t original_memory_usage = map->getMemoryUsage();
+    const size_t original_num_blocks = map->getHashMap().size();
+    ASSERT_LT(memory_budget, original_memory_usage);
+
+    // Check that the map was shrunk, and only met the budget by evicting
+    // blocks if allowed to
+    MemoryBudgetMapOperation(operation_config, map).run(true);
+    EXPECT_LT(map->getMemoryUsage(), original_memory_usage);
+    if (allow_block_eviction) {
+      EXPECT_LE(map->getMemoryUsage(), memory_budget);
+      EXPECT_LT(map->getHashMap().size(), original_num_blocks);
+    }
+  }
+}
+}  // namespace wavemap
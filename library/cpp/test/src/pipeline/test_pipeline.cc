@@ -0,0 +1,86 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wavemap/core/common.h"
+#include "wavemap/core/data_structure/image.h"
+#include "wavemap/core/data_structure/pointcloud.h"
+#include "wavemap/core/integrator/measurement_model/continuous_beam.h"
+#include "wavemap/core/integrator/projection_model/spherical_projector.h"
+#include "wavemap/core/integrator/projective/coarse_to_fine/hashed_wavelet_integrator.h"
+#include "wavemap/core/map/hashed_wavelet_octree.h"
+#include "wavemap/core/utils/profile/metrics.h"
+#include "wavemap/pipeline/pipeline.h"
+#include "wavemap/test/config_generator.h"
+#include "wavemap/test/fixture_base.h"
+#include "wavemap/test/geometry_generator.h"
+
+namespace wavemap {
+class PipelineTest : public FixtureBase,
+                     public GeometryGenerator,
+                     public ConfigGenerator {
+ protected:
+  std::unique_ptr<HashedWaveletIntegrator> createIntegrator(
+      HashedWaveletOctree::Ptr map) {
+    const auto projection_model = std::make_shared<SphericalProjector>(
+        getRandomConfig<SphericalProjectorConfig>());
+    const auto posed_range_image =
+        std::make_shared<PosedImage<>>(projection_model->getDimensions());
+    const auto beam_offset_image =
+        std::make_shared<Image<Vector2D>>(projection_model->getDimensions());
+    const auto measurement_model = std::make_shared<ContinuousBeam>(
+        getRandomConfig<ContinuousBeamConfig>(*projection_model),
+        projection_model, posed_range_image, beam_offset_image);
+    return std::make_unique<HashedWaveletIntegrator>(
+        getRandomConfig<ProjectiveIntegratorConfig>(), projection_model,
+        posed_range_image, beam_offset_image, measurement_model,
+        std::move(map));
+  }
+
+  PosedPointcloud<> getRandomPosedPointcloud() {
+    return PosedPointcloud<>(getRandomTransformation(),
+                             Pointcloud<>(getRandomPointVector<3>()));
+  }
+};
+
+TEST_F(PipelineTest, FusedIntegrationMetrics) {
+  auto map = std::make_shared<HashedWaveletOctree>(
+      getRandomConfig<HashedWaveletOctreeConfig>());
+  Pipeline pipeline(map);
+  pipeline.addIntegrator("first", createIntegrator(map));
+  pipeline.addIntegrator("second", createIntegrator(map));
+
+  // Check that each fused measurement is recorded like a sequential one
+  auto& num_points = metrics::getCounter("integrator_points_total");
+  auto& integration_time =
+      metrics::getHistogram("integrator_integration_seconds");
+  const uint64_t original_num_points = num_points.get();
+  const uint64_t original_num_integrations = integration_time.getCount();
+  const std::vector<PosedPointcloud<>> pointclouds{getRandomPosedPointcloud(),
+                                                   getRandomPosedPointcloud()};
+  EXPECT_TRUE(pipeline.runIntegratorsFused(
+      std::vector<std::string>{"first", "second"}, pointclouds));
+  EXPECT_EQ(num_points.get(), original_num_points + pointclouds[0].size() +
+                                  pointclouds[1].size());
+  EXPECT_EQ(integration_time.getCount(), original_num_integrations + 2u);
+}
+
+TEST_F(PipelineTest, FusedIntegrationUnknownIntegrator) {
+  auto map = std::make_shared<HashedWaveletOctree>(
+      getRandomConfig<HashedWaveletOctreeConfig>());
+  Pipeline pipeline(map);
+  pipeline.addIntegrator("first", createIntegrator(map));
+
+  // Check that nothing is imported or integrated if any name is unknown
+  auto& num_points = metrics::getCounter("integrator_points_total");
+  const uint64_t original_num_points = num_points.get();
+  const std::vector<PosedPointcloud<>> pointclouds{getRandomPosedPointcloud(),
+                                                   getRandomPosedPointcloud()};
+  EXPECT_FALSE(pipeline.runIntegratorsFused(
+      std::vector<std::string>{"first", "unknown"}, pointclouds));
+  EXPECT_EQ(num_points.get(), original_num_points);
+  EXPECT_TRUE(map->empty());
+}
+}  // namespace wavemap
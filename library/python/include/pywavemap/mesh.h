@@ -0,0 +1,12 @@
+#ifndef PYWAVEMAP_MESH_H_
+#define PYWAVEMAP_MESH_H_
+
+#include <nanobind/nanobind.h>
+
+namespace nb = nanobind;
+
+namespace wavemap {
+void add_mesh_module(nb::module_& m_mesh);
+}  // namespace wavemap
+
+#endif  // PYWAVEMAP_MESH_H_
@@ -0,0 +1,161 @@
+#include "pywavemap/mesh.h"
+
+#include <memory>
+#include <vector>
+
+#include <nanobind/eigen/dense.h>
+#include <wavemap/core/map/hashed_chunked_wavelet_octree.h>
+#include <wavemap/core/map/hashed_wavelet_octree.h>
+#include <wavemap/core/utils/mesh/surface_extractor.h>
+
+using namespace nb::literals;  // NOLINT
+
+namespace wavemap {
+namespace {
+// Convert a mesh into a tuple of (N, 3) vertex and (M, 3) triangle arrays
+nb::tuple meshToArrays(const SurfaceMesh& mesh) {
+  // Create the raw results arrays and wrap them in Python capsules that
+  // deallocate them when all references to them expire
+  auto* vertices = new float[3 * mesh.vertices.size()];
+  nb::capsule vertices_owner(vertices, [](void* p) noexcept {
+    delete[] reinterpret_cast<float*>(p);
+  });
+  auto* triangles = new SurfaceMesh::VertexIndex[3 * mesh.triangles.size()];
+  nb::capsule triangles_owner(triangles, [](void* p) noexcept {
+    delete[] reinterpret_cast<SurfaceMesh::VertexIndex*>(p);
+  });
+
+  // Populate the results
+  size_t idx = 0;
+  for (const auto& vertex : mesh.vertices) {
+    vertices[idx + 0] = vertex.x();
+    vertices[idx + 1] = vertex.y();
+    vertices[idx + 2] = vertex.z();
+    idx += 3;
+  }
+  idx = 0;
+  for (const auto& triangle : mesh.triangles) {
+    triangles[idx + 0] = triangle[0];
+    triangles[idx + 1] = triangle[1];
+    triangles[idx + 2] = triangle[2];
+    idx += 3;
+  }
+
+  // Return results as numpy arrays
+  return nb::make_tuple(
+      nb::ndarray<nb::numpy, FloatingPoint>{
+          vertices, {mesh.vertices.size(), 3u}, vertices_owner},
+      nb::ndarray<nb::numpy, SurfaceMesh::VertexIndex>{
+          triangles, {mesh.triangles.size(), 3u}, triangles_owner});
+}
+
+// Convert a list of block indices into an (N, 3) array
+nb::ndarray<nb::numpy, IndexElement> blockIndicesToArray(
+    const std::vector<Index3D>& block_indices) {
+  auto* results = new IndexElement[3 * block_indices.size()];
+  nb::capsule owner(results, [](void* p) noexcept {
+    delete[] reinterpret_cast<IndexElement*>(p);
+  });
+  size_t idx = 0;
+  for (const auto& block_index : block_indices) {
+    results[idx + 0] = block_index.x();
+    results[idx + 1] = block_index.y();
+    results[idx + 2] = block_index.z();
+    idx += 3;
+  }
+  return {results, {block_indices.size(), 3u}, owner};
+}
+}  // namespace
+
+void add_mesh_module(nb::module_& m_mesh) {
+  nb::class_<SurfaceExtractor>(
+      m_mesh, "SurfaceExtractor",
+      "A class that incrementally extracts the surface of occupied space as "
+      "a triangle mesh. The map is meshed block by block, in parallel, and "
+      "only the blocks that changed since the previous update are remeshed.")
+      .def(
+          "__init__",
+          [](SurfaceExtractor* self, FloatingPoint occupancy_threshold) {
+            SurfaceExtractorConfig config;
+            config.occupancy_threshold = occupancy_threshold;
+            new (self) SurfaceExtractor(config);
+          },
+          "threshold"_a = 1e-3f,
+          "    :param threshold: The log-odds threshold above which a cell is "
+          "considered occupied.")
+      .def(
+          "update",
+          [](SurfaceExtractor& self, const HashedWaveletOctree& map) {
+            return blockIndicesToArray(self.update(map));
+          },
+          "map"_a,
+          "Remesh the blocks that changed since the previous update.\n\n"
+          "    :returns: An (N, 3) numpy array with the indices of the updated "
+          "blocks.")
+      .def(
+          "update",
+          [](SurfaceExtractor& self, const HashedChunkedWaveletOctree& map) {
+            return blockIndicesToArray(self.update(map));
+          },
+          "map"_a,
+          "Remesh the blocks that changed since the previous update.\n\n"
+          "    :returns: An (N, 3) numpy array with the indices of the updated "
+          "blocks.")
+      .def(
+          "get_mesh",
+          [](const SurfaceExtractor& self) {
+            return meshToArrays(self.getMesh());
+          },
+          "Retrieve the current mesh of all blocks.\n\n"
+          "    :returns: A tuple with an (N, 3) numpy array of vertex "
+          "positions (float32) and an (M, 3) numpy array of triangles, given "
+          "as vertex indices (uint32) in counter-clockwise order when seen "
+          "from free space.")
+      .def(
+          "get_block_mesh",
+          [](const SurfaceExtractor& self, const Index3D& block_index) {
+            const auto& block_meshes = self.getBlockMeshes();
+            const auto it = block_meshes.find(block_index);
+            return meshToArrays(it != block_meshes.end() ? it->second
+                                                         : SurfaceMesh{});
+          },
+          "block_index"_a,
+          "Retrieve the mesh of a single block, in the same format as "
+          "get_mesh.")
+      .def("clear", &SurfaceExtractor::clear,
+           "Drop all meshes, such that the next update remeshes all blocks.");
+
+  // Convenience functions to mesh a whole map at once
+  m_mesh.def(
+      "extract_surface",
+      [](const HashedWaveletOctree& map, FloatingPoint occupancy_threshold) {
+        SurfaceExtractorConfig config;
+        config.occupancy_threshold = occupancy_threshold;
+        SurfaceExtractor surface_extractor{config};
+        surface_extractor.update(map);
+        return meshToArrays(surface_extractor.getMesh());
+      },
+      "map"_a, "threshold"_a = 1e-3f,
+      "Extract the surface of occupied space as a triangle mesh.\n\n"
+      "    :param threshold: The log-odds threshold above which a cell is "
+      "considered occupied.\n"
+      "    :returns: A tuple with an (N, 3) numpy array of vertex positions "
+      "and an (M, 3) numpy array of triangle vertex indices.");
+  m_mesh.def(
+      "extract_surface",
+      [](const HashedChunkedWaveletOctree& map,
+         FloatingPoint occupancy_threshold) {
+        SurfaceExtractorConfig config;
+        config.occupancy_threshold = occupancy_threshold;
+        SurfaceExtractor surface_extractor{config};
+        surface_extractor.update(map);
+        return meshToArrays(surface_extractor.getMesh());
+      },
+      "map"_a, "threshold"_a = 1e-3f,
+      "Extract the surface of occupied space as a triangle mesh.\n\n"
+      "    :param threshold: The log-odds threshold above which a cell is "
+      "considered occupied.\n"
+      "    :returns: A tuple with an (N, 3) numpy array of vertex positions "
+      "and an (M, 3) numpy array of triangle vertex indices.");
+}
+}  // namespace wavemap
@@ -7,6 +7,7 @@
 #include "pywavemap/logging.h"
 #include "pywavemap/maps.h"
 #include "pywavemap/measurements.h"
+#include "pywavemap/mesh.h"
 #include "pywavemap/param.h"
 #include "pywavemap/pipeline.h"
 
@@ -52,6 +53,14 @@ NB_MODULE(_pywavemap_bindings, m) {
                       "Submodule with tools to edit wavemap maps.");
   add_edit_module(m_edit);
 
+  // Bindings for surface mesh extraction
+  nb::module_ m_mesh =
+      m.def_submodule("mesh",
+                      "mesh\n"
+                      "====\n"
+                      "Submodule to extract surface meshes from wavemap maps.");
+  add_mesh_module(m_mesh);
+
   // Bindings for index types
   add_index_bindings(m);
 
@@ -12,4 +12,4 @@ from ._pywavemap_bindings import (Map, HashedWaveletOctree,
 from ._pywavemap_bindings import Pipeline
 
 # Binding submodules
-from ._pywavemap_bindings import logging, param, convert, edit
+from ._pywavemap_bindings import logging, param, convert, edit, mesh
@@ -71,3 +71,21 @@ def test_batched_trilinear_interpolation():
         point_log_odds = test_map.interpolate(point,
                                               InterpolationMode.TRILINEAR)
         assert points_log_odds[point_idx] == point_log_odds
+
+
+def test_surface_extraction():
+    import pywavemap as wave
+
+    test_map = load_test_map()
+
+    vertices, triangles = wave.mesh.extract_surface(test_map)
+    assert vertices.shape[1] == 3
+    assert triangles.shape[1] == 3
+    assert triangles.shape[0] == 0 or triangles.max() < vertices.shape[0]
+
+    surface_extractor = wave.mesh.SurfaceExtractor()
+    updated_blocks = surface_extractor.update(test_map)
+    assert updated_blocks.shape[1] == 3
+    assert surface_extractor.update(test_map).shape[0] == 0
+    _, incremental_triangles = surface_extractor.get_mesh()
+    assert incremental_triangles.shape == triangles.shape